@@ -0,0 +1,143 @@
+/*
+ *  private/output/Writer.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputWriter_h
+#define AvidaOutputWriter_h
+
+#include "apto/core.h"
+#include "apto/core/Mutex.h"
+#include "apto/core/Thread.h"
+#include "avida/output/Types.h"
+
+#include <fstream>
+#include <string>
+
+
+namespace Avida {
+  namespace Output {
+
+    // Output::Writer - Background thread that performs the disk writes of output files
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Files write into a WriteBuffer, which collects the formatted text in memory and hands it to the writer thread in
+    // blocks of at least BLOCK_SIZE bytes, or when committed.  Blocks wait in a bounded ring; the lock guarding it is only
+    // ever held to swap a block in or out, never across a write, so the simulation thread does not wait on the disk.  It
+    // does wait when a buffer has outgrown MAX_PENDING bytes with the ring still full (back-pressure), and in Drain(),
+    // which returns once everything committed so far is on disk.  Once the writer has been stopped, later writes are
+    // performed on the calling thread.
+
+    class Writer : public Apto::Thread, public Apto::RefCountObject<Apto::ThreadSafe>
+    {
+      friend class WriteBuffer;
+    public:
+      static const int BLOCK_SIZE = 64 * 1024;          // Buffered bytes that trigger a hand off
+      static const int MAX_PENDING = 4 * 1024 * 1024;   // Buffered bytes beyond which a full ring is waited on
+
+    private:
+      class Sink : public Apto::RefCountObject<Apto::ThreadSafe>
+      {
+      public:
+        std::filebuf file;
+
+        ~Sink() { file.close(); }
+      };
+      typedef Apto::SmartPtr<Sink, Apto::InternalRCObject> SinkPtr;
+
+      struct Block
+      {
+        SinkPtr sink;
+        std::string data;
+        bool flush;
+      };
+
+      Apto::Mutex m_mutex;
+      Apto::ConditionVariable m_cond;         // Signals the writer thread that blocks are waiting
+      Apto::ConditionVariable m_space_cond;   // Signals producers (and Drain) that a block has been written
+      Apto::Array<Block> m_ring;
+      Apto::Array<WriteBuffer*> m_buffers;    // Open buffers, whose committed text may still be waiting for ring space
+      int m_head;
+      int m_count;
+      bool m_busy;
+      bool m_terminate;
+      bool m_stopped;
+
+    public:
+      Writer(int max_blocks);
+      ~Writer();
+
+      // Opens path with the given mode, returning a stream buffer that writes to it through this writer (NULL on failure)
+      WriteBuffer* Open(const OutputID& path, std::ios::openmode mode);
+
+      // Must be called from the thread writing to the open buffers
+      void Drain();
+      void Stop();
+
+    protected:
+      void Run();
+
+    private:
+      void release(WriteBuffer* buffer);
+      bool push(SinkPtr sink, std::string& data, bool flush, bool wait);
+      static void write(Sink& sink, const std::string& data, bool flush);
+
+      Writer(const Writer&); // @not_implemented
+      Writer& operator=(const Writer&); // @not_implemented
+    };
+
+
+    // Output::WriteBuffer - Stream buffer of a file written through an Output::Writer
+    // --------------------------------------------------------------------------------------------------------------
+
+    class WriteBuffer : public std::streambuf
+    {
+      friend class Writer;
+    private:
+      WriterPtr m_writer;
+      Writer::SinkPtr m_sink;
+      std::string m_data;
+      bool m_flush_pending;     // Committed, but the ring was full when the text was handed off
+      char m_put[8192];
+
+    public:
+      ~WriteBuffer();
+
+      // Hands everything written so far to the writer thread, to be flushed to disk once written.  Only waits for ring
+      // space beyond MAX_PENDING bytes; otherwise text that does not fit is handed off by a later write or commit.
+      void Commit();
+
+    protected:
+      int_type overflow(int_type c);
+      int sync();
+
+    private:
+      WriteBuffer(WriterPtr writer, Writer::SinkPtr sink);
+
+      void collect();
+      void handoff(bool wait);
+
+      WriteBuffer(const WriteBuffer&); // @not_implemented
+      WriteBuffer& operator=(const WriteBuffer&); // @not_implemented
+    };
+
+  };
+};
+
+#endif
@@ -33,6 +33,8 @@
 #include "cCountTracker.h"
 #include "cDoubleSum.h"
 
+class cCheckpoint;
+
 
 namespace Avida {
   namespace Systematics {
@@ -58,12 +60,40 @@ namespace Avida {
     {
       friend class GenotypeArbiter;
     private:
+      // State only needed while the genotype is active.  Deactivated genotypes that must be kept as ancestors are
+      // frozen, releasing this in favor of a compact record in the arbiter's HistoricStore.
+      struct LiveState
+      {
+        Genome genome;
+        
+        cCountTracker births;
+        cCountTracker deaths;
+        cCountTracker breed_in;
+        cCountTracker breed_true;
+        cCountTracker breed_out;
+        
+        cCountTracker gestation_count;
+        
+        cDoubleSum copied_size;
+        cDoubleSum exe_size;
+        cDoubleSum gestation_time;
+        cDoubleSum repro_rate;
+        cDoubleSum merit;
+        cDoubleSum fitness;
+        
+        Apto::Array<Apto::Stat::Accumulator<int> > task_counts;
+        
+        LiveState(const Genome& in_genome, int num_triggers) : genome(in_genome), task_counts(num_triggers) { ; }
+      };
+      
       mutable GenotypeArbiterPtr m_mgr;
       Apto::List<GenotypePtr, Apto::SparseVector>::EntryHandle* m_handle;
       
       Source m_src;
-      Genome m_genome;
-      Apto::String m_name;
+      LiveState* m_live;
+      int m_record;             // Frozen record in the arbiter's historic store, -1 if never frozen
+      int m_length;
+      int m_name_num;           // Sequence number of the threshold name, -1 if unnamed
       
       bool m_threshold;
       bool m_active;
@@ -78,29 +108,12 @@ namespace Avida {
       int m_total_organisms;
       
       Apto::Array<GenotypePtr> m_parents;
-      Apto::String m_parent_str;
+      Genotype* m_jump;         // Ancestor along the first parent lineage, used to skip over it in O(log depth) steps
       
-      cCountTracker m_births;
-      cCountTracker m_deaths;
-      cCountTracker m_breed_in;
-      cCountTracker m_breed_true;
-      cCountTracker m_breed_out;
-
-      cCountTracker m_gestation_count;
-            
-      cDoubleSum m_copied_size;
-      cDoubleSum m_exe_size;
-      cDoubleSum m_gestation_time;
-      cDoubleSum m_repro_rate;
-      cDoubleSum m_merit;
-      cDoubleSum m_fitness;
-            
       int m_last_birth_cell;
       int m_last_group_id;
       int m_last_forager_type;
       
-      Apto::Array<Apto::Stat::Accumulator<int> > m_task_counts;
-      
       mutable PropertyMap* m_prop_map;
       
       
@@ -143,14 +156,22 @@ namespace Avida {
       // Methods called by GenotypeArbiter
       Genotype(GenotypeArbiterPtr mgr, GroupID in_id, UnitPtr founder, Update update, ConstGroupMembershipPtr parents);
       Genotype(GenotypeArbiterPtr mgr, GroupID in_id, void* props);
+      Genotype(GenotypeArbiterPtr mgr, GroupID in_id, const Genome& genome, const Source& src,
+               const Apto::Array<GenotypePtr>& parents);
 
       void NotifyNewUnit(UnitPtr u);
       void UpdateReset();
 
-      inline const Genome& GroupGenome() const { return m_genome; }
+      inline const Genome& GroupGenome() const { assert(m_live); return m_live->genome; }
       inline const Apto::Array<GenotypePtr> Parents() const { return m_parents; }
       
-      inline void SetName(const Apto::String& name) { m_name = name; }
+      inline int GenomeLength() const { return m_length; }
+      inline void SetName(int name_num) { m_name_num = name_num; }
+      
+      void Freeze();
+      void Thaw();
+      
+      void Checkpoint(cCheckpoint& ckpt);
       
       inline bool IsThreshold() const { return m_threshold; }
       inline bool IsActive() const { return m_active; }
@@ -165,6 +186,13 @@ namespace Avida {
             
     private:
       void setupPropertyMap() const;
+      void decodeGenome(Genome& genome) const;
+      void setupJump();
+      Genotype* ancestorAtDepth(int depth);
+      
+      Apto::String name() const;
+      Apto::String parentString() const;
+      Apto::String genomeString() const;
       inline GenotypePtr thisPtr();
     };
 
@@ -30,6 +30,10 @@
 #include "avida/systematics/Arbiter.h"
 
 #include "avida/private/systematics/Genotype.h"
+#include "avida/private/systematics/HistoricStore.h"
+#include "avida/private/systematics/ProbeTable.h"
+
+class cCheckpoint;
 
 
 namespace Avida {
@@ -47,23 +51,29 @@ namespace Avida {
         EVENT_REMOVE_THRESHOLD
       };
       
-      static const int HASH_SIZE = 3203;
-      
     private:
+      // Active genotypes keyed on sequence hash, and all tracked genotypes keyed on mixed ID
+      typedef ProbeTable<GenotypePtr> GenotypeTable;
+      
+      
       // Config Settings
       int m_threshold;
       bool m_disable_class;
       
       // Internal Data Structures
-      Apto::List<GenotypePtr, Apto::SparseVector> m_active_hash[HASH_SIZE];
+      GenotypeTable m_active_hash;  // active genotypes, keyed on sequence hash
+      GenotypeTable m_id_index;     // all genotypes tracked by the arbiter (active and historic), keyed on mixed ID
       Apto::Array<Apto::List<GenotypePtr, Apto::SparseVector>, Apto::ManagedPointer> m_active_sz;
       Apto::List<GenotypePtr, Apto::SparseVector> m_historic;
+      HistoricStore m_store;        // frozen records of the historic genotypes kept as ancestors
       GenotypePtr m_coalescent;
+      GenotypePtr m_coalescent_floor; // last coalescent found, the search for the next one starts from it
       int m_best;
       int m_next_id;
       int m_dom_prev;
       int m_dom_time;
       Apto::Array<int> m_sz_count;
+      bool m_restoring;             // organisms are being reinjected between the two halves of a checkpoint load
       
       Update m_cur_update;
       
@@ -118,7 +128,8 @@ namespace Avida {
       
       
     public:
-      GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class = false);
+      GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class = false,
+                      const Apto::String& spill_path = "", int spill_mb = 0);
       ~GenotypeArbiter();
       
       // Arbiter Interface Methods
@@ -134,6 +145,17 @@ namespace Avida {
       IteratorPtr Begin();
       
       
+      // Lineage Queries - follow the first parent lineage, in O(log depth) steps
+      GroupPtr AncestorAtDepth(GroupID g_id, int depth);
+      bool IsAncestor(GroupID ancestor_id, GroupID g_id);
+      
+      
+      // Checkpointing (see cCheckpoint) - the lineage is transferred ahead of the organisms, which are then reinjected
+      // with hints naming their genotypes, and the state of the genotypes after them
+      void CheckpointLineage(cCheckpoint& ckpt);
+      void CheckpointState(cCheckpoint& ckpt);
+      
+      
       // Data::Provider
       Data::ConstDataSetPtr Provides() const;
       void UpdateProvidedValues(Update current_update);
@@ -157,9 +179,13 @@ namespace Avida {
       template <class T> Data::PackagePtr packageData(const T&) const;
       Data::ProviderPtr activateProvider(World*);
       
-      unsigned int hashGenome(const InstructionSequence& genome) const;
-      Apto::String nameGenotype(int size);
+      unsigned long long hashGenome(const InstructionSequence& genome) const;
+      static inline unsigned long long hashID(int g_id);
+      int nameGenotype(int size);
       
+      GenotypePtr findGenotype(int g_id) const;
+      void genotypeIDs(Apto::Array<int>& ids) const;
+      void checkpointList(cCheckpoint& ckpt, Apto::List<GenotypePtr, Apto::SparseVector>& list, int num_units);
       void removeGenotype(GenotypePtr genotype);
       void updateCoalescent();
       
@@ -186,6 +212,15 @@ namespace Avida {
     };
 
 
+    inline unsigned long long GenotypeArbiter::hashID(int g_id)
+    {
+      // splitmix64 finalizer, spreads sequential IDs across the table
+      unsigned long long x = (unsigned long long)g_id;
+      x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+      return x ^ (x >> 31);
+    }
+
     inline void GenotypeArbiter::resizeActiveList(int size)
     {
       if (m_active_sz.GetSize() <= size) m_active_sz.Resize(size + 1);
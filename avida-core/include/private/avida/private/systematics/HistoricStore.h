@@ -0,0 +1,126 @@
+/*
+ *  private/systematics/HistoricStore.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaSystematicsHistoricStore_h
+#define AvidaSystematicsHistoricStore_h
+
+#include "apto/core.h"
+#include "avida/core/Genome.h"
+
+
+namespace Avida {
+  namespace Systematics {
+
+    // HistoricStore - Frozen records of historic genotypes
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Each record holds the summarized statistics of a deactivated genotype, by column, along with its genome encoded
+    // either in full (a keyframe) or as the edit that turns the genome of its first parent into it.  Deltas are only
+    // taken against frozen parents, so the length of the chain of deltas that must be replayed to decode a genome is
+    // fixed when the record is made, and bounded by MAX_CHAIN.
+    //
+    // Encoded genomes are packed into chunks.  When a spill path is set, full chunks beyond the resident limit are
+    // written to it and mapped back read-only, leaving the operating system to page cold records in as they are read.
+
+    class HistoricStore
+    {
+    public:
+      enum Statistic {
+        STAT_COPIED_SIZE = 0,
+        STAT_EXE_SIZE,
+        STAT_GESTATION_TIME,
+        STAT_REPRO_RATE,
+        STAT_MERIT,
+        STAT_FITNESS,
+        STAT_MAX_FITNESS,
+        NUM_STATS
+      };
+
+      static const int MAX_CHAIN = 16;
+      static const int CHUNK_SIZE = 1024 * 1024;
+
+    private:
+      struct Chunk
+      {
+        unsigned char* data;
+        int size;
+        int used;
+        int live;
+        long long file_offset;    // Offset of the spilled copy, or -1 while resident
+      };
+
+      Apto::Array<double> m_stats[NUM_STATS];
+      Apto::Array<int> m_total_gestation;
+
+      Apto::Array<int> m_chunk;
+      Apto::Array<int> m_offset;
+      Apto::Array<int> m_length;
+      Apto::Array<unsigned char> m_chain;
+      Apto::Array<int> m_free;
+
+      Apto::Array<Chunk> m_chunks;
+      Apto::Array<int> m_free_chunks;
+      int m_cur_chunk;
+
+      Apto::String m_spill_path;
+      int m_spill_fd;
+      long long m_resident_limit;
+      long long m_resident_bytes;
+      long long m_file_size;
+      Apto::Array<long long> m_free_file;
+      int m_spill_next;
+
+    public:
+      HistoricStore(const Apto::String& spill_path = "", int resident_mb = 0);
+      ~HistoricStore();
+
+      // Freezes genome, encoded against base (the genome of a frozen parent record, or NULL for a keyframe)
+      int Add(const Genome& genome, const Genome* base = NULL, int base_record = -1);
+      void Remove(int record);
+
+      inline int Chain(int record) const { return m_chain[record]; }
+      inline bool IsDelta(int record) const { return m_chain[record] > 0; }
+
+      // Decodes the genome of record into genome, where base is the decoded genome it was encoded against (if any)
+      void Decode(int record, const Genome* base, Genome& genome) const;
+
+      inline double Stat(int record, Statistic stat) const { return m_stats[stat][record]; }
+      inline void SetStat(int record, Statistic stat, double value) { m_stats[stat][record] = value; }
+      inline int TotalGestation(int record) const { return m_total_gestation[record]; }
+      inline void SetTotalGestation(int record, int count) { m_total_gestation[record] = count; }
+
+      inline int GetSize() const { return m_chain.GetSize() - m_free.GetSize(); }
+
+    private:
+      int allocRecord();
+      unsigned char* allocBytes(int record, int length);
+      const unsigned char* recordBytes(int record) const;
+      void releaseChunk(int idx);
+      void spill();
+
+      HistoricStore(const HistoricStore&); // @not_implemented
+      HistoricStore& operator=(const HistoricStore&); // @not_implemented
+    };
+
+  };
+};
+
+#endif
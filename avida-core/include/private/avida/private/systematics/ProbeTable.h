@@ -0,0 +1,132 @@
+/*
+ *  private/systematics/ProbeTable.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaSystematicsProbeTable_h
+#define AvidaSystematicsProbeTable_h
+
+#include "apto/core.h"
+
+
+namespace Avida {
+  namespace Systematics {
+
+    // ProbeTable - Open addressed (linear probing) table, permitting multiple entries per key
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // T must be a pointer-like type, constructible from NULL and testable for NULL.  Empty slots hold T(NULL).
+
+    template <class T> class ProbeTable
+    {
+    private:
+      struct Entry
+      {
+        unsigned long long key;
+        T value;
+
+        Entry() : key(0), value(NULL) { ; }
+      };
+
+      Apto::Array<Entry> m_entries;
+      int m_count;
+
+    public:
+      ProbeTable() : m_entries(64), m_count(0) { ; }
+
+      inline int GetSize() const { return m_count; }
+      inline int GetCapacity() const { return m_entries.GetSize(); }
+
+      // Walks the entries matching key.  Start with slot = -1, each call returns the next match (or NULL when done).
+      inline T Find(unsigned long long key, int& slot) const;
+      inline T EntryAt(int slot) const { return m_entries[slot].value; }
+
+      void Insert(unsigned long long key, T value);
+      bool Remove(unsigned long long key, T value);
+
+    private:
+      inline int home(unsigned long long key) const { return (int)(key & (m_entries.GetSize() - 1)); }
+      void grow();
+    };
+
+
+    template <class T> inline T ProbeTable<T>::Find(unsigned long long key, int& slot) const
+    {
+      const int mask = m_entries.GetSize() - 1;
+      slot = (slot < 0) ? home(key) : ((slot + 1) & mask);
+      for (; m_entries[slot].value; slot = (slot + 1) & mask) {
+        if (m_entries[slot].key == key) return m_entries[slot].value;
+      }
+      return T(NULL);
+    }
+
+    template <class T> void ProbeTable<T>::Insert(unsigned long long key, T value)
+    {
+      // Keep the load factor at or below one half so that probe sequences stay short
+      if ((m_count + 1) * 2 > m_entries.GetSize()) grow();
+
+      const int mask = m_entries.GetSize() - 1;
+      int slot = home(key);
+      while (m_entries[slot].value) slot = (slot + 1) & mask;
+      m_entries[slot].key = key;
+      m_entries[slot].value = value;
+      m_count++;
+    }
+
+    template <class T> bool ProbeTable<T>::Remove(unsigned long long key, T value)
+    {
+      const int mask = m_entries.GetSize() - 1;
+      int slot = home(key);
+      for (; m_entries[slot].value; slot = (slot + 1) & mask) {
+        if (m_entries[slot].key == key && m_entries[slot].value == value) break;
+      }
+      if (!m_entries[slot].value) return false;
+
+      // Backward shift deletion, moving later members of the probe run into the hole so that no tombstones are needed
+      int hole = slot;
+      for (int next = (hole + 1) & mask; m_entries[next].value; next = (next + 1) & mask) {
+        const int next_home = home(m_entries[next].key);
+        // Only move the entry if its home position does not lie cyclically within (hole, next]
+        if (((next - next_home) & mask) >= ((next - hole) & mask)) {
+          m_entries[hole] = m_entries[next];
+          hole = next;
+        }
+      }
+      m_entries[hole].value = T(NULL);
+      m_count--;
+
+      return true;
+    }
+
+    template <class T> void ProbeTable<T>::grow()
+    {
+      Apto::Array<Entry> old_entries(m_entries);
+      m_entries.ResizeClear(old_entries.GetSize() * 2);
+      for (int i = 0; i < m_entries.GetSize(); i++) m_entries[i].value = T(NULL);
+      m_count = 0;
+
+      for (int i = 0; i < old_entries.GetSize(); i++) {
+        if (old_entries[i].value) Insert(old_entries[i].key, old_entries[i].value);
+      }
+    }
+
+  };
+};
+
+#endif
@@ -137,6 +137,12 @@ namespace Avida {
     static int FindSlidingDistance(const InstructionSequence& seq1, const InstructionSequence& seq2);
     static int FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2);
     
+    // Distances from seq1 to each of seqs, placed in the matching entries of distances
+    static void FindHammingDistances(const InstructionSequence& seq1, const Apto::Array<const InstructionSequence*>& seqs,
+                                     Apto::Array<int>& distances);
+    static void FindEditDistances(const InstructionSequence& seq1, const Apto::Array<const InstructionSequence*>& seqs,
+                                  Apto::Array<int>& distances);
+    
     
   protected:
     LIB_EXPORT virtual void adjustCapacity(int new_size);
@@ -0,0 +1,115 @@
+/*
+ *  output/ColumnFile.h
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AvidaOutputColumnFile_h
+#define AvidaOutputColumnFile_h
+
+#include "avida/output/File.h"
+
+#include <iostream>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+
+
+namespace Avida {
+  namespace Output {
+
+    // Output::ColumnFile - File socket that stores data rows as typed, columnar binary chunks
+    // --------------------------------------------------------------------------------------------------------------
+    //
+    // Rows written with Write() and Endl() are buffered by column and stored in chunks of up to CHUNK_ROWS rows,
+    // preceded by a schema giving each column's type, stream formatting and descriptor.  Header comments and anything
+    // written around the typed interface (OFStream(), WriteAnonymous(), WriteRaw(), ...) are kept as verbatim text
+    // chunks, in order, so that ConvertToText() reproduces exactly the file that Output::File would have written.
+
+    class ColumnFile : public File
+    {
+      friend class File;
+    public:
+      enum ColumnType { COL_DOUBLE = 1, COL_INT = 2, COL_STRING = 3, COL_TEXT = 4 };
+      static const int FORMAT_VERSION = 1;
+      static const int CHUNK_ROWS = 4096;
+
+    private:
+      struct Value
+      {
+        int type;
+        int precision;
+        unsigned int flags;
+        double d;
+        int64_t i;
+        std::string s;
+      };
+
+      struct ColumnSpec
+      {
+        int type;
+        int precision;
+        unsigned int flags;
+        Apto::String name;
+      };
+
+      std::ofstream m_out;
+      std::stringbuf m_raw;                 // Captures text written directly to the file stream
+
+      Apto::Array<Apto::String> m_col_names;  // Column descriptors of the first row
+      Apto::Array<ColumnSpec> m_schema;
+      Apto::Array<std::string> m_col_data;    // Encoded values of the buffered rows, by column
+      int m_num_rows;
+
+      Apto::Array<Value> m_row;             // Typed values of the current row
+      bool m_line_is_text;                  // Current row has been mixed with raw text, and is stored as text
+      std::string m_line_text;
+
+
+    public:
+      LIB_EXPORT ~ColumnFile();
+
+      LIB_EXPORT void Write(double x, const char* descr, const char* format = "");
+      LIB_EXPORT void Write(int i, const char* descr, const char* format = "");
+      LIB_EXPORT void Write(long i, const char* descr, const char* format = "");
+      LIB_EXPORT void Write(unsigned int i, const char* descr, const char* format = "");
+      LIB_EXPORT void Write(const char* data_str, const char* descr, const char* format = "");
+      LIB_EXPORT void Write(Apto::Array<int> list, const char* descr, const char* format);
+
+      LIB_EXPORT void FlushComments();
+      LIB_EXPORT void Endl();
+      LIB_EXPORT void Flush();
+
+      // Writes the legacy text form of a column file, returning false if the input is not a valid column file
+      LIB_EXPORT static bool ConvertToText(std::istream& in, std::ostream& out);
+
+    private:
+      LIB_LOCAL ColumnFile(World* world, const OutputID& output_id);
+
+      LIB_LOCAL bool beginValue(const char* descr, const char* format);
+      LIB_LOCAL Value& pushValue(int type);
+      LIB_LOCAL void syncRaw();
+      LIB_LOCAL void addRow();
+      LIB_LOCAL void flushRows();
+      LIB_LOCAL void writeChunk(char tag, const std::string& payload);
+    };
+
+  };
+};
+
+#endif
@@ -39,7 +39,7 @@ namespace Avida {
     
     class File : public Socket
     {
-    private:
+    protected:
       Apto::String m_descr;
       Apto::String m_filetype;
       Apto::String m_format;
@@ -49,6 +49,7 @@ namespace Avida {
       int m_num_cols;
       
       std::ofstream m_fp;
+      WriteBuffer* m_write_buf;             // Set when the file is written by the output manager's writer thread
 
       
     public:
@@ -84,12 +85,12 @@ namespace Avida {
       //  first argument (x, i, data_str, etc.) - the value to write (as double, int, const char *, etc.)
       //  descr - descriptive string detailing the meaning of the value
       //  format (optional) - formatting identifier for the column
-      LIB_EXPORT void Write(double x, const char* descr, const char* format = "");
-      LIB_EXPORT void Write(int i, const char* descr, const char* format = "");
-      LIB_EXPORT void Write(long i, const char* descr, const char* format = "");
-      LIB_EXPORT void Write(unsigned int i, const char* descr, const char* format = "");
-      LIB_EXPORT void Write(const char* data_str, const char* descr, const char* format = "");
-      LIB_EXPORT void Write(Apto::Array<int> list, const char* descr, const char* format);
+      LIB_EXPORT virtual void Write(double x, const char* descr, const char* format = "");
+      LIB_EXPORT virtual void Write(int i, const char* descr, const char* format = "");
+      LIB_EXPORT virtual void Write(long i, const char* descr, const char* format = "");
+      LIB_EXPORT virtual void Write(unsigned int i, const char* descr, const char* format = "");
+      LIB_EXPORT virtual void Write(const char* data_str, const char* descr, const char* format = "");
+      LIB_EXPORT virtual void Write(Apto::Array<int> list, const char* descr, const char* format);
       
       
       // The following methods output a value into the data file anonymously (no column descriptor).
@@ -113,13 +114,17 @@ namespace Avida {
       LIB_EXPORT void WriteTimeStamp(); // Writes the current time into the data file comments.
       LIB_EXPORT void WriteRaw(const char* str); // Writes raw string to the file immediately
       
-      LIB_EXPORT void FlushComments(); // Forces writing of accumulated comments
+      LIB_EXPORT virtual void FlushComments(); // Forces writing of accumulated comments
+      
+      LIB_EXPORT virtual void Endl(); // Write all data to disk and start a new line.
       
-      LIB_EXPORT void Endl(); // Write all data to disk and start a new line.
       
+      LIB_EXPORT virtual void Flush();
       
-      LIB_EXPORT void Flush();
       
+    protected:
+      // Leaves the file stream unopened, writing through capture_buf instead
+      LIB_LOCAL File(World* world, const OutputID& output_id, std::streambuf* capture_buf);
       
     private:
       LIB_EXPORT static FilePtr createWithPath(World* world, Apto::String path, bool append, Feedback* feedback);
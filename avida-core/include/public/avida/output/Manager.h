@@ -29,6 +29,8 @@
 #include "avida/core/World.h"
 #include "avida/output/Types.h"
 
+#include <ios>
+
 
 namespace Avida {
   namespace Output {
@@ -47,6 +49,8 @@ namespace Avida {
       mutable Apto::Mutex m_mutex;
       Apto::Map<OutputID, SocketWeakRef> m_sockets;
       Apto::Map<OutputID, SocketPtr> m_static_sockets;
+      Apto::Map<OutputID, bool> m_columnar;
+      WriterPtr m_writer;
       
     public:
       LIB_EXPORT Manager(const Apto::String& output_path);
@@ -61,6 +65,18 @@ namespace Avida {
       
       LIB_EXPORT void FlushAll();
       
+      // Selects Output::ColumnFile rather than Output::File for the file sockets subsequently opened at output_id
+      LIB_EXPORT void SetColumnar(const OutputID& output_id, bool columnar = true);
+      LIB_EXPORT bool IsColumnar(const OutputID& output_id) const;
+      
+      // Moves the disk writes of subsequently opened files onto a background thread, queueing up to max_blocks blocks
+      LIB_EXPORT void StartWriter(int max_blocks = 256);
+      LIB_EXPORT void StopWriter();
+      LIB_EXPORT void DrainWriter(); // Flushes all sockets and waits until everything written so far is on disk
+      
+      // Opens output_id for writing by the background thread, returning NULL if it is not running or the open fails
+      LIB_EXPORT WriteBuffer* OpenBuffered(const OutputID& output_id, std::ios::openmode mode);
+      
       LIB_EXPORT bool AttachTo(World* world);
       LIB_EXPORT static ManagerPtr Of(World* world);
       
@@ -68,6 +68,7 @@ namespace Avida {
       Apto::Array<Systematics::GroupPtr> m_color_chart_ptr;
       int m_threshold_colors;
       int m_next_color;
+      int m_num_color_changes;
     
     public:
       struct MapColor : public Systematics::GroupData
@@ -89,6 +90,9 @@ namespace Avida {
       
       LIB_EXPORT void Update();      
       
+      // Count of color assignments and removals so far; unchanged across an Update() means every group kept its color
+      LIB_EXPORT inline int GetNumColorChanges() const { return m_num_color_changes; }
+      
       LIB_EXPORT static MapColorPtr MapColorOf(Systematics::GroupPtr bg);
     };
     
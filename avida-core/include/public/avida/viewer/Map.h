@@ -88,6 +88,10 @@ namespace Avida {
       virtual Apto::String GetProperty(const Apto::String& property) const = 0;
       
       virtual void Update(cPopulation& pop) = 0;
+      
+      // Update only the listed cells, the rest of the population is unchanged since the last update.  Modes that cannot
+      // update incrementally fall back to a full update.
+      virtual void UpdateCells(cPopulation& pop, const Apto::Array<int>&) { Update(pop); }
     };
     
     
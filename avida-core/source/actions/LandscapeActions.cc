@@ -83,7 +83,7 @@ public:
     cLandscape* land = NULL;
     Apto::Array<tList<cLandscape> > batches(m_max_dist);
     Apto::Array<int> depths;
-    
+    tAnalyzeJobBatch<cLandscape> jobbatch(m_world->GetAnalyze().GetJobQueue());
     
     if (ctx.GetAnalyzeMode()) {
       if (m_world->GetVerbosity() >= VERBOSE_ON) {
@@ -97,7 +97,7 @@ public:
       cAnalyzeGenotype* genotype = NULL;
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       while ((genotype = batch_it.Next())) {
-        LoadGenome(batches, genotype->GetGenome());
+        LoadGenome(jobbatch, batches, genotype->GetGenome());
         depths.Push(genotype->GetDepth());
       }
     } else {
@@ -110,7 +110,7 @@ public:
 //      update = m_world->GetStats().GetUpdate();
     }
     
-    m_world->GetAnalyze().GetJobQueue().Execute();
+    jobbatch.RunBatch();
 
     Avida::Output::FilePtr df;
     if (ctx.GetAnalyzeMode()) df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_filename);
@@ -139,21 +139,19 @@ public:
   }
   
 private:
-  void LoadGenome(Apto::Array<tList<cLandscape> >& batches, const Genome& genome)
+  void LoadGenome(tAnalyzeJobBatch<cLandscape>& jobbatch, Apto::Array<tList<cLandscape> >& batches, const Genome& genome)
   {
-    cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
-
     for (int dist = batches.GetSize(); dist >= 1; dist--) {
       cLandscape* land = new cLandscape(m_world, genome);
       land->SetDistance(dist);
       land->SetTrials(m_trials);
       batches[dist - 1].PushRear(land);
       if (dist == 1) {
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::Process));        
+        jobbatch.AddJob(land, &cLandscape::Process);
       } else {
         land->SetMinFound(m_min_found);
         land->SetMaxTrials(m_max_trials);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::RandomProcess));
+        jobbatch.AddJob(land, &cLandscape::RandomProcess);
       }
     }
   }
@@ -252,7 +250,7 @@ public:
         ctx.Driver().Feedback().Notify("Full Landscapping...");
       }
 
-      cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
+      tAnalyzeJobBatch<cLandscape> jobbatch(m_world->GetAnalyze().GetJobQueue());
       
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
@@ -260,9 +258,9 @@ public:
         land = new cLandscape(m_world, genotype->GetGenome());
         land->SetDistance(m_dist);
         m_batch.PushRear(land);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::Process));
+        jobbatch.AddJob(land, &cLandscape::Process);
       }
-      jobqueue.Execute();
+      jobbatch.RunBatch();
 
       Avida::Output::FilePtr sf = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_sfilename);
       Avida::Output::FilePtr ef;
@@ -367,7 +365,7 @@ public:
         ctx.Driver().Feedback().Notify("Deletion Landscapping...");
       }
 
-      cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
+      tAnalyzeJobBatch<cLandscape> jobbatch(m_world->GetAnalyze().GetJobQueue());
       
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
@@ -375,9 +373,9 @@ public:
         land = new cLandscape(m_world, genotype->GetGenome());
         land->SetDistance(m_dist);
         m_batch.PushRear(land);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::ProcessDelete));
+        jobbatch.AddJob(land, &cLandscape::ProcessDelete);
       }
-      jobqueue.Execute();
+      jobbatch.RunBatch();
 
       Avida::Output::FilePtr sf = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_sfilename);
       Avida::Output::FilePtr cf;
@@ -430,7 +428,7 @@ public:
         ctx.Driver().Feedback().Notify("Insertion Landscapping...");
       }
 
-      cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
+      tAnalyzeJobBatch<cLandscape> jobbatch(m_world->GetAnalyze().GetJobQueue());
       
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
@@ -438,9 +436,9 @@ public:
         land = new cLandscape(m_world, genotype->GetGenome());
         land->SetDistance(m_dist);
         m_batch.PushRear(land);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::ProcessInsert));
+        jobbatch.AddJob(land, &cLandscape::ProcessInsert);
       }
-      jobqueue.Execute();
+      jobbatch.RunBatch();
     
       Avida::Output::FilePtr sf = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_sfilename);
       Avida::Output::FilePtr cf;
@@ -578,7 +576,7 @@ public:
         ctx.Driver().Feedback().Notify("Random Landscapping...");
       }
 
-      cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
+      tAnalyzeJobBatch<cLandscape> jobbatch(m_world->GetAnalyze().GetJobQueue());
       
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
@@ -587,9 +585,9 @@ public:
         land->SetDistance(m_dist);
         land->SetTrials(m_trials);
         m_batch.PushRear(land);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::RandomProcess));
+        jobbatch.AddJob(land, &cLandscape::RandomProcess);
       }
-      jobqueue.Execute();
+      jobbatch.RunBatch();
       Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_filename);
       while ((land = m_batch.Pop())) {
         land->PrintStats(*df, update);
@@ -636,7 +634,7 @@ public:
         ctx.Driver().Feedback().Notify("Sample Landscapping...");
       }
 
-      cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
+      tAnalyzeJobBatch<cLandscape> jobbatch(m_world->GetAnalyze().GetJobQueue());
       
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
@@ -644,9 +642,9 @@ public:
         cLandscape* land = new cLandscape(m_world, genotype->GetGenome());
         land->SetTrials(m_trials);
         m_batch.PushRear(land);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::SampleProcess));
+        jobbatch.AddJob(land, &cLandscape::SampleProcess);
       }
-      jobqueue.Execute();
+      jobbatch.RunBatch();
       Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_filename);
       while ((land = m_batch.Pop())) {
         land->PrintStats(*df, update);
@@ -804,7 +802,7 @@ public:
         ctx.Driver().Feedback().Notify("Pair Testing Landscape...");
       }
       
-      cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
+      tAnalyzeJobBatch<cLandscape> jobbatch(m_world->GetAnalyze().GetJobQueue());
       
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
@@ -812,13 +810,13 @@ public:
         cLandscape* land = new cLandscape(m_world, genotype->GetGenome());
         if (m_sample_size) {
           land->SetTrials(m_sample_size);
-          jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::TestPairs));
+          jobbatch.AddJob(land, &cLandscape::TestPairs);
         } else {
-          jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::TestAllPairs));
+          jobbatch.AddJob(land, &cLandscape::TestAllPairs);
         }
         m_batch.PushRear(land);
       }
-      jobqueue.Execute();
+      jobbatch.RunBatch();
       Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_filename);
       while ((land = m_batch.Pop())) {
         land->PrintStats(*df, update);
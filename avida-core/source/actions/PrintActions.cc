@@ -28,6 +28,7 @@
 #include "avida/data/Package.h"
 #include "avida/data/Recorder.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Manager.h"
@@ -49,11 +50,14 @@
 #include "cMigrationMatrix.h"
 #include "cOrganism.h"
 #include "cPhenPlastGenotype.h"
+#include "cPhenPlastSummary.h"
 #include "cPhenPlastUtil.h"
 #include "cPlasticPhenotype.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
 #include "cStats.h"
+#include "cTestCPUCache.h"
+#include "cTestSnapshot.h"
 #include "cWorld.h"
 #include "cUserFeedback.h"
 #include "cParasite.h"
@@ -69,19 +73,33 @@ class cBioGroup;
 using namespace Avida;
 
 
+// Stats output files may be written as text (the default) or as binary column files, which are smaller and faster to
+// write, and which the avida-columns tool converts back to text
+static void SetStatsOutputFormat(cWorld* world, const cString& filename, const cString& format, Feedback& feedback)
+{
+  if (format == "" || format == "text") return;
+  if (format != "binary") {
+    feedback.Warning("unknown output format '%s', writing '%s' as text", (const char*)format, (const char*)filename);
+    return;
+  }
+  Output::ManagerPtr mgr = Output::Manager::Of(world->GetNewWorld());
+  mgr->SetColumnar(mgr->OutputIDFromPath(Apto::String((const char*)filename)));
+}
+
 #define STATS_OUT_FILE(METHOD, DEFAULT)                                                   /*  1 */ \
 class cAction ## METHOD : public cAction {                                                /*  2 */ \
 private:                                                                                  /*  3 */ \
 cString m_filename;                                                                     /*  4 */ \
 public:                                                                                   /*  5 */ \
-cAction ## METHOD(cWorld* world, const cString& args, Feedback&) : cAction(world, args)            /*  6 */ \
+cAction ## METHOD(cWorld* world, const cString& args, Feedback& feedback) : cAction(world, args)   /*  6 */ \
 {                                                                                       /*  7 */ \
 cString largs(args);                                                                  /*  8 */ \
 if (largs == "") m_filename = #DEFAULT; else m_filename = largs.PopWord();            /*  9 */ \
-}                                                                                       /* 10 */ \
-static const cString GetDescription() { return "Arguments: [string fname=\"" #DEFAULT "\"]"; }  /* 11 */ \
-void Process(cAvidaContext&) { m_world->GetStats().METHOD(m_filename); }            /* 12 */ \
-}                                                                                         /* 13 */ \
+SetStatsOutputFormat(world, m_filename, largs.PopWord(), feedback);                   /* 10 */ \
+}                                                                                       /* 11 */ \
+static const cString GetDescription() { return "Arguments: [string fname=\"" #DEFAULT "\"] [string format=\"text\"|\"binary\"]"; }  /* 12 */ \
+void Process(cAvidaContext&) { m_world->GetStats().METHOD(m_filename); }            /* 13 */ \
+}                                                                                         /* 14 */ \
 
 STATS_OUT_FILE(PrintAverageData,            average.dat         );
 STATS_OUT_FILE(PrintDemeAverageData,        deme_average.dat    );
@@ -278,6 +296,37 @@ public:
   }
 };
 
+class cActionPrintTestCPUCacheData : public cAction
+{
+private:
+  cString m_filename;
+public:
+  cActionPrintTestCPUCacheData(cWorld* world, const cString& args, Feedback&) : cAction(world, args)
+  {
+    cString largs(args);
+    if (largs == "") m_filename = "testcpu_cache.dat"; else m_filename = largs.PopWord();
+  }
+  static const cString GetDescription() { return "Arguments: [string fname=\"testcpu_cache.dat\"]"; }
+  void Process(cAvidaContext& ctx)
+  {
+    cTestCPUCache* cache = m_world->GetHardwareManager().GetTestCPUCache();
+    if (cache == NULL) return;
+    
+    const long long hits = cache->GetNumHits();
+    const long long misses = cache->GetNumMisses();
+    
+    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+    df->WriteComment("Avida test CPU result cache statistics");
+    df->WriteTimeStamp();
+    df->Write(m_world->GetStats().GetUpdate(), "Update");
+    df->Write(cache->GetNumEntries(), "Cached Results");
+    df->Write((long)hits, "Cache Hits");
+    df->Write((long)misses, "Cache Misses");
+    df->Write((hits + misses) ? (double)hits / (double)(hits + misses) : 0.0, "Hit Rate");
+    df->Endl();
+  }
+};
+
 class cActionPrintResWallLocData : public cAction
 {
 private:
@@ -1320,6 +1369,160 @@ private:
   double m_hist_fstep;
   cString m_filenames[3];
   
+  class cSnapshot : public cTestSnapshot
+  {
+  private:
+    int m_save_max;
+    int m_print_fitness_histo;
+    double m_hist_fmax;
+    double m_hist_fstep;
+    cString m_filenames[3];
+    
+    Apto::Array<bool> m_viable;
+    Apto::Array<bool> m_copy_true;
+    Apto::Array<int> m_gestation_time;
+    Apto::Array<double> m_colony_fitness;
+    
+  public:
+    cSnapshot(cWorld* world, const cActionPrintDetailedFitnessData& action)
+    : cTestSnapshot(world), m_save_max(action.m_save_max), m_print_fitness_histo(action.m_print_fitness_histo)
+    , m_hist_fmax(action.m_hist_fmax), m_hist_fstep(action.m_hist_fstep)
+    {
+      for (int i = 0; i < 3; i++) m_filenames[i] = action.m_filenames[i];
+      
+      CapturePopulation(true);
+      m_viable.Resize(m_genotypes.GetSize());
+      m_copy_true.Resize(m_genotypes.GetSize());
+      m_gestation_time.Resize(m_genotypes.GetSize());
+      m_colony_fitness.Resize(m_genotypes.GetSize());
+    }
+    
+  protected:
+    void Test(cAvidaContext& ctx, int idx)
+    {
+      cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
+      cCPUTestInfo test_info;
+      testcpu->TestGenome(ctx, test_info, m_genotypes[idx].genome);
+      delete testcpu;
+      
+      m_viable[idx] = test_info.IsViable();
+      m_copy_true[idx] = test_info.GetTestPhenotype().CopyTrue();
+      m_gestation_time[idx] = test_info.GetTestPhenotype().GetGestationTime();
+      m_colony_fitness[idx] = test_info.GetColonyFitness();
+    }
+    
+    void Write(cAvidaContext& ctx)
+    {
+      // the histogram variables
+      Apto::Array<int> histo;
+      Apto::Array<int> histo_testCPU;
+      int bins = 0;
+      
+      if (m_print_fitness_histo) {
+        bins = static_cast<int>(m_hist_fmax / m_hist_fstep) + 1;
+        histo.Resize(bins, 0);
+        histo_testCPU.Resize(bins, 0 );
+      }
+      
+      int n = 0;
+      int nhist_tot = 0;
+      int nhist_tot_testCPU = 0;
+      double fave = 0;
+      double fave_testCPU = 0;
+      double max_fitness = -1; // we set this to -1, so that even 0 is larger...
+      int max_f_genotype = -1;
+      
+      for (int i = 0; i < m_organisms.GetSize(); i++) {
+        const int idx = m_organisms[i];
+        
+        // We calculate the fitness based on the current merit,
+        // but with the true gestation time. Also, we set the fitness
+        // to zero if the creature is not viable.
+        const double f = (m_viable[idx]) ? cMerit(m_merits[i]).CalcFitness(m_gestation_time[idx]) : 0;
+        const double f_testCPU = m_colony_fitness[idx];
+        
+        // Get the maximum fitness in the population
+        // Here, we want to count only organisms that can truly replicate,
+        // to avoid complications
+        if (f_testCPU > max_fitness && m_copy_true[idx]) {
+          max_fitness = f_testCPU;
+          max_f_genotype = idx;
+        }
+        
+        fave += f;
+        fave_testCPU += f_testCPU;
+        n += 1;
+        
+        
+        // histogram
+        if (m_print_fitness_histo && f < m_hist_fmax) {
+          histo[static_cast<int>(f / m_hist_fstep)] += 1;
+          nhist_tot += 1;
+        }
+        
+        if (m_print_fitness_histo && f_testCPU < m_hist_fmax) {
+          histo_testCPU[static_cast<int>(f_testCPU / m_hist_fstep)] += 1;
+          nhist_tot_testCPU += 1;
+        }
+      }
+      
+      
+      // determine the name of the maximum fitness genotype
+      cString max_f_name;
+      if (max_f_genotype >= 0) {
+        if (m_genotypes[max_f_genotype].threshold)
+          max_f_name = m_genotypes[max_f_genotype].name;
+        else {
+          // we put the snapshot update into the name, so that it becomes unique.
+          ConstInstructionSequencePtr seq;
+          seq.DynamicCastFrom(m_genotypes[max_f_genotype].genome.Representation());
+          max_f_name.Set("%03d-no_name-u%i", seq->GetSize(), m_update);
+        }
+      }
+      
+      Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filenames[0]);
+      df->Write(m_update, "Update");
+      df->Write(m_generation, "Generation");
+      df->Write(fave / static_cast<double>(n), "Average Fitness");
+      df->Write(fave_testCPU / static_cast<double>(n), "Average Test Fitness");
+      df->Write(n, "Organism Total");
+      df->Write(max_fitness, "Maximum Fitness");
+      df->Write(max_f_name, "Maxfit genotype name");
+      df->Endl();
+      
+      if (m_save_max && max_f_genotype >= 0) {
+        cString filename;
+        filename.Set("archive/%s", static_cast<const char*>(max_f_name));
+        cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
+        testcpu->PrintGenome(ctx, m_genotypes[max_f_genotype].genome, filename);
+        delete testcpu;
+      }
+      
+      if (m_print_fitness_histo) {
+        Avida::Output::FilePtr hdf = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filenames[1]);
+        hdf->Write(m_update, "Update");
+        hdf->Write(m_generation, "Generation");
+        hdf->Write(fave / static_cast<double>(n), "Average Fitness");
+        
+        // now output the fitness histo
+        for (int i = 0; i < histo.GetSize(); i++)
+          hdf->WriteAnonymous(static_cast<double>(histo[i]) / static_cast<double>(nhist_tot));
+        hdf->Endl();
+        
+        
+        Avida::Output::FilePtr tdf = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filenames[2]);
+        tdf->Write(m_update, "Update");
+        tdf->Write(m_generation, "Generation");
+        tdf->Write(fave / static_cast<double>(n), "Average Fitness");
+        
+        // now output the fitness histo
+        for (int i = 0; i < histo_testCPU.GetSize(); i++)
+          tdf->WriteAnonymous(static_cast<double>(histo_testCPU[i]) / static_cast<double>(nhist_tot_testCPU));
+        tdf->Endl();
+      }
+    }
+  };
+  
 public:
   cActionPrintDetailedFitnessData(cWorld* world, const cString& args, Feedback&)
   : cAction(world, args), m_save_max(0), m_print_fitness_histo(0), m_hist_fmax(1.0), m_hist_fstep(0.1)
@@ -1338,123 +1541,8 @@ public:
   
   void Process(cAvidaContext& ctx)
   {
-    cPopulation& pop = m_world->GetPopulation();
-    const int update = m_world->GetStats().GetUpdate();
-    const double generation = m_world->GetStats().SumGeneration().Average();
-    
-    // the histogram variables
-    Apto::Array<int> histo;
-    Apto::Array<int> histo_testCPU;
-    int bins = 0;
-    
-    if (m_print_fitness_histo) {
-      bins = static_cast<int>(m_hist_fmax / m_hist_fstep) + 1;
-      histo.Resize(bins, 0);
-      histo_testCPU.Resize(bins, 0 );
-    }
-    
-    int n = 0;
-    int nhist_tot = 0;
-    int nhist_tot_testCPU = 0;
-    double fave = 0;
-    double fave_testCPU = 0;
-    double max_fitness = -1; // we set this to -1, so that even 0 is larger...
-    Systematics::GroupPtr max_f_genotype;
-    
-    cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
-    
-    for (int i = 0; i < pop.GetSize(); i++) {
-      if (pop.GetCell(i).IsOccupied() == false) continue;  // One use organisms.
-      
-      cOrganism* organism = pop.GetCell(i).GetOrganism();
-      Systematics::GroupPtr genotype = organism->SystematicsGroup("genotype");
-      
-      cCPUTestInfo test_info;
-      testcpu->TestGenome(ctx, test_info, Genome(genotype->Properties().Get("genome")));
-      // We calculate the fitness based on the current merit,
-      // but with the true gestation time. Also, we set the fitness
-      // to zero if the creature is not viable.
-      const double f = (test_info.IsViable()) ? organism->GetPhenotype().GetMerit().CalcFitness(test_info.GetTestPhenotype().GetGestationTime()) : 0;
-      const double f_testCPU = test_info.GetColonyFitness();
-      
-      // Get the maximum fitness in the population
-      // Here, we want to count only organisms that can truly replicate,
-      // to avoid complications
-      if (f_testCPU > max_fitness && test_info.GetTestPhenotype().CopyTrue()) {
-        max_fitness = f_testCPU;
-        max_f_genotype = genotype;
-      }
-      
-      fave += f;
-      fave_testCPU += f_testCPU;
-      n += 1;
-      
-      
-      // histogram
-      if (m_print_fitness_histo && f < m_hist_fmax) {
-        histo[static_cast<int>(f / m_hist_fstep)] += 1;
-        nhist_tot += 1;
-      }
-      
-      if (m_print_fitness_histo && f_testCPU < m_hist_fmax) {
-        histo_testCPU[static_cast<int>(f_testCPU / m_hist_fstep)] += 1;
-        nhist_tot_testCPU += 1;
-      }
-    }
-    
-    
-    // determine the name of the maximum fitness genotype
-    cString max_f_name;
-    if ((bool)Apto::StrAs(max_f_genotype->Properties().Get("threshold")))
-      max_f_name = max_f_genotype->Properties().Get("name").StringValue();
-    else {
-      // we put the current update into the name, so that it becomes unique.
-      Genome gen(max_f_genotype->Properties().Get("genome"));
-      InstructionSequencePtr seq;
-      seq.DynamicCastFrom(gen.Representation());
-      max_f_name.Set("%03d-no_name-u%i", seq->GetSize(), update);
-    }
-    
-    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filenames[0]);
-    df->Write(update, "Update");
-    df->Write(generation, "Generation");
-    df->Write(fave / static_cast<double>(n), "Average Fitness");
-    df->Write(fave_testCPU / static_cast<double>(n), "Average Test Fitness");
-    df->Write(n, "Organism Total");
-    df->Write(max_fitness, "Maximum Fitness");
-    df->Write(max_f_name, "Maxfit genotype name");
-    df->Endl();
-    
-    if (m_save_max) {
-      cString filename;
-      filename.Set("archive/%s", static_cast<const char*>(max_f_name));
-      testcpu->PrintGenome(ctx, Genome(max_f_genotype->Properties().Get("genome")), filename);
-    }
-    
-    delete testcpu;
-    
-    if (m_print_fitness_histo) {
-      Avida::Output::FilePtr hdf = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filenames[1]);
-      hdf->Write(update, "Update");
-      hdf->Write(generation, "Generation");
-      hdf->Write(fave / static_cast<double>(n), "Average Fitness");
-      
-      // now output the fitness histo
-      for (int i = 0; i < histo.GetSize(); i++)
-        hdf->WriteAnonymous(static_cast<double>(histo[i]) / static_cast<double>(nhist_tot));
-      hdf->Endl();
-      
-      
-      Avida::Output::FilePtr tdf = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filenames[2]);
-      tdf->Write(update, "Update");
-      tdf->Write(generation, "Generation");
-      tdf->Write(fave / static_cast<double>(n), "Average Fitness");
-      
-      // now output the fitness histo
-      for (int i = 0; i < histo_testCPU.GetSize(); i++)
-        tdf->WriteAnonymous(static_cast<double>(histo_testCPU[i]) / static_cast<double>(nhist_tot_testCPU));
-      tdf->Endl();
-    }
+    // Each genotype present is tested once, in the background, and the output written when the tests are done
+    m_world->SubmitSnapshot(cTestSnapshotPtr(new cSnapshot(m_world, *this)), ctx);
   }
 };
 
@@ -2307,7 +2395,7 @@ private:
   int     m_num_trials;
   
 private:
-  void PrintHeader(ofstream& fot)
+  static void PrintHeader(ofstream& fot, int num_tasks, int num_inputs)
   {
     fot << "# Phenotypic Plasticity" << endl
     << "# Format: " << endl
@@ -2318,14 +2406,14 @@ private:
     << "# fitness" << endl
     << "# merit" << endl
     << "# gestation time" << endl;
-    for (int k = 0; k < m_world->GetEnvironment().GetNumTasks(); k++)
+    for (int k = 0; k < num_tasks; k++)
       fot << "# task." << k << endl;
-    for (int k = 0; k < m_world->GetEnvironment().GetInputSize(); k++)
+    for (int k = 0; k < num_inputs; k++)
       fot << "# env_input." << k << endl;
     fot << endl;
   }
   
-  void PrintPPG(ofstream& fot, Apto::SmartPtr<cPhenPlastGenotype> ppgen, int id, const cString& pid)
+  static void PrintPPG(ofstream& fot, Apto::SmartPtr<cPhenPlastGenotype> ppgen, int id, const cString& pid)
   {
     
     for (int k = 0; k < ppgen->GetNumPhenotypes(); k++){
@@ -2348,6 +2436,42 @@ private:
     }
   }
   
+  class cSnapshot : public cTestSnapshot
+  {
+  private:
+    cString m_filename;
+    int m_num_trials;
+    int m_num_tasks;
+    int m_num_inputs;
+    Apto::Array<Apto::SmartPtr<cPhenPlastGenotype> > m_ppgens;
+    
+  public:
+    cSnapshot(cWorld* world, const cString& filename, int num_trials)
+    : cTestSnapshot(world), m_filename(filename), m_num_trials(num_trials)
+    , m_num_tasks(world->GetEnvironment().GetNumTasks()), m_num_inputs(world->GetEnvironment().GetInputSize())
+    {
+      CaptureGenotypes();
+      m_ppgens.Resize(m_genotypes.GetSize());
+    }
+    
+  protected:
+    void Test(cAvidaContext& ctx, int idx)
+    {
+      cCPUTestInfo test_info;
+      m_ppgens[idx] = Apto::SmartPtr<cPhenPlastGenotype>(new cPhenPlastGenotype(m_genotypes[idx].genome, m_num_trials, test_info, m_world, ctx));
+    }
+    
+    void Write(cAvidaContext&)
+    {
+      cString this_path = m_filename + "-" + cStringUtil::Convert(m_update) + ".dat";
+      Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)this_path);
+      ofstream& fot = df->OFStream();
+      PrintHeader(fot, m_num_tasks, m_num_inputs);
+      
+      for (int i = 0; i < m_genotypes.GetSize(); i++) PrintPPG(fot, m_ppgens[i], m_genotypes[i].id, m_genotypes[i].parents);
+    }
+  };
+  
 public:
   cActionPrintPhenotypicPlasticity(cWorld* world, const cString& args, Feedback&)
   : cAction(world,  args)
@@ -2361,32 +2485,20 @@ public:
   
   void Process(cAvidaContext& ctx)
   {
-    cCPUTestInfo test_info;
-    
     if (ctx.GetAnalyzeMode()){ // Analyze mode
+      cCPUTestInfo test_info;
       cString this_path = m_filename;
       Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)this_path);
       ofstream& fot = df->OFStream();
-      PrintHeader(fot);
+      PrintHeader(fot, m_world->GetEnvironment().GetNumTasks(), m_world->GetEnvironment().GetInputSize());
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
       while((genotype = batch_it.Next())){
         Apto::SmartPtr<cPhenPlastGenotype> ppgen(new cPhenPlastGenotype(genotype->GetGenome(), m_num_trials, test_info, m_world, ctx));
         PrintPPG(fot, ppgen, genotype->GetID(), genotype->GetParents());
       }
-    } else{  // Run mode
-      cString this_path = m_filename + "-" + cStringUtil::Convert(m_world->GetStats().GetUpdate()) + ".dat";
-      Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_filename);
-      ofstream& fot = df->OFStream();
-      PrintHeader(fot);
-      
-      Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
-      Systematics::Arbiter::IteratorPtr it = classmgr->ArbiterForRole("genotype")->Begin();
-      while (it->Next()) {
-        Systematics::GroupPtr bg = it->Get();
-        Apto::SmartPtr<cPhenPlastGenotype> ppgen(new cPhenPlastGenotype(Genome(bg->Properties().Get("genome")), m_num_trials, test_info, m_world, ctx));
-        PrintPPG(fot, ppgen, bg->ID(), (const char*)bg->Properties().Get("parents").StringValue());
-      }
+    } else{  // Run mode, the genotypes are tested in the background and written to phenplast-<update>.dat when done
+      m_world->SubmitSnapshot(cTestSnapshotPtr(new cSnapshot(m_world, m_filename, m_num_trials)), ctx);
     }
   }
 };
@@ -2504,7 +2616,7 @@ private:
   cString m_filename;
   bool    m_first_run;
   
-  void PrintHeader(ofstream& fot)
+  static void PrintHeader(ofstream& fot)
   {
     fot << "# Plastic Genotype Sumary" << endl
     <<  "#format  update num_genotypes num_plastic_genotypes num_gen_taskplast num_orgs num_plastic_orgs num_org_taskplast median_phenplast_entropy median_taskplast_entropy" << endl
@@ -2519,12 +2631,128 @@ private:
     <<  "# median_taskplast_entropy   Median entropy of task-plastic genotypes." << endl << endl;
   }
   
-  inline bool HasPlasticTasks(Apto::Array<double> task_probs){
+  static inline bool HasPlasticTasks(Apto::Array<double> task_probs){
     for (int k = 0; k < task_probs.GetSize(); k++)
       if (task_probs[k] != 0 && task_probs[k] != 1) return true;
     return false;
   }
   
+  // Tally of the plasticity of a set of genotypes, filled in by the mode specific collection below
+  struct sSummary
+  {
+    Apto::Array<double> pp_entropy;      // Will hold the phenotypic entropy values greater than 0.0
+    Apto::Array<double> pp_taskentropy;  // Will hold phenotypic entropy values for only those organisms with task plasticity
+    int num_plast_genotypes;    // Number of plastic genotypes
+    int num_genotypes;          // Number of genotypes in the population
+    int num_orgs;               // Number of organisms in the population
+    int num_plast_orgs;         // Number of plastic organisms in the population
+    int gen_task_plast;         // Number of genotypes with task plasticity
+    int org_task_plast;         // Number of organisms with task plasticity
+    
+    sSummary(int genotypes) : num_plast_genotypes(0), num_genotypes(genotypes), num_orgs(0), num_plast_orgs(0)
+    , gen_task_plast(0), org_task_plast(0)
+    {
+      pp_entropy.ResizeClear(num_genotypes);
+      pp_taskentropy.ResizeClear(num_genotypes);
+    }
+  };
+  
+  static void PrintSummary(ofstream& fot, int update, sSummary& sum)
+  {
+    double median = -1.0;           // Will hold the median phenotypic value (excluding 0.0)
+    double task_median = -1.0;      // Will hold the median phenotypic entropy value of only those genotypes showing task plasticity
+    
+    // Finish gathering data
+    // The median will be calculated as either -1 (set above) if there is no data
+    //    or as the median if there is an odd number of elements or an average
+    //    of the middle two elements if there is an even number of elements.
+    if (sum.num_plast_genotypes > 0){   //Handle our array of entropies if we need to
+      Apto::QSort(sum.pp_entropy, 0, sum.num_plast_genotypes-1);
+      int ndx    = sum.num_plast_genotypes / 2;
+      median     = (sum.num_plast_genotypes % 2 == 1) ? sum.pp_entropy[ndx] : (sum.pp_entropy[ndx-1] + sum.pp_entropy[ndx]) / 2.0;
+      if (sum.gen_task_plast > 0){      //Handle our second array of entropies if we need to
+        Apto::QSort(sum.pp_taskentropy, 0, sum.gen_task_plast-1);
+        ndx    = sum.gen_task_plast / 2;
+        task_median  = (sum.gen_task_plast % 2 == 1) ? sum.pp_taskentropy[ndx] : (sum.pp_taskentropy[ndx-1] + sum.pp_taskentropy[ndx]) / 2.0;
+      }
+    }
+    
+    //Printing
+    fot << update << " "
+    << sum.num_genotypes << " "
+    << sum.num_plast_genotypes << " "
+    << sum.gen_task_plast << " "
+    << sum.num_orgs << " "
+    << sum.num_plast_orgs << " "
+    << sum.org_task_plast << " "
+    << median << " "
+    << task_median << endl;    
+  }
+  
+  class cSnapshot : public cTestSnapshot
+  {
+  private:
+    cString m_filename;
+    bool m_print_header;
+    Apto::Array<Apto::SmartPtr<cPhenPlastSummary> > m_summaries;
+    Apto::Array<bool> m_tested;
+    
+  public:
+    cSnapshot(cWorld* world, const cString& filename, bool print_header)
+    : cTestSnapshot(world), m_filename(filename), m_print_header(print_header)
+    {
+      CaptureGenotypes();
+      m_summaries.Resize(m_genotypes.GetSize());
+      m_tested.Resize(m_genotypes.GetSize(), false);
+      
+      // Genotypes summarized by earlier calls keep their summary, only the others need to be tested
+      Systematics::ArbiterPtr arbiter = Systematics::Manager::Of(world->GetNewWorld())->ArbiterForRole("genotype");
+      for (int i = 0; i < m_genotypes.GetSize(); i++) {
+        m_summaries[i] = arbiter->Group(m_genotypes[i].id)->GetData<cPhenPlastSummary>();
+      }
+    }
+    
+  protected:
+    void Test(cAvidaContext& ctx, int idx)
+    {
+      if (m_summaries[idx]) return;
+      m_summaries[idx] = Apto::SmartPtr<cPhenPlastSummary>(cPhenPlastUtil::TestPlasticity(ctx, m_world, m_genotypes[idx].genome));
+      m_tested[idx] = true;
+    }
+    
+    void Write(cAvidaContext&)
+    {
+      // Hand new summaries to the genotypes that are still around, as cPhenPlastUtil would have
+      Systematics::ArbiterPtr arbiter = Systematics::Manager::Of(m_world->GetNewWorld())->ArbiterForRole("genotype");
+      for (int i = 0; i < m_genotypes.GetSize(); i++) {
+        if (!m_tested[i]) continue;
+        Systematics::GroupPtr bg = arbiter->Group(m_genotypes[i].id);
+        if (bg && !bg->GetData<cPhenPlastSummary>()) bg->AttachData(m_summaries[i]);
+      }
+      
+      sSummary sum(m_genotypes.GetSize());
+      for (int i = 0; i < m_genotypes.GetSize(); i++) {
+        const cPhenPlastSummary& ps = *m_summaries[i];
+        int num = m_genotypes[i].num_units;
+        sum.num_orgs += num;
+        if (ps.m_num_phenotypes > 1) {
+          double entropy = ps.m_phenotypic_entropy;
+          sum.pp_entropy[sum.num_plast_genotypes++] = entropy;
+          sum.num_plast_orgs += num;
+          if (HasPlasticTasks(ps.m_task_probabilities)) {
+            sum.org_task_plast += num;
+            sum.pp_taskentropy[sum.gen_task_plast++] = entropy;
+          }
+        }
+      }
+      
+      Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+      ofstream& fot = df->OFStream();
+      if (m_print_header) PrintHeader(fot);
+      PrintSummary(fot, m_update, sum);
+    }
+  };
+  
 public:
   cActionPrintPlasticGenotypeSummary(cWorld* world, const cString& args, Feedback&)
   : cAction(world, args)
@@ -2538,95 +2766,40 @@ public:
   
   void Process(cAvidaContext& ctx)
   {
+    // E X P E R I M E N T    M O D E
+    // Genotypes not yet summarized are tested in the background, the line is written when they are done
+    if (!ctx.GetAnalyzeMode()) {
+      m_world->SubmitSnapshot(cTestSnapshotPtr(new cSnapshot(m_world, m_filename, m_first_run)), ctx);
+      m_first_run = false;
+      return;
+    }
     
-    //Setup
-    Avida::Output::FilePtr df;
-    if (ctx.GetAnalyzeMode()) df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_filename);
-    else df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+    // A N A L Y Z E    M O D E
+    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_filename);
     ofstream& fot = df->OFStream();
     if (m_first_run == true){
       PrintHeader(fot);
       m_first_run = false;
     }
-    double median = -1.0;           // Will hold the median phenotypic value (excluding 0.0)
-    double task_median = -1.0;      // Will hold the median phenotypic entropy value of only those genotypes showing task plasticity
-    Apto::Array<double> pp_entropy;      // Will hold the phenotypic entropy values greater than 0.0
-    Apto::Array<double> pp_taskentropy;  // Will hold phenotypic entropy values for only those organisms with task plasticity
-    int num_plast_genotypes = 0;    // Number of plastic genotypes
-    int num_genotypes = 0;          // Number of genotypes in the population
-    int num_orgs = 0;               // Number of organisms in the population
-    int num_plast_orgs = 0;         // Number of plastic organisms in the population
-    int gen_task_plast = 0;         // Number of genotypes with task plasticity
-    int org_task_plast = 0;         // Number of organisms with task plasticity
-    
-    //Collect data using methods from the correct mode
-    if (ctx.GetAnalyzeMode()){  // A N A L Y Z E    M O D E
-      num_genotypes = m_world->GetAnalyze().GetCurrentBatch().GetSize();
-      pp_entropy.ResizeClear(num_genotypes);
-      pp_taskentropy.ResizeClear(num_genotypes);
-      tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
-      cAnalyzeGenotype* genotype = NULL;
-      while((genotype = batch_it.Next())){  //For each genotype
-        int num = genotype->GetNumCPUs();   //   find the number of organisms
-        num_orgs += num;                    //   add it to the total number of organisms
-        if (genotype->GetNumPhenotypes() > 1){                     //If the genotype is plastic
-          double entropy = genotype->GetPhenotypicEntropy();       //   get the entropy
-          pp_entropy[num_plast_genotypes++] = entropy;             //   append the entropy to our array
-          num_plast_orgs += num;                                   //   count the organisms as plastic
-          if (HasPlasticTasks(genotype->GetTaskProbabilities())){        // If the genotype has tasks plasticity
-            org_task_plast += num;                                       //    count the organisms belonging to the genotype as plastic
-            pp_taskentropy[gen_task_plast++] = entropy;                  //    append the plastic genotype to the taskentropy array
-          } // End if probabilistic tasks
-        } // End if plastic phenotype
-      } // End looping through genotypes
-    }
-    else {  // E X P E R I M E N T    M O D E    (See above for explination)
-      Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
-      Systematics::Arbiter::IteratorPtr it = classmgr->ArbiterForRole("genotype")->Begin();
-      pp_entropy.ResizeClear(num_genotypes);
-      pp_taskentropy.ResizeClear(num_genotypes);
-      while (it->Next()) {
-        Systematics::GroupPtr bg = it->Get();
-        int num = bg->NumUnits();
-        num_orgs += num;
-        if (cPhenPlastUtil::GetNumPhenotypes(ctx, m_world, bg) > 1) {
-          double entropy = cPhenPlastUtil::GetPhenotypicEntropy(ctx, m_world, bg);
-          pp_entropy[num_plast_genotypes++] = entropy;
-          num_plast_orgs += num;
-          if (HasPlasticTasks(cPhenPlastUtil::GetTaskProbabilities(ctx, m_world, bg))) {
-            org_task_plast += num;
-            pp_taskentropy[gen_task_plast++] = entropy;
-          }
-        }
-      }
-    }// End selection of runtime context
-    
-    // Finish gathering data
-    // The median will be calculated as either -1 (set above) if there is no data
-    //    or as the median if there is an odd number of elements or an average
-    //    of the middle two elements if there is an even number of elements.
-    int update = (ctx.GetAnalyzeMode()) ? -1 : m_world->GetStats().GetUpdate();
-    if (num_plast_genotypes > 0){   //Handle our array of entropies if we need to
-      Apto::QSort(pp_entropy, 0, num_plast_genotypes-1);
-      int ndx    = num_plast_genotypes / 2;
-      median     = (num_plast_genotypes % 2 == 1) ? pp_entropy[ndx] : (pp_entropy[ndx-1] + pp_entropy[ndx]) / 2.0;
-      if (gen_task_plast > 0){      //Handle our second array of entropies if we need to
-        Apto::QSort(pp_taskentropy, 0, gen_task_plast-1);
-        ndx    = gen_task_plast / 2;
-        task_median  = (gen_task_plast % 2 == 1) ? pp_taskentropy[ndx] : (pp_taskentropy[ndx-1] + pp_taskentropy[ndx]) / 2.0;
-      }
-    }
     
-    //Printing
-    fot << update << " "
-    << num_genotypes << " "
-    << num_plast_genotypes << " "
-    << gen_task_plast << " "
-    << num_orgs << " "
-    << num_plast_orgs << " "
-    << org_task_plast << " "
-    << median << " "
-    << task_median << endl;    
+    sSummary sum(m_world->GetAnalyze().GetCurrentBatch().GetSize());
+    tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
+    cAnalyzeGenotype* genotype = NULL;
+    while((genotype = batch_it.Next())){  //For each genotype
+      int num = genotype->GetNumCPUs();   //   find the number of organisms
+      sum.num_orgs += num;                //   add it to the total number of organisms
+      if (genotype->GetNumPhenotypes() > 1){                         //If the genotype is plastic
+        double entropy = genotype->GetPhenotypicEntropy();           //   get the entropy
+        sum.pp_entropy[sum.num_plast_genotypes++] = entropy;         //   append the entropy to our array
+        sum.num_plast_orgs += num;                                   //   count the organisms as plastic
+        if (HasPlasticTasks(genotype->GetTaskProbabilities())){      // If the genotype has tasks plasticity
+          sum.org_task_plast += num;                                 //    count the organisms belonging to the genotype as plastic
+          sum.pp_taskentropy[sum.gen_task_plast++] = entropy;        //    append the plastic genotype to the taskentropy array
+        } // End if probabilistic tasks
+      } // End if plastic phenotype
+    } // End looping through genotypes
+    
+    PrintSummary(fot, -1, sum);
   }
   
 };
@@ -2803,6 +2976,61 @@ class cActionTestDominant : public cAction
 private:
   cString m_filename;
   
+  class cSnapshot : public cTestSnapshot
+  {
+  private:
+    cString m_filename;
+    
+    double m_merit;
+    int m_gestation_time;
+    double m_fitness;
+    int m_copied_size;
+    int m_executed_size;
+    
+  public:
+    cSnapshot(cWorld* world, const cString& filename)
+    : cTestSnapshot(world), m_filename(filename), m_merit(0.0), m_gestation_time(0), m_fitness(0.0), m_copied_size(0)
+    , m_executed_size(0)
+    {
+      CaptureGenotypes(1);
+    }
+    
+  protected:
+    void Test(cAvidaContext& ctx, int idx)
+    {
+      cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
+      cCPUTestInfo test_info;
+      testcpu->TestGenome(ctx, test_info, m_genotypes[idx].genome);
+      delete testcpu;
+      
+      cPhenotype& colony_phenotype = test_info.GetColonyOrganism()->GetPhenotype();
+      m_merit = colony_phenotype.GetMerit().GetDouble();
+      m_gestation_time = colony_phenotype.GetGestationTime();
+      m_fitness = colony_phenotype.GetFitness();
+      m_copied_size = colony_phenotype.GetCopiedSize();
+      m_executed_size = colony_phenotype.GetExecutedSize();
+    }
+    
+    void Write(cAvidaContext&)
+    {
+      if (!m_genotypes.GetSize()) return;
+      
+      ConstInstructionSequencePtr seq;
+      seq.DynamicCastFrom(m_genotypes[0].genome.Representation());
+      
+      Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
+      df->Write(m_update, "Update");
+      df->Write(m_merit, "Merit");
+      df->Write(m_gestation_time, "Gestation Time");
+      df->Write(m_fitness, "Fitness");
+      df->Write(1.0 / (0.1 + m_gestation_time), "Reproduction Rate");
+      df->Write(seq->GetSize(), "Genome Length");
+      df->Write(m_copied_size, "Copied Size");
+      df->Write(m_executed_size, "Executed Size");
+      df->Endl();
+    }
+  };
+  
 public:
   cActionTestDominant(cWorld* world, const cString& args, Feedback&) : cAction(world, args), m_filename("dom-test.dat")
   {
@@ -2812,30 +3040,7 @@ public:
   static const cString GetDescription() { return "Arguments: [string fname='dom-test.dat']"; }
   void Process(cAvidaContext& ctx)
   {
-    Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
-    Systematics::Arbiter::IteratorPtr it = classmgr->ArbiterForRole("genotype")->Begin();
-    Systematics::GroupPtr bg = it->Next();
-    Genome genome(bg->Properties().Get("genome"));
-    InstructionSequencePtr seq;
-    seq.DynamicCastFrom(genome.Representation());
-    
-    cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
-    cCPUTestInfo test_info;
-    testcpu->TestGenome(ctx, test_info, genome);
-    delete testcpu;
-    
-    cPhenotype& colony_phenotype = test_info.GetColonyOrganism()->GetPhenotype();
-    
-    Avida::Output::FilePtr df = Avida::Output::File::StaticWithPath(m_world->GetNewWorld(), (const char*)m_filename);
-    df->Write(m_world->GetStats().GetUpdate(), "Update");
-    df->Write(colony_phenotype.GetMerit().GetDouble(), "Merit");
-    df->Write(colony_phenotype.GetGestationTime(), "Gestation Time");
-    df->Write(colony_phenotype.GetFitness(), "Fitness");
-    df->Write(1.0 / (0.1 + colony_phenotype.GetGestationTime()), "Reproduction Rate");
-    df->Write(seq->GetSize(), "Genome Length");
-    df->Write(colony_phenotype.GetCopiedSize(), "Copied Size");
-    df->Write(colony_phenotype.GetExecutedSize(), "Executed Size");
-    df->Endl();
+    m_world->SubmitSnapshot(cTestSnapshotPtr(new cSnapshot(m_world, m_filename)), ctx);
   }
 };
 
@@ -3110,16 +3315,24 @@ public:
     
     // Loop through genotypes again, and determine the average genetic distance.
     it = classmgr->ArbiterForRole("genotype")->Begin();
-    cDoubleSum distance_sum;
+    Apto::Array<InstructionSequencePtr> genotype_seqs;
+    Apto::Array<const InstructionSequence*> genotype_seq_ptrs;
+    Apto::Array<int> genotype_counts;
     while ((it->Next())) {
-      const int num_organisms = it->Get()->NumUnits();
       Genome cur_gen(it->Get()->Properties().Get("genome"));
       InstructionSequencePtr cur_seq;
       cur_seq.DynamicCastFrom(cur_gen.Representation());
-      const int cur_dist = InstructionSequence::FindEditDistance(con_genome, *cur_seq);
-      distance_sum.Add(cur_dist, num_organisms);
+      genotype_seqs.Push(cur_seq);
+      genotype_seq_ptrs.Push(&(*cur_seq));
+      genotype_counts.Push(it->Get()->NumUnits());
     }
     
+    // The consensus is compared against every genotype at once, so its match vectors are only built once.
+    Apto::Array<int> genotype_dists;
+    InstructionSequence::FindEditDistances(con_genome, genotype_seq_ptrs, genotype_dists);
+    cDoubleSum distance_sum;
+    for (int i = 0; i < genotype_dists.GetSize(); i++) distance_sum.Add(genotype_dists[i], genotype_counts[i]);
+    
     // Finally, gather last bits of data and print the results.
     // @TODO - find consensus bio group
     //    cGenotype* con_genotype = classmgr.FindGenotype(con_genome, -1);
@@ -5262,291 +5475,292 @@ public:
 
 void RegisterPrintActions(cActionLibrary* action_lib)
 {
-  action_lib->Register<cActionPrintDebug>("PrintDebug");
+  action_lib->RegisterOutput<cActionPrintDebug>("PrintDebug");
   
   
   // Stats Out Files
-  action_lib->Register<cActionPrintAverageData>("PrintAverageData");
-  action_lib->Register<cActionPrintDemeAverageData>("PrintDemeAverageData");
-  action_lib->Register<cActionPrintFlowRateTuples>("PrintFlowRateTuples");
-  action_lib->Register<cActionPrintErrorData>("PrintErrorData");
-  action_lib->Register<cActionPrintVarianceData>("PrintVarianceData");
-  action_lib->Register<cActionPrintCountData>("PrintCountData");
-  action_lib->Register<cActionPrintMessageData>("PrintMessageData");
-  action_lib->Register<cActionPrintMessageLog>("PrintMessageLog");
-  action_lib->Register<cActionPrintRetMessageLog>("PrintRetMessageLog");
-  action_lib->Register<cActionPrintInterruptData>("PrintInterruptData");
-  action_lib->Register<cActionPrintTotalsData>("PrintTotalsData");
-  action_lib->Register<cActionPrintThreadsData>("PrintThreadsData");
-  action_lib->Register<cActionPrintTasksData>("PrintTasksData");
-  action_lib->Register<cActionPrintSoloTaskSnapshot>("PrintSoloTaskSnapshot");
-  action_lib->Register<cActionPrintHostTasksData>("PrintHostTasksData");
-  action_lib->Register<cActionPrintParasiteTasksData>("PrintParasiteTasksData");
-  action_lib->Register<cActionPrintTasksExeData>("PrintTasksExeData");
-  action_lib->Register<cActionPrintNewTasksData>("PrintNewTasksData");
-  action_lib->Register<cActionPrintNewReactionData>("PrintNewReactionData");
-  action_lib->Register<cActionPrintNewTasksDataPlus>("PrintNewTasksDataPlus");
-  action_lib->Register<cActionPrintTasksQualData>("PrintTasksQualData");
-  action_lib->Register<cActionPrintResourceData>("PrintResourceData");
-  action_lib->Register<cActionPrintResourceLocData>("PrintResourceLocData");
-  action_lib->Register<cActionPrintResWallLocData>("PrintResWallLocData");
-  action_lib->Register<cActionPrintReactionData>("PrintReactionData");
-  action_lib->Register<cActionPrintReactionExeData>("PrintReactionExeData");
-  action_lib->Register<cActionPrintCurrentReactionData>("PrintCurrentReactionData");
-  action_lib->Register<cActionPrintReactionRewardData>("PrintReactionRewardData");
-  action_lib->Register<cActionPrintCurrentReactionRewardData>("PrintCurrentReactionRewardData");
-  action_lib->Register<cActionPrintTimeData>("PrintTimeData");
-  action_lib->Register<cActionPrintExtendedTimeData>("PrintExtendedTimeData");
-  action_lib->Register<cActionPrintMutationRateData>("PrintMutationRateData");
-  action_lib->Register<cActionPrintDivideMutData>("PrintDivideMutData");
-  action_lib->Register<cActionPrintParasiteData>("PrintParasiteData");
-  action_lib->Register<cActionPrintNumDivides>("PrintNumDivides");
-  
-  action_lib->Register<cActionPrintPreyAverageData>("PrintPreyAverageData");
-  action_lib->Register<cActionPrintPredatorAverageData>("PrintPredatorAverageData");
-  action_lib->Register<cActionPrintTopPredatorAverageData>("PrintTopPredatorAverageData");
-  action_lib->Register<cActionPrintPreyErrorData>("PrintPreyErrorData");
-  action_lib->Register<cActionPrintPredatorErrorData>("PrintPredatorErrorData");
-  action_lib->Register<cActionPrintTopPredatorErrorData>("PrintTopPredatorErrorData");
-  action_lib->Register<cActionPrintPreyVarianceData>("PrintPreyVarianceData");
-  action_lib->Register<cActionPrintPredatorVarianceData>("PrintPredatorVarianceData");
-  action_lib->Register<cActionPrintTopPredatorVarianceData>("PrintTopPredatorVarianceData");
-  action_lib->Register<cActionPrintPreyInstructionData>("PrintPreyInstructionData");
-  action_lib->Register<cActionPrintPredatorInstructionData>("PrintPredatorInstructionData");
-  action_lib->Register<cActionPrintTopPredatorInstructionData>("PrintTopPredatorInstructionData");
-  action_lib->Register<cActionPrintPreyFromSensorInstructionData>("PrintPreyFromSensorInstructionData");
-  action_lib->Register<cActionPrintPredatorFromSensorInstructionData>("PrintPredatorFromSensorInstructionData");
-  action_lib->Register<cActionPrintTopPredatorFromSensorInstructionData>("PrintTopPredatorFromSensorInstructionData");
-  action_lib->Register<cActionPrintGroupAttackData>("PrintGroupAttackData");
-  action_lib->Register<cActionPrintKilledPreyFTData>("PrintKilledPreyFTData");
-  action_lib->Register<cActionPrintAttacks>("PrintAttacks");
-  
-  action_lib->Register<cActionPrintFromMessageInstructionData>("PrintFromMessageInstructionData");
-  
-  action_lib->Register<cActionPrintMaleInstructionData>("PrintMaleInstructionData");
-  action_lib->Register<cActionPrintFemaleInstructionData>("PrintFemaleInstructionData");
-  action_lib->Register<cActionPrintSenseData>("PrintSenseData");
-  action_lib->Register<cActionPrintSenseExeData>("PrintSenseExeData");
-  action_lib->Register<cActionPrintInstructionData>("PrintInstructionData");
-  action_lib->Register<cActionPrintInternalTasksData>("PrintInternalTasksData");
-  action_lib->Register<cActionPrintInternalTasksQualData>("PrintInternalTasksQualData");
-  action_lib->Register<cActionPrintSleepData>("PrintSleepData");
-  action_lib->Register<cActionPrintCompetitionData>("PrintCompetitionData");
-  action_lib->Register<cActionPrintDynamicMaxMinData>("PrintDynamicMaxMinData");
-  action_lib->Register<cActionPrintMaleAverageData>("PrintMaleAverageData");
-  action_lib->Register<cActionPrintFemaleAverageData>("PrintFemaleAverageData");
-  action_lib->Register<cActionPrintMaleErrorData>("PrintMaleErrorData");
-  action_lib->Register<cActionPrintFemaleErrorData>("PrintFemaleErrorData");
-  action_lib->Register<cActionPrintMaleVarianceData>("PrintMaleVarianceData");
-  action_lib->Register<cActionPrintFemaleVarianceData>("PrintFemaleVarianceData");
+  action_lib->RegisterOutput<cActionPrintAverageData>("PrintAverageData");
+  action_lib->RegisterOutput<cActionPrintDemeAverageData>("PrintDemeAverageData");
+  action_lib->RegisterOutput<cActionPrintFlowRateTuples>("PrintFlowRateTuples");
+  action_lib->RegisterOutput<cActionPrintErrorData>("PrintErrorData");
+  action_lib->RegisterOutput<cActionPrintVarianceData>("PrintVarianceData");
+  action_lib->RegisterOutput<cActionPrintCountData>("PrintCountData");
+  action_lib->RegisterOutput<cActionPrintMessageData>("PrintMessageData");
+  action_lib->RegisterOutput<cActionPrintMessageLog>("PrintMessageLog");
+  action_lib->RegisterOutput<cActionPrintRetMessageLog>("PrintRetMessageLog");
+  action_lib->RegisterOutput<cActionPrintInterruptData>("PrintInterruptData");
+  action_lib->RegisterOutput<cActionPrintTotalsData>("PrintTotalsData");
+  action_lib->RegisterOutput<cActionPrintThreadsData>("PrintThreadsData");
+  action_lib->RegisterOutput<cActionPrintTasksData>("PrintTasksData");
+  action_lib->RegisterOutput<cActionPrintSoloTaskSnapshot>("PrintSoloTaskSnapshot");
+  action_lib->RegisterOutput<cActionPrintHostTasksData>("PrintHostTasksData");
+  action_lib->RegisterOutput<cActionPrintParasiteTasksData>("PrintParasiteTasksData");
+  action_lib->RegisterOutput<cActionPrintTasksExeData>("PrintTasksExeData");
+  action_lib->RegisterOutput<cActionPrintNewTasksData>("PrintNewTasksData");
+  action_lib->RegisterOutput<cActionPrintNewReactionData>("PrintNewReactionData");
+  action_lib->RegisterOutput<cActionPrintNewTasksDataPlus>("PrintNewTasksDataPlus");
+  action_lib->RegisterOutput<cActionPrintTasksQualData>("PrintTasksQualData");
+  action_lib->RegisterOutput<cActionPrintResourceData>("PrintResourceData");
+  action_lib->RegisterOutput<cActionPrintResourceLocData>("PrintResourceLocData");
+  action_lib->RegisterOutput<cActionPrintResWallLocData>("PrintResWallLocData");
+  action_lib->RegisterOutput<cActionPrintTestCPUCacheData>("PrintTestCPUCacheData");
+  action_lib->RegisterOutput<cActionPrintReactionData>("PrintReactionData");
+  action_lib->RegisterOutput<cActionPrintReactionExeData>("PrintReactionExeData");
+  action_lib->RegisterOutput<cActionPrintCurrentReactionData>("PrintCurrentReactionData");
+  action_lib->RegisterOutput<cActionPrintReactionRewardData>("PrintReactionRewardData");
+  action_lib->RegisterOutput<cActionPrintCurrentReactionRewardData>("PrintCurrentReactionRewardData");
+  action_lib->RegisterOutput<cActionPrintTimeData>("PrintTimeData");
+  action_lib->RegisterOutput<cActionPrintExtendedTimeData>("PrintExtendedTimeData");
+  action_lib->RegisterOutput<cActionPrintMutationRateData>("PrintMutationRateData");
+  action_lib->RegisterOutput<cActionPrintDivideMutData>("PrintDivideMutData");
+  action_lib->RegisterOutput<cActionPrintParasiteData>("PrintParasiteData");
+  action_lib->RegisterOutput<cActionPrintNumDivides>("PrintNumDivides");
+  
+  action_lib->RegisterOutput<cActionPrintPreyAverageData>("PrintPreyAverageData");
+  action_lib->RegisterOutput<cActionPrintPredatorAverageData>("PrintPredatorAverageData");
+  action_lib->RegisterOutput<cActionPrintTopPredatorAverageData>("PrintTopPredatorAverageData");
+  action_lib->RegisterOutput<cActionPrintPreyErrorData>("PrintPreyErrorData");
+  action_lib->RegisterOutput<cActionPrintPredatorErrorData>("PrintPredatorErrorData");
+  action_lib->RegisterOutput<cActionPrintTopPredatorErrorData>("PrintTopPredatorErrorData");
+  action_lib->RegisterOutput<cActionPrintPreyVarianceData>("PrintPreyVarianceData");
+  action_lib->RegisterOutput<cActionPrintPredatorVarianceData>("PrintPredatorVarianceData");
+  action_lib->RegisterOutput<cActionPrintTopPredatorVarianceData>("PrintTopPredatorVarianceData");
+  action_lib->RegisterOutput<cActionPrintPreyInstructionData>("PrintPreyInstructionData");
+  action_lib->RegisterOutput<cActionPrintPredatorInstructionData>("PrintPredatorInstructionData");
+  action_lib->RegisterOutput<cActionPrintTopPredatorInstructionData>("PrintTopPredatorInstructionData");
+  action_lib->RegisterOutput<cActionPrintPreyFromSensorInstructionData>("PrintPreyFromSensorInstructionData");
+  action_lib->RegisterOutput<cActionPrintPredatorFromSensorInstructionData>("PrintPredatorFromSensorInstructionData");
+  action_lib->RegisterOutput<cActionPrintTopPredatorFromSensorInstructionData>("PrintTopPredatorFromSensorInstructionData");
+  action_lib->RegisterOutput<cActionPrintGroupAttackData>("PrintGroupAttackData");
+  action_lib->RegisterOutput<cActionPrintKilledPreyFTData>("PrintKilledPreyFTData");
+  action_lib->RegisterOutput<cActionPrintAttacks>("PrintAttacks");
+  
+  action_lib->RegisterOutput<cActionPrintFromMessageInstructionData>("PrintFromMessageInstructionData");
+  
+  action_lib->RegisterOutput<cActionPrintMaleInstructionData>("PrintMaleInstructionData");
+  action_lib->RegisterOutput<cActionPrintFemaleInstructionData>("PrintFemaleInstructionData");
+  action_lib->RegisterOutput<cActionPrintSenseData>("PrintSenseData");
+  action_lib->RegisterOutput<cActionPrintSenseExeData>("PrintSenseExeData");
+  action_lib->RegisterOutput<cActionPrintInstructionData>("PrintInstructionData");
+  action_lib->RegisterOutput<cActionPrintInternalTasksData>("PrintInternalTasksData");
+  action_lib->RegisterOutput<cActionPrintInternalTasksQualData>("PrintInternalTasksQualData");
+  action_lib->RegisterOutput<cActionPrintSleepData>("PrintSleepData");
+  action_lib->RegisterOutput<cActionPrintCompetitionData>("PrintCompetitionData");
+  action_lib->RegisterOutput<cActionPrintDynamicMaxMinData>("PrintDynamicMaxMinData");
+  action_lib->RegisterOutput<cActionPrintMaleAverageData>("PrintMaleAverageData");
+  action_lib->RegisterOutput<cActionPrintFemaleAverageData>("PrintFemaleAverageData");
+  action_lib->RegisterOutput<cActionPrintMaleErrorData>("PrintMaleErrorData");
+  action_lib->RegisterOutput<cActionPrintFemaleErrorData>("PrintFemaleErrorData");
+  action_lib->RegisterOutput<cActionPrintMaleVarianceData>("PrintMaleVarianceData");
+  action_lib->RegisterOutput<cActionPrintFemaleVarianceData>("PrintFemaleVarianceData");
   
   // @WRE: Added printing of visit data
-  action_lib->Register<cActionPrintCellVisitsData>("PrintCellVisitsData");
+  action_lib->RegisterOutput<cActionPrintCellVisitsData>("PrintCellVisitsData");
   
   // Population Out Files
-  action_lib->Register<cActionPrintPhenotypeData>("PrintPhenotypeData");
-  action_lib->Register<cActionPrintParasitePhenotypeData>("PrintParasitePhenotypeData");
-  action_lib->Register<cActionPrintHostPhenotypeData>("PrintHostPhenotypeData");
-  action_lib->Register<cActionPrintPhenotypeStatus>("PrintPhenotypeStatus");
-  
-  action_lib->Register<cActionPrintDemeTestamentStats>("PrintDemeTestamentStats");
-	action_lib->Register<cActionPrintCurrentMeanDemeDensity>("PrintCurrentMeanDemeDensity");
-  
-	action_lib->Register<cActionPrintPredicatedMessages>("PrintPredicatedMessages");
-	action_lib->Register<cActionPrintCellData>("PrintCellData");
-	action_lib->Register<cActionPrintConsensusData>("PrintConsensusData");
-	action_lib->Register<cActionPrintSimpleConsensusData>("PrintSimpleConsensusData");
-	action_lib->Register<cActionPrintCurrentOpinions>("PrintCurrentOpinions");
-	action_lib->Register<cActionPrintOpinionsSetPerDeme>("PrintOpinionsSetPerDeme");
-	action_lib->Register<cActionPrintSynchronizationData>("PrintSynchronizationData");
-  action_lib->Register<cActionPrintCurrentMeanDemeDensity>("PrintCurrentMeanDemeDensity");
-  
-  action_lib->Register<cActionPrintPredicatedMessages>("PrintPredicatedMessages");
-  action_lib->Register<cActionPrintCellData>("PrintCellData");
-  action_lib->Register<cActionPrintConsensusData>("PrintConsensusData");
-  action_lib->Register<cActionPrintSimpleConsensusData>("PrintSimpleConsensusData");
-  action_lib->Register<cActionPrintCurrentOpinions>("PrintCurrentOpinions");
-  action_lib->Register<cActionPrintOpinionsSetPerDeme>("PrintOpinionsSetPerDeme");
-  action_lib->Register<cActionPrintSynchronizationData>("PrintSynchronizationData");
-  action_lib->Register<cActionPrintDetailedSynchronizationData>("PrintDetailedSynchronizationData");
-  
-  action_lib->Register<cActionPrintDonationStats>("PrintDonationStats");
+  action_lib->RegisterOutput<cActionPrintPhenotypeData>("PrintPhenotypeData");
+  action_lib->RegisterOutput<cActionPrintParasitePhenotypeData>("PrintParasitePhenotypeData");
+  action_lib->RegisterOutput<cActionPrintHostPhenotypeData>("PrintHostPhenotypeData");
+  action_lib->RegisterOutput<cActionPrintPhenotypeStatus>("PrintPhenotypeStatus");
+  
+  action_lib->RegisterOutput<cActionPrintDemeTestamentStats>("PrintDemeTestamentStats");
+	action_lib->RegisterOutput<cActionPrintCurrentMeanDemeDensity>("PrintCurrentMeanDemeDensity");
+  
+	action_lib->RegisterOutput<cActionPrintPredicatedMessages>("PrintPredicatedMessages");
+	action_lib->RegisterOutput<cActionPrintCellData>("PrintCellData");
+	action_lib->RegisterOutput<cActionPrintConsensusData>("PrintConsensusData");
+	action_lib->RegisterOutput<cActionPrintSimpleConsensusData>("PrintSimpleConsensusData");
+	action_lib->RegisterOutput<cActionPrintCurrentOpinions>("PrintCurrentOpinions");
+	action_lib->RegisterOutput<cActionPrintOpinionsSetPerDeme>("PrintOpinionsSetPerDeme");
+	action_lib->RegisterOutput<cActionPrintSynchronizationData>("PrintSynchronizationData");
+  action_lib->RegisterOutput<cActionPrintCurrentMeanDemeDensity>("PrintCurrentMeanDemeDensity");
+  
+  action_lib->RegisterOutput<cActionPrintPredicatedMessages>("PrintPredicatedMessages");
+  action_lib->RegisterOutput<cActionPrintCellData>("PrintCellData");
+  action_lib->RegisterOutput<cActionPrintConsensusData>("PrintConsensusData");
+  action_lib->RegisterOutput<cActionPrintSimpleConsensusData>("PrintSimpleConsensusData");
+  action_lib->RegisterOutput<cActionPrintCurrentOpinions>("PrintCurrentOpinions");
+  action_lib->RegisterOutput<cActionPrintOpinionsSetPerDeme>("PrintOpinionsSetPerDeme");
+  action_lib->RegisterOutput<cActionPrintSynchronizationData>("PrintSynchronizationData");
+  action_lib->RegisterOutput<cActionPrintDetailedSynchronizationData>("PrintDetailedSynchronizationData");
+  
+  action_lib->RegisterOutput<cActionPrintDonationStats>("PrintDonationStats");
     
   // kabooms output file
-  action_lib->Register<cActionPrintKaboom>("PrintKaboom");
-  action_lib->Register<cActionPrintQuorum>("PrintQuorum");
+  action_lib->RegisterOutput<cActionPrintKaboom>("PrintKaboom");
+  action_lib->RegisterOutput<cActionPrintQuorum>("PrintQuorum");
   
   // deme output files
-  action_lib->Register<cActionPrintDemeAllStats>("PrintDemeAllStats");
-  action_lib->Register<cActionPrintDemeAllStats>("PrintDemeStats"); //duplicate of previous
-  action_lib->Register<cActionPrintDemesTotalAvgEnergy>("PrintDemesTotalAvgEnergy");
-  action_lib->Register<cActionPrintDemeEnergySharingStats>("PrintDemeEnergySharingStats");
-  action_lib->Register<cActionPrintDemeEnergyDistributionStats>("PrintDemeEnergyDistributionStats");
-  action_lib->Register<cActionPrintDemeDonorStats>("PrintDemeDonorStats");
-  action_lib->Register<cActionPrintDemeSpacialEnergy>("PrintDemeSpacialEnergyStats");
-  action_lib->Register<cActionPrintDemeSpacialSleep>("PrintDemeSpacialSleepStats");
-  action_lib->Register<cActionPrintDemeResources>("PrintDemeResourceStats");
-  action_lib->Register<cActionPrintDemeGlobalResources>("PrintDemeGlobalResources");
-  action_lib->Register<cActionPrintDemeReplicationData>("PrintDemeReplicationData");
-  action_lib->Register<cActionPrintDemeGermlineSequestration>("PrintDemeGermlineSequestration");
-  action_lib->Register<cActionPrintDemeOrgGermlineSequestration>("PrintDemeOrgGermlineSequestration");
-  action_lib->Register<cActionPrintDemeGLSFounders>("PrintDemeGLSFounders");
-  action_lib->Register<cActionPrintDemeReactionDiversityReplicationData>("PrintDemeReactionDiversityReplicationData");
-  action_lib->Register<cActionPrintDemeGermResourcesData>("PrintDemeGermResourcesData");
-  action_lib->Register<cActionPrintWinningDeme>("PrintWinningDeme");
-  action_lib->Register<cActionPrintDemeTreatableReplicationData>("PrintDemeTreatableReplicationData");
-  action_lib->Register<cActionPrintDemeUntreatableReplicationData>("PrintDemeUntreatableReplicationData");
-  action_lib->Register<cActionPrintDemeTreatableCount>("PrintDemeTreatableCount");
-  action_lib->Register<cActionPrintDemeFitness>("PrintDemeFitnessData");
-  action_lib->Register<cActionPrintDemeLifeFitness>("PrintDemeLifeFitnessData");
-  action_lib->Register<cActionPrintDemeTasks>("PrintDemeTasksData");
-  
-  action_lib->Register<cActionPrintDemeCompetitionData>("PrintDemeCompetitionData");
-  action_lib->Register<cActionPrintDemeNetworkData>("PrintDemeNetworkData");
-  action_lib->Register<cActionPrintDemeNetworkTopology>("PrintDemeNetworkTopology");
-  action_lib->Register<cActionPrintDemeFoundersData>("PrintDemeFoundersData");
-  action_lib->Register<cActionPrintGermlineData>("PrintGermlineData");
-  action_lib->Register<cActionSaveDemeFounders>("SaveDemeFounders");
-  action_lib->Register<cActionPrintPerDemeTasksData>("PrintPerDemeTasksData");
-  action_lib->Register<cActionPrintPerDemeTasksExeData>("PrintPerDemeTasksExeData");
-  action_lib->Register<cActionPrintAvgDemeTasksExeData>("PrintAvgDemeTasksExeData");
-  action_lib->Register<cActionPrintAvgTreatableDemeTasksExeData>("PrintAvgTreatableDemeTasksExeData");
-  action_lib->Register<cActionPrintAvgUntreatableDemeTasksExeData>("PrintAvgUntreatableDemeTasksExeData");
-  action_lib->Register<cActionPrintPerDemeReactionData>("PrintPerDemeReactionData");
-  action_lib->Register<cActionPrintDemeTasksData>("PrintDemeTasksData");
-  action_lib->Register<cActionPrintDemeTasksExeData>("PrintDemeTasksExeData");
-  action_lib->Register<cActionPrintDemeReactionData>("PrintDemeReactionData");
-  action_lib->Register<cActionPrintDemeOrgTasksData>("PrintDemeOrgTasksData");
-  action_lib->Register<cActionPrintDemeOrgTasksExeData>("PrintDemeOrgTasksExeData");
-  action_lib->Register<cActionPrintDemeOrgReactionData>("PrintDemeOrgReactionData");
-  action_lib->Register<cActionPrintDemeCurrentTaskExeData>("PrintDemeCurrentTaskExeData");
-  action_lib->Register<cActionPrintCurrentTaskCounts>("PrintCurrentTaskCounts");
-  action_lib->Register<cActionPrintPerDemeGenPerFounderData>("PrintPerDemeGenPerFounderData");
-  action_lib->Register<cActionPrintDemeMigrationSuicidePoints>("PrintDemeMigrationSuicidePoints");
-  
-  action_lib->Register<cActionPrintDemesTasksData>("PrintDemesTasksData"); //@JJB**
-  action_lib->Register<cActionPrintDemesReactionsData>("PrintDemesReactionsData"); //@JJB**
-  action_lib->Register<cActionPrintDemesMeritsData>("PrintDemesMeritsData"); //@JJB**
-  action_lib->Register<cActionPrintDemesFitnessData>("PrintDemesFitnessData"); //@JJB**
-  
-  action_lib->Register<cActionPrintMultiProcessData>("PrintMultiProcessData");
-  action_lib->Register<cActionPrintProfilingData>("PrintProfilingData");
-  action_lib->Register<cActionPrintOrganismLocation>("PrintOrganismLocation");
-  action_lib->Register<cActionPrintOrgLocData>("PrintOrgLocData");
-  action_lib->Register<cActionPrintPreyFlockingData>("PrintPreyFlockingData");
-  action_lib->Register<cActionPrintOrgGuardData>("PrintOrgGuardData");
-  action_lib->Register<cActionPrintAgePolyethismData>("PrintAgePolyethismData");
-  action_lib->Register<cActionPrintIntrinsicTaskSwitchingCostData>("PrintIntrinsicTaskSwitchingCostData");
-  action_lib->Register<cActionPrintDenData>("PrintDenData");
+  action_lib->RegisterOutput<cActionPrintDemeAllStats>("PrintDemeAllStats");
+  action_lib->RegisterOutput<cActionPrintDemeAllStats>("PrintDemeStats"); //duplicate of previous
+  action_lib->RegisterOutput<cActionPrintDemesTotalAvgEnergy>("PrintDemesTotalAvgEnergy");
+  action_lib->RegisterOutput<cActionPrintDemeEnergySharingStats>("PrintDemeEnergySharingStats");
+  action_lib->RegisterOutput<cActionPrintDemeEnergyDistributionStats>("PrintDemeEnergyDistributionStats");
+  action_lib->RegisterOutput<cActionPrintDemeDonorStats>("PrintDemeDonorStats");
+  action_lib->RegisterOutput<cActionPrintDemeSpacialEnergy>("PrintDemeSpacialEnergyStats");
+  action_lib->RegisterOutput<cActionPrintDemeSpacialSleep>("PrintDemeSpacialSleepStats");
+  action_lib->RegisterOutput<cActionPrintDemeResources>("PrintDemeResourceStats");
+  action_lib->RegisterOutput<cActionPrintDemeGlobalResources>("PrintDemeGlobalResources");
+  action_lib->RegisterOutput<cActionPrintDemeReplicationData>("PrintDemeReplicationData");
+  action_lib->RegisterOutput<cActionPrintDemeGermlineSequestration>("PrintDemeGermlineSequestration");
+  action_lib->RegisterOutput<cActionPrintDemeOrgGermlineSequestration>("PrintDemeOrgGermlineSequestration");
+  action_lib->RegisterOutput<cActionPrintDemeGLSFounders>("PrintDemeGLSFounders");
+  action_lib->RegisterOutput<cActionPrintDemeReactionDiversityReplicationData>("PrintDemeReactionDiversityReplicationData");
+  action_lib->RegisterOutput<cActionPrintDemeGermResourcesData>("PrintDemeGermResourcesData");
+  action_lib->RegisterOutput<cActionPrintWinningDeme>("PrintWinningDeme");
+  action_lib->RegisterOutput<cActionPrintDemeTreatableReplicationData>("PrintDemeTreatableReplicationData");
+  action_lib->RegisterOutput<cActionPrintDemeUntreatableReplicationData>("PrintDemeUntreatableReplicationData");
+  action_lib->RegisterOutput<cActionPrintDemeTreatableCount>("PrintDemeTreatableCount");
+  action_lib->RegisterOutput<cActionPrintDemeFitness>("PrintDemeFitnessData");
+  action_lib->RegisterOutput<cActionPrintDemeLifeFitness>("PrintDemeLifeFitnessData");
+  action_lib->RegisterOutput<cActionPrintDemeTasks>("PrintDemeTasksData");
+  
+  action_lib->RegisterOutput<cActionPrintDemeCompetitionData>("PrintDemeCompetitionData");
+  action_lib->RegisterOutput<cActionPrintDemeNetworkData>("PrintDemeNetworkData");
+  action_lib->RegisterOutput<cActionPrintDemeNetworkTopology>("PrintDemeNetworkTopology");
+  action_lib->RegisterOutput<cActionPrintDemeFoundersData>("PrintDemeFoundersData");
+  action_lib->RegisterOutput<cActionPrintGermlineData>("PrintGermlineData");
+  action_lib->RegisterOutput<cActionSaveDemeFounders>("SaveDemeFounders");
+  action_lib->RegisterOutput<cActionPrintPerDemeTasksData>("PrintPerDemeTasksData");
+  action_lib->RegisterOutput<cActionPrintPerDemeTasksExeData>("PrintPerDemeTasksExeData");
+  action_lib->RegisterOutput<cActionPrintAvgDemeTasksExeData>("PrintAvgDemeTasksExeData");
+  action_lib->RegisterOutput<cActionPrintAvgTreatableDemeTasksExeData>("PrintAvgTreatableDemeTasksExeData");
+  action_lib->RegisterOutput<cActionPrintAvgUntreatableDemeTasksExeData>("PrintAvgUntreatableDemeTasksExeData");
+  action_lib->RegisterOutput<cActionPrintPerDemeReactionData>("PrintPerDemeReactionData");
+  action_lib->RegisterOutput<cActionPrintDemeTasksData>("PrintDemeTasksData");
+  action_lib->RegisterOutput<cActionPrintDemeTasksExeData>("PrintDemeTasksExeData");
+  action_lib->RegisterOutput<cActionPrintDemeReactionData>("PrintDemeReactionData");
+  action_lib->RegisterOutput<cActionPrintDemeOrgTasksData>("PrintDemeOrgTasksData");
+  action_lib->RegisterOutput<cActionPrintDemeOrgTasksExeData>("PrintDemeOrgTasksExeData");
+  action_lib->RegisterOutput<cActionPrintDemeOrgReactionData>("PrintDemeOrgReactionData");
+  action_lib->RegisterOutput<cActionPrintDemeCurrentTaskExeData>("PrintDemeCurrentTaskExeData");
+  action_lib->RegisterOutput<cActionPrintCurrentTaskCounts>("PrintCurrentTaskCounts");
+  action_lib->RegisterOutput<cActionPrintPerDemeGenPerFounderData>("PrintPerDemeGenPerFounderData");
+  action_lib->RegisterOutput<cActionPrintDemeMigrationSuicidePoints>("PrintDemeMigrationSuicidePoints");
+  
+  action_lib->RegisterOutput<cActionPrintDemesTasksData>("PrintDemesTasksData"); //@JJB**
+  action_lib->RegisterOutput<cActionPrintDemesReactionsData>("PrintDemesReactionsData"); //@JJB**
+  action_lib->RegisterOutput<cActionPrintDemesMeritsData>("PrintDemesMeritsData"); //@JJB**
+  action_lib->RegisterOutput<cActionPrintDemesFitnessData>("PrintDemesFitnessData"); //@JJB**
+  
+  action_lib->RegisterOutput<cActionPrintMultiProcessData>("PrintMultiProcessData");
+  action_lib->RegisterOutput<cActionPrintProfilingData>("PrintProfilingData");
+  action_lib->RegisterOutput<cActionPrintOrganismLocation>("PrintOrganismLocation");
+  action_lib->RegisterOutput<cActionPrintOrgLocData>("PrintOrgLocData");
+  action_lib->RegisterOutput<cActionPrintPreyFlockingData>("PrintPreyFlockingData");
+  action_lib->RegisterOutput<cActionPrintOrgGuardData>("PrintOrgGuardData");
+  action_lib->RegisterOutput<cActionPrintAgePolyethismData>("PrintAgePolyethismData");
+  action_lib->RegisterOutput<cActionPrintIntrinsicTaskSwitchingCostData>("PrintIntrinsicTaskSwitchingCostData");
+  action_lib->RegisterOutput<cActionPrintDenData>("PrintDenData");
 
   
   //Coalescence Clade Actions
-  action_lib->Register<cActionPrintCCladeCounts>("PrintCCladeCounts");
-  action_lib->Register<cActionPrintCCladeFitnessHistogram>("PrintCCladeFitnessHistogram");
-  action_lib->Register<cActionPrintCCladeRelativeFitnessHistogram>("PrintCCladeRelativeFitnessHistogram");
+  action_lib->RegisterOutput<cActionPrintCCladeCounts>("PrintCCladeCounts");
+  action_lib->RegisterOutput<cActionPrintCCladeFitnessHistogram>("PrintCCladeFitnessHistogram");
+  action_lib->RegisterOutput<cActionPrintCCladeRelativeFitnessHistogram>("PrintCCladeRelativeFitnessHistogram");
   
   // Processed Data
-  action_lib->Register<cActionPrintData>("PrintData");
-  action_lib->Register<cActionPrintInstructionAbundanceHistogram>("PrintInstructionAbundanceHistogram");
-  action_lib->Register<cActionPrintDepthHistogram>("PrintDepthHistogram");
-  action_lib->Register<cActionPrintParasiteDepthHistogram>("PrintParasiteDepthHistogram");
-  action_lib->Register<cActionPrintHostDepthHistogram>("PrintHostDepthHistogram");
-  action_lib->Register<cActionEcho>("Echo");
-  action_lib->Register<cActionPrintGenotypeAbundanceHistogram>("PrintGenotypeAbundanceHistogram");
-  //  action_lib->Register<cActionPrintSpeciesAbundanceHistogram>("PrintSpeciesAbundanceHistogram");
-  //  action_lib->Register<cActionPrintLineageTotals>("PrintLineageTotals");
-  action_lib->Register<cActionPrintLineageCounts>("PrintLineageCounts");
-  action_lib->Register<cActionPrintDominantGenotype>("PrintDominantGenotype");
-  action_lib->Register<cActionPrintDominantGroupGenotypes>("PrintDominantGroupGenotypes");
-  action_lib->Register<cActionPrintDominantForagerGenotypes>("PrintDominantForagerGenotypes");
-  action_lib->Register<cActionPrintDetailedFitnessData>("PrintDetailedFitnessData");
-  action_lib->Register<cActionPrintLogFitnessHistogram>("PrintLogFitnessHistogram");
-  action_lib->Register<cActionPrintRelativeFitnessHistogram>("PrintRelativeFitnessHistogram");
-  action_lib->Register<cActionPrintGeneticDistanceData>("PrintGeneticDistanceData");
-  action_lib->Register<cActionPrintPopulationDistanceData>("PrintPopulationDistanceData");
-  
-  action_lib->Register<cActionPrintPhenotypicPlasticity>("PrintPhenotypicPlasticity");
-  action_lib->Register<cActionPrintTaskProbHistogram>("PrintTaskProbHistogram");
-  action_lib->Register<cActionPrintPlasticGenotypeSummary>("PrintPlasticGenotypeSummary");
-  
-  action_lib->Register<cActionTestDominant>("TestDominant");
-  action_lib->Register<cActionPrintTaskSnapshot>("PrintTaskSnapshot");
-  action_lib->Register<cActionPrintViableTasksData>("PrintViableTasksData");
-  action_lib->Register<cActionPrintAveNumTasks>("PrintAveNumTasks");
-  
-  action_lib->Register<cActionPrintGenomicSiteEntropy>("PrintGenomicSiteEntropy");
+  action_lib->RegisterOutput<cActionPrintData>("PrintData");
+  action_lib->RegisterOutput<cActionPrintInstructionAbundanceHistogram>("PrintInstructionAbundanceHistogram");
+  action_lib->RegisterOutput<cActionPrintDepthHistogram>("PrintDepthHistogram");
+  action_lib->RegisterOutput<cActionPrintParasiteDepthHistogram>("PrintParasiteDepthHistogram");
+  action_lib->RegisterOutput<cActionPrintHostDepthHistogram>("PrintHostDepthHistogram");
+  action_lib->RegisterOutput<cActionEcho>("Echo");
+  action_lib->RegisterOutput<cActionPrintGenotypeAbundanceHistogram>("PrintGenotypeAbundanceHistogram");
+  //  action_lib->RegisterOutput<cActionPrintSpeciesAbundanceHistogram>("PrintSpeciesAbundanceHistogram");
+  //  action_lib->RegisterOutput<cActionPrintLineageTotals>("PrintLineageTotals");
+  action_lib->RegisterOutput<cActionPrintLineageCounts>("PrintLineageCounts");
+  action_lib->RegisterOutput<cActionPrintDominantGenotype>("PrintDominantGenotype");
+  action_lib->RegisterOutput<cActionPrintDominantGroupGenotypes>("PrintDominantGroupGenotypes");
+  action_lib->RegisterOutput<cActionPrintDominantForagerGenotypes>("PrintDominantForagerGenotypes");
+  action_lib->RegisterOutput<cActionPrintDetailedFitnessData>("PrintDetailedFitnessData");
+  action_lib->RegisterOutput<cActionPrintLogFitnessHistogram>("PrintLogFitnessHistogram");
+  action_lib->RegisterOutput<cActionPrintRelativeFitnessHistogram>("PrintRelativeFitnessHistogram");
+  action_lib->RegisterOutput<cActionPrintGeneticDistanceData>("PrintGeneticDistanceData");
+  action_lib->RegisterOutput<cActionPrintPopulationDistanceData>("PrintPopulationDistanceData");
+  
+  action_lib->RegisterOutput<cActionPrintPhenotypicPlasticity>("PrintPhenotypicPlasticity");
+  action_lib->RegisterOutput<cActionPrintTaskProbHistogram>("PrintTaskProbHistogram");
+  action_lib->RegisterOutput<cActionPrintPlasticGenotypeSummary>("PrintPlasticGenotypeSummary");
+  
+  action_lib->RegisterOutput<cActionTestDominant>("TestDominant");
+  action_lib->RegisterOutput<cActionPrintTaskSnapshot>("PrintTaskSnapshot");
+  action_lib->RegisterOutput<cActionPrintViableTasksData>("PrintViableTasksData");
+  action_lib->RegisterOutput<cActionPrintAveNumTasks>("PrintAveNumTasks");
+  
+  action_lib->RegisterOutput<cActionPrintGenomicSiteEntropy>("PrintGenomicSiteEntropy");
   
   // Grid Information Dumps
-  action_lib->Register<cActionDumpClassificationIDGrid>("DumpClassificationIDGrid");
-  action_lib->Register<cActionDumpFitnessGrid>("DumpFitnessGrid");
-  action_lib->Register<cActionDumpGenotypeColorGrid>("DumpGenotypeColorGrid");
-  action_lib->Register<cActionDumpPhenotypeIDGrid>("DumpPhenotypeIDGrid");
-  action_lib->Register<cActionDumpIDGrid>("DumpIDGrid");
-  action_lib->Register<cActionDumpVitalityGrid>("DumpVitalityGrid");
-  action_lib->Register<cActionDumpTargetGrid>("DumpTargetGrid");
-  action_lib->Register<cActionDumpMaxResGrid>("DumpMaxResGrid");
-  action_lib->Register<cActionDumpTaskGrid>("DumpTaskGrid");
-  action_lib->Register<cActionDumpLastTaskGrid>("DumpLastTaskGrid");
-  action_lib->Register<cActionDumpHostTaskGrid>("DumpHostTaskGrid");
-  action_lib->Register<cActionDumpParasiteTaskGrid>("DumpParasiteTaskGrid");
-  action_lib->Register<cActionDumpHostTaskGridComma>("DumpHostTaskGridComma");
-  action_lib->Register<cActionDumpParasiteTaskGridComma>("DumpParasiteTaskGridComma");
-  action_lib->Register<cActionDumpParasiteVirulenceGrid>("DumpParasiteVirulenceGrid");
-  action_lib->Register<cActionDumpOffspringMigrationCounts>("DumpOffspringMigrationCounts"); 
-  action_lib->Register<cActionDumpParasiteMigrationCounts>("DumpParasiteMigrationCounts"); 
-  
-  action_lib->Register<cActionDumpReactionGrid>("DumpReactionGrid");
-  action_lib->Register<cActionDumpDonorGrid>("DumpDonorGrid");
-  action_lib->Register<cActionDumpReceiverGrid>("DumpReceiverGrid");
-  action_lib->Register<cActionDumpEnergyGrid>("DumpEnergyGrid");
-  action_lib->Register<cActionDumpExecutionRatioGrid>("DumpExecutionRatioGrid");
-  action_lib->Register<cActionDumpCellDataGrid>("DumpCellDataGrid");
-  action_lib->Register<cActionDumpSleepGrid>("DumpSleepGrid");
-  action_lib->Register<cActionDumpGenomeLengthGrid>("DumpGenomeLengthGrid");
-  action_lib->Register<cActionDumpGenotypeGrid>("DumpGenotypeGrid");
-  action_lib->Register<cActionDumpParasiteGenotypeGrid>("DumpParasiteGenotypeGrid");
+  action_lib->RegisterOutput<cActionDumpClassificationIDGrid>("DumpClassificationIDGrid");
+  action_lib->RegisterOutput<cActionDumpFitnessGrid>("DumpFitnessGrid");
+  action_lib->RegisterOutput<cActionDumpGenotypeColorGrid>("DumpGenotypeColorGrid");
+  action_lib->RegisterOutput<cActionDumpPhenotypeIDGrid>("DumpPhenotypeIDGrid");
+  action_lib->RegisterOutput<cActionDumpIDGrid>("DumpIDGrid");
+  action_lib->RegisterOutput<cActionDumpVitalityGrid>("DumpVitalityGrid");
+  action_lib->RegisterOutput<cActionDumpTargetGrid>("DumpTargetGrid");
+  action_lib->RegisterOutput<cActionDumpMaxResGrid>("DumpMaxResGrid");
+  action_lib->RegisterOutput<cActionDumpTaskGrid>("DumpTaskGrid");
+  action_lib->RegisterOutput<cActionDumpLastTaskGrid>("DumpLastTaskGrid");
+  action_lib->RegisterOutput<cActionDumpHostTaskGrid>("DumpHostTaskGrid");
+  action_lib->RegisterOutput<cActionDumpParasiteTaskGrid>("DumpParasiteTaskGrid");
+  action_lib->RegisterOutput<cActionDumpHostTaskGridComma>("DumpHostTaskGridComma");
+  action_lib->RegisterOutput<cActionDumpParasiteTaskGridComma>("DumpParasiteTaskGridComma");
+  action_lib->RegisterOutput<cActionDumpParasiteVirulenceGrid>("DumpParasiteVirulenceGrid");
+  action_lib->RegisterOutput<cActionDumpOffspringMigrationCounts>("DumpOffspringMigrationCounts"); 
+  action_lib->RegisterOutput<cActionDumpParasiteMigrationCounts>("DumpParasiteMigrationCounts"); 
+  
+  action_lib->RegisterOutput<cActionDumpReactionGrid>("DumpReactionGrid");
+  action_lib->RegisterOutput<cActionDumpDonorGrid>("DumpDonorGrid");
+  action_lib->RegisterOutput<cActionDumpReceiverGrid>("DumpReceiverGrid");
+  action_lib->RegisterOutput<cActionDumpEnergyGrid>("DumpEnergyGrid");
+  action_lib->RegisterOutput<cActionDumpExecutionRatioGrid>("DumpExecutionRatioGrid");
+  action_lib->RegisterOutput<cActionDumpCellDataGrid>("DumpCellDataGrid");
+  action_lib->RegisterOutput<cActionDumpSleepGrid>("DumpSleepGrid");
+  action_lib->RegisterOutput<cActionDumpGenomeLengthGrid>("DumpGenomeLengthGrid");
+  action_lib->RegisterOutput<cActionDumpGenotypeGrid>("DumpGenotypeGrid");
+  action_lib->RegisterOutput<cActionDumpParasiteGenotypeGrid>("DumpParasiteGenotypeGrid");
   
   //Dump Genotype Lists
-  action_lib->Register<cActionDumpHostGenotypeList>("DumpHostGenotypeList");
-  action_lib->Register<cActionDumpParasiteGenotypeList>("DumpParasiteGenotypeList");
+  action_lib->RegisterOutput<cActionDumpHostGenotypeList>("DumpHostGenotypeList");
+  action_lib->RegisterOutput<cActionDumpParasiteGenotypeList>("DumpParasiteGenotypeList");
 
   
-  action_lib->Register<cActionPrintNumOrgsKilledData>("PrintNumOrgsKilledData");
-  action_lib->Register<cActionPrintMigrationData>("PrintMigrationData");
+  action_lib->RegisterOutput<cActionPrintNumOrgsKilledData>("PrintNumOrgsKilledData");
+  action_lib->RegisterOutput<cActionPrintMigrationData>("PrintMigrationData");
   
-  action_lib->Register<cActionPrintReputationData>("PrintReputationData");
-  action_lib->Register<cActionPrintDirectReciprocityData>("PrintDirectReciprocityData");
-  action_lib->Register<cActionPrintStringMatchData>("PrintStringMatchData");
-  action_lib->Register<cActionPrintShadedAltruists>("PrintShadedAltruists");
+  action_lib->RegisterOutput<cActionPrintReputationData>("PrintReputationData");
+  action_lib->RegisterOutput<cActionPrintDirectReciprocityData>("PrintDirectReciprocityData");
+  action_lib->RegisterOutput<cActionPrintStringMatchData>("PrintStringMatchData");
+  action_lib->RegisterOutput<cActionPrintShadedAltruists>("PrintShadedAltruists");
   
-  action_lib->Register<cActionPrintGroupsFormedData>("PrintGroupsFormedData");
-  action_lib->Register<cActionPrintGroupIds>("PrintGroupIds");
-  action_lib->Register<cActionPrintGroupTolerance>("PrintGroupTolerance"); 
-  action_lib->Register<cActionPrintGroupMTTolerance>("PrintGroupMTTolerance"); 
-  action_lib->Register<cActionPrintToleranceInstructionData>("PrintToleranceInstructionData"); 
-  action_lib->Register<cActionPrintToleranceData>("PrintToleranceData"); 
-  action_lib->Register<cActionPrintTargets>("PrintTargets");
-  action_lib->Register<cActionPrintMimicDisplays>("PrintMimicDisplays");
-  action_lib->Register<cActionPrintTopPredTargets>("PrintTopPredTargets");
+  action_lib->RegisterOutput<cActionPrintGroupsFormedData>("PrintGroupsFormedData");
+  action_lib->RegisterOutput<cActionPrintGroupIds>("PrintGroupIds");
+  action_lib->RegisterOutput<cActionPrintGroupTolerance>("PrintGroupTolerance"); 
+  action_lib->RegisterOutput<cActionPrintGroupMTTolerance>("PrintGroupMTTolerance"); 
+  action_lib->RegisterOutput<cActionPrintToleranceInstructionData>("PrintToleranceInstructionData"); 
+  action_lib->RegisterOutput<cActionPrintToleranceData>("PrintToleranceData"); 
+  action_lib->RegisterOutput<cActionPrintTargets>("PrintTargets");
+  action_lib->RegisterOutput<cActionPrintMimicDisplays>("PrintMimicDisplays");
+  action_lib->RegisterOutput<cActionPrintTopPredTargets>("PrintTopPredTargets");
   
-  action_lib->Register<cActionPrintHGTData>("PrintHGTData");
+  action_lib->RegisterOutput<cActionPrintHGTData>("PrintHGTData");
   
   action_lib->Register<cActionSetVerbose>("SetVerbose");
   action_lib->Register<cActionSetVerbose>("VERBOSE");
   
-  action_lib->Register<cActionPrintNumOrgsInDeme>("PrintNumOrgsInDeme");
-  action_lib->Register<cActionCalcConsensus>("CalcConsensus");
-  action_lib->Register<cActionPrintEditDistance>("PrintEditDistance");
+  action_lib->RegisterOutput<cActionPrintNumOrgsInDeme>("PrintNumOrgsInDeme");
+  action_lib->RegisterOutput<cActionCalcConsensus>("CalcConsensus");
+  action_lib->RegisterOutput<cActionPrintEditDistance>("PrintEditDistance");
   
   //@CHC: Mating type-related actions	
-  action_lib->Register<cActionPrintMatingTypeHistogram>("PrintMatingTypeHistogram");
-  action_lib->Register<cActionPrintMatingDisplayData>("PrintMatingDisplayData");
-  action_lib->Register<cActionPrintFemaleMatePreferenceData>("PrintFemaleMatePreferenceData");
-  action_lib->Register<cActionPrintBirthChamberMatingTypeHistogram>("PrintBirthChamberMatingTypeHistogram");
-  action_lib->Register<cActionPrintSuccessfulMates>("PrintSuccessfulMates");
-  action_lib->Register<cActionPrintBirthChamber>("PrintBirthChamber");
+  action_lib->RegisterOutput<cActionPrintMatingTypeHistogram>("PrintMatingTypeHistogram");
+  action_lib->RegisterOutput<cActionPrintMatingDisplayData>("PrintMatingDisplayData");
+  action_lib->RegisterOutput<cActionPrintFemaleMatePreferenceData>("PrintFemaleMatePreferenceData");
+  action_lib->RegisterOutput<cActionPrintBirthChamberMatingTypeHistogram>("PrintBirthChamberMatingTypeHistogram");
+  action_lib->RegisterOutput<cActionPrintSuccessfulMates>("PrintSuccessfulMates");
+  action_lib->RegisterOutput<cActionPrintBirthChamber>("PrintBirthChamber");
   
   
-  action_lib->Register<cActionPrintDominantData>("PrintDominantData");
+  action_lib->RegisterOutput<cActionPrintDominantData>("PrintDominantData");
   
 }
@@ -281,6 +281,46 @@ public:
   }
 };
 
+/*
+ Writes a checkpoint of the running world, from which the run can be resumed by setting RESTORE_CHECKPOINT.  The
+ checkpoint is written once all of this update's events have been processed.
+
+ Parameters:
+   filename (string) [default: "checkpoint"]
+     The name of the checkpoint file, to which the update number and '.ckpt' are appended.
+*/
+class cActionSaveCheckpoint : public cAction
+{
+private:
+  cString m_filename;
+  
+public:
+  cActionSaveCheckpoint(cWorld* world, const cString& args, Feedback& feedback)
+    : cAction(world, args), m_filename("")
+  {
+    cArgSchema schema(':','=');
+    
+    // String Entries
+    schema.AddEntry("filename", 0, "checkpoint");
+    
+    cArgContainer* argc = cArgContainer::Load(args, schema, feedback);
+    
+    if (argc) {
+      m_filename = argc->GetString(0);
+    }
+    
+    delete argc;
+  }
+  
+  static const cString GetDescription() { return "Arguments: [string filename='checkpoint']"; }
+  
+  void Process(cAvidaContext&)
+  {
+    int update = m_world->GetStats().GetUpdate();
+    m_world->RequestCheckpoint(cStringUtil::Stringf("%s-%d.ckpt", (const char*)m_filename, update));
+  }
+};
+
 void RegisterSaveLoadActions(cActionLibrary* action_lib)
 {
   action_lib->Register<cActionLoadParasiteGenotypeList>("LoadParasiteGenotypeList");
@@ -290,4 +330,5 @@ void RegisterSaveLoadActions(cActionLibrary* action_lib)
   action_lib->Register<cActionLoadStructuredSystematicsGroup>("LoadStructuredSystematicsGroup");
   action_lib->Register<cActionSaveStructuredSystematicsGroup>("SaveStructuredSystematicsGroup");
   action_lib->Register<cActionSaveFlameData>("SaveFlameData");
+  action_lib->Register<cActionSaveCheckpoint>("SaveCheckpoint");
 }
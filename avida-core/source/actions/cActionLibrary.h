@@ -40,6 +40,7 @@ private:
   
   tObjectFactory<cAction* (cWorld*, const cString&, Feedback&)> m_factory;
   Apto::Map<Apto::String, ClassDescFunction> m_desc_funcs;
+  Apto::Set<Apto::String> m_output_keys;
   
   cActionLibrary() { ; }
 
@@ -58,10 +59,20 @@ public:
     m_desc_funcs.Set(lkey, &ClassType::GetDescription);
     return m_factory.Register<ClassType>(lkey);
   }
+  
+  // Output actions only read the world, so they may run while test snapshots (see cTestSnapshot) are still pending.
+  // Before any other action, the world finishes those snapshots, as it may change the environment or configuration.
+  template<typename ClassType> bool RegisterOutput(const Apto::String& key)
+  {
+    if (!Register<ClassType>(key)) return false;
+    m_output_keys.Insert(key.AsLower());
+    return true;
+  }
   bool Unregister(const Apto::String& key)
   {
     Apto::String lkey(key.AsLower());
     m_desc_funcs.Remove(lkey);
+    m_output_keys.Remove(lkey);
     return m_factory.Unregister(lkey);
   }
   
@@ -71,6 +82,7 @@ public:
   }
   
   bool Supports(const Apto::String& key) const { return m_factory.Supports(key.AsLower()); }
+  bool IsOutput(const Apto::String& key) const { return m_output_keys.Has(key.AsLower()); }
   
   const cString Describe(const Apto::String& key) const
   {
@@ -39,6 +39,7 @@
 #include "cAnalyzeCommandAction.h"
 #include "cAnalyzeCommandDef.h"
 #include "cAnalyzeCommandDefBase.h"
+#include "cAnalyzeDistanceScan.h"
 #include "cAnalyzeFlowCommand.h"
 #include "cAnalyzeFlowCommandDef.h"
 #include "cAnalyzeFunction.h"
@@ -48,6 +49,7 @@
 #include "cAvidaContext.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
+#include "cGenotypeColumns.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHardwareStatusPrinter.h"
@@ -769,27 +771,119 @@ double cAnalyze::IncreasedInfo(cAnalyzeGenotype * genotype1,
 
 void cAnalyze::LoadFile(cString cur_string)
 {
-  // LOAD
+  // LOAD [filename] [stat relation value]
   
   cString filename = cur_string.PopWord();
   
+  // Optional filter, so that unwanted genotypes are dropped before they are ever built
+  cGenotypeFileReader::cFilter filter;
+  if (cur_string.CountNumWords() > 0) {
+    cString error;
+    const int num_args = cur_string.CountNumWords();
+    cString stat_name = cur_string.PopWord();
+    cString relation = cur_string.PopWord();
+    cString test_value = cur_string.PopWord();
+    if (num_args != 3 || !filter.Setup(stat_name, relation, test_value, error)) {
+      if (error.GetSize()) cerr << "error: " << error << endl;
+      cerr << "Format: LOAD [filename] [stat relation value]" << endl;
+      cerr << "Example: LOAD detail-1000.spop num_cpus > 0" << endl;
+      if (exit_on_error) exit(1);
+      return;
+    }
+  }
+  
   cout << "Loading: " << filename << endl;
   
-  cInitFile input_file(filename, m_world->GetWorkingDir());
-  if (!input_file.WasOpened()) {
-    const cUserFeedback& feedback = input_file.GetFeedback();
-    for (int i = 0; i < feedback.GetNumMessages(); i++) {
-      switch (feedback.GetMessageType(i)) {
-        case cUserFeedback::UF_ERROR:    cerr << "error: "; break;
-        case cUserFeedback::UF_WARNING:  cerr << "warning: "; break;
-        default: break;
-      };
-      cerr << feedback.GetMessage(i) << endl;
+  tList< tDataEntryCommand<cAnalyzeGenotype> > output_list;
+  tList<cAnalyzeGenotype> loaded;
+  bool id_inc = false;
+  
+  // Plain genotype files are mapped and parsed in parallel, anything needing cInitFile processing is read through it
+  cGenotypeFileReader reader(m_world, filename, m_world->GetWorkingDir());
+  bool streamed = false;
+  if (reader.IsStreamable()) {
+    if (!LoadFile_Columns(reader.GetFiletype(), reader.GetFormat(), filter, output_list)) return;
+    id_inc = reader.GetFormat().HasString("id");
+    streamed = reader.Load(m_jobqueue, output_list, &filter, loaded);
+    if (!streamed) {
+      while (output_list.GetSize()) delete output_list.Pop();
+      if (m_world->GetVerbosity() >= VERBOSE_DETAILS) cout << "  file requires full processing, rereading" << endl;
+    }
+  }
+  
+  if (!streamed) {
+    cInitFile input_file(filename, m_world->GetWorkingDir());
+    if (!input_file.WasOpened()) {
+      const cUserFeedback& feedback = input_file.GetFeedback();
+      for (int i = 0; i < feedback.GetNumMessages(); i++) {
+        switch (feedback.GetMessageType(i)) {
+          case cUserFeedback::UF_ERROR:    cerr << "error: "; break;
+          case cUserFeedback::UF_WARNING:  cerr << "warning: "; break;
+          default: break;
+        };
+        cerr << feedback.GetMessage(i) << endl;
+      }
+      if (exit_on_error) exit(1);
+    }
+    
+    if (!LoadFile_Columns(input_file.GetFiletype(), input_file.GetFormat(), filter, output_list)) return;
+    id_inc = input_file.GetFormat().HasString("id");
+    
+    // Setup the genome...
+    const cInstSet& is = m_world->GetHardwareManager().GetDefaultInstSet();
+    HashPropertyMap props;
+    cHardwareManager::SetupPropertyMap(props, (const char*)is.GetInstSetName());
+    Genome default_genome(is.GetHardwareType(), props, GeneticRepresentationPtr(new InstructionSequence(1)));
+    
+    tListIterator< tDataEntryCommand<cAnalyzeGenotype> > output_it(output_list);
+    for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
+      cString cur_line = input_file.GetLine(line_id);
+      
+      cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, default_genome);
+      
+      output_it.Reset();
+      tDataEntryCommand<cAnalyzeGenotype>* data_command = NULL;
+      while ((data_command = output_it.Next()) != NULL) {
+        data_command->SetValue(genotype, cur_line.PopWord());
+      }
+      
+      if (filter.IsActive() && !filter.Passes(genotype)) {
+        delete genotype;
+        continue;
+      }
+      
+      loaded.PushRear(genotype);
     }
-    if (exit_on_error) exit(1);
   }
   
-  const cString filetype = input_file.GetFiletype();
+  while (output_list.GetSize()) delete output_list.Pop();
+  
+  int load_count = 0;
+  cAnalyzeGenotype* genotype = NULL;
+  while ((genotype = loaded.Pop()) != NULL) {
+    // Give this genotype a name.  Base it on the ID if possible.
+    if (id_inc == false) {
+      cString name = cStringUtil::Stringf("org-%d", load_count++);
+      genotype->SetName(name);
+    }
+    else {
+      cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
+      genotype->SetName(name);
+    }
+    
+    // Add this genotype to the proper batch.
+    batch[cur_batch].List().PushRear(genotype);
+  }
+  
+  // Adjust the flags on this batch
+  batch[cur_batch].SetLineage(false);
+  batch[cur_batch].SetAligned(false);
+}
+
+bool cAnalyze::LoadFile_Columns(const cString& filetype, const cStringList& format,
+                                const cGenotypeFileReader::cFilter& filter,
+                                tList< tDataEntryCommand<cAnalyzeGenotype> >& output_list)
+{
   if (filetype != "population_data" &&  // Deprecated
       filetype != "genotype_data") {
     cerr << "error: cannot load files of type \"" << filetype << "\"." << endl;
@@ -802,10 +896,8 @@ void cAnalyze::LoadFile(cString cur_string)
   
   
   // Construct a linked list of data types that can be loaded...
-  tList< tDataEntryCommand<cAnalyzeGenotype> > output_list;
-  tListIterator< tDataEntryCommand<cAnalyzeGenotype> > output_it(output_list);
   cUserFeedback feedback;
-  cAnalyzeGenotype::GetDataCommandManager().LoadCommandList(input_file.GetFormat(), output_list, &feedback);
+  cAnalyzeGenotype::GetDataCommandManager().LoadCommandList(format, output_list, &feedback);
   
   for (int i = 0; i < feedback.GetNumMessages(); i++) {
     switch (feedback.GetMessageType(i)) {
@@ -816,45 +908,20 @@ void cAnalyze::LoadFile(cString cur_string)
     cerr << feedback.GetMessage(i) << endl;
   }  
   
-  if (feedback.GetNumErrors()) return;
-  
-  bool id_inc = input_file.GetFormat().HasString("id");
-  
-  // Setup the genome...
-  const cInstSet& is = m_world->GetHardwareManager().GetDefaultInstSet();
-  HashPropertyMap props;
-  cHardwareManager::SetupPropertyMap(props, (const char*)is.GetInstSetName());
-  Genome default_genome(is.GetHardwareType(), props, GeneticRepresentationPtr(new InstructionSequence(1)));
-  int load_count = 0;
+  // Filtering on load reads the filter stat from its own column
+  bool missing_filter_column = false;
+  if (filter.IsActive() && !format.HasString(filter.GetStatName())) {
+    cerr << "error: filter stat '" << filter.GetStatName() << "' is not one of the columns of the file" << endl;
+    if (exit_on_error) exit(1);
+    missing_filter_column = true;
+  }
   
-  for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-    cString cur_line = input_file.GetLine(line_id);
-    
-    cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, default_genome);
-    
-    output_it.Reset();
-    tDataEntryCommand<cAnalyzeGenotype>* data_command = NULL;
-    while ((data_command = output_it.Next()) != NULL) {
-      data_command->SetValue(genotype, cur_line.PopWord());
-    }
-    
-    // Give this genotype a name.  Base it on the ID if possible.
-    if (id_inc == false) {
-      cString name = cStringUtil::Stringf("org-%d", load_count++);
-      genotype->SetName(name);
-    }
-    else {
-      cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
-      genotype->SetName(name);
-    }
-    
-    // Add this genotype to the proper batch.
-    batch[cur_batch].List().PushRear(genotype);
+  if (feedback.GetNumErrors() || missing_filter_column) {
+    while (output_list.GetSize()) delete output_list.Pop();
+    return false;
   }
   
-  // Adjust the flags on this batch
-  batch[cur_batch].SetLineage(false);
-  batch[cur_batch].SetAligned(false);
+  return true;
 }
 
 
@@ -916,16 +983,40 @@ void cAnalyze::CommandFilter(cString cur_string)
   }
   
   
-  // Loop through the genotypes and remove the entries that don't match.
-  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-  cAnalyzeGenotype * cur_genotype = NULL;
-  while ((cur_genotype = batch_it.Next()) != NULL) {
-    const cFlexVar value = stat_command->GetValue(cur_genotype);
-    int compare = 1 + CompareFlexStat(value, test_value);
+  cGenotypeColumns* columns = BatchUtil_GetColumns();
+  const cGenotypeColumns::cColumn column = (columns) ? columns->FindColumn(*stat_command) : cGenotypeColumns::cColumn();
+  if (column.IsNumeric()) {
+    // Scan the column, then rebuild the list from the rows that are kept
+    const bool column_rel_ok[3] = { rel_ok[0], rel_ok[1], rel_ok[2] };
+    Apto::Array<bool> keep;
+    columns->Filter(column, column_rel_ok, test_value.AsDouble(), keep);
+    
+    tListPlus<cAnalyzeGenotype>& gen_list = batch[cur_batch].List();
+    gen_list.Clear();
+    Apto::Array<int> kept_rows;
+    for (int row = 0; row < keep.GetSize(); row++) {
+      if (keep[row]) {
+        gen_list.PushRear(columns->GetRow(row));
+        kept_rows.Push(row);
+      } else {
+        delete columns->GetRow(row);
+      }
+    }
+    columns->Select(kept_rows);
+  } else {
+    batch[cur_batch].DropColumns();
     
-    // Check if we should eliminate this genotype...
-    if (rel_ok[compare] == false) {
-      delete batch_it.Remove();
+    // Loop through the genotypes and remove the entries that don't match.
+    tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
+    cAnalyzeGenotype * cur_genotype = NULL;
+    while ((cur_genotype = batch_it.Next()) != NULL) {
+      const cFlexVar value = stat_command->GetValue(cur_genotype);
+      int compare = 1 + CompareFlexStat(value, test_value);
+      
+      // Check if we should eliminate this genotype...
+      if (rel_ok[compare] == false) {
+        delete batch_it.Remove();
+      }
     }
   }
   delete stat_command;
@@ -946,6 +1037,13 @@ void cAnalyze::FindGenotype(cString cur_string)
   }
   
   tListPlus<cAnalyzeGenotype> & gen_list = batch[cur_batch].List();
+  
+  cGenotypeColumns* columns = BatchUtil_GetColumns();
+  if (columns) {
+    FindGenotype_Columns(columns, cur_string);
+    return;
+  }
+  
   tListPlus<cAnalyzeGenotype> found_list;
   while (cur_string.CountNumWords() > 0) {
     cString gen_desc(cur_string.PopWord());
@@ -975,6 +1073,59 @@ void cAnalyze::FindGenotype(cString cur_string)
   batch[cur_batch].SetAligned(false);
 }
 
+void cAnalyze::FindGenotype_Columns(cGenotypeColumns* columns, cString cur_string)
+{
+  // Same selection as PopGenotype(), on the columns, with the rows found so far marked as taken
+  Apto::Array<bool> taken(columns->GetNumRows());
+  taken.SetAll(false);
+  int num_left = columns->GetNumRows();
+  Apto::Array<int> found_rows;
+  
+  while (cur_string.CountNumWords() > 0) {
+    cString gen_desc(cur_string.PopWord());
+    if (m_world->GetVerbosity() >= VERBOSE_ON) cout << gen_desc << " ";
+    gen_desc.ToLower();
+    
+    int found_row = -1;
+    if (gen_desc == "num_cpus" || gen_desc == "total_cpus" || gen_desc == "merit" || gen_desc == "fitness" ||
+        gen_desc == "length") {
+      found_row = columns->FindMax(columns->FindColumn(gen_desc), taken);
+    } else if (gen_desc.IsNumeric(0)) {
+      found_row = columns->FindValue(columns->FindColumn("id"), gen_desc.AsInt(), taken);
+    } else if (gen_desc == "random") {
+      int gen_pos = random.GetUInt(num_left);
+      for (int row = 0; row < taken.GetSize() && found_row < 0; row++) {
+        if (!taken[row] && gen_pos-- == 0) found_row = row;
+      }
+    } else {
+      cout << "  Error: unknown type " << gen_desc << endl;
+      if (exit_on_error) exit(1);
+    }
+    
+    if (found_row < 0) {
+      cerr << "  Warning: genotype not found!" << endl;
+      continue;
+    }
+    
+    // Save this genotype...
+    taken[found_row] = true;
+    num_left--;
+    found_rows.Push(found_row);
+  }
+  cout << endl;
+  
+  // Delete all genotypes other than the ones found, and refill the list in the order they were found
+  tListPlus<cAnalyzeGenotype>& gen_list = batch[cur_batch].List();
+  gen_list.Clear();
+  for (int row = 0; row < taken.GetSize(); row++) if (!taken[row]) delete columns->GetRow(row);
+  for (int i = 0; i < found_rows.GetSize(); i++) gen_list.PushRear(columns->GetRow(found_rows[i]));
+  columns->Select(found_rows);
+  
+  // Adjust the flags on this batch
+  batch[cur_batch].SetLineage(false);
+  batch[cur_batch].SetAligned(false);
+}
+
 void cAnalyze::FindOrganism(cString cur_string)
 {
   // At least one argument is rquired.
@@ -1882,12 +2033,12 @@ void cAnalyze::CommandDetail(cString cur_string)
   // Setup the file...
   if (filename == "cout") {
     CommandDetail_Header(cout, file_type, output_it);
-    CommandDetail_Body(cout, file_type, output_it);
+    if (!CommandDetail_Columns(cout, file_type, output_it)) CommandDetail_Body(cout, file_type, output_it);
   } else {
     Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
     ofstream& fp = df->OFStream();
     CommandDetail_Header(fp, file_type, output_it);
-    CommandDetail_Body(fp, file_type, output_it);
+    if (!CommandDetail_Columns(fp, file_type, output_it)) CommandDetail_Body(fp, file_type, output_it);
 	}
   
   // And clean up...
@@ -2061,6 +2212,30 @@ void cAnalyze::CommandDetail_Body(ostream& fp, int format_type,
   }
   }
 
+bool cAnalyze::CommandDetail_Columns(ostream& fp, int format_type,
+                                     tListIterator< tDataEntryCommand<cAnalyzeGenotype> > & output_it)
+{
+  // Only plain text rows, without the per genotype messages, are written from the columns
+  if (format_type != FILE_TYPE_TEXT || m_world->GetVerbosity() >= VERBOSE_DETAILS) return false;
+  
+  cGenotypeColumns* columns = BatchUtil_GetColumns();
+  if (columns == NULL) return false;
+  
+  // Every stat must have a column, otherwise the whole batch goes through CommandDetail_Body()
+  Apto::Array<cGenotypeColumns::cColumn> cols;
+  output_it.Reset();
+  tDataEntryCommand<cAnalyzeGenotype> * data_command = NULL;
+  while ((data_command = output_it.Next()) != NULL) {
+    const cGenotypeColumns::cColumn col = columns->FindColumn(*data_command);
+    if (!col.IsValid()) return false;
+    cols.Push(col);
+  }
+  if (cols.GetSize() == 0) return false;
+  
+  columns->WriteRows(fp, cols);
+  return true;
+}
+
 void cAnalyze::CommandDetailAverage_Body(ostream& fp, int nucoutputs,
                                          tListIterator< tDataEntryCommand<cAnalyzeGenotype> > & output_it)
 {
@@ -2421,6 +2596,7 @@ void cAnalyze::CommandHistogram_Body(ostream& fp, int format_type,
   output_it.Reset();
   tDataEntryCommand<cAnalyzeGenotype> * data_command = NULL;
   cAnalyzeGenotype* first_genotype = batch[cur_batch].List().GetFirst();
+  cGenotypeColumns* columns = BatchUtil_GetColumns();
   
   while ((data_command = output_it.Next()) != NULL) {
     if (format_type == FILE_TYPE_TEXT) {
@@ -2433,15 +2609,26 @@ void cAnalyze::CommandHistogram_Body(ostream& fp, int format_type,
     
     Apto::Map<Apto::String, int> count_dict;
     
-    // Loop through all genotypes in this batch to collect the info we need.
-    tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-    cAnalyzeGenotype * cur_genotype;
-    while ((cur_genotype = batch_it.Next()) != NULL) {
-      const Apto::String cur_name((const char*)data_command->GetValue(cur_genotype).AsString());
-      int count = 0;
-      count_dict.Get(cur_name, count);
-      count += cur_genotype->GetNumCPUs();
-      count_dict.Set(cur_name, count);
+    const cGenotypeColumns::cColumn column = (columns) ? columns->FindColumn(*data_command) : cGenotypeColumns::cColumn();
+    if (column.type == cGenotypeColumns::cColumn::INT) {
+      // Integer stats are counted on the column, named as cFlexVar::AsString() would print them
+      Apto::Array<int> values;
+      Apto::Array<int> counts;
+      columns->CountValues(column, values, counts);
+      for (int i = 0; i < values.GetSize(); i++) {
+        count_dict.Set(Apto::String((const char*)cStringUtil::Stringf("%d", values[i])), counts[i]);
+      }
+    } else {
+      // Loop through all genotypes in this batch to collect the info we need.
+      tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
+      cAnalyzeGenotype * cur_genotype;
+      while ((cur_genotype = batch_it.Next()) != NULL) {
+        const Apto::String cur_name((const char*)data_command->GetValue(cur_genotype).AsString());
+        int count = 0;
+        count_dict.Get(cur_name, count);
+        count += cur_genotype->GetNumCPUs();
+        count_dict.Set(cur_name, count);
+      }
     }
         
     // Figure out the maximum count and the maximum widths...
@@ -2680,29 +2867,42 @@ void cAnalyze::CommandPrintDiversity(cString cur_string)
   const int max_length = BatchUtil_GetMaxLength();
   tMatrix<int> inst_freq(max_length, num_insts+1);
   
+  // With columns, the frequencies of all tasks are collected up front, one task per job
+  cGenotypeColumns* columns = BatchUtil_GetColumns();
+  if (columns && columns->GetNumTasks() < num_tasks) columns = NULL;
+  Apto::Array<Apto::Array<int, Apto::Smart> > task_freqs;
+  if (columns) columns->CountTaskSites(num_insts, max_length, task_freqs, task_count, task_gen_count);
+  
   for (int task_id = 0; task_id < num_tasks; task_id++) {
-    inst_freq.SetAll(0);
+    if (columns) {
+      const Apto::Array<int, Apto::Smart>& freq = task_freqs[task_id];
+      for (int pos = 0; pos < max_length; pos++) {
+        for (int inst = 0; inst <= num_insts; inst++) inst_freq(pos, inst) = freq[pos * (num_insts + 1) + inst];
+      }
+    } else {
+      inst_freq.SetAll(0);
     
-    // Loop through all genotypes, singling out those that do current task...
-    tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
-    cAnalyzeGenotype* genotype = NULL;
-    while ((genotype = batch_it.Next()) != NULL) {
-      if (m_world->GetHardwareManager().GetInstSet(genotype->GetGenome().Properties().Get("instset").StringValue()).GetInstSetName() != is.GetInstSetName() || genotype->GetTaskCount(task_id) == 0) continue;
+      // Loop through all genotypes, singling out those that do current task...
+      tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
+      cAnalyzeGenotype* genotype = NULL;
+      while ((genotype = batch_it.Next()) != NULL) {
+        if (m_world->GetHardwareManager().GetInstSet(genotype->GetGenome().Properties().Get("instset").StringValue()).GetInstSetName() != is.GetInstSetName() || genotype->GetTaskCount(task_id) == 0) continue;
       
-      const Genome& genome_p = genotype->GetGenome();
-      ConstInstructionSequencePtr seq_p;
-      ConstGeneticRepresentationPtr rep_p = genome_p.Representation();
-      seq_p.DynamicCastFrom(rep_p);
-      const InstructionSequence& genome = *seq_p;
+        const Genome& genome_p = genotype->GetGenome();
+        ConstInstructionSequencePtr seq_p;
+        ConstGeneticRepresentationPtr rep_p = genome_p.Representation();
+        seq_p.DynamicCastFrom(rep_p);
+        const InstructionSequence& genome = *seq_p;
       
-      const int num_cpus = genotype->GetNumCPUs();
-      task_count[task_id] += num_cpus;
-      task_gen_count[task_id]++;
-      for (int i = 0; i < genotype->GetLength(); i++) {
-        inst_freq( i, genome[i].GetOp() ) += num_cpus;
-      }
-      for (int i = genotype->GetLength(); i < max_length; i++) {
-        inst_freq(i, num_insts) += num_cpus; // Entry for "past genome end"
+        const int num_cpus = genotype->GetNumCPUs();
+        task_count[task_id] += num_cpus;
+        task_gen_count[task_id]++;
+        for (int i = 0; i < genotype->GetLength(); i++) {
+          inst_freq( i, genome[i].GetOp() ) += num_cpus;
+        }
+        for (int i = genotype->GetLength(); i < max_length; i++) {
+          inst_freq(i, num_insts) += num_cpus; // Entry for "past genome end"
+        }
       }
     }
     
@@ -3196,6 +3396,59 @@ void cAnalyze::PhyloCommunityComplexity(cString cur_string)
 }
 
 
+// Accumulates genetic distances between genotypes weighted by the number of organism pairs they represent.  Totals
+// are kept per row so that rows can be reduced concurrently by cAnalyzeDistanceScan.
+class cAnalyzeDistanceSums : public cAnalyzeDistanceScan::cRowReducer
+{
+private:
+  const Apto::Array<cAnalyzeGenotype*>& m_row_genotypes;
+  const Apto::Array<cAnalyzeGenotype*>& m_col_genotypes;
+  int m_threshold;
+  
+  Apto::Array<double> m_total_dist;
+  Apto::Array<double> m_total_pairs;
+  Apto::Array<double> m_threshold_pairs;
+  Apto::Array<int> m_max_dist;
+  
+public:
+  cAnalyzeDistanceSums(const Apto::Array<cAnalyzeGenotype*>& rows, const Apto::Array<cAnalyzeGenotype*>& cols,
+                       int threshold = 0)
+    : m_row_genotypes(rows), m_col_genotypes(cols), m_threshold(threshold)
+    , m_total_dist(rows.GetSize()), m_total_pairs(rows.GetSize()), m_threshold_pairs(rows.GetSize())
+    , m_max_dist(rows.GetSize())
+  {
+    m_total_dist.SetAll(0.0);
+    m_total_pairs.SetAll(0.0);
+    m_threshold_pairs.SetAll(0.0);
+    m_max_dist.SetAll(0);
+  }
+  
+  void ReduceRow(int row, int first_col, const Apto::Array<int>& distances)
+  {
+    cAnalyzeGenotype* genotype1 = m_row_genotypes[row];
+    const int count1 = genotype1->GetNumCPUs();
+    for (int i = 0; i < distances.GetSize(); i++) {
+      cAnalyzeGenotype* genotype2 = m_col_genotypes[first_col + i];
+      const int count2 = genotype2->GetNumCPUs();
+      const int dist = distances[i];
+      if (dist > m_max_dist[row]) m_max_dist[row] = dist;
+      
+      // Organisms are never paired with themselves
+      const int num_pairs = (genotype1 == genotype2) ? ((count1 - 1) * (count2 - 1)) : (count1 * count2);
+      if (num_pairs == 0) continue;
+      m_total_dist[row] += static_cast<double>(dist) * num_pairs;
+      m_total_pairs[row] += num_pairs;
+      if (dist >= m_threshold) m_threshold_pairs[row] += num_pairs;
+    }
+  }
+  
+  double GetTotalDistance() const { double total = 0.0; for (int i = 0; i < m_total_dist.GetSize(); i++) total += m_total_dist[i]; return total; }
+  double GetTotalPairs() const { double total = 0.0; for (int i = 0; i < m_total_pairs.GetSize(); i++) total += m_total_pairs[i]; return total; }
+  double GetThresholdPairs() const { double total = 0.0; for (int i = 0; i < m_threshold_pairs.GetSize(); i++) total += m_threshold_pairs[i]; return total; }
+  int GetMaxDistance() const { int max = 0; for (int i = 0; i < m_max_dist.GetSize(); i++) if (m_max_dist[i] > max) max = m_max_dist[i]; return max; }
+};
+
+
 // Calculate Edit Distance stats for all pairs of organisms across the population.
 void cAnalyze::CommandPrintDistances(cString cur_string)
 {
@@ -3221,63 +3474,32 @@ void cAnalyze::CommandPrintDistances(cString cur_string)
   fout << "# 5: Frac distances above threshold (" << dist_threshold << ")" << endl;
   fout << endl;
   
-  // Loop through all pairs of organisms.
-  int dist_total = 0;
-  int dist_max = 0;
-  int pair_count = 0;
-  int threshold_pair_count = 0;
-	double count = 0;
-	
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-  tListIterator<cAnalyzeGenotype> batch_it1(batch[cur_batch].List());
-
-  int watermark = 0;
+  // Gather all of the genotypes, pairing each with itself for a distance of 0.
+  Apto::Array<cAnalyzeGenotype*> genotypes;
+  cAnalyzeDistanceScan scan(cAnalyzeDistanceScan::EDIT_DISTANCE);
+  int self_pairs = 0;
   
-  while ((genotype1 = batch_it1.Next()) != NULL) {
-		count ++;
-    const int gen1_count = genotype1->GetNumCPUs();
-
-    // Pair this genotype with itself for a distance of 0.
-    pair_count += gen1_count * (gen1_count - 1) / 2;
-
-    // Loop through the other genotypes this one can be paired with.
-    tListIterator<cAnalyzeGenotype> batch_it2(batch_it1);
-    while ((genotype2 = batch_it2.Next()) != NULL) {
-      const int gen2_count = genotype2->GetNumCPUs();
-      const int cur_pairs = gen1_count * gen2_count;
-      
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int cur_dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
-      dist_total += cur_pairs * cur_dist;
-      if (cur_dist > dist_max) dist_max = cur_dist;
-      pair_count += cur_pairs;
-      if (cur_dist >= dist_threshold) threshold_pair_count += cur_pairs;
-
-      if (pair_count > watermark) {
-	cout << watermark << endl;
-	watermark += 100000;
-      }
-    }
+  cAnalyzeGenotype* genotype = NULL;
+  tListIterator<cAnalyzeGenotype> batch_it(batch[cur_batch].List());
+  while ((genotype = batch_it.Next()) != NULL) {
+    const int gen_count = genotype->GetNumCPUs();
+    self_pairs += gen_count * (gen_count - 1) / 2;
+    genotypes.Push(genotype);
+    scan.AddRow(genotype->GetGenome());
   }
   
-	count = (count * (count-1) ) /2;
+  // Loop through all pairs of genotypes in parallel.
+  cAnalyzeDistanceSums sums(genotypes, genotypes, dist_threshold);
+  scan.RunUpperTriangle(m_jobqueue, sums);
+  
+  const double dist_total = sums.GetTotalDistance();
+  const int pair_count = static_cast<int>(sums.GetTotalPairs()) + self_pairs;
+	const double count = (genotypes.GetSize() * (genotypes.GetSize() - 1.0)) / 2;
   fout << pair_count << " "
-	     << ((double) dist_total) / count << " " 
-       << ((double) dist_total) / (double) pair_count << " "
-       << dist_max << " "
-       << ((double) threshold_pair_count) / (double) pair_count << " "
+	     << dist_total / count << " " 
+       << dist_total / (double) pair_count << " "
+       << sums.GetMaxDistance() << " "
+       << sums.GetThresholdPairs() / (double) pair_count << " "
        << endl;
 }
 
@@ -7328,45 +7550,27 @@ void cAnalyze::CommandHamming(cString cur_string)
     cout.flush();
   }
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-
-  double total_dist = 0;
-  double total_count = 0;
+  // Compare all of the genotypes in each batch in parallel...
+  Apto::Array<cAnalyzeGenotype*> genotypes1;
+  Apto::Array<cAnalyzeGenotype*> genotypes2;
+  cAnalyzeDistanceScan scan(cAnalyzeDistanceScan::HAMMING_DISTANCE);
   
+  cAnalyzeGenotype* genotype = NULL;
   tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
+  while ((genotype = list1_it.Next()) != NULL) {
+    genotypes1.Push(genotype);
+    scan.AddRow(genotype->GetGenome());
+  }
   tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      const int num_pairs = (genotype1 == genotype2) ?
-        ((count1 - 1) * (count2 - 1)) : (count1 * count2);
-      if (num_pairs == 0) continue;
-      
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-      
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindHammingDistance(genotype1_seq, genotype2_seq);
-      total_dist += dist * num_pairs;
-      total_count += num_pairs;
-    }
+  while ((genotype = list2_it.Next()) != NULL) {
+    genotypes2.Push(genotype);
+    scan.AddColumn(genotype->GetGenome());
   }
   
+  cAnalyzeDistanceSums sums(genotypes1, genotypes2);
+  scan.Run(m_jobqueue, sums);
+  const double total_dist = sums.GetTotalDistance();
+  const double total_count = sums.GetTotalPairs();
   
   // Calculate the final answer
   double ave_dist = (double) total_dist / (double) total_count;
@@ -7406,45 +7610,28 @@ void cAnalyze::CommandLevenstein(cString cur_string)
     cout.flush();
   }
   
-  // Setup some variables;
-  cAnalyzeGenotype * genotype1 = NULL;
-  cAnalyzeGenotype * genotype2 = NULL;
-  double total_dist = 0;
-  double total_count = 0;
+  // Compare all of the genotypes in each batch in parallel...
+  Apto::Array<cAnalyzeGenotype*> genotypes1;
+  Apto::Array<cAnalyzeGenotype*> genotypes2;
+  cAnalyzeDistanceScan scan(cAnalyzeDistanceScan::EDIT_DISTANCE);
   
+  cAnalyzeGenotype* genotype = NULL;
   tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
+  while ((genotype = list1_it.Next()) != NULL) {
+    genotypes1.Push(genotype);
+    scan.AddRow(genotype->GetGenome());
+  }
   tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
-  
-  // Loop through all of the genotypes in each batch...
-  while ((genotype1 = list1_it.Next()) != NULL) {
-    list2_it.Reset();
-    while ((genotype2 = list2_it.Next()) != NULL) {
-      // Determine the counts...
-      const int count1 = genotype1->GetNumCPUs();
-      const int count2 = genotype2->GetNumCPUs();
-      const int num_pairs = (genotype1 == genotype2) ?
-        ((count1 - 1) * (count2 - 1)) : (count1 * count2);
-      if (num_pairs == 0) continue;
-      
-      // And do the tests...
-      const Genome& genotype1_genome = genotype1->GetGenome();
-      ConstInstructionSequencePtr genotype1_seq_p;
-      ConstGeneticRepresentationPtr genotype1_rep_p = genotype1_genome.Representation();
-      genotype1_seq_p.DynamicCastFrom(genotype1_rep_p);
-      const InstructionSequence& genotype1_seq = *genotype1_seq_p;
-
-      const Genome& genotype2_genome = genotype2->GetGenome();
-      ConstInstructionSequencePtr genotype2_seq_p;
-      ConstGeneticRepresentationPtr genotype2_rep_p = genotype2_genome.Representation();
-      genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
-      const InstructionSequence& genotype2_seq = *genotype2_seq_p;
-
-      const int dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
-      total_dist += dist * num_pairs;
-      total_count += num_pairs;
-    }
+  while ((genotype = list2_it.Next()) != NULL) {
+    genotypes2.Push(genotype);
+    scan.AddColumn(genotype->GetGenome());
   }
   
+  cAnalyzeDistanceSums sums(genotypes1, genotypes2);
+  scan.Run(m_jobqueue, sums);
+  const double total_dist = sums.GetTotalDistance();
+  const double total_count = sums.GetTotalPairs();
+  
   // Calculate the final answer
   double ave_dist = (double) total_dist / (double) total_count;
   cout << " ave distance = " << ave_dist << endl;
@@ -10786,6 +10973,40 @@ int cAnalyze::BatchUtil_GetMaxLength(int batch_id)
   return max_length;
 }
 
+cGenotypeColumns* cAnalyze::BatchUtil_GetColumns(int batch_id)
+{
+  if (!m_world->GetConfig().COLUMNAR_BATCHES.Get()) return NULL;
+  if (batch_id < 0) batch_id = cur_batch;
+  
+  // A row count that no longer matches means the list was changed without the columns being dropped
+  cGenotypeColumns* columns = batch[batch_id].GetColumns();
+  if (columns && columns->GetNumRows() == batch[batch_id].GetSize()) return columns;
+  
+  columns = new cGenotypeColumns(m_world, m_jobqueue, batch[batch_id].List());
+  batch[batch_id].SetColumns(columns);
+  m_columnar_batches.Push(batch_id);
+  
+  return columns;
+}
+
+void cAnalyze::BatchUtil_DropColumns()
+{
+  for (int i = 0; i < m_columnar_batches.GetSize(); i++) {
+    if (m_columnar_batches[i] < batch.GetSize()) batch[m_columnar_batches[i]].DropColumns();
+  }
+  m_columnar_batches.Resize(0);
+}
+
+bool cAnalyze::BatchUtil_KeepsColumns(const cString& command) const
+{
+  // Commands that either leave the batches alone or keep their columns up to date, every other command may change
+  // genotypes in ways the columns cannot see
+  cString name(command);
+  name.ToUpper();
+  return (name == "FILTER" || name == "FIND_GENOTYPE" || name == "HISTOGRAM" || name == "DETAIL" ||
+          name == "PRINT_DIVERSITY");
+}
+
 
 void cAnalyze::CommandForeach(cString cur_string,
                               tList<cAnalyzeCommand> & clist)
@@ -11052,6 +11273,7 @@ void cAnalyze::ProcessCommands(tList<cAnalyzeCommand>& clist)
     PreProcessArgs(args);
     
     cAnalyzeCommandDefBase* command_fun = FindAnalyzeCommandDef(command);
+    if (!BatchUtil_KeepsColumns(command)) BatchUtil_DropColumns();
     
     cUserFeedback feedback;
     if (command_fun != NULL) {
@@ -11389,6 +11611,7 @@ void cAnalyze::RunInteractive()
     PreProcessArgs(args);
     
     cAnalyzeCommandDefBase* command_fun = FindAnalyzeCommandDef(command);
+    if (!BatchUtil_KeepsColumns(command)) BatchUtil_DropColumns();
     
     if (command_fun != NULL) {                                // First check for built-in functions...
       cUserFeedback feedback;
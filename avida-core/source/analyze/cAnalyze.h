@@ -32,6 +32,7 @@
 #include "cAvidaContext.h"
 #include "cBitArray.h"
 #include "cGenotypeBatch.h"
+#include "cGenotypeFileReader.h"
 #include "cFlexVar.h"
 #include "cString.h"
 #include "cStringList.h"
@@ -51,6 +52,7 @@ class cAnalyzeGenotype;
 class cAnalyzeScreen;
 class cCPUTestInfo;
 class cEnvironment;
+class cGenotypeColumns;
 class cInitFile;
 class cInstSet;
 class cResourceHistory;
@@ -82,6 +84,7 @@ private:
   int GetTempNextID(){ return temporary_next_id; }
 
   Apto::Array<cGenotypeBatch> batch;
+  Apto::Array<int> m_columnar_batches;  // batches that may hold a column copy
   tList<cAnalyzeCommand> command_list;
   tList<cAnalyzeFunction> function_list;
   tList<cAnalyzeCommandDefBase> command_lib;
@@ -186,6 +189,9 @@ private:
   
   // Batch management...
   int BatchUtil_GetMaxLength(int batch_id = -1);
+  cGenotypeColumns* BatchUtil_GetColumns(int batch_id = -1);
+  void BatchUtil_DropColumns();
+  bool BatchUtil_KeepsColumns(const cString& command) const;
   
   // Command helpers...
   void CommandDetail_Header(std::ostream& fp, int format_type,
@@ -193,6 +199,8 @@ private:
   void CommandDetail_Body(std::ostream& fp, int format_type,
                           tListIterator< tDataEntryCommand<cAnalyzeGenotype> > & output_it,
                           int time_step = -1, int max_time = 1);
+  bool CommandDetail_Columns(std::ostream& fp, int format_type,
+                             tListIterator< tDataEntryCommand<cAnalyzeGenotype> > & output_it);
   void CommandDetailAverage_Body(std::ostream& fp, int num_arguments,
                                  tListIterator< tDataEntryCommand<cAnalyzeGenotype> >& output_it);
   void CommandHistogram_Header(std::ostream& fp, int format_type,
@@ -208,12 +216,15 @@ private:
   // from a file specified by the user, or resource.dat by default.
   void LoadResources(cString cur_string);
   void LoadFile(cString cur_string);
+  bool LoadFile_Columns(const cString& filetype, const cStringList& format, const cGenotypeFileReader::cFilter& filter,
+                        tList< tDataEntryCommand<cAnalyzeGenotype> >& output_list);
   genotype_vector LoadDetailFileAsVector(cString cur_string); 
   //Loads all sequences from a detail file into a vector
   
   // Reduction and Sampling
   void CommandFilter(cString cur_string);
   void FindGenotype(cString cur_string);
+  void FindGenotype_Columns(cGenotypeColumns* columns, cString cur_string);
   void FindOrganism(cString cur_string);
   void FindLineage(cString cur_string);
   void FindSexLineage(cString cur_string);
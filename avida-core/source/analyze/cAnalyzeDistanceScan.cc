@@ -0,0 +1,86 @@
+/*
+ *  cAnalyzeDistanceScan.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cAnalyzeDistanceScan.h"
+
+#include "cAnalyzeJobQueue.h"
+#include "cAvidaContext.h"
+#include "tAnalyzeParallelFor.h"
+
+using namespace Avida;
+
+
+void cAnalyzeDistanceScan::AddRow(const Genome& genome)
+{
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+  m_row_seqs.Push(seq);
+  m_rows.Push(&(*seq));
+}
+
+
+void cAnalyzeDistanceScan::AddColumn(const Genome& genome)
+{
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+  m_col_seqs.Push(seq);
+  m_cols.Push(&(*seq));
+}
+
+
+void cAnalyzeDistanceScan::Run(cAnalyzeJobQueue& queue, cRowReducer& reducer)
+{
+  m_upper_triangle = false;
+  m_reducer = &reducer;
+  
+  tAnalyzeParallelFor<cAnalyzeDistanceScan> loop(queue);
+  loop.Run(this, &cAnalyzeDistanceScan::scanRow, m_rows.GetSize());
+  
+  m_reducer = NULL;
+}
+
+
+void cAnalyzeDistanceScan::RunUpperTriangle(cAnalyzeJobQueue& queue, cRowReducer& reducer)
+{
+  m_upper_triangle = true;
+  m_reducer = &reducer;
+  
+  // The last row has nothing after it to be compared against
+  tAnalyzeParallelFor<cAnalyzeDistanceScan> loop(queue);
+  loop.Run(this, &cAnalyzeDistanceScan::scanRow, m_rows.GetSize() - 1);
+  
+  m_reducer = NULL;
+}
+
+
+void cAnalyzeDistanceScan::scanRow(cAvidaContext&, int row)
+{
+  const Apto::Array<const InstructionSequence*>& all_cols = (m_upper_triangle) ? m_rows : m_cols;
+  const int first_col = (m_upper_triangle) ? row + 1 : 0;
+  
+  Apto::Array<const InstructionSequence*> cols(all_cols.GetSize() - first_col);
+  for (int i = 0; i < cols.GetSize(); i++) cols[i] = all_cols[first_col + i];
+  
+  Apto::Array<int> distances;
+  if (m_metric == EDIT_DISTANCE) InstructionSequence::FindEditDistances(*m_rows[row], cols, distances);
+  else InstructionSequence::FindHammingDistances(*m_rows[row], cols, distances);
+  
+  m_reducer->ReduceRow(row, first_col, distances);
+}
@@ -0,0 +1,86 @@
+/*
+ *  cAnalyzeDistanceScan.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cAnalyzeDistanceScan_h
+#define cAnalyzeDistanceScan_h
+
+#include "apto/core.h"
+#include "avida/core/Genome.h"
+#include "avida/core/InstructionSequence.h"
+
+class cAnalyzeJobQueue;
+class cAvidaContext;
+
+
+/**
+ * Many-vs-many genetic distance calculation on the analyze job queue.  Each row sequence is compared against all of
+ * the column sequences (or, for an upper triangle scan, against every row after it) by one job, which hands the row's
+ * distances to a reducer.  Rows are never held as a full matrix, so all-pairs scans of large batches stay O(n) in
+ * memory.
+ **/
+
+class cAnalyzeDistanceScan
+{
+public:
+  enum eMetric { HAMMING_DISTANCE, EDIT_DISTANCE };
+  
+  // Receives the distances from one row to the columns starting at first_col.  Rows are reduced concurrently, so
+  // implementations may only modify state belonging to the given row.
+  class cRowReducer
+  {
+  public:
+    virtual ~cRowReducer() { ; }
+    virtual void ReduceRow(int row, int first_col, const Apto::Array<int>& distances) = 0;
+  };
+  
+private:
+  eMetric m_metric;
+  Apto::Array<Avida::ConstInstructionSequencePtr> m_row_seqs;
+  Apto::Array<Avida::ConstInstructionSequencePtr> m_col_seqs;
+  Apto::Array<const Avida::InstructionSequence*> m_rows;
+  Apto::Array<const Avida::InstructionSequence*> m_cols;
+  bool m_upper_triangle;
+  cRowReducer* m_reducer;
+  
+  
+  cAnalyzeDistanceScan(); // @not_implemented
+  cAnalyzeDistanceScan(const cAnalyzeDistanceScan&); // @not_implemented
+  cAnalyzeDistanceScan& operator=(const cAnalyzeDistanceScan&); // @not_implemented
+  
+public:
+  cAnalyzeDistanceScan(eMetric metric) : m_metric(metric), m_upper_triangle(false), m_reducer(NULL) { ; }
+  
+  void AddRow(const Avida::Genome& genome);
+  void AddColumn(const Avida::Genome& genome);
+  
+  int GetNumRows() const { return m_rows.GetSize(); }
+  int GetNumColumns() const { return m_cols.GetSize(); }
+  
+  // Compare every row against every column
+  void Run(cAnalyzeJobQueue& queue, cRowReducer& reducer);
+  
+  // Compare every row against the rows that follow it, columns are ignored
+  void RunUpperTriangle(cAnalyzeJobQueue& queue, cRowReducer& reducer);
+  
+private:
+  void scanRow(cAvidaContext& ctx, int row);
+};
+
+#endif
@@ -22,20 +22,36 @@
 #ifndef cAnalyzeJob_h
 #define cAnalyzeJob_h
 
+class cAnalyzeJobQueue;
+class cAnalyzeJobWorker;
 class cAvidaContext;
 
 class cAnalyzeJob
 {
+  friend class cAnalyzeJobQueue;
+  friend class cAnalyzeJobWorker;
+  
 private:
   int m_id;
+  int m_seed;
+  int m_num_children;
+  cAnalyzeJobQueue* m_queue;
+  cAnalyzeJobWorker* m_worker;  // worker currently executing this job, NULL when run inline
   
 public:
-  cAnalyzeJob() : m_id(0) { ; }
+  cAnalyzeJob() : m_id(0), m_seed(0), m_num_children(0), m_queue(NULL), m_worker(NULL) { ; }
   virtual ~cAnalyzeJob() { ; }
   
   void SetID(int newid) { m_id = newid; }
   int GetID() { return m_id; }
   
+  // Random seed assigned when the job was queued, jobs are always executed with a context seeded from it
+  int GetSeed() const { return m_seed; }
+  
+  // Queue a child job from within Run().  Children are pushed onto the executing worker's own deque, where idle
+  // workers may steal them.  The child's seed is derived from this job's seed and the order of the spawn calls.
+  void SpawnJob(cAnalyzeJob* child);
+  
   virtual void Run(cAvidaContext& ctx) = 0;
 };
 
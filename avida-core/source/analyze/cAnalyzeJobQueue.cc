@@ -27,6 +27,7 @@
 #include "avida/core/WorldDriver.h"
 
 #include "cAnalyzeJobWorker.h"
+#include "cCheckpoint.h"
 #include "cWorld.h"
 
 
@@ -38,18 +39,18 @@ using namespace Avida;
 
 
 cAnalyzeJobQueue::cAnalyzeJobQueue(cWorld* world)
-: m_world(world), m_last_jobid(0), m_jobs(0), m_pending(0), m_workers(Apto::Platform::AvailableCPUs())
+: m_world(world), m_last_jobid(0), m_outstanding(0), m_idle(0), m_epoch(0), m_next_worker(0), m_terminate(false)
+, m_workers(Apto::Platform::AvailableCPUs())
 {
   const int max_workers = world->GetConfig().MAX_CONCURRENCY.Get();
   if (max_workers > 0 && max_workers < m_workers.GetSize()) m_workers.Resize(max_workers);
   
-  m_job_seed_rng = new Apto::RNG::AvidaRNG(world->GetRandom().GetInt(world->GetRandom().MaxSeed()));
+  m_job_seed_rng = new cReplayRandom(world->GetRandom().GetInt(world->GetRandom().MaxSeed()));
   
   if (m_workers.GetSize() > 1) {
-    for (int i = 0; i < m_workers.GetSize(); i++) {
-      m_workers[i] = new cAnalyzeJobWorker(this);
-      m_workers[i]->Start();
-    }
+    // All deques must exist before any worker starts looking for jobs to steal
+    for (int i = 0; i < m_workers.GetSize(); i++) m_workers[i] = new cAnalyzeJobWorker(this, i);
+    for (int i = 0; i < m_workers.GetSize(); i++) m_workers[i]->Start();
   } else {
     m_workers.Resize(0);
   }
@@ -62,15 +63,17 @@ cAnalyzeJobQueue::~cAnalyzeJobQueue()
   m_mutex.Lock();
   
   // Clean out any waiting jobs
-  cAnalyzeJob* job;
-  while ((job = m_queue.Pop())) delete job;
+  for (int i = 0; i < num_workers; i++) {
+    Apto::MutexAutoLock lock(m_workers[i]->m_deque_mutex);
+    cAnalyzeJob* job;
+    while ((job = m_workers[i]->m_deque.Pop())) delete job;
+  }
   
-  // Set job count so that all workers receive NULL jobs
-  m_jobs = num_workers;
+  m_terminate = true;
   
   m_mutex.Unlock();
   
-  // Signal all workers to check job queue
+  // Signal all workers to check for termination
   m_cond.Broadcast();
   
   for (int i = 0; i < num_workers; i++) {
@@ -81,28 +84,115 @@ cAnalyzeJobQueue::~cAnalyzeJobQueue()
   delete m_job_seed_rng;
 }
 
-inline void cAnalyzeJobQueue::queueJob(cAnalyzeJob* job)
+
+void cAnalyzeJobQueue::Checkpoint(cCheckpoint& ckpt)
 {
-  if (m_workers.GetSize()) m_queue.PushRear(job);
-  else singleThreadedJobExecution(job);
+  m_mutex.Lock();
+  if (!ckpt.IsLoading()) m_job_seed_rng->Rebase();
+  int seed = m_job_seed_rng->Seed();
+  long long draws = m_job_seed_rng->GetDraws();
+  ckpt.BeginSection("AJOB");
+  ckpt.Transfer(m_last_jobid);
+  ckpt.Transfer(seed);
+  ckpt.Transfer(draws);
+  if (ckpt.IsOK() && ckpt.IsLoading()) {
+    if (draws < 0) ckpt.Fail("invalid job seed state");
+    else m_job_seed_rng->Restore(seed, draws);
+  }
+  ckpt.EndSection();
+  m_mutex.Unlock();
 }
 
-void cAnalyzeJobQueue::AddJob(cAnalyzeJob* job)
+
+void cAnalyzeJobQueue::queueJob(cAnalyzeJob* job, bool signal)
 {
-  Apto::MutexAutoLock lock(m_mutex);
+  m_mutex.Lock();
   job->SetID(m_last_jobid++);
-  queueJob(job);
-  m_jobs++;
+  job->m_seed = m_job_seed_rng->GetInt(m_job_seed_rng->MaxSeed());
+  job->m_queue = this;
+  
+  if (!m_workers.GetSize()) {
+    m_mutex.Unlock();
+    singleThreadedJobExecution(job);
+    return;
+  }
+  
+  // Pushed while holding m_mutex, so that a worker rescanning the deques under the lock in waitForJob cannot miss it
+  m_outstanding++;
+  m_workers[m_next_worker]->pushJob(job);
+  m_next_worker = (m_next_worker + 1) % m_workers.GetSize();
+  m_epoch++;
+  m_mutex.Unlock(); // should unlock prior to signaling condition variable
+  
+  if (signal) m_cond.Signal();
 }
 
-void cAnalyzeJobQueue::AddJobImmediate(cAnalyzeJob* job)
+void cAnalyzeJobQueue::queueChildJob(cAnalyzeJob* parent, cAnalyzeJob* child)
 {
+  // Spawn order within a single job is sequential, so the derived seed is independent of scheduling
+  child->SetID(parent->GetID());
+  child->m_seed = DeriveSeed(parent->m_seed, parent->m_num_children++);
+  child->m_queue = this;
+  
+  if (!parent->m_worker) {
+    singleThreadedJobExecution(child);
+    return;
+  }
+  
+  // The child must be counted before the parent can be reported complete, otherwise Execute() could return early
   m_mutex.Lock();
-  job->SetID(m_last_jobid++);
-  queueJob(job);
-  m_jobs++;
-  m_mutex.Unlock(); // should unlock prior to signaling condition variable
-  m_cond.Signal();
+  m_outstanding++;
+  m_mutex.Unlock();
+  
+  parent->m_worker->pushJob(child);
+  
+  // The parent's worker will get to the child itself if nobody else does, so a stale read of m_idle only costs
+  // parallelism, never progress
+  if (m_idle) {
+    m_mutex.Lock();
+    m_epoch++;
+    m_mutex.Unlock();
+    m_cond.Signal();
+  }
+}
+
+
+cAnalyzeJob* cAnalyzeJobQueue::stealJob(cAnalyzeJobWorker* thief)
+{
+  const int num_workers = m_workers.GetSize();
+  for (int i = 1; i < num_workers; i++) {
+    cAnalyzeJobWorker* victim = m_workers[(thief->m_id + i) % num_workers];
+    Apto::MutexAutoLock lock(victim->m_deque_mutex);
+    cAnalyzeJob* job = victim->m_deque.Pop();
+    if (job) return job;
+  }
+  return NULL;
+}
+
+cAnalyzeJob* cAnalyzeJobQueue::waitForJob(cAnalyzeJobWorker* worker)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  
+  while (true) {
+    // Report jobs completed since the worker last went idle
+    if (worker->m_completed) {
+      m_outstanding -= worker->m_completed;
+      worker->m_completed = 0;
+      if (!m_outstanding) m_term_cond.Broadcast();
+    }
+    
+    if (m_terminate) return NULL;
+    
+    // Rescan while holding m_mutex, jobs added via queueJob are pushed under this lock
+    cAnalyzeJob* job = worker->popJob();
+    if (!job) job = stealJob(worker);
+    if (job) return job;
+    
+    const int epoch = m_epoch;
+    m_idle++;
+    while (epoch == m_epoch && !m_terminate) m_cond.Wait(m_mutex);
+    m_idle--;
+  }
 }
 
 
@@ -124,7 +214,7 @@ void cAnalyzeJobQueue::Execute()
   
   // Wait for term signal
   m_mutex.Lock();
-  while (m_jobs > 0 || m_pending > 0) {
+  while (m_outstanding > 0) {
     m_term_cond.Wait(m_mutex);
   }
   m_mutex.Unlock();
@@ -133,11 +223,30 @@ void cAnalyzeJobQueue::Execute()
     m_world->GetDriver().Feedback().Notify("job queue complete");
 }
 
+
+int cAnalyzeJobQueue::DeriveSeed(int seed, int index) const
+{
+  // murmur3 finalizer over the combined seed and index, mapped into [1, MaxSeed)
+  unsigned int hash = (unsigned int)seed ^ ((unsigned int)index * 0x9E3779B9u + 0x7F4A7C15u);
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6Bu;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35u;
+  hash ^= hash >> 16;
+  return 1 + (int)(hash % (unsigned int)(m_job_seed_rng->MaxSeed() - 1));
+}
+
+
 void cAnalyzeJobQueue::singleThreadedJobExecution(cAnalyzeJob* job)
 {
-  Apto::RNG::AvidaRNG rng(GetSeedForJob(job->GetID()));
+  Apto::RNG::AvidaRNG rng(job->GetSeed());
   cAvidaContext ctx(&m_world->GetDriver(), rng);
   job->Run(ctx);
   delete job;
 }
 
+
+void cAnalyzeJob::SpawnJob(cAnalyzeJob* child)
+{
+  m_queue->queueChildJob(this, child);
+}
@@ -26,9 +26,11 @@
 #include "apto/platform.h"
 
 #include "cAnalyzeJob.h"
+#include "cReplayRandom.h"
 #include "tList.h"
 
 class cAnalyzeJobWorker;
+class cCheckpoint;
 class cWorld;
 
 #if APTO_PLATFORM(WINDOWS) && defined(AddJob)
@@ -39,27 +41,44 @@ class cWorld;
 const int MT_RANDOM_INDEX_MASK = 0x7F;
 
 
+/**
+ * Work-stealing analyze job queue.  Every worker thread owns a local deque; jobs added from outside are dealt out
+ * round-robin across the deques and child jobs spawned by a running job go onto the deque of the worker executing it.
+ * Idle workers steal from the front of the other deques, so the shared mutex is only taken when jobs are added and
+ * when a worker runs out of work.
+ *
+ * Each job is assigned its random seed when it is queued (children derive theirs from the parent's seed), so the
+ * random stream seen by a job does not depend on which worker runs it or when.
+ **/
+
 class cAnalyzeJobQueue
 {
+  friend class cAnalyzeJob;
   friend class cAnalyzeJobWorker;
   
 private:
   cWorld* m_world;
-  tList<cAnalyzeJob> m_queue;
   int m_last_jobid;
-  Apto::Random* m_job_seed_rng;
+  cReplayRandom* m_job_seed_rng;
   Apto::Mutex m_mutex;
   Apto::ConditionVariable m_cond;
   Apto::ConditionVariable m_term_cond;
   
-  volatile int m_jobs;      // count of waiting jobs, used in condition variable constructs
-  volatile int m_pending;   // count of currently executing jobs
+  volatile int m_outstanding; // count of queued and executing jobs that have not yet been reported complete
+  volatile int m_idle;        // count of workers waiting on m_cond
+  int m_epoch;                // incremented whenever new work is queued, used in condition variable constructs
+  int m_next_worker;          // deque to receive the next externally added job
+  bool m_terminate;
   
   Apto::Array<cAnalyzeJobWorker*> m_workers;
 
 
   void singleThreadedJobExecution(cAnalyzeJob* job);
-  inline void queueJob(cAnalyzeJob* job);
+  void queueJob(cAnalyzeJob* job, bool signal);
+  void queueChildJob(cAnalyzeJob* parent, cAnalyzeJob* child);
+  
+  cAnalyzeJob* stealJob(cAnalyzeJobWorker* thief);
+  cAnalyzeJob* waitForJob(cAnalyzeJobWorker* worker);
 
   
   cAnalyzeJobQueue(); // @not_implemented
@@ -71,13 +90,19 @@ public:
   cAnalyzeJobQueue(cWorld* world);
   ~cAnalyzeJobQueue();
 
-  void AddJob(cAnalyzeJob* job);
-  void AddJobImmediate(cAnalyzeJob* job);
+  void AddJob(cAnalyzeJob* job) { queueJob(job, false); }
+  void AddJobImmediate(cAnalyzeJob* job) { queueJob(job, true); }
 
   void Start();
   void Execute();
   
-  int GetSeedForJob(int jobid) { Apto::MutexAutoLock lock(m_mutex); return m_job_seed_rng->GetInt(m_job_seed_rng->MaxSeed()); }
+  int GetNumWorkers() const { return m_workers.GetSize(); }
+  
+  // Checkpointing of the job seed stream (see cCheckpoint), while no jobs are outstanding
+  void Checkpoint(cCheckpoint& ckpt);
+  
+  // Deterministically derive the seed for the index'th random stream belonging to a job seeded with 'seed'
+  int DeriveSeed(int seed, int index) const;
 };
 
 #endif
@@ -32,34 +32,33 @@ void cAnalyzeJobWorker::Run()
   cAvidaContext ctx(&m_queue->m_world->GetDriver(), rng);
   ctx.SetAnalyzeMode();
   
-  cAnalyzeJob* job = NULL;
-  
   while (1) {
-    m_queue->m_mutex.Lock();
-    while (m_queue->m_jobs == 0) {
-      m_queue->m_cond.Wait(m_queue->m_mutex);
-    }
-    job = m_queue->m_queue.Pop();
-    m_queue->m_jobs--;
-    m_queue->m_pending++; 
-    m_queue->m_mutex.Unlock();
+    // Local work first (most recently pushed, typically a child of the last job), then steal, then sleep
+    cAnalyzeJob* job = popJob();
+    if (!job) job = m_queue->stealJob(this);
+    if (!job) job = m_queue->waitForJob(this);
+    
+    // Terminate worker on NULL job receipt
+    if (!job) break;
     
-    if (job) {
-      // Set RNG from the waiting pool and execute the job
-      rng.ResetSeed(m_queue->GetSeedForJob(job->GetID()));
-      job->Run(ctx);
-      delete job;
-      m_queue->m_mutex.Lock();
-      int pending = --m_queue->m_pending;
-      m_queue->m_mutex.Unlock();
-      if (!pending) m_queue->m_term_cond.Signal();
-    } else {
-      // Terminate worker on NULL job receipt
-      m_queue->m_mutex.Lock();
-      int pending = --m_queue->m_pending;
-      m_queue->m_mutex.Unlock();
-      if (!pending) m_queue->m_term_cond.Signal();
-      break;
-    }
+    // Set RNG from the seed assigned at queue time and execute the job
+    rng.ResetSeed(job->GetSeed());
+    job->m_worker = this;
+    job->Run(ctx);
+    delete job;
+    m_completed++;
   }
 }
+
+
+void cAnalyzeJobWorker::pushJob(cAnalyzeJob* job)
+{
+  Apto::MutexAutoLock lock(m_deque_mutex);
+  m_deque.PushRear(job);
+}
+
+cAnalyzeJob* cAnalyzeJobWorker::popJob()
+{
+  Apto::MutexAutoLock lock(m_deque_mutex);
+  return m_deque.PopRear();
+}
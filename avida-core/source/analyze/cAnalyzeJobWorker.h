@@ -22,20 +22,40 @@
 #ifndef cAnalyzeJobWorker_h
 #define cAnalyzeJobWorker_h
 
+#include "apto/core/Mutex.h"
 #include "apto/core/Thread.h"
 
+#include "tList.h"
+
+class cAnalyzeJob;
 class cAnalyzeJobQueue;
 
 
 class cAnalyzeJobWorker : public Apto::Thread
 {
+  friend class cAnalyzeJobQueue;
+  
 private:
   cAnalyzeJobQueue* m_queue;
+  int m_id;
+  
+  // Local job deque.  The owning worker pushes and pops at the rear, thieves take from the front.
+  Apto::Mutex m_deque_mutex;
+  tList<cAnalyzeJob> m_deque;
+  
+  int m_completed;  // jobs finished since last reported to the queue
   
   void Run();
+  
+  void pushJob(cAnalyzeJob* job);
+  cAnalyzeJob* popJob();
+  
+  cAnalyzeJobWorker(); // @not_implemented
+  cAnalyzeJobWorker(const cAnalyzeJobWorker&); // @not_implemented
+  cAnalyzeJobWorker& operator=(const cAnalyzeJobWorker&); // @not_implemented
 
 public:
-  cAnalyzeJobWorker(cAnalyzeJobQueue* queue) : m_queue(queue) { ; }  
+  cAnalyzeJobWorker(cAnalyzeJobQueue* queue, int worker_id) : m_queue(queue), m_id(worker_id), m_completed(0) { ; }
 };
 
 #endif
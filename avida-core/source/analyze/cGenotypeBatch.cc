@@ -22,9 +22,10 @@
 #include "cGenotypeBatch.h"
 
 #include "cAnalyzeGenotype.h"
+#include "cGenotypeColumns.h"
 
 
-cGenotypeBatch::cGenotypeBatch(const cGenotypeBatch& rhs) : m_list(rhs.m_list), m_name(rhs.m_name), m_is_lineage(rhs.m_is_lineage), m_is_aligned(rhs.m_is_aligned)
+cGenotypeBatch::cGenotypeBatch(const cGenotypeBatch& rhs) : m_list(rhs.m_list), m_name(rhs.m_name), m_is_lineage(rhs.m_is_lineage), m_is_aligned(rhs.m_is_aligned), m_columns(NULL)
 {
   if (rhs.m_lineage_head) {
     m_lineage_head = new cAnalyzeGenotype(*(rhs.m_lineage_head));
@@ -43,6 +44,7 @@ cGenotypeBatch::~cGenotypeBatch()
   
   delete m_lineage_head;
   delete m_clade_head;
+  delete m_columns;
 }
 
 cGenotypeBatch& cGenotypeBatch::operator=(const cGenotypeBatch& rhs)
@@ -55,6 +57,7 @@ cGenotypeBatch& cGenotypeBatch::operator=(const cGenotypeBatch& rhs)
   m_name =       rhs.m_name;
   m_is_lineage = rhs.m_is_lineage;
   m_is_aligned = rhs.m_is_aligned;
+  DropColumns();
 
   // pointery bits
   delete m_lineage_head;
@@ -71,6 +74,14 @@ cGenotypeBatch& cGenotypeBatch::operator=(const cGenotypeBatch& rhs)
 }
 
 
+void cGenotypeBatch::SetColumns(cGenotypeColumns* columns)
+{
+  if (columns == m_columns) return;
+  delete m_columns;
+  m_columns = columns;
+}
+
+
 cAnalyzeGenotype* cGenotypeBatch::FindGenotypeNumCPUs() const
 {
   return new cAnalyzeGenotype(*(m_list.FindMax(&cAnalyzeGenotype::GetNumCPUs)));
@@ -390,6 +401,8 @@ void cGenotypeBatch::RemoveClade(cAnalyzeGenotype* start_genotype)
 
 void cGenotypeBatch::RemoveClade(int start_genotype_id)
 {
+  DropColumns();
+  
   if (m_is_lineage) {
     tListIterator<cAnalyzeGenotype> it(m_list);
     cAnalyzeGenotype* genotype = NULL;
@@ -33,6 +33,7 @@
 // cGenotypeBatch      : Collection of cAnalyzeGenotypes
 
 class cAnalyzeGenotype;
+class cGenotypeColumns;
 
 
 class cGenotypeBatch
@@ -44,9 +45,10 @@ private:
   cAnalyzeGenotype* m_clade_head;
   bool m_is_lineage;
   bool m_is_aligned;
+  cGenotypeColumns* m_columns;
   
 public:
-  cGenotypeBatch() : m_name(""), m_lineage_head(NULL), m_clade_head(NULL), m_is_lineage(false), m_is_aligned(false) { ; }
+  cGenotypeBatch() : m_name(""), m_lineage_head(NULL), m_clade_head(NULL), m_is_lineage(false), m_is_aligned(false), m_columns(NULL) { ; }
   cGenotypeBatch(const cGenotypeBatch&);
   ~cGenotypeBatch();
 
@@ -67,6 +69,11 @@ public:
   
   void MergeWith(cGenotypeBatch* batch) { m_list.Append(batch->m_list); }
   
+  // Optional column copy of the list, owned by the batch (see cGenotypeColumns)
+  cGenotypeColumns* GetColumns() { return m_columns; }
+  void SetColumns(cGenotypeColumns* columns);
+  void DropColumns() { SetColumns(NULL); }
+  
   cAnalyzeGenotype* FindGenotypeNumCPUs() const;
   cAnalyzeGenotype* PopGenotypeNumCPUs();
   cAnalyzeGenotype* FindGenotypeTotalCPUs() const;
@@ -106,7 +113,7 @@ public:
 
   
 private:
-  inline void clearFlags() { m_lineage_head = NULL; m_is_lineage = false; m_clade_head = NULL; m_is_aligned = false; }
+  inline void clearFlags() { m_lineage_head = NULL; m_is_lineage = false; m_clade_head = NULL; m_is_aligned = false; DropColumns(); }
 };
 
 
@@ -0,0 +1,463 @@
+/*
+ *  cGenotypeColumns.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cGenotypeColumns.h"
+
+#include "avida/core/InstructionSequence.h"
+
+#include "cAnalyzeGenotype.h"
+#include "cAnalyzeJobQueue.h"
+#include "cEnvironment.h"
+#include "cHardwareManager.h"
+#include "cInstSet.h"
+#include "cWorld.h"
+#include "tAnalyzeParallelFor.h"
+
+#include <sstream>
+
+
+// Stat keywords (with their aliases) that are copied into columns
+static const struct { const char* name; int stat; } s_stat_names[] = {
+  { "id",                 cGenotypeColumns::STAT_ID },
+  { "dom_id",             cGenotypeColumns::STAT_ID },
+  { "parent_id",          cGenotypeColumns::STAT_PARENT_ID },
+  { "num_cpus",           cGenotypeColumns::STAT_NUM_CPUS },
+  { "num_units",          cGenotypeColumns::STAT_NUM_CPUS },
+  { "dom_num_cpus",       cGenotypeColumns::STAT_NUM_CPUS },
+  { "total_cpus",         cGenotypeColumns::STAT_TOTAL_CPUS },
+  { "total_units",        cGenotypeColumns::STAT_TOTAL_CPUS },
+  { "length",             cGenotypeColumns::STAT_LENGTH },
+  { "copy_length",        cGenotypeColumns::STAT_COPY_LENGTH },
+  { "exe_length",         cGenotypeColumns::STAT_EXE_LENGTH },
+  { "gest_time",          cGenotypeColumns::STAT_GEST_TIME },
+  { "update_born",        cGenotypeColumns::STAT_UPDATE_BORN },
+  { "gen_born",           cGenotypeColumns::STAT_UPDATE_BORN },
+  { "update_dead",        cGenotypeColumns::STAT_UPDATE_DEAD },
+  { "update_deactivated", cGenotypeColumns::STAT_UPDATE_DEAD },
+  { "update",             cGenotypeColumns::STAT_UPDATE_DEAD },
+  { "depth",              cGenotypeColumns::STAT_DEPTH },
+  { "dom_depth",          cGenotypeColumns::STAT_DEPTH },
+  { "merit",              cGenotypeColumns::STAT_MERIT },
+  { "fitness",            cGenotypeColumns::STAT_FITNESS },
+  { NULL, 0 }
+};
+
+
+cGenotypeColumns::cGenotypeColumns(cWorld* world, cAnalyzeJobQueue& queue, tListPlus<cAnalyzeGenotype>& genotypes)
+  : m_world(world), m_queue(queue), m_num_tasks(world->GetEnvironment().GetNumTasks()), m_has_genomes(false)
+  , m_scan_value(0.0), m_scan_taken(NULL), m_scan_keep(NULL), m_scan_cols(NULL), m_scan_precision(0)
+  , m_scan_num_insts(0), m_scan_max_length(0), m_scan_freqs(NULL), m_scan_counts(NULL), m_scan_gen_counts(NULL)
+{
+  // The list can only be walked from this thread, the blocks index the rows
+  m_rows.Resize(genotypes.GetSize());
+  tListIterator<cAnalyzeGenotype> it(genotypes);
+  cAnalyzeGenotype* genotype = NULL;
+  for (int row = 0; (genotype = it.Next()); row++) m_rows[row] = genotype;
+
+  m_ints.Resize(NUM_INT_STATS + m_num_tasks);
+  for (int i = 0; i < m_ints.GetSize(); i++) m_ints[i].Resize(m_rows.GetSize());
+  m_doubles.Resize(NUM_STATS - NUM_INT_STATS);
+  for (int i = 0; i < m_doubles.GetSize(); i++) m_doubles[i].Resize(m_rows.GetSize());
+
+  tAnalyzeParallelFor<cGenotypeColumns> loop(m_queue);
+  loop.Run(this, &cGenotypeColumns::copyBlock, numBlocks());
+}
+
+
+cGenotypeColumns::cColumn cGenotypeColumns::FindColumn(const tDataEntryCommand<cAnalyzeGenotype>& command) const
+{
+  // Arguments change what some stats return (e.g. task.N:binary), those are left to the data command
+  if (command.GetArgs().GetSize()) return cColumn();
+
+  if (command.GetName() == "task") {
+    const cString idx = command.GetIndex().AsString();
+    if (idx.GetSize() == 0 || !idx.IsNumber()) return cColumn();
+    const int task_id = idx.AsInt();
+    if (task_id < 0 || task_id >= m_num_tasks) return cColumn();
+    return cColumn(cColumn::INT, NUM_INT_STATS + task_id);
+  }
+
+  if (command.GetName() == "sequence" || command.GetName() == "dom_sequence") return cColumn(cColumn::SEQUENCE);
+
+  return FindColumn(command.GetName());
+}
+
+
+cGenotypeColumns::cColumn cGenotypeColumns::FindColumn(const cString& stat_name) const
+{
+  for (int i = 0; s_stat_names[i].name; i++) {
+    if (stat_name != s_stat_names[i].name) continue;
+    const int stat = s_stat_names[i].stat;
+    if (stat < NUM_INT_STATS) return cColumn(cColumn::INT, stat);
+    return cColumn(cColumn::DOUBLE, stat - NUM_INT_STATS);
+  }
+  return cColumn();
+}
+
+
+void cGenotypeColumns::Filter(const cColumn& col, const bool rel_ok[3], double value, Apto::Array<bool>& keep)
+{
+  assert(col.IsNumeric());
+
+  keep.Resize(m_rows.GetSize());
+  m_scan_col = col;
+  m_scan_value = value;
+  for (int i = 0; i < 3; i++) m_scan_rel_ok[i] = rel_ok[i];
+  m_scan_keep = &keep;
+
+  tAnalyzeParallelFor<cGenotypeColumns> loop(m_queue);
+  loop.Run(this, &cGenotypeColumns::filterBlock, numBlocks());
+
+  m_scan_keep = NULL;
+}
+
+
+int cGenotypeColumns::FindMax(const cColumn& col, const Apto::Array<bool>& taken)
+{
+  assert(col.IsNumeric());
+
+  m_scan_col = col;
+  m_scan_taken = &taken;
+  m_blocks.Resize(numBlocks());
+
+  tAnalyzeParallelFor<cGenotypeColumns> loop(m_queue);
+  loop.Run(this, &cGenotypeColumns::maxBlock, numBlocks());
+
+  // Blocks are combined in row order, so ties go to the first row as in a list scan
+  int best = -1;
+  for (int b = 0; b < m_blocks.GetSize(); b++) {
+    const int row = m_blocks[b].best_row;
+    if (row >= 0 && (best < 0 || GetDouble(col, row) > GetDouble(col, best))) best = row;
+  }
+
+  m_blocks.Resize(0);
+  m_scan_taken = NULL;
+  return best;
+}
+
+
+int cGenotypeColumns::FindValue(const cColumn& col, int value, const Apto::Array<bool>& taken)
+{
+  assert(col.type == cColumn::INT);
+
+  m_scan_col = col;
+  m_scan_value = value;
+  m_scan_taken = &taken;
+  m_blocks.Resize(numBlocks());
+
+  tAnalyzeParallelFor<cGenotypeColumns> loop(m_queue);
+  loop.Run(this, &cGenotypeColumns::valueBlock, numBlocks());
+
+  int found = -1;
+  for (int b = 0; b < m_blocks.GetSize() && found < 0; b++) found = m_blocks[b].best_row;
+
+  m_blocks.Resize(0);
+  m_scan_taken = NULL;
+  return found;
+}
+
+
+void cGenotypeColumns::Select(const Apto::Array<int>& rows)
+{
+  const int num_rows = rows.GetSize();
+
+  Apto::Array<cAnalyzeGenotype*> new_rows(num_rows);
+  for (int i = 0; i < num_rows; i++) new_rows[i] = m_rows[rows[i]];
+  m_rows = new_rows;
+
+  for (int c = 0; c < m_ints.GetSize(); c++) {
+    Apto::Array<int, Apto::Smart> column(num_rows);
+    for (int i = 0; i < num_rows; i++) column[i] = m_ints[c][rows[i]];
+    m_ints[c] = column;
+  }
+  for (int c = 0; c < m_doubles.GetSize(); c++) {
+    Apto::Array<double, Apto::Smart> column(num_rows);
+    for (int i = 0; i < num_rows; i++) column[i] = m_doubles[c][rows[i]];
+    m_doubles[c] = column;
+  }
+
+  if (m_has_genomes) {
+    Apto::Array<unsigned char, Apto::Smart> arena;
+    Apto::Array<int> offsets(num_rows + 1);
+    Apto::Array<bool> default_inst_set(num_rows);
+    for (int i = 0; i < num_rows; i++) {
+      offsets[i] = arena.GetSize();
+      default_inst_set[i] = m_default_inst_set[rows[i]];
+      for (int p = m_genome_offset[rows[i]]; p < m_genome_offset[rows[i] + 1]; p++) arena.Push(m_arena[p]);
+    }
+    offsets[num_rows] = arena.GetSize();
+    m_arena = arena;
+    m_genome_offset = offsets;
+    m_default_inst_set = default_inst_set;
+  }
+}
+
+
+void cGenotypeColumns::CountValues(const cColumn& col, Apto::Array<int>& values, Apto::Array<int>& counts)
+{
+  assert(col.type == cColumn::INT);
+
+  m_scan_col = col;
+  m_blocks.Resize(numBlocks());
+
+  tAnalyzeParallelFor<cGenotypeColumns> loop(m_queue);
+  loop.Run(this, &cGenotypeColumns::countBlock, numBlocks());
+
+  // Merge in block order, so that values keep the order of their first row
+  values.Resize(0);
+  counts.Resize(0);
+  Apto::Map<int, int> slots;
+  for (int b = 0; b < m_blocks.GetSize(); b++) {
+    const sBlock& block = m_blocks[b];
+    for (int i = 0; i < block.values.GetSize(); i++) {
+      int slot = -1;
+      if (!slots.Get(block.values[i], slot)) {
+        slot = values.GetSize();
+        slots.Set(block.values[i], slot);
+        values.Push(block.values[i]);
+        counts.Push(0);
+      }
+      counts[slot] += block.weights[i];
+    }
+  }
+
+  m_blocks.Resize(0);
+}
+
+
+void cGenotypeColumns::WriteRows(std::ostream& fp, const Apto::Array<cColumn>& cols)
+{
+  m_scan_cols = &cols;
+  m_scan_flags = fp.flags();
+  m_scan_precision = fp.precision();
+
+  bool with_sequence = false;
+  for (int i = 0; i < cols.GetSize(); i++) if (cols[i].type == cColumn::SEQUENCE) with_sequence = true;
+  if (with_sequence) {
+    buildGenomes();
+    m_symbols.Resize(256);
+    for (int op = 0; op < m_symbols.GetSize(); op++) m_symbols[op] = (const char*)Instruction(op).GetSymbol();
+  }
+
+  m_blocks.Resize(numBlocks());
+
+  tAnalyzeParallelFor<cGenotypeColumns> loop(m_queue);
+  loop.Run(this, &cGenotypeColumns::writeBlock, numBlocks());
+
+  for (int b = 0; b < m_blocks.GetSize(); b++) fp << m_blocks[b].text;
+  fp.flush();
+
+  m_blocks.Resize(0);
+  m_scan_cols = NULL;
+}
+
+
+void cGenotypeColumns::CountTaskSites(int num_insts, int max_length,
+                                      Apto::Array<Apto::Array<int, Apto::Smart> >& freqs,
+                                      Apto::Array<int>& task_counts, Apto::Array<int>& task_gen_counts)
+{
+  buildGenomes();
+
+  const int num_tasks = task_counts.GetSize();
+  freqs.Resize(num_tasks);
+  for (int t = 0; t < num_tasks; t++) {
+    freqs[t].Resize(max_length * (num_insts + 1));
+    freqs[t].SetAll(0);
+  }
+  task_counts.SetAll(0);
+  task_gen_counts.SetAll(0);
+
+  m_scan_num_insts = num_insts;
+  m_scan_max_length = max_length;
+  m_scan_freqs = &freqs;
+  m_scan_counts = &task_counts;
+  m_scan_gen_counts = &task_gen_counts;
+
+  // Tasks are independent, one matrix each, so they are scanned in parallel rather than the rows
+  tAnalyzeParallelFor<cGenotypeColumns> loop(m_queue);
+  loop.Run(this, &cGenotypeColumns::taskSitesTask, num_tasks);
+
+  m_scan_freqs = NULL;
+  m_scan_counts = NULL;
+  m_scan_gen_counts = NULL;
+}
+
+
+void cGenotypeColumns::buildGenomes()
+{
+  if (m_has_genomes) return;
+
+  // Genome properties are not safe to read concurrently, so the arena is filled from this thread
+  const cInstSet& is = m_world->GetHardwareManager().GetDefaultInstSet();
+  m_genome_offset.Resize(m_rows.GetSize() + 1);
+  m_default_inst_set.Resize(m_rows.GetSize());
+  m_arena.Resize(0);
+
+  for (int row = 0; row < m_rows.GetSize(); row++) {
+    const Genome& genome = m_rows[row]->GetGenome();
+    m_default_inst_set[row] =
+      (m_world->GetHardwareManager().GetInstSet(genome.Properties().Get("instset").StringValue()).GetInstSetName() ==
+       is.GetInstSetName());
+
+    ConstInstructionSequencePtr seq;
+    seq.DynamicCastFrom(genome.Representation());
+    m_genome_offset[row] = m_arena.GetSize();
+    for (int i = 0; i < seq->GetSize(); i++) m_arena.Push((unsigned char)(*seq)[i].GetOp());
+  }
+  m_genome_offset[m_rows.GetSize()] = m_arena.GetSize();
+
+  m_has_genomes = true;
+}
+
+
+void cGenotypeColumns::copyBlock(cAvidaContext&, int block)
+{
+  for (int row = blockBegin(block); row < blockEnd(block); row++) {
+    const cAnalyzeGenotype* genotype = m_rows[row];
+    m_ints[STAT_ID][row] = genotype->GetID();
+    m_ints[STAT_PARENT_ID][row] = genotype->GetParentID();
+    m_ints[STAT_NUM_CPUS][row] = genotype->GetNumCPUs();
+    m_ints[STAT_TOTAL_CPUS][row] = genotype->GetTotalCPUs();
+    m_ints[STAT_LENGTH][row] = genotype->GetLength();
+    m_ints[STAT_COPY_LENGTH][row] = genotype->GetCopyLength();
+    m_ints[STAT_EXE_LENGTH][row] = genotype->GetExeLength();
+    m_ints[STAT_GEST_TIME][row] = genotype->GetGestTime();
+    m_ints[STAT_UPDATE_BORN][row] = genotype->GetUpdateBorn();
+    m_ints[STAT_UPDATE_DEAD][row] = genotype->GetUpdateDead();
+    m_ints[STAT_DEPTH][row] = genotype->GetDepth();
+    m_doubles[STAT_MERIT - NUM_INT_STATS][row] = genotype->GetMerit();
+    m_doubles[STAT_FITNESS - NUM_INT_STATS][row] = genotype->GetFitness();
+    for (int t = 0; t < m_num_tasks; t++) m_ints[NUM_INT_STATS + t][row] = genotype->GetTaskCount(t);
+  }
+}
+
+
+void cGenotypeColumns::filterBlock(cAvidaContext&, int block)
+{
+  // Same ordering as comparing the stat against the test value as flex vars: equal, greater, otherwise less
+  Apto::Array<bool>& keep = *m_scan_keep;
+  for (int row = blockBegin(block); row < blockEnd(block); row++) {
+    const double value = GetDouble(m_scan_col, row);
+    const int compare = (value == m_scan_value) ? 1 : ((value > m_scan_value) ? 2 : 0);
+    keep[row] = m_scan_rel_ok[compare];
+  }
+}
+
+
+void cGenotypeColumns::maxBlock(cAvidaContext&, int block)
+{
+  const Apto::Array<bool>& taken = *m_scan_taken;
+  int best = -1;
+  for (int row = blockBegin(block); row < blockEnd(block); row++) {
+    if (taken[row]) continue;
+    if (best < 0 || GetDouble(m_scan_col, row) > GetDouble(m_scan_col, best)) best = row;
+  }
+  m_blocks[block].best_row = best;
+}
+
+
+void cGenotypeColumns::valueBlock(cAvidaContext&, int block)
+{
+  const Apto::Array<bool>& taken = *m_scan_taken;
+  const Apto::Array<int, Apto::Smart>& column = m_ints[m_scan_col.idx];
+  const int value = (int)m_scan_value;
+  int found = -1;
+  for (int row = blockBegin(block); row < blockEnd(block) && found < 0; row++) {
+    if (!taken[row] && column[row] == value) found = row;
+  }
+  m_blocks[block].best_row = found;
+}
+
+
+void cGenotypeColumns::countBlock(cAvidaContext&, int block)
+{
+  sBlock& result = m_blocks[block];
+  result.values.Resize(0);
+  result.weights.Resize(0);
+
+  const Apto::Array<int, Apto::Smart>& column = m_ints[m_scan_col.idx];
+  const Apto::Array<int, Apto::Smart>& num_cpus = m_ints[STAT_NUM_CPUS];
+  Apto::Map<int, int> slots;
+  for (int row = blockBegin(block); row < blockEnd(block); row++) {
+    int slot = -1;
+    if (!slots.Get(column[row], slot)) {
+      slot = result.values.GetSize();
+      slots.Set(column[row], slot);
+      result.values.Push(column[row]);
+      result.weights.Push(0);
+    }
+    result.weights[slot] += num_cpus[row];
+  }
+}
+
+
+void cGenotypeColumns::writeBlock(cAvidaContext&, int block)
+{
+  const Apto::Array<cColumn>& cols = *m_scan_cols;
+
+  std::ostringstream out;
+  out.flags(m_scan_flags);
+  out.precision(m_scan_precision);
+
+  for (int row = blockBegin(block); row < blockEnd(block); row++) {
+    for (int c = 0; c < cols.GetSize(); c++) {
+      const cColumn& col = cols[c];
+      if (col.type == cColumn::INT) out << m_ints[col.idx][row];
+      else if (col.type == cColumn::DOUBLE) out << m_doubles[col.idx][row];
+      else {
+        for (int p = m_genome_offset[row]; p < m_genome_offset[row + 1]; p++) out << m_symbols[m_arena[p]];
+      }
+      out << " ";
+    }
+    out << "\n";
+  }
+
+  m_blocks[block].text = out.str();
+}
+
+
+void cGenotypeColumns::taskSitesTask(cAvidaContext&, int task_id)
+{
+  const int num_insts = m_scan_num_insts;
+  const int max_length = m_scan_max_length;
+  Apto::Array<int, Apto::Smart>& freq = (*m_scan_freqs)[task_id];
+  const Apto::Array<int, Apto::Smart>& task = m_ints[NUM_INT_STATS + task_id];
+  const Apto::Array<int, Apto::Smart>& num_cpus = m_ints[STAT_NUM_CPUS];
+  const Apto::Array<int, Apto::Smart>& length = m_ints[STAT_LENGTH];
+
+  int count = 0;
+  int gen_count = 0;
+  for (int row = 0; row < m_rows.GetSize(); row++) {
+    if (!m_default_inst_set[row] || task[row] == 0) continue;
+
+    const int weight = num_cpus[row];
+    count += weight;
+    gen_count++;
+
+    const int genome_size = m_genome_offset[row + 1] - m_genome_offset[row];
+    const unsigned char* ops = (genome_size) ? &m_arena[m_genome_offset[row]] : NULL;
+    const int cur_length = (length[row] < genome_size) ? length[row] : genome_size;
+    for (int i = 0; i < cur_length; i++) freq[i * (num_insts + 1) + ops[i]] += weight;
+    for (int i = length[row]; i < max_length; i++) freq[i * (num_insts + 1) + num_insts] += weight;
+  }
+
+  (*m_scan_counts)[task_id] = count;
+  (*m_scan_gen_counts)[task_id] = gen_count;
+}
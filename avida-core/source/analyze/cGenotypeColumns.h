@@ -0,0 +1,189 @@
+/*
+ *  cGenotypeColumns.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGenotypeColumns_h
+#define cGenotypeColumns_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+#include "tDataEntryCommand.h"
+#include "tList.h"
+
+#include <iostream>
+#include <string>
+
+class cAnalyzeGenotype;
+class cAnalyzeJobQueue;
+class cAvidaContext;
+class cWorld;
+
+
+/**
+ * Column copy of a genotype batch.  The stored stats of every genotype (ids, counts, lengths, gestation time, merit,
+ * fitness and task counts) are held in one typed array per stat, and the genome sequences, when needed, in a single
+ * arena of instruction ops.  Scans over the columns are split into blocks of rows that run on the analyze job queue.
+ *
+ * Rows are in batch list order and refer back to their genotypes, which the batch still owns.  The columns are only a
+ * copy: whoever changes the batch list or the stats of its genotypes must drop them.  Select() is the one way of
+ * removing genotypes that keeps the columns valid, the caller then rebuilds the list from the selected rows.
+ **/
+
+class cGenotypeColumns
+{
+public:
+  enum eStat {
+    STAT_ID = 0,
+    STAT_PARENT_ID,
+    STAT_NUM_CPUS,
+    STAT_TOTAL_CPUS,
+    STAT_LENGTH,
+    STAT_COPY_LENGTH,
+    STAT_EXE_LENGTH,
+    STAT_GEST_TIME,
+    STAT_UPDATE_BORN,
+    STAT_UPDATE_DEAD,
+    STAT_DEPTH,
+    NUM_INT_STATS,
+    STAT_MERIT = NUM_INT_STATS,
+    STAT_FITNESS,
+    NUM_STATS
+  };
+
+  // Reference to one column, as resolved from a stat name or data command
+  class cColumn
+  {
+  public:
+    enum eType { NONE, INT, DOUBLE, SEQUENCE };
+
+    eType type;
+    int idx;    // into the int or double columns
+
+    cColumn(eType in_type = NONE, int in_idx = -1) : type(in_type), idx(in_idx) { ; }
+
+    bool IsValid() const { return (type != NONE); }
+    bool IsNumeric() const { return (type == INT || type == DOUBLE); }
+  };
+
+private:
+  enum { ROWS_PER_BLOCK = 16384 };
+
+  // Per block results of the scan in progress
+  struct sBlock
+  {
+    int best_row;
+    Apto::Array<int, Apto::Smart> values;
+    Apto::Array<int, Apto::Smart> weights;
+    std::string text;
+  };
+
+  cWorld* m_world;
+  cAnalyzeJobQueue& m_queue;
+  int m_num_tasks;
+
+  Apto::Array<cAnalyzeGenotype*> m_rows;
+  Apto::Array<Apto::Array<int, Apto::Smart> > m_ints;       // fixed int stats, then the task counts
+  Apto::Array<Apto::Array<double, Apto::Smart> > m_doubles;
+
+  bool m_has_genomes;
+  Apto::Array<unsigned char, Apto::Smart> m_arena;
+  Apto::Array<int> m_genome_offset;    // row start in the arena, with a trailing end offset
+  Apto::Array<bool> m_default_inst_set;
+
+  // State of the scan in progress
+  Apto::Array<sBlock> m_blocks;
+  cColumn m_scan_col;
+  double m_scan_value;
+  bool m_scan_rel_ok[3];
+  const Apto::Array<bool>* m_scan_taken;
+  Apto::Array<bool>* m_scan_keep;
+  const Apto::Array<cColumn>* m_scan_cols;
+  std::ios_base::fmtflags m_scan_flags;
+  std::streamsize m_scan_precision;
+  Apto::Array<cString> m_symbols;
+  int m_scan_num_insts;
+  int m_scan_max_length;
+  Apto::Array<Apto::Array<int, Apto::Smart> >* m_scan_freqs;
+  Apto::Array<int>* m_scan_counts;
+  Apto::Array<int>* m_scan_gen_counts;
+
+
+  cGenotypeColumns(); // @not_implemented
+  cGenotypeColumns(const cGenotypeColumns&); // @not_implemented
+  cGenotypeColumns& operator=(const cGenotypeColumns&); // @not_implemented
+
+public:
+  cGenotypeColumns(cWorld* world, cAnalyzeJobQueue& queue, tListPlus<cAnalyzeGenotype>& genotypes);
+
+  int GetNumRows() const { return m_rows.GetSize(); }
+  int GetNumTasks() const { return m_num_tasks; }
+  cAnalyzeGenotype* GetRow(int row) const { return m_rows[row]; }
+
+  int GetInt(const cColumn& col, int row) const { return m_ints[col.idx][row]; }
+  double GetDouble(const cColumn& col, int row) const
+  {
+    return (col.type == cColumn::INT) ? (double)m_ints[col.idx][row] : m_doubles[col.idx][row];
+  }
+
+  // Column holding the values the data command would return, invalid when the stat is not one that is copied
+  cColumn FindColumn(const tDataEntryCommand<cAnalyzeGenotype>& command) const;
+  cColumn FindColumn(const cString& stat_name) const;
+
+  // Mark the rows whose value passes the relation (less, same, greater) with the test value
+  void Filter(const cColumn& col, const bool rel_ok[3], double value, Apto::Array<bool>& keep);
+
+  // First row holding the largest value, or the given value, among those not yet taken, -1 if there is none
+  int FindMax(const cColumn& col, const Apto::Array<bool>& taken);
+  int FindValue(const cColumn& col, int value, const Apto::Array<bool>& taken);
+
+  // Reduce the columns to the given rows, in the given order
+  void Select(const Apto::Array<int>& rows);
+
+  // Distinct values of an int column in order of first appearance, each with the summed num_cpus of its rows
+  void CountValues(const cColumn& col, Apto::Array<int>& values, Apto::Array<int>& counts);
+
+  // Write each row as the space separated values of the columns, formatted as the data commands would print them
+  void WriteRows(std::ostream& fp, const Apto::Array<cColumn>& cols);
+
+  // Per task instruction frequencies by site (past the end of a genome counts as instruction num_insts), weighted by
+  // num_cpus, over the genotypes of the default instruction set that perform the task
+  void CountTaskSites(int num_insts, int max_length, Apto::Array<Apto::Array<int, Apto::Smart> >& freqs,
+                      Apto::Array<int>& task_counts, Apto::Array<int>& task_gen_counts);
+
+private:
+  int numBlocks() const { return (m_rows.GetSize() + ROWS_PER_BLOCK - 1) / ROWS_PER_BLOCK; }
+  int blockBegin(int block) const { return block * ROWS_PER_BLOCK; }
+  int blockEnd(int block) const
+  {
+    return (block + 1) * ROWS_PER_BLOCK < m_rows.GetSize() ? (block + 1) * ROWS_PER_BLOCK : m_rows.GetSize();
+  }
+
+  void buildGenomes();
+
+  void copyBlock(cAvidaContext& ctx, int block);
+  void filterBlock(cAvidaContext& ctx, int block);
+  void maxBlock(cAvidaContext& ctx, int block);
+  void valueBlock(cAvidaContext& ctx, int block);
+  void countBlock(cAvidaContext& ctx, int block);
+  void writeBlock(cAvidaContext& ctx, int block);
+  void taskSitesTask(cAvidaContext& ctx, int task_id);
+};
+
+#endif
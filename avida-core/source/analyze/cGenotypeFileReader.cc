@@ -0,0 +1,310 @@
+/*
+ *  cGenotypeFileReader.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cGenotypeFileReader.h"
+
+#include "apto/core/FileSystem.h"
+#include "apto/platform.h"
+#include "avida/core/InstructionSequence.h"
+
+#include "cAnalyzeGenotype.h"
+#include "cAnalyzeJobQueue.h"
+#include "cHardwareManager.h"
+#include "cInstSet.h"
+#include "cStringUtil.h"
+#include "cWorld.h"
+#include "tAnalyzeParallelFor.h"
+#include "tDataCommandManager.h"
+
+#include <cstring>
+
+#if !APTO_PLATFORM(WINDOWS)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+
+static const size_t MIN_CHUNK_SIZE = 4 * 1024 * 1024;
+
+
+static inline bool isSpace(char c) { return (c == ' ' || c == '\t' || c == '\r' || c == '\n'); }
+
+// Directives that cInitFile acts on, any of which in a data file means it cannot be streamed
+static bool isDirective(const char* line, const char* end)
+{
+  static const char* const directives[] = { "#include", "#import", "#define", "#filetype", "#format", NULL };
+  for (int i = 0; directives[i]; i++) {
+    const size_t len = strlen(directives[i]);
+    if ((size_t)(end - line) >= len && strncmp(line, directives[i], len) == 0 &&
+        ((size_t)(end - line) == len || isSpace(line[len]))) return true;
+  }
+  return false;
+}
+
+
+bool cGenotypeFileReader::cFilter::Setup(const cString& stat_name, const cString& relation, const cString& value,
+                                         cString& error)
+{
+  m_rel_ok[0] = m_rel_ok[1] = m_rel_ok[2] = false;
+  if (relation == "==")      {                       m_rel_ok[1] = true;                       }
+  else if (relation == "!=") { m_rel_ok[0] = true;                         m_rel_ok[2] = true; }
+  else if (relation == "<")  { m_rel_ok[0] = true;                                             }
+  else if (relation == ">")  {                                             m_rel_ok[2] = true; }
+  else if (relation == "<=") { m_rel_ok[0] = true;   m_rel_ok[1] = true;                       }
+  else if (relation == ">=") {                       m_rel_ok[1] = true;   m_rel_ok[2] = true; }
+  else {
+    error = cStringUtil::Stringf("unknown relation '%s'", (const char*)relation);
+    return false;
+  }
+
+  delete m_stat;
+  m_stat = cAnalyzeGenotype::GetDataCommandManager().GetDataCommand(stat_name, &error);
+  if (!m_stat) return false;
+
+  m_stat_name = stat_name;
+  m_value = value;
+  return true;
+}
+
+
+bool cGenotypeFileReader::cFilter::Passes(const cAnalyzeGenotype* genotype) const
+{
+  const cFlexVar value = m_stat->GetValue(genotype);
+  if (value == m_value) return m_rel_ok[1];
+  return (value > m_value) ? m_rel_ok[2] : m_rel_ok[0];
+}
+
+
+
+cGenotypeFileReader::cGenotypeFileReader(cWorld* world, const cString& filename, const cString& working_dir)
+  : m_world(world), m_streamable(false), m_filetype("unknown"), m_data(NULL), m_size(0), m_body(0), m_filter(NULL)
+  , m_filter_column(-1)
+{
+#if !APTO_PLATFORM(WINDOWS)
+  const Apto::String path = Apto::FileSystem::GetAbsolutePath(Apto::String(filename), Apto::String(working_dir));
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* mapped = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped != MAP_FAILED) {
+      m_data = static_cast<const char*>(mapped);
+      m_size = st.st_size;
+    }
+  }
+  close(fd);  // the mapping keeps the file open
+
+  if (m_data) m_streamable = readHeader();
+#endif
+}
+
+cGenotypeFileReader::~cGenotypeFileReader()
+{
+#if !APTO_PLATFORM(WINDOWS)
+  if (m_data) munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+
+int cGenotypeFileReader::FindColumn(const cFilter& filter) const
+{
+  for (int i = 0; i < m_format.GetSize(); i++) if (m_format.GetLine(i) == filter.GetStatName()) return i;
+  return -1;
+}
+
+
+bool cGenotypeFileReader::Load(cAnalyzeJobQueue& queue, tList<tDataEntryCommand<cAnalyzeGenotype> >& columns,
+                               const cFilter* filter, tList<cAnalyzeGenotype>& genotypes)
+{
+  if (!m_streamable) return false;
+
+  // The command list is not safe to iterate from several threads, so the workers index a copy of it
+  m_columns.Resize(0);
+  tListIterator<tDataEntryCommand<cAnalyzeGenotype> > column_it(columns);
+  tDataEntryCommand<cAnalyzeGenotype>* column = NULL;
+  while ((column = column_it.Next())) m_columns.Push(column);
+
+  m_filter = (filter && filter->IsActive()) ? filter : NULL;
+  m_filter_column = (m_filter) ? FindColumn(*m_filter) : -1;
+  if (m_filter && (m_filter_column < 0 || m_filter_column >= m_columns.GetSize())) return false;
+
+  // Split the body into chunks that end on line boundaries
+  const size_t body_size = m_size - m_body;
+  int num_chunks = queue.GetNumWorkers() * 8;
+  if (num_chunks < 1) num_chunks = 1;
+  if ((size_t)num_chunks > body_size / MIN_CHUNK_SIZE) num_chunks = (int)(body_size / MIN_CHUNK_SIZE);
+  if (num_chunks < 1) num_chunks = 1;
+
+  m_chunks.Resize(num_chunks);
+  size_t begin = m_body;
+  for (int i = 0; i < num_chunks; i++) {
+    size_t end = m_size;
+    if (i < num_chunks - 1) {
+      end = m_body + (body_size / num_chunks) * (i + 1);
+      if (end < begin) end = begin;
+      const char* nl = static_cast<const char*>(memchr(m_data + end, '\n', m_size - end));
+      end = (nl) ? (nl - m_data) + 1 : m_size;
+    }
+    m_chunks[i].begin = begin;
+    m_chunks[i].end = end;
+    m_chunks[i].genotypes.Resize(0);
+    m_chunks[i].unsupported = false;
+    begin = end;
+  }
+
+  tAnalyzeParallelFor<cGenotypeFileReader> loop(queue);
+  loop.Run(this, &cGenotypeFileReader::parseChunk, num_chunks);
+
+  bool unsupported = false;
+  for (int i = 0; i < num_chunks; i++) unsupported = unsupported || m_chunks[i].unsupported;
+
+  for (int i = 0; i < num_chunks; i++) {
+    Apto::Array<cAnalyzeGenotype*, Apto::Smart>& chunk_genotypes = m_chunks[i].genotypes;
+    for (int g = 0; g < chunk_genotypes.GetSize(); g++) {
+      if (unsupported) delete chunk_genotypes[g];
+      else genotypes.PushRear(chunk_genotypes[g]);
+    }
+    chunk_genotypes.Resize(0);
+  }
+
+  m_columns.Resize(0);
+  m_filter = NULL;
+
+  return !unsupported;
+}
+
+
+bool cGenotypeFileReader::readHeader()
+{
+  bool has_format = false;
+
+  size_t pos = 0;
+  while (pos < m_size) {
+    const char* line = m_data + pos;
+    const char* nl = static_cast<const char*>(memchr(line, '\n', m_size - pos));
+    const char* end = (nl) ? nl : m_data + m_size;
+
+    if (*line == '#') {
+      // Pull the directive word and its arguments the way cInitFile does
+      cString cmdstr(line, end - line);
+      const cString cmd = cmdstr.PopWord();
+      if (cmd == "#include" || cmd == "#import" || cmd == "#define") return false;
+      if (cmd == "#filetype") {
+        if (m_filetype != "unknown") return false;
+        m_filetype = cmdstr.PopWord();
+      } else if (cmd == "#format") {
+        if (has_format) return false;
+        m_format.Load(cmdstr);
+        has_format = true;
+      }
+    } else {
+      // Anything other than whitespace or a trailing comment marks the start of the data
+      const char* p = line;
+      while (p < end && *p != '#' && isSpace(*p)) p++;
+      if (p < end && *p != '#') break;
+    }
+
+    pos = (nl) ? (nl - m_data) + 1 : m_size;
+  }
+
+  m_body = pos;
+  return true;
+}
+
+
+void cGenotypeFileReader::parseChunk(cAvidaContext&, int chunk_id)
+{
+  sChunk& chunk = m_chunks[chunk_id];
+
+  // Each chunk builds its own template genome, genotypes clone it on construction
+  const cInstSet& is = m_world->GetHardwareManager().GetDefaultInstSet();
+  HashPropertyMap props;
+  cHardwareManager::SetupPropertyMap(props, (const char*)is.GetInstSetName());
+  Genome default_genome(is.GetHardwareType(), props, GeneticRepresentationPtr(new InstructionSequence(1)));
+  cAnalyzeGenotype* scratch = (m_filter) ? new cAnalyzeGenotype(m_world, default_genome) : NULL;
+
+  const int num_columns = m_columns.GetSize();
+  Apto::Array<const char*> token_begin(num_columns);
+  Apto::Array<int> token_size(num_columns);
+
+  size_t pos = chunk.begin;
+  while (pos < chunk.end && !chunk.unsupported) {
+    const char* line = m_data + pos;
+    const char* nl = static_cast<const char*>(memchr(line, '\n', chunk.end - pos));
+    const char* end = (nl) ? nl : m_data + chunk.end;
+    pos = (nl) ? (nl - m_data) + 1 : chunk.end;
+
+    if (*line == '#') {
+      if (isDirective(line, end)) chunk.unsupported = true;
+      continue;
+    }
+
+    // Everything past a comment mark is dropped
+    const char* hash = static_cast<const char*>(memchr(line, '#', end - line));
+    if (hash) end = hash;
+
+    // Tokenize in place, a line with fewer words than columns leaves the remaining columns empty
+    int num_tokens = 0;
+    const char* last = NULL;
+    for (const char* p = line; p < end;) {
+      while (p < end && isSpace(*p)) p++;
+      if (p == end) break;
+      const char* word = p;
+      while (p < end && !isSpace(*p)) p++;
+      last = p - 1;
+      if (num_tokens < num_columns) {
+        token_begin[num_tokens] = word;
+        token_size[num_tokens] = p - word;
+      }
+      num_tokens++;
+    }
+
+    if (!num_tokens) continue;
+    if (*last == '\\') {
+      chunk.unsupported = true;  // continued lines are joined by cInitFile
+      continue;
+    }
+
+    if (m_filter) {
+      const int col = m_filter_column;
+      m_columns[col]->SetValue(scratch, (col < num_tokens) ? cString(token_begin[col], token_size[col]) : cString(""));
+      if (!m_filter->Passes(scratch)) continue;
+    }
+
+    cAnalyzeGenotype* genotype = new cAnalyzeGenotype(m_world, default_genome);
+    for (int i = 0; i < num_columns; i++) {
+      m_columns[i]->SetValue(genotype, (i < num_tokens) ? cString(token_begin[i], token_size[i]) : cString(""));
+    }
+    chunk.genotypes.Push(genotype);
+  }
+
+  delete scratch;
+
+#if !APTO_PLATFORM(WINDOWS) && defined(MADV_DONTNEED)
+  // The parsed pages will not be read again, let them go rather than have them count against the process
+  const size_t page = sysconf(_SC_PAGESIZE);
+  const size_t first = ((chunk.begin + page - 1) / page) * page;
+  const size_t last_page = (chunk.end / page) * page;
+  if (last_page > first) madvise(const_cast<char*>(m_data) + first, last_page - first, MADV_DONTNEED);
+#endif
+}
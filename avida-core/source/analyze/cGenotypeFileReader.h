@@ -0,0 +1,125 @@
+/*
+ *  cGenotypeFileReader.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGenotypeFileReader_h
+#define cGenotypeFileReader_h
+
+#include "apto/core.h"
+
+#include "cFlexVar.h"
+#include "cString.h"
+#include "cStringList.h"
+#include "tDataEntryCommand.h"
+#include "tList.h"
+
+#include <cstddef>
+
+class cAnalyzeGenotype;
+class cAnalyzeJobQueue;
+class cAvidaContext;
+class cWorld;
+
+
+/**
+ * Streaming reader for genotype data files (detail and historic dumps).  The file is mapped read-only and its data
+ * lines are split into chunks that are parsed in parallel on the analyze job queue, tokenizing in place instead of
+ * copying every line into a cInitFile first.  Parsed chunk ranges are handed back to the operating system as they are
+ * finished, so memory use is bounded by the genotypes kept rather than by the size of the file.
+ *
+ * Only plain files are streamed: ones using #include, #import, #define or continued lines must still go through
+ * cInitFile.  IsStreamable() reports what the header allows, and Load() fails if the body turns out to need more.
+ **/
+
+class cGenotypeFileReader
+{
+public:
+  // Filter applied to each line before its genotype is built, with the relations of the FILTER command
+  class cFilter
+  {
+  private:
+    cString m_stat_name;
+    tDataEntryCommand<cAnalyzeGenotype>* m_stat;
+    cFlexVar m_value;
+    bool m_rel_ok[3];   // less, same, greater
+
+    cFilter(const cFilter&); // @not_implemented
+    cFilter& operator=(const cFilter&); // @not_implemented
+
+  public:
+    cFilter() : m_stat(NULL) { ; }
+    ~cFilter() { delete m_stat; }
+
+    bool Setup(const cString& stat_name, const cString& relation, const cString& value, cString& error);
+
+    bool IsActive() const { return (m_stat != NULL); }
+    const cString& GetStatName() const { return m_stat_name; }
+    bool Passes(const cAnalyzeGenotype* genotype) const;
+  };
+
+private:
+  struct sChunk
+  {
+    size_t begin;
+    size_t end;
+    Apto::Array<cAnalyzeGenotype*, Apto::Smart> genotypes;
+    bool unsupported;   // found a line that only cInitFile can process
+  };
+
+  cWorld* m_world;
+  bool m_streamable;
+  cString m_filetype;
+  cStringList m_format;
+
+  const char* m_data;
+  size_t m_size;
+  size_t m_body;   // offset of the first line following the header directives
+
+  Apto::Array<sChunk> m_chunks;
+  Apto::Array<tDataEntryCommand<cAnalyzeGenotype>*> m_columns;
+  const cFilter* m_filter;
+  int m_filter_column;
+
+
+  cGenotypeFileReader(); // @not_implemented
+  cGenotypeFileReader(const cGenotypeFileReader&); // @not_implemented
+  cGenotypeFileReader& operator=(const cGenotypeFileReader&); // @not_implemented
+
+public:
+  cGenotypeFileReader(cWorld* world, const cString& filename, const cString& working_dir);
+  ~cGenotypeFileReader();
+
+  bool IsStreamable() const { return m_streamable; }
+  const cString& GetFiletype() const { return m_filetype; }
+  const cStringList& GetFormat() const { return m_format; }
+
+  // Column of the format that the filter reads, or -1 if it is not one of the loaded columns
+  int FindColumn(const cFilter& filter) const;
+
+  // Parse the data lines, appending the genotypes (in file order) that pass the filter, if any.  Returns false, and
+  // appends nothing, when the body needs processing that only cInitFile provides.
+  bool Load(cAnalyzeJobQueue& queue, tList<tDataEntryCommand<cAnalyzeGenotype> >& columns, const cFilter* filter,
+            tList<cAnalyzeGenotype>& genotypes);
+
+private:
+  bool readHeader();
+  void parseChunk(cAvidaContext& ctx, int chunk_id);
+};
+
+#endif
@@ -21,6 +21,9 @@
 
 #include "cMutationalNeighborhood.h"
 
+#include "avida/Avida.h"
+#include "avida/core/Feedback.h"
+#include "avida/core/WorldDriver.h"
 #include "avida/output/File.h"
 
 #include "cAnalyze.h"
@@ -40,7 +43,7 @@ using namespace std;
 
 
 cMutationalNeighborhood::cMutationalNeighborhood(cWorld* world, const Genome& genome, int target)
-  : m_world(world), m_initialized(false)
+  : m_world(world), m_initialized(false), m_num_units(0), m_completed(0)
   , m_inst_set(m_world->GetHardwareManager().GetInstSet(genome.Properties().Get("instset").StringValue()))
   , m_target(target), m_base_genome(genome)
 {
@@ -55,108 +58,53 @@ cMutationalNeighborhood::cMutationalNeighborhood(cWorld* world, const Genome& ge
 void cMutationalNeighborhood::Process(cAvidaContext& ctx)
 {
   m_mutex.Lock();
-  if (m_initialized) {
-    int cur_site = m_cur_site++;
-    m_mutex.Unlock();
-
-    if (cur_site < m_base_genome_size) {
-      // Create test infrastructure
-      cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
-      cCPUTestInfo test_info;
-      
-      // Setup One Step Data
-      sStep& opdata = m_onestep_point[cur_site];
-      opdata.peak_fitness = m_base_fitness;
-      opdata.peak_genome = m_base_genome;
-      opdata.site_count.Resize(m_base_genome_size, 0);
-
-      sStep& oidata = m_onestep_insert[cur_site];
-      oidata.peak_fitness = m_base_fitness;
-      oidata.peak_genome = m_base_genome;
-      oidata.site_count.Resize(m_base_genome_size + 1, 0);
-
-      sStep& oddata = m_onestep_delete[cur_site];
-      oddata.peak_fitness = m_base_fitness;
-      oddata.peak_genome = m_base_genome;
-      oddata.site_count.Resize(m_base_genome_size, 0);
-      
-      
-      // Setup Data Used in Two Step
-      sStep& tpdata = m_twostep_point[cur_site];
-      tpdata.peak_fitness = m_base_fitness;
-      tpdata.peak_genome = m_base_genome;
-      tpdata.site_count.Resize(m_base_genome_size, 0);
-
-      sStep& tidata = m_twostep_insert[cur_site];
-      tidata.peak_fitness = m_base_fitness;
-      tidata.peak_genome = m_base_genome;
-      tidata.site_count.Resize(m_base_genome_size + 2, 0);
-
-      sStep& tddata = m_twostep_delete[cur_site];
-      tddata.peak_fitness = m_base_fitness;
-      tddata.peak_genome = m_base_genome;
-      tddata.site_count.Resize(m_base_genome_size, 0);
-
-      
-      sStep& tipdata = m_insert_point[cur_site];
-      tipdata.peak_fitness = m_base_fitness;
-      tipdata.peak_genome = m_base_genome;
-      tipdata.site_count.Resize(m_base_genome_size + 1, 0);
-      
-      sStep& tiddata = m_insert_delete[cur_site];
-      tiddata.peak_fitness = m_base_fitness;
-      tiddata.peak_genome = m_base_genome;
-      tiddata.site_count.Resize(m_base_genome_size + 1, 0);
-      
-      sStep& tdpdata = m_delete_point[cur_site];
-      tdpdata.peak_fitness = m_base_fitness;
-      tdpdata.peak_genome = m_base_genome;
-      tdpdata.site_count.Resize(m_base_genome_size, 0);
-      
-      
-      // Do the processing, starting with One Step
-      ProcessOneStepPoint(ctx, testcpu, test_info, cur_site);
-      ProcessOneStepInsert(ctx, testcpu, test_info, cur_site);
-      ProcessOneStepDelete(ctx, testcpu, test_info, cur_site);
-
-      // Process the hanging insertion on the first cycle through (to balance execution time)
-      if (cur_site == 0) {
-        cur_site = m_base_genome_size;
-        
-        sStep& oidata2 = m_onestep_insert[cur_site];
-        oidata2.peak_fitness = m_base_fitness;
-        oidata2.peak_genome = m_base_genome;
-        oidata2.site_count.Resize(m_base_genome_size + 1, 0);
-        
-        sStep& tidata2 = m_twostep_insert[cur_site];
-        tidata2.peak_fitness = m_base_fitness;
-        tidata2.peak_genome = m_base_genome;
-        tidata2.site_count.Resize(m_base_genome_size + 2, 0);
-        
-        sStep& tipdata2 = m_insert_point[cur_site];
-        tipdata2.peak_fitness = m_base_fitness;
-        tipdata2.peak_genome = m_base_genome;
-        tipdata2.site_count.Resize(m_base_genome_size + 1, 0);
-        
-        sStep& tiddata2 = m_insert_delete[cur_site];
-        tiddata2.peak_fitness = m_base_fitness;
-        tiddata2.peak_genome = m_base_genome;
-        tiddata2.site_count.Resize(m_base_genome_size + 1, 0);
-        
-        ProcessOneStepInsert(ctx, testcpu, test_info, cur_site); 
-      }
-
-      // Cleanup
-      delete testcpu;
-    }
-  } else {
+  if (!m_initialized) {
     ProcessInitialize(ctx);
     return;
   }
-  
-  m_mutex.Lock();
-  if (++m_completed == m_base_genome_size) ProcessComplete(ctx); 
   m_mutex.Unlock();
+  
+  // Each job uses a single test CPU and keeps claiming work units until none remain
+  cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
+  cCPUTestInfo test_info;
+  cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
+  
+  while (true) {
+    m_mutex.Lock();
+    int unit = m_cur_unit++;
+    m_mutex.Unlock();
+    
+    if (unit >= m_num_units) break;
+    
+    // Reseed per unit, so that the random stream does not depend on which job claimed the unit
+    ctx.GetRandom().ResetSeed(jobqueue.DeriveSeed(m_unit_seed, unit));
+    ProcessUnit(ctx, testcpu, test_info, unit);
+  }
+  
+  // Cleanup
+  delete testcpu;
+}
+
+
+double cMutationalNeighborhood::GetProgress()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (!m_initialized || m_num_units == 0) return 0.0;
+  return double(m_completed) / m_num_units;
+}
+
+int cMutationalNeighborhood::GetEstimatedSecondsRemaining()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (!m_initialized) return -1;
+  return EstimateSecondsRemaining();
+}
+
+int cMutationalNeighborhood::EstimateSecondsRemaining() const
+{
+  if (m_completed == 0) return -1;
+  const double elapsed = difftime(time(NULL), m_start_time);
+  return int(elapsed * (m_num_units - m_completed) / m_completed + 0.5);
 }
 
 
@@ -198,28 +146,174 @@ void cMutationalNeighborhood::ProcessInitialize(cAvidaContext& ctx)
   m_fitness_insert.ResizeClear(m_base_genome_size + 1, m_inst_set.GetSize());
   m_fitness_delete.ResizeClear(m_base_genome_size, 1);
   
-  m_cur_site = 0;
+  for (int i = 0; i < m_base_genome_size; i++) {
+    // Setup One Step Data
+    InitStep(m_onestep_point[i], m_base_genome_size);
+    InitStep(m_onestep_insert[i], m_base_genome_size + 1);
+    InitStep(m_onestep_delete[i], m_base_genome_size);
+    
+    // Setup Data Used in Two Step
+    InitStep(m_twostep_point[i], m_base_genome_size);
+    InitStep(m_twostep_insert[i], m_base_genome_size + 2);
+    InitStep(m_twostep_delete[i], m_base_genome_size);
+    
+    InitStep(m_insert_point[i], m_base_genome_size + 1);
+    InitStep(m_insert_delete[i], m_base_genome_size + 1);
+    InitStep(m_delete_point[i], m_base_genome_size);
+  }
+  
+  // The hanging insertion past the end of the genome
+  InitStep(m_onestep_insert[m_base_genome_size], m_base_genome_size + 1);
+  InitStep(m_twostep_insert[m_base_genome_size], m_base_genome_size + 2);
+  InitStep(m_insert_point[m_base_genome_size], m_base_genome_size + 1);
+  InitStep(m_insert_delete[m_base_genome_size], m_base_genome_size + 1);
+  
+  const int inst_size = m_inst_set.GetSize();
+  m_point_units.ResizeClear(m_base_genome_size);
+  for (int i = 0; i < m_point_units.GetSize(); i++) {
+    m_point_units[i].results.Resize(inst_size, NULL);
+    m_point_units[i].remaining = inst_size;
+  }
+  m_insert_units.ResizeClear(m_base_genome_size + 1);
+  for (int i = 0; i < m_insert_units.GetSize(); i++) {
+    m_insert_units[i].results.Resize(inst_size, NULL);
+    m_insert_units[i].remaining = inst_size;
+  }
+  
+  m_cur_unit = 0;
+  m_num_units = m_base_genome_size * (2 * inst_size + 1) + inst_size;
   m_completed = 0;
+  m_unit_seed = ctx.GetRandom().GetInt(ctx.GetRandom().MaxSeed());
+  m_start_time = time(NULL);
+  m_last_reported = 0;
   m_initialized = true;
   
   // Unlock internal mutex (was locked on Process() entrance)
   //  - will allow workers to begin processing if job queue already active
   m_mutex.Unlock();
   
-  // Load enough jobs to process all sites
+  // Load one job per worker, each of which processes work units until all have been claimed
   cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
-  for (int i = 0; i < m_base_genome_size; i++)
+  const int num_jobs = (jobqueue.GetNumWorkers() > 1) ? jobqueue.GetNumWorkers() : 1;
+  for (int i = 0; i < num_jobs; i++)
     jobqueue.AddJob(new tAnalyzeJob<cMutationalNeighborhood>(this, &cMutationalNeighborhood::Process));
   
   jobqueue.Start();
 }
 
 
-void cMutationalNeighborhood::ProcessOneStepPoint(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site)
+void cMutationalNeighborhood::ProcessUnit(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int unit)
 {
+  // Units are ordered by site, each site contributing one point unit per instruction, then one insertion unit per
+  // instruction, then its deletion.  The hanging insertion past the end of the genome comes last.  The earliest sites
+  // have the longest second step scans, so handing them out first keeps the tail of the run short.
   const int inst_size = m_inst_set.GetSize();
-  sStep& odata = m_onestep_point[cur_site];
+  const int site_units = 2 * inst_size + 1;
+  const int cur_site = unit / site_units;
+  const int offset = unit % site_units;
+  
+  if (cur_site == m_base_genome_size) ProcessOneStepInsert(ctx, testcpu, test_info, cur_site, offset);
+  else if (offset < inst_size) ProcessOneStepPoint(ctx, testcpu, test_info, cur_site, offset);
+  else if (offset < 2 * inst_size) ProcessOneStepInsert(ctx, testcpu, test_info, cur_site, offset - inst_size);
+  else ProcessOneStepDelete(ctx, testcpu, test_info, cur_site);
   
+  CompleteUnit(ctx);
+}
+
+
+void cMutationalNeighborhood::CompleteUnit(cAvidaContext& ctx)
+{
+  m_mutex.Lock();
+  m_completed++;
+  
+  if (m_completed < m_num_units && m_world->GetVerbosity() >= VERBOSE_ON) {
+    const int decile = (10 * m_completed) / m_num_units;
+    if (decile > m_last_reported) {
+      m_last_reported = decile;
+      cString msg;
+      msg.Set("mutational neighborhood %d%% complete, about %d seconds remaining", decile * 10, EstimateSecondsRemaining());
+      m_world->GetDriver().Feedback().Notify((const char*)msg);
+    }
+  }
+  
+  if (m_completed == m_num_units) ProcessComplete(ctx);
+  m_mutex.Unlock();
+}
+
+
+bool cMutationalNeighborhood::CompleteSiteUnit(sSiteUnits& site_units, int inst, sUnitResult* result)
+{
+  // Each unit owns its own result slot, only the remaining count must be synchronized
+  site_units.results[inst] = result;
+  
+  Apto::MutexAutoLock lock(m_mutex);
+  return (--site_units.remaining == 0);
+}
+
+
+inline void cMutationalNeighborhood::InitStep(sStep& step, int num_sites)
+{
+  step.peak_fitness = m_base_fitness;
+  step.peak_genome = m_base_genome;
+  step.site_count.Resize(num_sites, 0);
+}
+
+
+void cMutationalNeighborhood::MergeStep(sStep& dest, const sStep& src)
+{
+  dest.total += src.total;
+  dest.total_fitness += src.total_fitness;
+  dest.total_sqr_fitness += src.total_sqr_fitness;
+  dest.pos += src.pos;
+  dest.neg += src.neg;
+  dest.neut += src.neut;
+  dest.dead += src.dead;
+  dest.size_pos += src.size_pos;
+  dest.size_neg += src.size_neg;
+  
+  if (src.peak_fitness > dest.peak_fitness) {
+    dest.peak_fitness = src.peak_fitness;
+    dest.peak_genome = src.peak_genome;
+  }
+  
+  for (int i = 0; i < dest.site_count.GetSize(); i++) dest.site_count[i] += src.site_count[i];
+  
+  dest.task_target += src.task_target;
+  dest.task_total += src.task_total;
+  dest.task_knockout += src.task_knockout;
+  
+  dest.task_size_target += src.task_size_target;
+  dest.task_size_total += src.task_size_total;
+  dest.task_size_knockout += src.task_size_knockout;
+}
+
+
+void cMutationalNeighborhood::MergeSiteUnits(sSiteUnits& site_units, sStep& onestep, sTwoStep* twostep[], int num_twostep)
+{
+  // Merge in instruction order, so that peaks are resolved exactly as a sequential scan of the site would
+  for (int i = 0; i < site_units.results.GetSize(); i++) {
+    sUnitResult* result = site_units.results[i];
+    if (!result) continue;
+    
+    MergeStep(onestep, result->onestep);
+    for (int j = 0; j < num_twostep; j++) MergeStep(*twostep[j], result->twostep[j]);
+  }
+  
+  // Pending fitness entries are pushed onto the front of the list, so later units' entries belong in front
+  for (int i = site_units.results.GetSize() - 1; i >= 0; i--) {
+    sUnitResult* result = site_units.results[i];
+    if (!result) continue;
+    
+    for (int j = 0; j < num_twostep; j++) twostep[j]->pending.Transfer(result->twostep[j].pending);
+    delete result;
+    site_units.results[i] = NULL;
+  }
+}
+
+
+void cMutationalNeighborhood::ProcessOneStepPoint(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
+                                                  int cur_site, int inst_num)
+{
   m_mutex.Lock();
   Genome mod_genome(m_base_genome);
   m_mutex.Unlock();
@@ -228,28 +322,32 @@ void cMutationalNeighborhood::ProcessOneStepPoint(cAvidaContext& ctx, cTestCPU*
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
 
-  // Loop through all the lines of genome, testing trying all combinations.
   int cur_inst = seq[cur_site].GetOp();
   
-  // Fill in unmutated entry in fitness table with base fitness
-  m_fitness_point[cur_site][cur_inst] = m_base_fitness;
-  
-  // Loop through all instructions...
-  for (int inst_num = 0; inst_num < inst_size; inst_num++) {
-    if (cur_inst == inst_num) continue;
+  sUnitResult* result = NULL;
+  if (cur_inst == inst_num) {
+    // Fill in unmutated entry in fitness table with base fitness
+    m_fitness_point[cur_site][cur_inst] = m_base_fitness;
+  } else {
+    result = new sUnitResult;
+    InitStep(result->onestep, m_base_genome_size);
+    InitStep(result->twostep[0], m_base_genome_size);
     
     seq[cur_site].SetOp(inst_num);
-    m_fitness_point[cur_site][inst_num] = ProcessOneStepGenome(ctx, testcpu, test_info, mod_genome, odata, cur_site);
+    m_fitness_point[cur_site][inst_num] = ProcessOneStepGenome(ctx, testcpu, test_info, mod_genome, result->onestep, cur_site);
 
-    ProcessTwoStepPoint(ctx, testcpu, test_info, cur_site, mod_genome);
+    ProcessTwoStepPoint(ctx, testcpu, test_info, cur_site, mod_genome, result->twostep[0]);
+  }
+  
+  if (CompleteSiteUnit(m_point_units[cur_site], inst_num, result)) {
+    sTwoStep* twostep[] = { &m_twostep_point[cur_site] };
+    MergeSiteUnits(m_point_units[cur_site], m_onestep_point[cur_site], twostep, 1);
   }
 }
 
-void cMutationalNeighborhood::ProcessOneStepInsert(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site)
+void cMutationalNeighborhood::ProcessOneStepInsert(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
+                                                   int cur_site, int inst_num)
 {
-  const int inst_size = m_inst_set.GetSize();
-  sStep& odata = m_onestep_insert[cur_site];
-  
   m_mutex.Lock();
   Genome mod_genome(m_base_genome);
   m_mutex.Unlock();
@@ -259,20 +357,29 @@ void cMutationalNeighborhood::ProcessOneStepInsert(cAvidaContext& ctx, cTestCPU*
   InstructionSequence& seq = *seq_p;
   seq.Insert(cur_site, Instruction(0));
   
-  // Loop through all instructions...
-  for (int inst_num = 0; inst_num < inst_size; inst_num++) {
-    seq[cur_site].SetOp(inst_num);
-    m_fitness_insert[cur_site][inst_num] = ProcessOneStepGenome(ctx, testcpu, test_info, mod_genome, odata, cur_site);
-    
-    ProcessTwoStepInsert(ctx, testcpu, test_info, cur_site, mod_genome);
-    ProcessInsertPointCombo(ctx, testcpu, test_info, cur_site, mod_genome);
-    ProcessInsertDeleteCombo(ctx, testcpu, test_info, cur_site, mod_genome);
-  }  
+  sUnitResult* result = new sUnitResult;
+  InitStep(result->onestep, m_base_genome_size + 1);
+  InitStep(result->twostep[0], m_base_genome_size + 2);
+  InitStep(result->twostep[1], m_base_genome_size + 1);
+  InitStep(result->twostep[2], m_base_genome_size + 1);
+  
+  seq[cur_site].SetOp(inst_num);
+  m_fitness_insert[cur_site][inst_num] = ProcessOneStepGenome(ctx, testcpu, test_info, mod_genome, result->onestep, cur_site);
+  
+  ProcessTwoStepInsert(ctx, testcpu, test_info, cur_site, mod_genome, result->twostep[0]);
+  ProcessInsertPointCombo(ctx, testcpu, test_info, cur_site, mod_genome, result->twostep[1]);
+  ProcessInsertDeleteCombo(ctx, testcpu, test_info, cur_site, mod_genome, result->twostep[2]);
+  
+  if (CompleteSiteUnit(m_insert_units[cur_site], inst_num, result)) {
+    sTwoStep* twostep[] = { &m_twostep_insert[cur_site], &m_insert_point[cur_site], &m_insert_delete[cur_site] };
+    MergeSiteUnits(m_insert_units[cur_site], m_onestep_insert[cur_site], twostep, 3);
+  }
 }
 
 
 void cMutationalNeighborhood::ProcessOneStepDelete(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site)
 {
+  // A single unit covers the deletion of a site, so it accumulates directly into the per-site data
   sStep& odata = m_onestep_delete[cur_site];
   
   m_mutex.Lock();
@@ -285,8 +392,8 @@ void cMutationalNeighborhood::ProcessOneStepDelete(cAvidaContext& ctx, cTestCPU*
   seq.Remove(cur_site);
 
   m_fitness_delete[cur_site][0] = ProcessOneStepGenome(ctx, testcpu, test_info, mod_genome, odata, cur_site);
-  ProcessTwoStepDelete(ctx, testcpu, test_info, cur_site, mod_genome);
-  ProcessDeletePointCombo(ctx, testcpu, test_info, cur_site, mod_genome);
+  ProcessTwoStepDelete(ctx, testcpu, test_info, cur_site, mod_genome, m_twostep_delete[cur_site]);
+  ProcessDeletePointCombo(ctx, testcpu, test_info, cur_site, mod_genome, m_delete_point[cur_site]);
 }
 
 
@@ -294,10 +401,11 @@ double cMutationalNeighborhood::ProcessOneStepGenome(cAvidaContext& ctx, cTestCP
                                                      const Genome& mod_genome, sStep& odata, int cur_site)
 {
   // Run the modified genome through the Test CPU
-  testcpu->TestGenome(ctx, test_info, mod_genome);
+  cTestCPUCache::sResult result;
+  testcpu->TestGenome(ctx, test_info, mod_genome, result);
   
   // Collect the calculated fitness
-  double test_fitness = test_info.GetColonyFitness();
+  double test_fitness = result.fitness;
   
   
   odata.total_fitness += test_fitness;
@@ -322,7 +430,7 @@ double cMutationalNeighborhood::ProcessOneStepGenome(cAvidaContext& ctx, cTestCP
   if (test_fitness >= m_neut_min) odata.site_count[cur_site]++;
   
   if (test_fitness != 0.0) { // Only count tasks if the organism is alive
-    const Apto::Array<int>& cur_tasks = test_info.GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+    const Apto::Array<int>& cur_tasks = result.task_counts;
     bool knockout = false;
     bool anytask = false;
     for (int i = 0; i < m_base_tasks.GetSize(); i++) {
@@ -349,13 +457,12 @@ double cMutationalNeighborhood::ProcessOneStepGenome(cAvidaContext& ctx, cTestCP
 
 
 void cMutationalNeighborhood::ProcessTwoStepPoint(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
-                                                  int cur_site, Genome& mod_genome)
+                                                  int cur_site, Genome& mod_genome, sTwoStep& tdata)
 {
   const int inst_size = m_inst_set.GetSize();
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
-  sTwoStep& tdata = m_twostep_point[cur_site];
   sPendFit cur(m_fitness_point, cur_site, seq[cur_site].GetOp());
 
   // Loop through remaining lines of genome, testing trying all combinations.
@@ -376,14 +483,13 @@ void cMutationalNeighborhood::ProcessTwoStepPoint(cAvidaContext& ctx, cTestCPU*
 
 
 void cMutationalNeighborhood::ProcessTwoStepInsert(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
-                                                   int cur_site, Genome& mod_genome)
+                                                   int cur_site, Genome& mod_genome, sTwoStep& tdata)
 {
   const int inst_size = m_inst_set.GetSize();
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
   const int mod_size = seq.GetSize();
-  sTwoStep& tdata = m_twostep_insert[cur_site];
   sPendFit cur(m_fitness_insert, cur_site, seq[cur_site].GetOp());
   
   // Loop through all instructions...
@@ -400,13 +506,12 @@ void cMutationalNeighborhood::ProcessTwoStepInsert(cAvidaContext& ctx, cTestCPU*
 
 
 void cMutationalNeighborhood::ProcessTwoStepDelete(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
-                                                   int cur_site, Genome& mod_genome)
+                                                   int cur_site, Genome& mod_genome, sTwoStep& tdata)
 {
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
   const int mod_size = seq.GetSize();
-  sTwoStep& tdata = m_twostep_delete[cur_site];
   sPendFit cur(m_fitness_delete, cur_site, 0); // Delete 'inst' is always 0
   
   // Loop through all instructions...
@@ -420,13 +525,12 @@ void cMutationalNeighborhood::ProcessTwoStepDelete(cAvidaContext& ctx, cTestCPU*
 
 
 void cMutationalNeighborhood::ProcessInsertPointCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
-                                                      int cur_site, Genome& mod_genome)
+                                                      int cur_site, Genome& mod_genome, sTwoStep& tdata)
 {
   const int inst_size = m_inst_set.GetSize();
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
-  sTwoStep& tdata = m_insert_point[cur_site];
   sPendFit cur(m_fitness_insert, cur_site, seq[cur_site].GetOp());
   
   // Loop through all lines of genome, testing trying all combinations.
@@ -450,12 +554,11 @@ void cMutationalNeighborhood::ProcessInsertPointCombo(cAvidaContext& ctx, cTestC
 
 
 void cMutationalNeighborhood::ProcessInsertDeleteCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
-                                                       int cur_site, Genome& mod_genome)
+                                                       int cur_site, Genome& mod_genome, sTwoStep& tdata)
 {
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
-  sTwoStep& tdata = m_insert_delete[cur_site];
   sPendFit cur(m_fitness_insert, cur_site, seq[cur_site].GetOp());
 
   // Loop through all lines of genome, testing trying all combinations.
@@ -472,13 +575,12 @@ void cMutationalNeighborhood::ProcessInsertDeleteCombo(cAvidaContext& ctx, cTest
 
 
 void cMutationalNeighborhood::ProcessDeletePointCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
-                                                      int cur_site, Genome& mod_genome)
+                                                      int cur_site, Genome& mod_genome, sTwoStep& tdata)
 {
   const int inst_size = m_inst_set.GetSize();
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
-  sTwoStep& tdata = m_delete_point[cur_site];
   sPendFit cur(m_fitness_delete, cur_site, 0); // Delete 'inst' is always 0
   
   // Loop through all lines of genome, testing trying all combinations.
@@ -504,10 +606,11 @@ double cMutationalNeighborhood::ProcessTwoStepGenome(cAvidaContext& ctx, cTestCP
                                                      const sPendFit& cur, const sPendFit& oth)
 {
   // Run the modified genome through the Test CPU
-  testcpu->TestGenome(ctx, test_info, mod_genome);
+  cTestCPUCache::sResult result;
+  testcpu->TestGenome(ctx, test_info, mod_genome, result);
   
   // Collect the calculated fitness
-  double test_fitness = test_info.GetColonyFitness();
+  double test_fitness = result.fitness;
   
   tdata.total_fitness += test_fitness;
   tdata.total_sqr_fitness += test_fitness * test_fitness;
@@ -531,7 +634,7 @@ double cMutationalNeighborhood::ProcessTwoStepGenome(cAvidaContext& ctx, cTestCP
   if (test_fitness >= m_neut_min) tdata.site_count[cur.site]++;
   
   if (test_fitness != 0.0) { // Only count tasks if the organism is alive
-    const Apto::Array<int>& cur_tasks = test_info.GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+    const Apto::Array<int>& cur_tasks = result.task_counts;
     bool knockout = false;
     bool anytask = false;
     for (int i = 0; i < m_base_tasks.GetSize(); i++) {
@@ -726,6 +829,9 @@ void cMutationalNeighborhood::ProcessComplete(cAvidaContext&)
   m_insert_delete.Resize(0);
   m_delete_point.Resize(0);
   
+  m_point_units.Resize(0);
+  m_insert_units.Resize(0);
+  
   m_fitness_point.Resize(0, 0);
   m_fitness_insert.Resize(0, 0);
   m_fitness_delete.Resize(0, 0);
@@ -29,6 +29,8 @@
 #include "tList.h"
 #include "tMatrix.h"
 
+#include <ctime>
+
 class cAvidaContext;
 class cCPUMemory;
 class cCPUTestInfo;
@@ -52,8 +54,14 @@ private:
   Apto::Mutex m_mutex;
   
   bool m_initialized;
-  int m_cur_site;
+  int m_cur_unit;
+  int m_num_units;
   int m_completed;
+  int m_unit_seed;
+  
+  // Progress tracking
+  time_t m_start_time;
+  int m_last_reported;  // last progress decile reported via feedback
   
   const cInstSet& m_inst_set;  
   int m_target;
@@ -142,6 +150,29 @@ private:
   Apto::Array<sTwoStep> m_insert_point;
   Apto::Array<sTwoStep> m_insert_delete;
   Apto::Array<sTwoStep> m_delete_point;
+  
+  
+  // Work Units
+  // -----------------------------------------------------------------------------------------------------------------------
+  
+  // Point and insertion sites are split into one work unit per first step instruction, so that the O(L*I) second step
+  // scans of a single site may run concurrently.  Each unit accumulates into its own sUnitResult without locking.  Once
+  // every unit of a site has finished, the results are merged into the per-site data above in instruction order, so
+  // the totals are independent of how the units were scheduled.
+  struct sUnitResult
+  {
+    sStep onestep;
+    sTwoStep twostep[3];
+  };
+  struct sSiteUnits
+  {
+    Apto::Array<sUnitResult*> results;
+    int remaining;
+    
+    sSiteUnits() : remaining(0) { ; }
+  };
+  Apto::Array<sSiteUnits> m_point_units;
+  Apto::Array<sSiteUnits> m_insert_units;
 
 
   // One Step Fitness Data
@@ -235,26 +266,44 @@ public:
   ~cMutationalNeighborhood() { ; }
   
   void Process(cAvidaContext& ctx);
+  
+  // Progress of a running Process(), may be called from any thread
+  double GetProgress();
+  int GetEstimatedSecondsRemaining();
 
 
 private:
   // Internal Calculation Methods
   // -----------------------------------------------------------------------------------------------------------------------
   void ProcessInitialize(cAvidaContext& ctx);
+  void ProcessUnit(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int unit);
+  void CompleteUnit(cAvidaContext& ctx);
+  bool CompleteSiteUnit(sSiteUnits& site_units, int inst, sUnitResult* result);
+  int EstimateSecondsRemaining() const;
+  
+  inline void InitStep(sStep& step, int num_sites);
+  void MergeStep(sStep& dest, const sStep& src);
+  void MergeSiteUnits(sSiteUnits& site_units, sStep& onestep, sTwoStep* twostep[], int num_twostep);
   
-  void ProcessOneStepPoint(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site);
-  void ProcessOneStepInsert(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site);
+  void ProcessOneStepPoint(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, int inst_num);
+  void ProcessOneStepInsert(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, int inst_num);
   void ProcessOneStepDelete(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site);
   double ProcessOneStepGenome(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, const Genome& mod_genome,
                               sStep& odata, int cur_site);
   void AggregateOneStep(Apto::Array<sStep>& steps, sOneStepAggregate& osa);
 
-  void ProcessTwoStepPoint(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
-  void ProcessTwoStepInsert(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
-  void ProcessTwoStepDelete(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
-  void ProcessInsertPointCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
-  void ProcessInsertDeleteCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
-  void ProcessDeletePointCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
+  void ProcessTwoStepPoint(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome,
+                           sTwoStep& tdata);
+  void ProcessTwoStepInsert(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome,
+                            sTwoStep& tdata);
+  void ProcessTwoStepDelete(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome,
+                            sTwoStep& tdata);
+  void ProcessInsertPointCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site,
+                               Genome& mod_genome, sTwoStep& tdata);
+  void ProcessInsertDeleteCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site,
+                                Genome& mod_genome, sTwoStep& tdata);
+  void ProcessDeletePointCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site,
+                               Genome& mod_genome, sTwoStep& tdata);
   double ProcessTwoStepGenome(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, const Genome& mod_genome,
                               sTwoStep& tdata, const sPendFit& cur, const sPendFit& oth);
   void AggregateTwoStep(Apto::Array<sTwoStep>& steps, sTwoStepAggregate& osa);
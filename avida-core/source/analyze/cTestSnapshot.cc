@@ -0,0 +1,167 @@
+/*
+ *  cTestSnapshot.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cTestSnapshot.h"
+
+#include "apto/platform.h"
+#include "avida/systematics/Arbiter.h"
+#include "avida/systematics/Group.h"
+#include "avida/systematics/Manager.h"
+
+#include "cAnalyze.h"
+#include "cAnalyzeJob.h"
+#include "cAnalyzeJobQueue.h"
+#include "cAvidaContext.h"
+#include "cOrganism.h"
+#include "cPhenotype.h"
+#include "cPopulation.h"
+#include "cPopulationCell.h"
+#include "cStats.h"
+#include "cWorld.h"
+
+using namespace Avida;
+
+#if APTO_PLATFORM(WINDOWS) && defined(AddJob)
+# undef AddJob
+#endif
+
+
+class cTestSnapshot::cTestJob : public cAnalyzeJob
+{
+private:
+  cTestSnapshot* m_snapshot;
+  int m_begin;
+  int m_end;
+  int m_base_seed;  // seed of the root job, -1 on the root itself
+
+public:
+  cTestJob(cTestSnapshot* snapshot, int begin, int end, int base_seed)
+    : m_snapshot(snapshot), m_begin(begin), m_end(end), m_base_seed(base_seed) { ; }
+
+  void Run(cAvidaContext& ctx)
+  {
+    if (m_base_seed < 0) m_base_seed = GetSeed();
+
+    // Each genotype is a full test CPU run, so hand every one but the first off to be stolen
+    while (m_end - m_begin > 1) {
+      const int mid = m_begin + (m_end - m_begin) / 2;
+      SpawnJob(new cTestJob(m_snapshot, mid, m_end, m_base_seed));
+      m_end = mid;
+    }
+
+    if (m_snapshot->m_background) ctx.SetBackgroundMode(m_snapshot->m_tot_creatures);
+    for (int i = m_begin; i < m_end; i++) {
+      ctx.GetRandom().ResetSeed(m_snapshot->m_queue->DeriveSeed(m_base_seed, i));
+      m_snapshot->Test(ctx, i);
+    }
+    ctx.ClearBackgroundMode();
+
+    // Signal while holding the lock, the world may release the snapshot as soon as it is released
+    Apto::MutexAutoLock lock(m_snapshot->m_mutex);
+    m_snapshot->m_remaining -= (m_end - m_begin);
+    if (m_snapshot->m_remaining == 0) m_snapshot->m_cond.Broadcast();
+  }
+};
+
+
+cTestSnapshot::cTestSnapshot(cWorld* world)
+  : m_world(world), m_update(world->GetStats().GetUpdate()), m_generation(world->GetStats().SumGeneration().Average())
+  , m_tot_creatures(world->GetStats().GetTotCreatures()), m_queue(NULL), m_background(false), m_remaining(0)
+{
+}
+
+
+void cTestSnapshot::CapturePopulation(bool with_merits)
+{
+  cPopulation& pop = m_world->GetPopulation();
+  Apto::Map<int, int> genotype_idx;
+
+  for (int i = 0; i < pop.GetSize(); i++) {
+    if (pop.GetCell(i).IsOccupied() == false) continue;
+
+    cOrganism* organism = pop.GetCell(i).GetOrganism();
+    Systematics::GroupPtr bg = organism->SystematicsGroup("genotype");
+
+    int idx = -1;
+    if (!genotype_idx.Get(bg->ID(), idx)) {
+      idx = m_genotypes.GetSize();
+      genotype_idx.Set(bg->ID(), idx);
+      m_genotypes.Resize(idx + 1);
+      captureGenotype(m_genotypes[idx], bg);
+      m_genotypes[idx].num_units = 0;
+    }
+
+    m_genotypes[idx].num_units++;
+    m_organisms.Push(idx);
+    if (with_merits) m_merits.Push(organism->GetPhenotype().GetMerit().GetDouble());
+  }
+}
+
+
+void cTestSnapshot::CaptureGenotypes(int max_genotypes)
+{
+  Systematics::ManagerPtr classmgr = Systematics::Manager::Of(m_world->GetNewWorld());
+  Systematics::Arbiter::IteratorPtr it = classmgr->ArbiterForRole("genotype")->Begin();
+
+  while ((max_genotypes <= 0 || m_genotypes.GetSize() < max_genotypes) && it->Next()) {
+    m_genotypes.Resize(m_genotypes.GetSize() + 1);
+    captureGenotype(m_genotypes[m_genotypes.GetSize() - 1], it->Get());
+  }
+}
+
+
+bool cTestSnapshot::IsComplete()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return (m_remaining == 0);
+}
+
+
+void cTestSnapshot::Wait()
+{
+  m_mutex.Lock();
+  while (m_remaining > 0) m_cond.Wait(m_mutex);
+  m_mutex.Unlock();
+}
+
+
+void cTestSnapshot::submit(bool background)
+{
+  if (!m_genotypes.GetSize()) return;
+
+  m_queue = &m_world->GetAnalyze().GetJobQueue();
+  m_background = background;
+  m_remaining = m_genotypes.GetSize();
+
+  // Without worker threads the queue runs the job inline, and the snapshot is complete on return
+  m_queue->AddJobImmediate(new cTestJob(this, 0, m_genotypes.GetSize(), -1));
+}
+
+
+void cTestSnapshot::captureGenotype(sGenotype& entry, Systematics::GroupPtr bg)
+{
+  // Rebuilt from the genome string, so that the workers never share genome data with the live genotype
+  entry.id = bg->ID();
+  entry.genome = Genome(bg->Properties().Get("genome"));
+  entry.name = (const char*)bg->Properties().Get("name").StringValue();
+  entry.parents = (const char*)bg->Properties().Get("parents").StringValue();
+  entry.threshold = (bool)Apto::StrAs(bg->Properties().Get("threshold"));
+  entry.num_units = bg->NumUnits();
+}
@@ -0,0 +1,116 @@
+/*
+ *  cTestSnapshot.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cTestSnapshot_h
+#define cTestSnapshot_h
+
+#include "apto/core.h"
+#include "apto/core/Mutex.h"
+#include "avida/core/Genome.h"
+#include "avida/systematics/Types.h"
+
+#include "cString.h"
+
+class cAnalyzeJobQueue;
+class cAvidaContext;
+class cWorld;
+
+
+/**
+ * Test CPU analysis of the population as it stood at one update.  Capturing copies the distinct genotypes (along with
+ * whatever per-organism state the analysis needs) out of the live population, then every genotype is tested once on
+ * the analyze job queue while the run carries on.  Once all genotypes have been tested, the world calls Write() from
+ * the main thread, in the order the snapshots were submitted, so output still appears in update order.
+ *
+ * Test() runs on the worker threads and may only read the captured genotype and store into its own result slot; it
+ * must not touch the population, which keeps changing underneath it.  Its test CPUs do read the environment and the
+ * configuration, so the world finishes pending snapshots before anything other than output actions runs (see
+ * cWorld::FinishSnapshots).  Write() must likewise rely only on the snapshot, as it may run several updates after the
+ * capture or while the world is being torn down.
+ **/
+
+class cTestSnapshot : public Apto::RefCountObject<Apto::ThreadSafe>
+{
+  friend class cWorld;
+
+public:
+  struct sGenotype
+  {
+    int id;
+    Avida::Genome genome;
+    cString name;
+    cString parents;
+    bool threshold;
+    int num_units;
+  };
+
+protected:
+  class cTestJob;
+  friend class cTestJob;
+
+protected:
+  cWorld* m_world;
+  int m_update;
+  double m_generation;
+  int m_tot_creatures;
+  Apto::Array<sGenotype> m_genotypes;
+  Apto::Array<int> m_organisms;     // genotype of each living organism, by cell, when captured from the population
+  Apto::Array<double> m_merits;     // current merit of each living organism, only when captured with merits
+
+private:
+  cAnalyzeJobQueue* m_queue;
+  bool m_background;                // tested alongside a running population, rather than waited on in analyze mode
+  int m_remaining;
+  Apto::Mutex m_mutex;
+  Apto::ConditionVariable m_cond;
+
+
+  cTestSnapshot(); // @not_implemented
+  cTestSnapshot(const cTestSnapshot&); // @not_implemented
+  cTestSnapshot& operator=(const cTestSnapshot&); // @not_implemented
+
+public:
+  cTestSnapshot(cWorld* world);
+  virtual ~cTestSnapshot() { ; }
+
+  int GetUpdate() const { return m_update; }
+  int GetNumGenotypes() const { return m_genotypes.GetSize(); }
+
+  // Capture the distinct genotypes of the living organisms, in order of their first appearance by cell
+  void CapturePopulation(bool with_merits = false);
+
+  // Capture the genotypes in systematics order, stopping after max_genotypes when it is positive
+  void CaptureGenotypes(int max_genotypes = -1);
+
+  bool IsComplete();
+  void Wait();
+
+protected:
+  virtual void Test(cAvidaContext& ctx, int idx) = 0;
+  virtual void Write(cAvidaContext& ctx) = 0;
+
+private:
+  void submit(bool background);
+  void captureGenotype(sGenotype& entry, Avida::Systematics::GroupPtr bg);
+};
+
+typedef Apto::SmartPtr<cTestSnapshot, Apto::InternalRCObject> cTestSnapshotPtr;
+
+#endif
@@ -26,7 +26,7 @@
 #include "apto/platform.h"
 
 #include "cAnalyzeJobQueue.h"
-#include "tAnalyzeJob.h"
+#include "tAnalyzeParallelFor.h"
 
 class cAvidaContext;
 
@@ -38,59 +38,38 @@ class cAvidaContext;
 template<class JobClass> class tAnalyzeJobBatch
 {
 protected:
-  template<class T> class tAnalyzeBatchJob;
-  friend class tAnalyzeBatchJob<JobClass>;
+  struct sBatchEntry
+  {
+    JobClass* target;
+    void (JobClass::*fun)(cAvidaContext&);
+  };
   
 protected:
   cAnalyzeJobQueue& m_queue;
   
-  int m_jobs;
-  
-  Apto::Mutex m_mutex;
-  Apto::ConditionVariable m_cond;
+  Apto::Array<sBatchEntry, Apto::Smart> m_entries;
   
   
 public:
-  tAnalyzeJobBatch(cAnalyzeJobQueue& queue) : m_queue(queue), m_jobs(0) { ; }
+  tAnalyzeJobBatch(cAnalyzeJobQueue& queue) : m_queue(queue) { ; }
   
   void AddJob(JobClass* target, void (JobClass::*funJ)(cAvidaContext&))
   {
-    m_mutex.Lock();
-    m_jobs++;
-    m_mutex.Unlock();
-    m_queue.AddJob(new tAnalyzeBatchJob<JobClass>(this, target, funJ));
+    sBatchEntry entry;
+    entry.target = target;
+    entry.fun = funJ;
+    m_entries.Push(entry);
   }
   
   void RunBatch()
   {
-    m_queue.Start();
-    m_mutex.Lock();
-    while (m_jobs > 0) {
-      m_cond.Wait(m_mutex);
-    }
-    m_mutex.Unlock();
+    tAnalyzeParallelFor<tAnalyzeJobBatch<JobClass> > loop(m_queue);
+    loop.Run(this, &tAnalyzeJobBatch<JobClass>::runEntry, m_entries.GetSize());
+    m_entries.Resize(0);
   }
   
 protected:
-  template<class T> class tAnalyzeBatchJob : public tAnalyzeJob<T>
-  {
-  protected:
-    tAnalyzeJobBatch<T>* m_batch;
-    
-  public:
-    tAnalyzeBatchJob(tAnalyzeJobBatch<T>* batch, T* target, void (T::*funJ)(cAvidaContext&))
-      : tAnalyzeJob<T>(target, funJ), m_batch(batch) { ; }
-    
-    void Run(cAvidaContext& ctx)
-    {
-      tAnalyzeJob<T>::Run(ctx);
-      
-      m_batch->m_mutex.Lock();
-      m_batch->m_jobs--;
-      m_batch->m_mutex.Unlock();
-      m_batch->m_cond.Signal();
-    }
-  };
+  void runEntry(cAvidaContext& ctx, int idx) { (m_entries[idx].target->*(m_entries[idx].fun))(ctx); }
 };
 
 
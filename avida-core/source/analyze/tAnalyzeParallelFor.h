@@ -0,0 +1,124 @@
+/*
+ *  tAnalyzeParallelFor.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef tAnalyzeParallelFor_h
+#define tAnalyzeParallelFor_h
+
+#include "apto/core.h"
+#include "apto/platform.h"
+
+#include "cAnalyzeJob.h"
+#include "cAnalyzeJobQueue.h"
+#include "cAvidaContext.h"
+
+#if APTO_PLATFORM(WINDOWS) && defined(AddJob)
+# undef AddJob
+#endif
+
+
+/**
+ * Runs (target->*fun)(ctx, i) for every i in [0, count) on the analyze job queue and waits for completion.  The range
+ * is split recursively into child jobs, at most 'grain' indices each, that idle workers steal.  The context random
+ * number generator is reseeded before every index from the root job's seed, so results do not depend on the grain or
+ * on how the ranges end up scheduled.
+ *
+ * Must not be called from within an analyze job, the calling thread blocks until all indices have been processed.
+ **/
+
+template<class T> class tAnalyzeParallelFor
+{
+protected:
+  class cRangeJob;
+  friend class cRangeJob;
+
+protected:
+  cAnalyzeJobQueue& m_queue;
+  int m_grain;
+
+  T* m_target;
+  void (T::*m_fun)(cAvidaContext&, int);
+
+  int m_remaining;
+
+  Apto::Mutex m_mutex;
+  Apto::ConditionVariable m_cond;
+
+
+public:
+  tAnalyzeParallelFor(cAnalyzeJobQueue& queue, int grain = 1)
+    : m_queue(queue), m_grain((grain > 0) ? grain : 1), m_target(NULL), m_fun(NULL), m_remaining(0) { ; }
+
+  void Run(T* target, void (T::*fun)(cAvidaContext&, int), int count)
+  {
+    if (count <= 0) return;
+
+    m_target = target;
+    m_fun = fun;
+    m_remaining = count;
+
+    m_queue.AddJob(new cRangeJob(this, 0, count, -1));
+    m_queue.Start();
+
+    m_mutex.Lock();
+    while (m_remaining > 0) {
+      m_cond.Wait(m_mutex);
+    }
+    m_mutex.Unlock();
+  }
+
+protected:
+  class cRangeJob : public cAnalyzeJob
+  {
+  protected:
+    tAnalyzeParallelFor<T>* m_loop;
+    int m_begin;
+    int m_end;
+    int m_base_seed;  // seed of the root range job, -1 on the root itself
+
+  public:
+    cRangeJob(tAnalyzeParallelFor<T>* loop, int begin, int end, int base_seed)
+      : m_loop(loop), m_begin(begin), m_end(end), m_base_seed(base_seed) { ; }
+
+    void Run(cAvidaContext& ctx)
+    {
+      if (m_base_seed < 0) m_base_seed = GetSeed();
+
+      // Hand off the upper halves, keeping the lowest slice for this job
+      while (m_end - m_begin > m_loop->m_grain) {
+        const int mid = m_begin + (m_end - m_begin) / 2;
+        SpawnJob(new cRangeJob(m_loop, mid, m_end, m_base_seed));
+        m_end = mid;
+      }
+
+      for (int i = m_begin; i < m_end; i++) {
+        ctx.GetRandom().ResetSeed(m_loop->m_queue.DeriveSeed(m_base_seed, i));
+        (m_loop->m_target->*(m_loop->m_fun))(ctx, i);
+      }
+
+      // Signal while holding the lock, the waiting thread may destroy the loop as soon as it is released
+      Apto::MutexAutoLock lock(m_loop->m_mutex);
+      m_loop->m_remaining -= (m_end - m_begin);
+      if (m_loop->m_remaining == 0) m_loop->m_cond.Signal();
+    }
+  };
+};
+
+
+#endif
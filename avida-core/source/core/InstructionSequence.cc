@@ -26,6 +26,9 @@
 
 #include "AvidaTools.h"
 
+#include <cstring>
+#include <stdint.h>
+
 using namespace AvidaTools;
 
 
@@ -494,16 +497,42 @@ int Avida::InstructionSequence::FindHammingDistance(const InstructionSequence& s
   // Initialize the hamming distance to anything protruding past the overlap.
   
   int hamming_distance = seq1.GetSize() + seq2.GetSize() - 2 * overlap;
-  
-  // Cycle through the overlap adding all differences to the distance.
-  for (int i = 0; i < overlap; i++) {
-    if (seq1[start1 + i] != seq2[start2 + i])  hamming_distance++;
+  if (overlap <= 0) return hamming_distance;
+  
+  // Cycle through the overlap adding all differences to the distance, eight sites at a time.
+  const unsigned char* site1 = reinterpret_cast<const unsigned char*>(&seq1[start1]);
+  const unsigned char* site2 = reinterpret_cast<const unsigned char*>(&seq2[start2]);
+  int i = 0;
+  for (; i + 8 <= overlap; i += 8) {
+    uint64_t word1, word2;
+    memcpy(&word1, site1 + i, 8);
+    memcpy(&word2, site2 + i, 8);
+    
+    // Fold each differing byte down onto its low bit, then add up the low bits of all eight bytes.
+    uint64_t diff = word1 ^ word2;
+    diff |= diff >> 4;
+    diff |= diff >> 2;
+    diff |= diff >> 1;
+    diff &= 0x0101010101010101ULL;
+    hamming_distance += static_cast<int>((diff * 0x0101010101010101ULL) >> 56);
+  }
+  for (; i < overlap; i++) {
+    if (site1[i] != site2[i])  hamming_distance++;
   }
   
   return hamming_distance;
 }
 
 
+void Avida::InstructionSequence::FindHammingDistances(const InstructionSequence& seq1,
+                                                     const Apto::Array<const InstructionSequence*>& seqs,
+                                                     Apto::Array<int>& distances)
+{
+  distances.Resize(seqs.GetSize());
+  for (int i = 0; i < seqs.GetSize(); i++) distances[i] = FindHammingDistance(seq1, *seqs[i]);
+}
+
+
 int Avida::InstructionSequence::FindBestOffset(const InstructionSequence& seq1, const InstructionSequence& seq2)
 {
   const int size1 = seq1.GetSize();
@@ -544,6 +573,96 @@ int Avida::InstructionSequence::FindSlidingDistance(const InstructionSequence& s
 }
 
 
+// EditDistancePattern - bit-parallel Levenshtein distance (Myers 1999, with Hyyro's formulation)
+// --------------------------------------------------------------------------------------------------------------
+//
+// Rather than filling in the dynamic programming chart one cell at a time, each column of the chart is held as a pair of
+// bit vectors recording where consecutive cells go up (pv) or down (mv) by one.  A whole column is then advanced with a
+// handful of word operations per 64 sites of the pattern.  The match vectors for the pattern are built once, so one
+// pattern can be compared against many sequences.
+
+namespace Avida {
+  class EditDistancePattern
+  {
+  private:
+    int m_size;
+    int m_blocks;
+    uint64_t m_last_bit;
+    int m_slot[256];              // Match vector slot for each instruction, slot 0 never matches
+    Apto::Array<uint64_t> m_peq;  // Match vectors, m_blocks words per slot
+    Apto::Array<uint64_t> m_pv;
+    Apto::Array<uint64_t> m_mv;
+    
+  public:
+    EditDistancePattern(const unsigned char* pattern, int size);
+    
+    int Distance(const unsigned char* text, int size);
+  };
+};
+
+
+Avida::EditDistancePattern::EditDistancePattern(const unsigned char* pattern, int size)
+  : m_size(size), m_blocks((size + 63) / 64), m_last_bit(1ULL << ((size + 63) % 64)), m_pv(m_blocks), m_mv(m_blocks)
+{
+  for (int i = 0; i < 256; i++) m_slot[i] = 0;
+  int num_slots = 1;
+  for (int i = 0; i < size; i++) if (m_slot[pattern[i]] == 0) m_slot[pattern[i]] = num_slots++;
+  
+  m_peq.Resize(num_slots * m_blocks);
+  m_peq.SetAll(0);
+  for (int i = 0; i < size; i++) m_peq[m_slot[pattern[i]] * m_blocks + i / 64] |= 1ULL << (i % 64);
+}
+
+
+int Avida::EditDistancePattern::Distance(const unsigned char* text, int size)
+{
+  if (m_size == 0) return size;
+  
+  for (int b = 0; b < m_blocks; b++) {
+    m_pv[b] = ~0ULL;
+    m_mv[b] = 0;
+  }
+  
+  int score = m_size;
+  for (int j = 0; j < size; j++) {
+    const uint64_t* eq_vec = &m_peq[m_slot[text[j]] * m_blocks];
+    
+    // The top row of the chart grows by one with each site of the text, so a +1 enters the first block.
+    int h_in = 1;
+    for (int b = 0; b < m_blocks; b++) {
+      const uint64_t pv = m_pv[b];
+      const uint64_t mv = m_mv[b];
+      uint64_t eq = eq_vec[b];
+      
+      const uint64_t xv = eq | mv;
+      if (h_in < 0) eq |= 1;
+      const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+      uint64_t ph = mv | ~(xh | pv);
+      uint64_t mh = pv & xh;
+      
+      const uint64_t high_bit = (b == m_blocks - 1) ? m_last_bit : (1ULL << 63);
+      int h_out = 0;
+      if (ph & high_bit) h_out = 1;
+      else if (mh & high_bit) h_out = -1;
+      
+      ph <<= 1;
+      mh <<= 1;
+      if (h_in < 0) mh |= 1;
+      else if (h_in > 0) ph |= 1;
+      
+      m_pv[b] = mh | ~(xv | ph);
+      m_mv[b] = ph & xv;
+      h_in = h_out;
+    }
+    
+    // Whatever leaves the bottom of the last block is the change in the bottom-right corner of the chart.
+    score += h_in;
+  }
+  
+  return score;
+}
+
+
 int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2)
 {
   const int size1 = seq1.GetSize();
@@ -564,50 +683,25 @@ int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1
   
   if (test_size1 <= 0 || test_size2 <=0) return abs(test_size1 - test_size2);
   
-  // Now match everything else...
-  int* cur_row  = new int[test_size1];  // The row we are calculating
-  int* prev_row = new int[test_size1];  // The last row we calculated
-  
-  // Initialize the previous row to record the differece from nothing.
-  for (int i = 0; i < test_size1; i++)  prev_row[i] = i + 1;
+  // Now match everything else, using the shorter of the two remainders as the pattern.
+  const unsigned char* sites1 = reinterpret_cast<const unsigned char*>(&seq1[match_front]);
+  const unsigned char* sites2 = reinterpret_cast<const unsigned char*>(&seq2[match_front]);
+  if (test_size1 <= test_size2) return EditDistancePattern(sites1, test_size1).Distance(sites2, test_size2);
+  return EditDistancePattern(sites2, test_size2).Distance(sites1, test_size1);
+}
+
+
+void Avida::InstructionSequence::FindEditDistances(const InstructionSequence& seq1,
+                                                  const Apto::Array<const InstructionSequence*>& seqs,
+                                                  Apto::Array<int>& distances)
+{
+  distances.Resize(seqs.GetSize());
   
-  // Loop through each subsequent character in the test code
-  for (int i = 0; i < test_size2; i++) {
-    // Initialize the first entry in cur_row.
-    if (seq1[match_front] == seq2[match_front + i]) cur_row[0] = i;
-    else cur_row[0] = (i < prev_row[0]) ? (i+1) : (prev_row[0] + 1);
-    
-    // Move down the cur_row and fill it out.
-    for (int j = 1; j < test_size1; j++) {
-      // If the values are equal, keep the value in the upper left.
-      if (seq1[match_front + j] == seq2[match_front + i]) {
-        cur_row[j] = prev_row[j-1];
-      }
-      
-      // Otherwise, set the current position the the minimal of the three
-      // numbers above (insertion), to the left (deletion), or upper left
-      // (mutation) in the chart, plus one.
-      else {
-        cur_row[j] = (prev_row[j] < prev_row[j-1]) ? prev_row[j] : prev_row[j-1];
-        if (cur_row[j-1] < cur_row[j]) cur_row[j] = cur_row[j-1];
-        cur_row[j]++;
-      }
-    }
-    
-    // Swap cur_row and prev_row. (we only really need to move the cur row
-    // over to prev, but this saves us from having to keep re-allocating
-    // new rows.  We recycle!
-    int* temp_row = cur_row;
-    cur_row = prev_row;
-    prev_row = temp_row;
+  const int size1 = seq1.GetSize();
+  EditDistancePattern pattern((size1) ? reinterpret_cast<const unsigned char*>(&seq1[0]) : NULL, size1);
+  for (int i = 0; i < seqs.GetSize(); i++) {
+    const InstructionSequence& seq2 = *seqs[i];
+    const int size2 = seq2.GetSize();
+    distances[i] = (size2) ? pattern.Distance(reinterpret_cast<const unsigned char*>(&seq2[0]), size2) : size1;
   }
-  
-  // Now that we are done, return the bottom-right corner of the chart.
-  
-  const int value = prev_row[test_size1 - 1];
-  
-  delete [] cur_row;
-  delete [] prev_row;
-  
-  return value;
 }
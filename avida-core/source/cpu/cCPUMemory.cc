@@ -22,6 +22,8 @@
 
 #include "cCPUMemory.h"
 
+#include "cCheckpoint.h"
+
 using namespace std;
 using namespace Avida;
 
@@ -179,3 +181,24 @@ void cCPUMemory::operator=(const InstructionSequence& other_genome)
   }
 }
 
+
+
+void cCPUMemory::Checkpoint(cCheckpoint& ckpt)
+{
+  int size = m_active_size;
+  ckpt.Transfer(size);
+  if (!ckpt.IsOK()) return;
+  if (ckpt.IsLoading()) {
+    if (size < 0) {
+      ckpt.Fail("invalid memory size");
+      return;
+    }
+    Resize(size);
+  }
+  for (int i = 0; i < size; i++) {
+    unsigned char op = static_cast<unsigned char>(m_seq[i].GetOp());
+    ckpt.Transfer(op);
+    ckpt.Transfer(m_flag_array[i]);
+    if (ckpt.IsLoading()) m_seq[i].SetOp(op);
+  }
+}
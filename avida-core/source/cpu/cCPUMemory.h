@@ -25,6 +25,8 @@
 
 #include "avida/core/InstructionSequence.h"
 
+class cCheckpoint;
+
 
 class cCPUMemory : public Avida::InstructionSequence
 {
@@ -91,6 +93,8 @@ public:
   void Remove(int pos, int num_sites = 1);
   void Replace(int pos, int num_sites, const InstructionSequence& genome);
 
+  void Checkpoint(cCheckpoint& ckpt);
+
   void operator=(const cCPUMemory& other_memory);
   void operator=(const InstructionSequence& other_genome);
 };
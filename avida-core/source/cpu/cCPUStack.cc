@@ -23,6 +23,7 @@
 #include "cCPUStack.h"
 
 #include <cassert>
+#include "cCheckpoint.h"
 #include "cString.h"
 
 using namespace std;
@@ -75,3 +76,10 @@ void cCPUStack::LoadState(istream & fp)
     Push(value);
   }
 }
+
+void cCPUStack::Checkpoint(cCheckpoint& ckpt)
+{
+  for (int i = 0; i < nHardware::STACK_SIZE; i++) ckpt.Transfer(stack[i]);
+  ckpt.Transfer(stack_pointer);
+  if (stack_pointer >= nHardware::STACK_SIZE) ckpt.Fail("invalid stack pointer");
+}
@@ -22,6 +22,7 @@
 
 #include "cCodeLabel.h"
 
+#include "cCheckpoint.h"
 
 #include <cmath>
 #include <vector>
@@ -34,6 +35,12 @@ using namespace std;
 const int cCodeLabel::MAX_LENGTH = 10;
 
 
+void cCodeLabel::Checkpoint(cCheckpoint& ckpt)
+{
+  ckpt.Transfer(m_nops);
+  if (m_nops.GetSize() > MAX_LENGTH) ckpt.Fail("invalid label length");
+}
+
 void cCodeLabel::ReadString(const cString& label_str)
 {
   cString lbl(label_str);
@@ -28,6 +28,8 @@
 #include "cString.h"
 #include "nHardware.h"
 
+class cCheckpoint;
+
 /**
  * The cCodeLabel class is used to identify a label within the genotype of
  * a creature, and aid in its manipulation.
@@ -61,6 +63,8 @@ public:
   inline void Rotate(const int rot, const int base);
 
   inline int GetSize() const { return m_nops.GetSize(); }
+
+  void Checkpoint(cCheckpoint& ckpt);
   
   inline cString AsString() const;
   
@@ -26,6 +26,7 @@
 #include "avida/core/WorldDriver.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cCodeLabel.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
@@ -127,6 +128,19 @@ void cHardwareBase::ResizeCostArrays(int new_size)
   m_active_thread_post_costs.SetAll(0);
 }
 
+// Instruction costs still owed, shared by all hardware types.  The per-instruction cost tables are rebuilt from the
+// instruction set by Reset(), so only the values that count down during execution are saved.
+void cHardwareBase::checkpointBaseState(cCheckpoint& ckpt)
+{
+  ckpt.Transfer(m_inst_cost);
+  ckpt.Transfer(m_female_cost);
+  ckpt.Transfer(m_task_switching_cost);
+  ckpt.Transfer(m_inst_ft_cost);
+  ckpt.Transfer(m_active_thread_costs);
+  ckpt.Transfer(m_active_thread_post_costs);
+  ckpt.Transfer(m_ext_mem);
+}
+
 int cHardwareBase::calcExecutedSize(const int parent_size)
 {
   int executed_size = 0;
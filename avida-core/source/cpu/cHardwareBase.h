@@ -33,9 +33,11 @@
 
 #include "cHardwareTracer.h"
 #include "cInstSet.h"
+#include "cObjectPool.h"
 #include "tBuffer.h"
 
 class cAvidaContext;
+class cCheckpoint;
 class cCodeLabel;
 class cCPUMemory;
 class cHeadCPU;
@@ -96,6 +98,16 @@ protected:
   
   int m_task_switching_cost;
 
+  // Optional features that SingleProcess implementations are specialized on, so that the common configuration
+  // executes without testing for features that are disabled.
+  enum {
+    PROCESS_COSTS = 0x1,        // instruction set has costs that must be paid
+    PROCESS_REGULATION = 0x2,   // promoters and/or constitutive regulation are enabled
+    PROCESS_TRACE = 0x4,        // execution is being traced
+    PROCESS_SPECULATIVE = 0x8,  // speculative execution
+    NUM_PROCESS_VARIANTS = 0x10
+  };
+
   // --------  Base Hardware Feature Support  ---------
   Apto::Array<int, Apto::Smart> m_ext_mem;
   bool m_implicit_repro_active;
@@ -123,6 +135,10 @@ public:
   cHardwareBase(cWorld* world, cOrganism* in_organism, cInstSet* inst_set);
   virtual ~cHardwareBase() { ; }
   
+  // Hardware is allocated from shared pools, one per size class, rather than the general heap
+  static void* operator new(size_t size) { return cObjectPool::AllocateSized(size); }
+  static void operator delete(void* ptr, size_t size) { cObjectPool::FreeSized(ptr, size); }
+  
   // interrupt types
   enum interruptTypes {MSG_INTERRUPT = 0, MOVE_INTERRUPT};
   
@@ -146,6 +162,7 @@ public:
   virtual void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) = 0;
   virtual void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) = 0;
   void SetTrace(HardwareTracerPtr tracer) { m_tracer = tracer; }
+  bool IsTraced() { if (m_tracer) return true; return (m_minitrace || m_microtrace || m_topnavtrace || m_reprotrace); }
   void SetMiniTrace(const cString& filename);
   void SetMicroTrace() { m_microtrace = true; } 
   void SetTopNavTrace(bool nav_trace) { m_topnavtrace = nav_trace; }
@@ -226,6 +243,9 @@ public:
   
   // --------  State Transfer  --------
   virtual void InheritState(cHardwareBase&) { ; }
+
+  // Save or restore the full execution state; returns false if this hardware type does not support checkpointing
+  virtual bool Checkpoint(cCheckpoint&) { return false; }
   
   
   // --------  Alarm  --------
@@ -244,6 +264,7 @@ public:
   
 protected:
   void ResizeCostArrays(int new_size);
+  void checkpointBaseState(cCheckpoint& ckpt);
 
   // --------  Core Execution Methods  --------
   bool SingleProcess_PayPreCosts(cAvidaContext& ctx, const Instruction& cur_inst, const int thread_id);
@@ -29,6 +29,7 @@
 #include "avida/private/systematics/SexualAncestry.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cCPUTestInfo.h"
 #include "cEnvironment.h"
 #include "cHardwareManager.h"
@@ -769,9 +770,11 @@ tInstLib<cHardwareCPU::tMethod>* cHardwareCPU::initInstLib(void)
 
 cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_organism, cInstSet* in_inst_set)
 : cHardwareBase(world, in_organism, in_inst_set)
+, m_decoded_version(-1)
 , m_last_cell_data(false, 0)
 {
   m_functions = s_inst_slib->GetFunctions();
+  decodeInstSet();
   
   m_spec_die = false;
   m_epigenetic_state = false;
@@ -781,9 +784,19 @@ cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
   
   m_promoters_enabled = m_world->GetConfig().PROMOTERS_ENABLED.Get();
   m_constitutive_regulation = m_world->GetConfig().CONSTITUTIVE_REGULATION.Get();
+  m_no_active_promoter_halt = (m_world->GetConfig().NO_ACTIVE_PROMOTER_EFFECT.Get() == 2);
+  m_promoter_processivity = m_world->GetConfig().PROMOTER_PROCESSIVITY.Get();
+  m_promoter_inst_max = m_world->GetConfig().PROMOTER_INST_MAX.Get();
+  
+  m_task_switch_penalty_enabled = m_world->GetConfig().TASK_SWITCH_PENALTY_TYPE.Get();
+  m_task_switch_penalty = m_world->GetConfig().TASK_SWITCH_PENALTY.Get();
   
   m_slip_read_head = !m_world->GetConfig().SLIP_COPY_MODE.Get();
   
+  m_process_features = 0;
+  if (m_has_any_costs) m_process_features |= PROCESS_COSTS;
+  if (m_promoters_enabled || m_constitutive_regulation) m_process_features |= PROCESS_REGULATION;
+  
   // Initialize memory...
   const Genome& in_genome = in_organism->GetGenome();
   ConstInstructionSequencePtr in_seq_p;
@@ -899,14 +912,137 @@ void cHardwareCPU::cLocalThread::Reset(cHardwareBase* in_hardware, int in_id)
     
 }
 
+void cHardwareCPU::cLocalThread::Checkpoint(cCheckpoint& ckpt)
+{
+  ckpt.Transfer(m_id);
+  ckpt.Transfer(m_promoter_inst_executed);
+  ckpt.Transfer(m_messageTriggerType);
+  for (int i = 0; i < NUM_REGISTERS; i++) ckpt.Transfer(reg[i]);
+  for (int i = 0; i < NUM_HEADS; i++) heads[i].Checkpoint(ckpt);
+  stack.Checkpoint(ckpt);
+  ckpt.Transfer(cur_stack);
+  ckpt.Transfer(cur_head);
+  read_label.Checkpoint(ckpt);
+  next_label.Checkpoint(ckpt);
+}
+
+bool cHardwareCPU::Checkpoint(cCheckpoint& ckpt)
+{
+  ckpt.BeginSection("HCPU");
+  checkpointBaseState(ckpt);
+
+  // Memory must come first, so that restored heads can point into it
+  m_memory.Checkpoint(ckpt);
+  m_global_stack.Checkpoint(ckpt);
+
+  int num_threads = m_threads.GetSize();
+  ckpt.Transfer(num_threads);
+  if (ckpt.IsLoading()) {
+    if (num_threads < 1 || num_threads > m_world->GetConfig().MAX_CPU_THREADS.Get()) {
+      ckpt.Fail("invalid thread count");
+      return false;
+    }
+    m_threads.Resize(num_threads);
+    for (int i = 0; i < num_threads; i++) m_threads[i].Reset(this, i);
+  }
+  for (int i = 0; i < num_threads && ckpt.IsOK(); i++) m_threads[i].Checkpoint(ckpt);
+  ckpt.Transfer(m_thread_id_chart);
+  ckpt.Transfer(m_cur_thread);
+
+  // Bit fields cannot be bound to references, so go through locals
+  bool mal_active = m_mal_active;
+  bool advance_ip = m_advance_ip;
+  bool executed_match_strings = m_executedmatchstrings;
+  bool spec_die = m_spec_die;
+  ckpt.Transfer(mal_active);
+  ckpt.Transfer(advance_ip);
+  ckpt.Transfer(executed_match_strings);
+  ckpt.Transfer(spec_die);
+  m_mal_active = mal_active;
+  m_advance_ip = advance_ip;
+  m_executedmatchstrings = executed_match_strings;
+  m_spec_die = spec_die;
+
+  ckpt.Transfer(m_promoter_index);
+  ckpt.Transfer(m_promoter_offset);
+  int num_promoters = m_promoters.GetSize();
+  ckpt.Transfer(num_promoters);
+  if (ckpt.IsLoading() && ckpt.IsOK()) {
+    if (num_promoters < 0) {
+      ckpt.Fail("invalid promoter count");
+      return false;
+    }
+    m_promoters.Resize(num_promoters);
+  }
+  for (int i = 0; i < num_promoters && ckpt.IsOK(); i++) {
+    ckpt.Transfer(m_promoters[i].m_pos);
+    ckpt.Transfer(m_promoters[i].m_bit_code);
+    ckpt.Transfer(m_promoters[i].m_regulation);
+  }
+
+  ckpt.Transfer(m_epigenetic_state);
+  for (int i = 0; i < NUM_REGISTERS; i++) ckpt.Transfer(m_epigenetic_saved_reg[i]);
+  m_epigenetic_saved_stack.Checkpoint(ckpt);
+
+  ckpt.Transfer(m_last_cell_data);
+  ckpt.Transfer(m_flash_info);
+  ckpt.Transfer(m_cycle_counter);
+  ckpt.EndSection();
+
+  if (ckpt.IsLoading() && ckpt.IsOK() && (m_cur_thread < 0 || m_cur_thread >= num_threads)) {
+    ckpt.Fail("invalid current thread");
+  }
+  return ckpt.IsOK();
+}
+
 void cHardwareCPU::SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype) { (void)df, (void)gen_id, (void)genotype; }
 
 
+// Build the per-opcode dispatch table, so that the execution loop does not need to go back through the instruction set
+// (and its library lookups) for every instruction executed.  Rebuilt whenever the instruction set reports a change.
+void cHardwareCPU::decodeInstSet()
+{
+  const int num_inst = m_inst_set->GetSize();
+  m_decoded.Resize(num_inst);
+  for (int i = 0; i < num_inst; i++) {
+    const Instruction inst(i);
+    sDecodedInst& decoded = m_decoded[i];
+    decoded.function = m_functions[m_inst_set->GetLibFunctionIndex(inst)];
+    decoded.prob_fail = m_inst_set->GetProbFail(inst);
+    decoded.addl_time_cost = m_inst_set->GetAddlTimeCost(inst);
+    decoded.stall = m_inst_set->ShouldStall(inst);
+  }
+  m_decoded_version = m_inst_set->GetVersion();
+}
+
+
+const cHardwareCPU::tProcessMethod cHardwareCPU::s_process_variants[NUM_PROCESS_VARIANTS] = {
+  &cHardwareCPU::singleProcess<0x0>, &cHardwareCPU::singleProcess<0x1>, &cHardwareCPU::singleProcess<0x2>,
+  &cHardwareCPU::singleProcess<0x3>, &cHardwareCPU::singleProcess<0x4>, &cHardwareCPU::singleProcess<0x5>,
+  &cHardwareCPU::singleProcess<0x6>, &cHardwareCPU::singleProcess<0x7>, &cHardwareCPU::singleProcess<0x8>,
+  &cHardwareCPU::singleProcess<0x9>, &cHardwareCPU::singleProcess<0xA>, &cHardwareCPU::singleProcess<0xB>,
+  &cHardwareCPU::singleProcess<0xC>, &cHardwareCPU::singleProcess<0xD>, &cHardwareCPU::singleProcess<0xE>,
+  &cHardwareCPU::singleProcess<0xF>
+};
+
+
+bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
+{
+  int features = m_process_features;
+  if (m_tracer) features |= PROCESS_TRACE;
+  if (speculative) features |= PROCESS_SPECULATIVE;
+  return (this->*s_process_variants[features])(ctx);
+}
+
+
 // This function processes the very next command in the genome, and is made
 // to be as optimized as possible.  This is the heart of avida.
 
-bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
+template <int FEATURES> bool cHardwareCPU::singleProcess(cAvidaContext& ctx)
 {
+  const bool speculative = (FEATURES & PROCESS_SPECULATIVE);
+  const bool promoters_enabled = (FEATURES & PROCESS_REGULATION) && m_promoters_enabled;
+  
   assert(!speculative || (speculative && !m_thread_slicing_parallel));
   
   int last_IP_pos = getIP().GetPosition();
@@ -923,11 +1059,11 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
   cPhenotype& phenotype = m_organism->GetPhenotype();
   
   // First instruction - check whether we should be starting at a promoter, when enabled.
-  if (phenotype.GetCPUCyclesUsed() == 0 && m_promoters_enabled) Inst_Terminate(ctx);
+  if (phenotype.GetCPUCyclesUsed() == 0 && promoters_enabled) Inst_Terminate(ctx);
   
   // Count the cpu cycles used
   phenotype.IncCPUCyclesUsed();
-  if (!m_world->GetConfig().NO_CPU_CYCLE_TIME.Get()) phenotype.IncTimeUsed();
+  if (!m_no_cpu_cycle_time) phenotype.IncTimeUsed();
   
   int num_threads = m_threads.GetSize();
   
@@ -953,12 +1089,13 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
     
     
     // Print the status of this CPU at each step...
-    if (m_tracer) m_tracer->TraceHardware(ctx, *this);
+    if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this);
     
     // Find the instruction to be executed
     const Instruction cur_inst = ip.GetInst();
+    const sDecodedInst& decoded = getDecodedInst(cur_inst);
     
-    if (speculative && (m_spec_die || m_inst_set->ShouldStall(cur_inst))) {
+    if (speculative && (m_spec_die || decoded.stall)) {
       // Speculative instruction reject, flush and return
       m_cur_thread = last_thread;
       phenotype.DecCPUCyclesUsed();
@@ -969,24 +1106,24 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
     
     // Test if costs have been paid and it is okay to execute this now...
     bool exec = true;
-    if (m_has_any_costs) exec = SingleProcess_PayPreCosts(ctx, cur_inst, m_cur_thread);
+    if (FEATURES & PROCESS_COSTS) exec = SingleProcess_PayPreCosts(ctx, cur_inst, m_cur_thread);
     
     // Constitutive regulation applied here
-    if (m_constitutive_regulation) Inst_SenseRegulate(ctx); 
+    if ((FEATURES & PROCESS_REGULATION) && m_constitutive_regulation) Inst_SenseRegulate(ctx); 
     
     // If there are no active promoters and a certain mode is set, then don't execute any further instructions
-    if (m_promoters_enabled && m_world->GetConfig().NO_ACTIVE_PROMOTER_EFFECT.Get() == 2 && m_promoter_index == -1) exec = false;
+    if (promoters_enabled && m_no_active_promoter_halt && m_promoter_index == -1) exec = false;
     
     // Now execute the instruction...
     if (exec == true) {
       // NOTE: This call based on the cur_inst must occur prior to instruction
       //       execution, because this instruction reference may be invalid after
       //       certain classes of instructions (namely divide instructions) @DMB
-      const int time_cost = m_inst_set->GetAddlTimeCost(cur_inst);
+      const int time_cost = decoded.addl_time_cost;
       
       // Prob of exec (moved from SingleProcess_PayCosts so that we advance IP after a fail)
-      if (m_inst_set->GetProbFail(cur_inst) > 0.0) {
-        exec = !( ctx.GetRandom().P(m_inst_set->GetProbFail(cur_inst)) );
+      if (decoded.prob_fail > 0.0) {
+        exec = !( ctx.GetRandom().P(decoded.prob_fail) );
       }
       
       // Flag instruction as executed even if it failed (moved from SingleProcess_ExecuteInst)
@@ -996,7 +1133,7 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
       getIP().SetFlagExecuted();
       
       // Add to the promoter inst executed count before executing the inst (in case it is a terminator)
-      if (m_promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
+      if (promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
       
       if (exec == true) {
         if (SingleProcess_ExecuteInst(ctx, cur_inst)) { 
@@ -1016,10 +1153,9 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
       phenotype.IncTimeUsed(time_cost);
       
       // In the promoter model, we may force termination after a certain number of inst have been executed
-      if (m_promoters_enabled) {
-        const double processivity = m_world->GetConfig().PROMOTER_PROCESSIVITY.Get();
-        if (ctx.GetRandom().P(1 - processivity)) Inst_Terminate(ctx);
-        if (m_world->GetConfig().PROMOTER_INST_MAX.Get() && (m_threads[m_cur_thread].GetPromoterInstExecuted() >= m_world->GetConfig().PROMOTER_INST_MAX.Get())) 
+      if (promoters_enabled) {
+        if (ctx.GetRandom().P(1 - m_promoter_processivity)) Inst_Terminate(ctx);
+        if (m_promoter_inst_max && (m_threads[m_cur_thread].GetPromoterInstExecuted() >= m_promoter_inst_max)) 
           Inst_Terminate(ctx);
       }
       
@@ -1065,20 +1201,20 @@ bool cHardwareCPU::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instructi
   Instruction actual_inst = cur_inst;
   
   // Get a pointer to the corresponding method...
-  int inst_idx = m_inst_set->GetLibFunctionIndex(actual_inst);
+  const tMethod function = getDecodedInst(actual_inst).function;
   
   // instruction execution count incremented
   m_organism->GetPhenotype().IncCurInstCount(actual_inst.GetOp());
 	
   // And execute it.
-  const bool exec_success = (this->*(m_functions[inst_idx]))(ctx);
+  const bool exec_success = (this->*function)(ctx);
   
   // NOTE: Organism may be dead now if instruction executed killed it (such as some divides, "die", or "explode")
   
   // Add in a cycle cost for switching which task is performed
-  if (m_world->GetConfig().TASK_SWITCH_PENALTY_TYPE.Get()) {
+  if (m_task_switch_penalty_enabled) {
     if (m_organism->GetPhenotype().GetNumNewUniqueReactions()) {
-      int cost = m_organism->GetPhenotype().GetNumNewUniqueReactions() * m_world->GetConfig().TASK_SWITCH_PENALTY.Get();
+      int cost = m_organism->GetPhenotype().GetNumNewUniqueReactions() * m_task_switch_penalty;
       IncrementTaskSwitchingCost(cost);
 			
       m_organism->GetPhenotype().ResetNumNewUniqueReactions();
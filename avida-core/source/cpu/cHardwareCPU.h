@@ -94,6 +94,8 @@ protected:
     void ResetPromoterInstExecuted() { m_promoter_inst_executed = 0; }
     void setMessageTriggerType(int value) { m_messageTriggerType = value; }
     int getMessageTriggerType() { return m_messageTriggerType; }
+
+    void Checkpoint(cCheckpoint& ckpt);
   };
 
 
@@ -104,6 +106,22 @@ protected:
 
   // --------  Member Variables  --------
   const tMethod* m_functions;
+  
+  // Instruction set entries pre-decoded for the execution loop, indexed by opcode
+  struct sDecodedInst
+  {
+    tMethod function;
+    double prob_fail;
+    int addl_time_cost;
+    bool stall;
+  };
+  Apto::Array<sDecodedInst> m_decoded;
+  int m_decoded_version;
+  
+  // Run-wide configuration settings used while executing instructions
+  double m_promoter_processivity;
+  int m_promoter_inst_max;
+  int m_task_switch_penalty;
 
   cCPUMemory m_memory;          // Memory...
   cCPUStack m_global_stack;     // A stack that all threads share.
@@ -126,6 +144,9 @@ protected:
     bool m_constitutive_regulation:1;
 
     bool m_slip_read_head:1;
+    
+    bool m_no_active_promoter_halt:1;
+    bool m_task_switch_penalty_enabled:1;
   };
 
   // <-- Promoter model
@@ -155,6 +176,15 @@ protected:
 
   bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst);
   
+  // SingleProcess variants, one per combination of PROCESS_* features
+  typedef bool (cHardwareCPU::*tProcessMethod)(cAvidaContext& ctx);
+  static const tProcessMethod s_process_variants[NUM_PROCESS_VARIANTS];
+  int m_process_features;
+  template <int FEATURES> bool singleProcess(cAvidaContext& ctx);
+  
+  inline const sDecodedInst& getDecodedInst(const Instruction& inst);
+  void decodeInstSet();
+  
   // --------  Stack Manipulation...  --------
   inline void StackPush(int value);
   inline int StackPop();
@@ -249,6 +279,7 @@ public:
   int GetType() const { return HARDWARE_TYPE_CPU_ORIGINAL; }  
   bool SupportsSpeculative() const { return true; }
   void PrintStatus(std::ostream& fp);
+  bool Checkpoint(cCheckpoint& ckpt);
   void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) { (void)ctx, (void)fp; }
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) { (void)fp, (void)exec_success; }
@@ -1124,6 +1155,12 @@ inline void cHardwareCPU::StackClear()
   }
 }
 
+inline const cHardwareCPU::sDecodedInst& cHardwareCPU::getDecodedInst(const Instruction& inst)
+{
+  if (m_decoded_version != m_inst_set->GetVersion()) decodeInstSet();
+  return m_decoded[inst.GetOp()];
+}
+
 inline void cHardwareCPU::SwitchStack()
 {
   m_threads[m_cur_thread].cur_stack++;
@@ -448,9 +448,15 @@ cHardwareExperimental::cHardwareExperimental(cAvidaContext& ctx, cWorld* world,
     m_constitutive_regulation = m_world->GetConfig().CONSTITUTIVE_REGULATION.Get();
     m_no_active_promoter_halt = (m_world->GetConfig().NO_ACTIVE_PROMOTER_EFFECT.Get() == 2);
   }
+  m_promoter_processivity = m_world->GetConfig().PROMOTER_PROCESSIVITY.Get();
+  m_promoter_inst_max = m_world->GetConfig().PROMOTER_INST_MAX.Get();
   
   m_slip_read_head = !m_world->GetConfig().SLIP_COPY_MODE.Get();
   
+  m_process_features = 0;
+  if (m_has_any_costs) m_process_features |= PROCESS_COSTS;
+  if (m_promoters_enabled) m_process_features |= PROCESS_REGULATION;
+  
   const Genome& in_genome = in_organism->GetGenome();
   ConstInstructionSequencePtr in_seq_p;
   in_seq_p.DynamicCastFrom(in_genome.Representation());
@@ -556,11 +562,35 @@ void cHardwareExperimental::cLocalThread::Reset(cHardwareExperimental* in_hardwa
 }
 
 
+const cHardwareExperimental::tProcessMethod cHardwareExperimental::s_process_variants[NUM_PROCESS_VARIANTS] = {
+  &cHardwareExperimental::singleProcess<0x0>, &cHardwareExperimental::singleProcess<0x1>,
+  &cHardwareExperimental::singleProcess<0x2>, &cHardwareExperimental::singleProcess<0x3>,
+  &cHardwareExperimental::singleProcess<0x4>, &cHardwareExperimental::singleProcess<0x5>,
+  &cHardwareExperimental::singleProcess<0x6>, &cHardwareExperimental::singleProcess<0x7>,
+  &cHardwareExperimental::singleProcess<0x8>, &cHardwareExperimental::singleProcess<0x9>,
+  &cHardwareExperimental::singleProcess<0xA>, &cHardwareExperimental::singleProcess<0xB>,
+  &cHardwareExperimental::singleProcess<0xC>, &cHardwareExperimental::singleProcess<0xD>,
+  &cHardwareExperimental::singleProcess<0xE>, &cHardwareExperimental::singleProcess<0xF>
+};
+
+
+bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
+{
+  int features = m_process_features;
+  if (m_tracer) features |= PROCESS_TRACE;
+  if (speculative) features |= PROCESS_SPECULATIVE;
+  return (this->*s_process_variants[features])(ctx);
+}
+
+
 // This function processes the very next command in the genome, and is made
 // to be as optimized as possible.  This is the heart of avida.
 
-bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
+template <int FEATURES> bool cHardwareExperimental::singleProcess(cAvidaContext& ctx)
 {
+  const bool speculative = (FEATURES & PROCESS_SPECULATIVE);
+  const bool promoters_enabled = (FEATURES & PROCESS_REGULATION);
+  
   assert(!speculative || (speculative && !m_thread_slicing_parallel));
   
   // Mark this organism as running...
@@ -575,7 +605,7 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
   cPhenotype& phenotype = m_organism->GetPhenotype();
   
   // First instruction - check whether we should be starting at a promoter, when enabled.
-  if (phenotype.GetCPUCyclesUsed() == 0 && m_promoters_enabled) PromoterTerminate(ctx);
+  if (phenotype.GetCPUCyclesUsed() == 0 && promoters_enabled) PromoterTerminate(ctx);
   
   m_cycle_count++;
   phenotype.IncCPUCyclesUsed();
@@ -583,7 +613,7 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
   
   // If we have threads turned on and we executed each thread in a single
   // timestep, adjust the number of instructions executed accordingly.
-  const int num_inst_exec = (m_world->GetConfig().THREAD_SLICING_METHOD.Get() == 1) ? m_threads.GetSize() : 1;
+  const int num_inst_exec = m_thread_slicing_parallel ? m_threads.GetSize() : 1;
   
   int num_active = 0;
   for (int i = 0; i < m_threads.GetSize(); i++) {
@@ -614,7 +644,7 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
       <<  " cell: " << m_organism->GetOrgInterface().GetAVCellID() << endl; */
 
     // Print the status of this CPU at each step...
-    if (m_tracer) m_tracer->TraceHardware(ctx, *this);
+    if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this);
     
     // Find the instruction to be executed
     const Instruction cur_inst = ip.GetInst();
@@ -629,7 +659,7 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
     }
     
     // Print the short form status of this CPU at each step... 
-    if (m_tracer) m_tracer->TraceHardware(ctx, *this, false, true);
+    if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this, false, true);
     
     // Test if costs have been paid and it is okay to execute this now...
     bool exec = true;
@@ -638,10 +668,10 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
     // record any failure due to costs being paid
     // before we try to execute the instruction, is this org currently paying precosts for it
     bool on_pause = IsPayingActiveCost(ctx, m_cur_thread);
-    if (m_has_any_costs) exec = SingleProcess_PayPreCosts(ctx, cur_inst, m_cur_thread);    
+    if (FEATURES & PROCESS_COSTS) exec = SingleProcess_PayPreCosts(ctx, cur_inst, m_cur_thread);    
     if (!exec) exec_success = -1;
 
-    if (m_promoters_enabled) {
+    if (promoters_enabled) {
       // Constitutive regulation applied here
       if (m_constitutive_regulation) Inst_SenseRegulate(ctx); 
       
@@ -664,7 +694,7 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
       }
       
       //Add to the promoter inst executed count before executing the inst (in case it is a terminator)
-      if (m_promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
+      if (promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
       
       if (exec == true) {
         if (SingleProcess_ExecuteInst(ctx, cur_inst)) {
@@ -676,7 +706,7 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
       }
       // Check if the instruction just executed caused premature death, break out of execution if so
       if (phenotype.GetToDelete()) {
-        if (m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
+        if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
         break;
       }
       
@@ -688,17 +718,15 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
       phenotype.IncTimeUsed(addl_time_cost);
       
       // In the promoter model, we may force termination after a certain number of inst have been executed
-      if (m_promoters_enabled) {
-        const double processivity = m_world->GetConfig().PROMOTER_PROCESSIVITY.Get();
-        if (ctx.GetRandom().P(1 - processivity)) PromoterTerminate(ctx);
-        if (m_world->GetConfig().PROMOTER_INST_MAX.Get() &&
-            (m_threads[m_cur_thread].GetPromoterInstExecuted() >= m_world->GetConfig().PROMOTER_INST_MAX.Get())) {
+      if (promoters_enabled) {
+        if (ctx.GetRandom().P(1 - m_promoter_processivity)) PromoterTerminate(ctx);
+        if (m_promoter_inst_max && (m_threads[m_cur_thread].GetPromoterInstExecuted() >= m_promoter_inst_max)) {
           PromoterTerminate(ctx);
         }
       }
     }
     // if using mini traces, report success or failure of execution
-    if (m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
+    if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
     
     bool do_record = false;
     // record exec failed if the org just now started paying precosts
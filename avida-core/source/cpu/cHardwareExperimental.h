@@ -230,6 +230,8 @@ private:
   int m_promoter_index;       // site to begin looking for the next active promoter from
   int m_promoter_offset;      // bit offset when testing whether a promoter is on
   Apto::Array<cPromoter, Apto::ManagedPointer> m_promoters;
+  double m_promoter_processivity;
+  int m_promoter_inst_max;
   
   
   cHardwareExperimental(const cHardwareExperimental&); // @not_implemented
@@ -308,6 +310,12 @@ private:
   
   // --------  Core Execution Methods  --------
   bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst);
+  
+  // SingleProcess variants, one per combination of PROCESS_* features
+  typedef bool (cHardwareExperimental::*tProcessMethod)(cAvidaContext& ctx);
+  static const tProcessMethod s_process_variants[NUM_PROCESS_VARIANTS];
+  int m_process_features;
+  template <int FEATURES> bool singleProcess(cAvidaContext& ctx);
   void internalReset();
   void internalResetOnFailedDivide();
   
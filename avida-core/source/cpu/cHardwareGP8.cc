@@ -249,6 +249,8 @@ cHardwareGP8::cHardwareGP8(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
   
   m_juv_enabled = (m_world->GetConfig().JUV_PERIOD.Get() > 0);
   
+  m_process_features = (m_has_any_costs) ? PROCESS_COSTS : 0;
+  
   const Genome& in_genome = in_organism->GetGenome();
   ConstInstructionSequencePtr in_seq_p;
   in_seq_p.DynamicCastFrom(in_genome.Representation());
@@ -387,8 +389,32 @@ void cHardwareGP8::Thread::Reset(cHardwareGP8* in_hardware, const Head& start_po
 }
 
 
+// GP8 hardware has no regulation support, so those variants share the unregulated implementations
+const cHardwareGP8::tProcessMethod cHardwareGP8::s_process_variants[NUM_PROCESS_VARIANTS] = {
+  &cHardwareGP8::singleProcess<0x0>, &cHardwareGP8::singleProcess<0x1>,
+  &cHardwareGP8::singleProcess<0x0>, &cHardwareGP8::singleProcess<0x1>,
+  &cHardwareGP8::singleProcess<0x4>, &cHardwareGP8::singleProcess<0x5>,
+  &cHardwareGP8::singleProcess<0x4>, &cHardwareGP8::singleProcess<0x5>,
+  &cHardwareGP8::singleProcess<0x8>, &cHardwareGP8::singleProcess<0x9>,
+  &cHardwareGP8::singleProcess<0x8>, &cHardwareGP8::singleProcess<0x9>,
+  &cHardwareGP8::singleProcess<0xC>, &cHardwareGP8::singleProcess<0xD>,
+  &cHardwareGP8::singleProcess<0xC>, &cHardwareGP8::singleProcess<0xD>
+};
+
+
 bool cHardwareGP8::SingleProcess(cAvidaContext& ctx, bool speculative)
 {
+  int features = m_process_features;
+  if (m_tracer) features |= PROCESS_TRACE;
+  if (speculative) features |= PROCESS_SPECULATIVE;
+  return (this->*s_process_variants[features])(ctx);
+}
+
+
+template <int FEATURES> bool cHardwareGP8::singleProcess(cAvidaContext& ctx)
+{
+  const bool speculative = (FEATURES & PROCESS_SPECULATIVE);
+  
   // If speculatively stalled, stay that way until a real instruction comes
   if (speculative && m_spec_stall) return false;
   
@@ -452,7 +478,7 @@ bool cHardwareGP8::SingleProcess(cAvidaContext& ctx, bool speculative)
       ip.Adjust();
       
       // Print the status of this CPU at each step...
-      if (m_tracer) m_tracer->TraceHardware(ctx, *this);
+      if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this);
     
       // Find the instruction to be executed
       const Instruction cur_inst = ip.GetInst();
@@ -465,7 +491,7 @@ bool cHardwareGP8::SingleProcess(cAvidaContext& ctx, bool speculative)
       }
       
       // Print the short form status of this CPU at each step... 
-      if (m_tracer) m_tracer->TraceHardware(ctx, *this, false, true);
+      if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this, false, true);
     
 /*      if (m_organism->GetID() == 0 && m_world->GetStats().GetUpdate() >= 0) {
       cout << " org: " << m_organism->GetID()
@@ -487,7 +513,7 @@ bool cHardwareGP8::SingleProcess(cAvidaContext& ctx, bool speculative)
       if ((inst_hw_units & m_hw_busy)) {
         m_threads[m_cur_thread].active = false;
         m_threads[m_cur_thread].wait_reg = -1;
-        if (m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
+        if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
         continue;
       }
 
@@ -496,7 +522,7 @@ bool cHardwareGP8::SingleProcess(cAvidaContext& ctx, bool speculative)
       // record any failure due to costs being paid
       // before we try to execute the instruction, is this org currently paying precosts for it
       bool on_pause = IsPayingActiveCost(ctx, m_cur_thread);
-      if (m_has_any_costs) exec = SingleProcess_PayPreCosts(ctx, cur_inst, m_cur_thread);
+      if (FEATURES & PROCESS_COSTS) exec = SingleProcess_PayPreCosts(ctx, cur_inst, m_cur_thread);
       if (!exec) exec_success = -1;
       
       // Now execute the instruction...
@@ -525,7 +551,7 @@ bool cHardwareGP8::SingleProcess(cAvidaContext& ctx, bool speculative)
         
         // Check if the instruction just executed caused premature death, break out of execution if so
         if (phenotype.GetToDelete()) {
-          if (m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
+          if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
           break;
         }
         
@@ -538,7 +564,7 @@ bool cHardwareGP8::SingleProcess(cAvidaContext& ctx, bool speculative)
       }
       
       // if using mini traces, report success or failure of execution
-      if (m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
+      if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
       
       bool do_record = false;
       // record exec failed if the org just now started paying precosts
@@ -560,7 +586,7 @@ bool cHardwareGP8::SingleProcess(cAvidaContext& ctx, bool speculative)
       }
       
       if (phenotype.GetToDelete()) {
-        if (m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
+        if ((FEATURES & PROCESS_TRACE) && m_tracer) m_tracer->TraceHardware(ctx, *this, false, true, exec_success);
         break;
       }
       
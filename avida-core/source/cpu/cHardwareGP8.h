@@ -388,6 +388,12 @@ private:
 
   // --------  Core Execution Methods  --------
   bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst);
+  
+  // SingleProcess variants, one per combination of PROCESS_* features
+  typedef bool (cHardwareGP8::*tProcessMethod)(cAvidaContext& ctx);
+  static const tProcessMethod s_process_variants[NUM_PROCESS_VARIANTS];
+  int m_process_features;
+  template <int FEATURES> bool singleProcess(cAvidaContext& ctx);
   void internalReset();
   void internalResetOnFailedDivide();
   void setupGenes();
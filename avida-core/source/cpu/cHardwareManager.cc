@@ -36,6 +36,7 @@
 #include "cInstSet.h"
 #include "cStringList.h"
 #include "cStringUtil.h"
+#include "cTestCPUCache.h"
 #include "cWorld.h"
 
 using namespace Avida;
@@ -43,16 +44,19 @@ using namespace Avida;
 static const Apto::BasicString<Apto::ThreadSafe> s_prop_id_instset("instset");
 
 cHardwareManager::cHardwareManager(cWorld* world)
-: m_world(world)
+: m_world(world), m_test_cpu_cache(NULL)
 {
   cString filename = world->GetConfig().INST_SET.Get();
   m_is_name_map.Set("(default)", 0);
 
+  const int cache_size = world->GetConfig().TEST_CPU_CACHE_SIZE.Get();
+  if (cache_size > 0) m_test_cpu_cache = new cTestCPUCache(cache_size);
 }
 
 cHardwareManager::~cHardwareManager()
 {
   for (int i = 0; i < m_inst_sets.GetSize(); i++) delete m_inst_sets[i];
+  delete m_test_cpu_cache;
 }
 
 
@@ -33,6 +33,7 @@ class cHardwareBase;
 class cInstSet;
 class cOrganism;
 class cStringList;
+class cTestCPUCache;
 class cUserFeedback;
 class cWorld;
 template<typename T> class tList;
@@ -46,6 +47,7 @@ private:
   cWorld* m_world;
   Apto::Array<cInstSet*> m_inst_sets;
   Apto::Map<Apto::String, int> m_is_name_map;
+  cTestCPUCache* m_test_cpu_cache;
 
   
   cHardwareManager(); // @not_implemented
@@ -66,6 +68,7 @@ public:
   
   cHardwareBase* Create(cAvidaContext& ctx, cOrganism* org, const Genome& mg);
   inline cTestCPU* CreateTestCPU(cAvidaContext& ctx) { return new cTestCPU(ctx, m_world); }
+  cTestCPUCache* GetTestCPUCache() { return m_test_cpu_cache; }
 
   inline bool IsInstSet(const Apto::String& name) const { return m_is_name_map.Has(name); }
   
@@ -22,6 +22,8 @@
 
 #include "cHeadCPU.h"
 
+#include "cCheckpoint.h"
+
 #include <cassert>
 
 
@@ -52,3 +54,19 @@ void cHeadCPU::fullAdjust(int mem_size)
   else m_position %= mem_size;
 }
 
+
+
+void cHeadCPU::Checkpoint(cCheckpoint& ckpt)
+{
+  // Heads are restored exactly as saved rather than adjusted, since a head may legitimately sit one past the end
+  ckpt.Transfer(m_position);
+  ckpt.Transfer(m_mem_space);
+  ckpt.Transfer(m_cached_ms);
+  if (ckpt.IsLoading() && ckpt.IsOK()) {
+    if (m_cached_ms < 0) {
+      ckpt.Fail("invalid head memory space");
+      return;
+    }
+    m_memory = &m_hardware->GetMemory(m_cached_ms);
+  }
+}
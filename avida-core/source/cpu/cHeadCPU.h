@@ -33,6 +33,7 @@
  * The cHeadCPU class contains a pointer to locations in memory for a CPU.
  **/
 
+class cCheckpoint;
 class cCodeLabel;
 class cString;
 
@@ -112,6 +113,9 @@ public:
   inline bool AtFront() const { return (m_position == 0); }
   inline bool AtEnd() const { return (m_position + 1 == GetMemory().GetSize()); }
   inline bool InMemory() const { return (m_position >= 0 && m_position < GetMemory().GetSize()); }
+
+  // The owning hardware's memory spaces must already be restored when loading
+  void Checkpoint(cCheckpoint& ckpt);
 };
 
 
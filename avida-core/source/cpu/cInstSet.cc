@@ -53,6 +53,7 @@ cInstSet::cInstSet(const cInstSet& _in)
   , m_has_choosy_female_costs(_in.m_has_choosy_female_costs)
   , m_has_post_costs(_in.m_has_post_costs)
   , m_has_bonus_costs(_in.m_has_bonus_costs)
+  , m_version(0)
 {
   m_mutation_index = new cOrderedWeightedIndex(*_in.m_mutation_index);
 }
@@ -74,6 +75,7 @@ cInstSet& cInstSet::operator=(const cInstSet& _in)
   m_has_choosy_female_costs = _in.m_has_choosy_female_costs;
   m_has_post_costs = _in.m_has_post_costs;
   m_has_bonus_costs = _in.m_has_bonus_costs;
+  m_version++;
 
   m_mutation_index = new cOrderedWeightedIndex(*_in.m_mutation_index);
   return *this;
@@ -102,6 +104,7 @@ Instruction cInstSet::ActivateNullInst()
   
   // Increase the size of the array...
   m_lib_name_map.Resize(inst_id + 1);
+  m_version++;
   
   // Setup the new function...
   m_lib_name_map[inst_id].lib_fun_id = null_fun_id;
@@ -225,6 +228,7 @@ bool cInstSet::LoadWithStringList(const cStringList& sl, cUserFeedback* feedback
     
     // Increase the size of the array...
     m_lib_name_map.Resize(inst_id + 1);
+    m_version++;
     
     // Setup the new function...
     m_lib_name_map[inst_id].lib_fun_id = fun_id;
@@ -92,6 +92,8 @@ public:
   int m_stack_size;
   int m_uops_per_cycle;
   
+  int m_version;  // Incremented whenever instruction entries change, so that cached decodings can be refreshed
+  
   cInstSet(); // @not_implemented
 
 public:
@@ -99,7 +101,7 @@ public:
     : m_world(world), m_name(name), m_hw_type(hw_type), m_inst_lib(inst_lib), m_mutation_index(NULL)
     , m_has_costs(false), m_has_ft_costs(false), m_has_energy_costs(false), m_has_res_costs(false), m_has_fem_res_costs(false)
     , m_has_female_costs(false), m_has_choosy_female_costs(false), m_has_post_costs(false), m_has_bonus_costs(false), m_stack_size(stack_size)
-    , m_uops_per_cycle(uops_per_cycle) { ; }
+    , m_uops_per_cycle(uops_per_cycle), m_version(0) { ; }
   cInstSet(const cInstSet&); 
   cInstSet& operator=(const cInstSet&); 
   inline ~cInstSet() { if (m_mutation_index != NULL) delete m_mutation_index; }
@@ -137,6 +139,7 @@ public:
   int GetRandFunctionIndex(cAvidaContext& ctx) const { return m_lib_name_map[ GetRandomInst(ctx).GetOp() ].lib_fun_id; }
 
   int GetSize() const { return m_lib_name_map.GetSize(); }
+  int GetVersion() const { return m_version; }
   int GetNumNops() const { return m_lib_nopmod_map.GetSize(); }
   
   bool HasCosts() const { return m_has_costs; }
@@ -168,7 +171,7 @@ public:
   Instruction ActivateNullInst();
   
   // Modification of instructions during run.
-  void SetProbFail(const Instruction& inst, double _prob_fail) { m_lib_name_map[inst.GetOp()].prob_fail = _prob_fail; }
+  void SetProbFail(const Instruction& inst, double _prob_fail) { m_lib_name_map[inst.GetOp()].prob_fail = _prob_fail; m_version++; }
   void SetRedundancy(const Instruction& inst, int _redundancy) { m_lib_name_map[inst.GetOp()].redundancy = _redundancy; m_mutation_index->SetWeight(inst.GetOp(), _redundancy);}
 
   // accessors for instruction library
@@ -230,6 +230,37 @@ bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Gen
   return test_info.is_viable;
 }
 
+bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, cTestCPUCache::sResult& result)
+{
+  // Only deterministic tests may be cached; traced tests must also actually run to produce their trace
+  cTestCPUCache* cache = m_world->GetHardwareManager().GetTestCPUCache();
+  if (test_info.m_tracer || test_info.use_random_inputs || test_info.use_manual_inputs) cache = NULL;
+  
+  Apto::String key;
+  if (cache) {
+    // The environment, configuration and resource history are keyed by version, so changes to any of them miss
+    key = Apto::FormatStr("%d,%d,%d,%d,%d,%d,%d;%s", test_info.generation_tests, (int)test_info.m_res_method,
+                          test_info.m_res_update, test_info.m_res_cpu_cycle_offset,
+                          (test_info.m_res) ? test_info.m_res->GetVersion() : -1, m_world->GetEnvironment().GetVersion(),
+                          cAvidaConfig::GetVersion(), (const char*)genome.AsString());
+    if (cache->Get(key, result)) return result.viable;
+  }
+  
+  TestGenome(ctx, test_info, genome);
+  
+  cPhenotype& phenotype = test_info.GetColonyOrganism()->GetPhenotype();
+  result.viable = test_info.is_viable;
+  result.fitness = test_info.GetColonyFitness();
+  result.merit = phenotype.GetMerit().GetDouble();
+  result.gestation_time = phenotype.GetGestationTime();
+  result.task_counts = phenotype.GetLastTaskCount();
+  
+  if (cache) cache->Set(key, result);
+  
+  return result.viable;
+}
+
+
 bool cTestCPU::TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth)
 {
   assert(cur_depth < test_info.generation_tests);
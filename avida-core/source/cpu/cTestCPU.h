@@ -28,6 +28,7 @@
 #include "cString.h"
 #include "cResourceCount.h"
 #include "cCPUTestInfo.h"
+#include "cTestCPUCache.h"
 #include "cWorld.h"
 
 
@@ -90,6 +91,10 @@ public:
   bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome);
   bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, std::ofstream& out_fp);
   
+  // Summarizes the colony phenotype into result, reusing earlier results from the hardware manager's test CPU cache
+  // when one is enabled.  On a cache hit the organisms in test_info are not updated.
+  bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, cTestCPUCache::sResult& result);
+  
   void PrintGenome(cAvidaContext& ctx, const Genome& genome, cString filename = "", int update = -1, bool for_groups = false, int last_birth_cell = 0, int last_group_id = -1, int last_forager_type = -1);
 
   inline int GetInput();
@@ -112,6 +117,7 @@ public:
   inline double GetFrozenCellResVal(cAvidaContext& ctx, int cell_id, int res_id);
   inline double GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id);
   inline const Apto::Array< Apto::Array<int> >& GetCellIdLists();
+  void MaskResourceAccess(int cell_id, Apto::Array<double>& res_count) const { m_resource_count.MaskCellAccess(cell_id, res_count); }
   
   // Used by cTestCPUInterface to get/update resources
   void ModifyResources(cAvidaContext& ctx, const Apto::Array<double>& res_change);
@@ -0,0 +1,164 @@
+/*
+ *  cTestCPUCache.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cTestCPUCache.h"
+
+
+cTestCPUCache::cTestCPUCache(int capacity)
+: m_shard_capacity((capacity + NUM_SHARDS - 1) / NUM_SHARDS)
+{
+  if (m_shard_capacity < 1) m_shard_capacity = 1;
+}
+
+cTestCPUCache::~cTestCPUCache()
+{
+  Clear();
+}
+
+
+cTestCPUCache::sShard& cTestCPUCache::shardFor(const Apto::String& key)
+{
+  // FNV-1a, only used to spread keys across the shards
+  unsigned int hash = 2166136261u;
+  for (int i = 0; i < key.GetSize(); i++) {
+    hash ^= (unsigned char)key[i];
+    hash *= 16777619u;
+  }
+  return m_shards[hash % NUM_SHARDS];
+}
+
+void cTestCPUCache::unlink(sShard& shard, sEntry* entry)
+{
+  if (entry->prev) entry->prev->next = entry->next;
+  else shard.head = entry->next;
+  if (entry->next) entry->next->prev = entry->prev;
+  else shard.tail = entry->prev;
+  entry->prev = entry->next = NULL;
+}
+
+void cTestCPUCache::pushFront(sShard& shard, sEntry* entry)
+{
+  entry->prev = NULL;
+  entry->next = shard.head;
+  if (shard.head) shard.head->prev = entry;
+  shard.head = entry;
+  if (!shard.tail) shard.tail = entry;
+}
+
+
+bool cTestCPUCache::Get(const Apto::String& key, sResult& result)
+{
+  sShard& shard = shardFor(key);
+  Apto::MutexAutoLock lock(shard.mutex);
+
+  sEntry* entry = NULL;
+  if (!shard.entries.Get(key, entry)) {
+    shard.misses++;
+    return false;
+  }
+
+  shard.hits++;
+  if (entry != shard.head) {
+    unlink(shard, entry);
+    pushFront(shard, entry);
+  }
+  result = entry->result;
+  return true;
+}
+
+void cTestCPUCache::Set(const Apto::String& key, const sResult& result)
+{
+  sShard& shard = shardFor(key);
+  Apto::MutexAutoLock lock(shard.mutex);
+
+  sEntry* entry = NULL;
+  if (shard.entries.Get(key, entry)) {
+    // Another thread tested the same genome concurrently, simply refresh the existing entry
+    entry->result = result;
+    unlink(shard, entry);
+    pushFront(shard, entry);
+    return;
+  }
+
+  if (shard.count >= m_shard_capacity) {
+    // Recycle the least recently used entry
+    entry = shard.tail;
+    unlink(shard, entry);
+    shard.entries.Remove(entry->key);
+  } else {
+    entry = new sEntry;
+    shard.count++;
+  }
+
+  entry->key = key;
+  entry->result = result;
+  pushFront(shard, entry);
+  shard.entries.Set(key, entry);
+}
+
+
+void cTestCPUCache::Clear()
+{
+  for (int i = 0; i < NUM_SHARDS; i++) {
+    sShard& shard = m_shards[i];
+    Apto::MutexAutoLock lock(shard.mutex);
+
+    sEntry* entry = shard.head;
+    while (entry) {
+      sEntry* next = entry->next;
+      delete entry;
+      entry = next;
+    }
+    shard.entries.Clear();
+    shard.head = shard.tail = NULL;
+    shard.count = 0;
+  }
+}
+
+
+int cTestCPUCache::GetNumEntries()
+{
+  int total = 0;
+  for (int i = 0; i < NUM_SHARDS; i++) {
+    Apto::MutexAutoLock lock(m_shards[i].mutex);
+    total += m_shards[i].count;
+  }
+  return total;
+}
+
+long long cTestCPUCache::GetNumHits()
+{
+  long long total = 0;
+  for (int i = 0; i < NUM_SHARDS; i++) {
+    Apto::MutexAutoLock lock(m_shards[i].mutex);
+    total += m_shards[i].hits;
+  }
+  return total;
+}
+
+long long cTestCPUCache::GetNumMisses()
+{
+  long long total = 0;
+  for (int i = 0; i < NUM_SHARDS; i++) {
+    Apto::MutexAutoLock lock(m_shards[i].mutex);
+    total += m_shards[i].misses;
+  }
+  return total;
+}
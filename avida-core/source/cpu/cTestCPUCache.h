@@ -0,0 +1,98 @@
+/*
+ *  cTestCPUCache.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cTestCPUCache_h
+#define cTestCPUCache_h
+
+#include "apto/core.h"
+#include "apto/core/Mutex.h"
+
+
+/**
+ * Bounded, thread-safe cache of test CPU results.  Entries are keyed on a string that identifies both the genome
+ * (hardware type, instruction set and sequence) and the test settings that affect the outcome.  The cache is split
+ * into independently locked shards, each evicting its least recently used entry once full.
+ **/
+
+class cTestCPUCache
+{
+public:
+  // Summary of the colony phenotype produced by a test
+  struct sResult
+  {
+    bool viable;
+    double fitness;
+    double merit;
+    int gestation_time;
+    Apto::Array<int> task_counts;
+  };
+
+private:
+  static const int NUM_SHARDS = 16;
+
+  struct sEntry
+  {
+    Apto::String key;
+    sResult result;
+    sEntry* prev;
+    sEntry* next;
+  };
+
+  struct sShard
+  {
+    Apto::Mutex mutex;
+    Apto::Map<Apto::String, sEntry*> entries;
+    sEntry* head;   // most recently used
+    sEntry* tail;   // least recently used
+    int count;
+    long long hits;
+    long long misses;
+
+    sShard() : head(NULL), tail(NULL), count(0), hits(0), misses(0) { ; }
+  };
+
+  sShard m_shards[NUM_SHARDS];
+  int m_shard_capacity;
+
+
+  sShard& shardFor(const Apto::String& key);
+
+  static void unlink(sShard& shard, sEntry* entry);
+  static void pushFront(sShard& shard, sEntry* entry);
+
+  cTestCPUCache(); // @not_implemented
+  cTestCPUCache(const cTestCPUCache&); // @not_implemented
+  cTestCPUCache& operator=(const cTestCPUCache&); // @not_implemented
+
+public:
+  cTestCPUCache(int capacity);
+  ~cTestCPUCache();
+
+  bool Get(const Apto::String& key, sResult& result);
+  void Set(const Apto::String& key, const sResult& result);
+
+  void Clear();
+
+  int GetNumEntries();
+  long long GetNumHits();
+  long long GetNumMisses();
+};
+
+#endif
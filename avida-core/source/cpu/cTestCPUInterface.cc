@@ -104,6 +104,11 @@ const Apto::Array< Apto::Array<int> >& cTestCPUInterface::GetCellIdLists()
 	return m_testcpu->GetCellIdLists();
 }
 
+void cTestCPUInterface::MaskResourceAccess(int cell_id, Apto::Array<double>& res_count)
+{
+  m_testcpu->MaskResourceAccess(cell_id, res_count);
+}
+
 void cTestCPUInterface::UpdateResources(cAvidaContext& ctx, const Apto::Array<double>& res_change)
 {
    m_testcpu->ModifyResources(ctx, res_change);
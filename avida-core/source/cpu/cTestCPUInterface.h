@@ -111,6 +111,7 @@ public:
   double GetFrozenCellResVal(cAvidaContext& ctx, int cell_id, int res_id);
   double GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id);
   const Apto::Array< Apto::Array<int> >& GetCellIdLists();
+  void MaskResourceAccess(int cell_id, Apto::Array<double>& res_count);
   
   int GetCurrPeakX(cAvidaContext& ctx, int res_id) { return 0; } 
   int GetCurrPeakY(cAvidaContext& ctx, int res_id) { return 0; } 
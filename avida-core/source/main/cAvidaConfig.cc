@@ -39,6 +39,7 @@ using namespace AvidaTools;
 
 
 Apto::Mutex cAvidaConfig::global_list_mutex;
+int cAvidaConfig::s_version = 0;
 tList<cAvidaConfig::cBaseConfigGroup> cAvidaConfig::global_group_list;
 tList<cAvidaConfig::cBaseConfigCustomFormat> cAvidaConfig::global_format_list;
 
@@ -75,6 +75,7 @@ private:                                                                      \
 public:                                                                       \
   void LoadStr(const cString& str_value) {                         /* 4 */ \
     value = cStringUtil::Convert(str_value, value);                           \
+    s_version++;                                                              \
   }                                                                           \
   bool EqualsString(const cString& str_value) const {                 /* 5 */ \
     return (value == cStringUtil::Convert(str_value, value));                 \
@@ -84,7 +85,7 @@ public:                                                                       \
     global_group_list.GetLast()->AddEntry(this);                      /* 8 */ \
   }                                                                           \
   TYPE Get() const { return value; }                                  /* 9 */ \
-  void Set(TYPE in_value) { value = in_value; }                               \
+  void Set(TYPE in_value) { value = in_value; s_version++; }                  \
   cString AsString() const { return cStringUtil::Convert(value); }    /* 10 */\
 } NAME                                                                /* 11 */\
 
@@ -252,6 +253,9 @@ private:
   static Apto::Mutex global_list_mutex;
   static tList<cBaseConfigGroup> global_group_list;
   static tList<cBaseConfigCustomFormat> global_format_list;
+  
+  // Bumped whenever any setting of any configuration changes, see GetVersion()
+  static int s_version;
   tList<cBaseConfigGroup> m_group_list;
   tList<cBaseConfigCustomFormat> m_format_list;
   
@@ -265,6 +269,9 @@ public:
   }
   ~cAvidaConfig() { ; }
   
+  // Changes whenever a setting is loaded or set, so that cached results that depend on the settings can be keyed on it
+  static int GetVersion() { return s_version; }
+  
 #ifdef OVERRIDE_CONFIG
 #include "config_overrides.h"
 #else
@@ -282,6 +289,10 @@ public:
   CONFIG_ADD_VAR(VERBOSITY, int, 1, "0 = No output at all\n1 = Normal output\n2 = Verbose output, detailing progress\n3 = High level of details, as available\n4 = Print Debug Information, as applicable");
   CONFIG_ADD_VAR(RANDOM_SEED, int, -1, "Random number seed (<0 for based on time)");
   CONFIG_ADD_VAR(SPECULATIVE, bool, 1, "Enable speculative execution\n(pre-execute instructions that don't affect other organisms)");
+  CONFIG_ADD_VAR(UPDATE_THREADS, int, 1, "Number of threads used to pre-execute organisms within an update\n(requires SPECULATIVE; results are reproducible for a given seed and thread count)");
+  CONFIG_ADD_VAR(UPDATE_THREAD_DEPTH, int, 64, "Maximum instructions pre-executed per organism at each parallel sync point");
+  CONFIG_ADD_VAR(RESOURCE_THREADS, int, 1, "Number of threads used to update spatial resources\n(results are identical for any thread count)");
+  CONFIG_ADD_VAR(OUTPUT_THREAD, bool, 0, "Write output files from a background thread\n(output is held in memory until written; checkpoints wait for it)");
   CONFIG_ADD_VAR(POPULATION_CAP, int, 0, "Carrying capacity in number of organisms (use 0 for no cap)");
   CONFIG_ADD_VAR(POP_CAP_ELDEST, int, 0, "Carrying capacity in number of organisms (use 0 for no cap). Will kill oldest organism in population, but still use birth method to place new offspring."); 
   
@@ -302,6 +313,7 @@ public:
   CONFIG_ADD_VAR(ANALYZE_FILE, cString, "analyze.cfg", "File used for analysis mode");
   CONFIG_ADD_VAR(ENVIRONMENT_FILE, cString, "environment.cfg", "File that describes the environment");
   CONFIG_ADD_VAR(MIGRATION_FILE, cString, "-", "NxN file that describes connectivity weights between demes");   
+  CONFIG_ADD_VAR(RESTORE_CHECKPOINT, cString, "-", "Checkpoint file (written by the SaveCheckpoint action) to resume the run from; - = none");
   
   
   // -------- Mutation config options --------
@@ -591,6 +603,8 @@ public:
   CONFIG_ADD_GROUP(GENEOLOGY_GROUP, "Geneology");
   CONFIG_ADD_VAR(THRESHOLD, int, 3, "Number of organisms in a genotype needed for it\n  to be considered viable.");
   CONFIG_ADD_VAR(TEST_CPU_TIME_MOD, int, 20, "Time allocated in test CPUs (multiple of length)");
+  CONFIG_ADD_VAR(TEST_CPU_CACHE_SIZE, int, 0, "Maximum number of test CPU results to cache for landscape and\n  mutational neighborhood analyses (0 = no caching).  Only valid when\n  test CPU evaluations are deterministic.");
+  CONFIG_ADD_VAR(HISTORIC_SPILL_MB, int, 0, "Megabytes of frozen historic genomes to keep in memory, beyond which\n  the oldest are moved to a file in the data directory (0 = never).");
   
 
   // -------- Organism Network config options --------
@@ -637,6 +651,7 @@ public:
   // -------- Analyze config options --------
   CONFIG_ADD_GROUP(ANALYZE_GROUP, "Analysis Settings");
   CONFIG_ADD_VAR(MAX_CONCURRENCY, int, -1, "Maximum number of analyze threads, -1 == use all available.");
+  CONFIG_ADD_VAR(COLUMNAR_BATCHES, bool, 0, "Keep column copies of genotype batches, so that FILTER, FIND_GENOTYPE, HISTOGRAM,\n  DETAIL and PRINT_DIVERSITY scan typed arrays in parallel instead of the genotypes.");
   CONFIG_ADD_VAR(INJECT_RESETS_TASKS, int, 0, "Executing INJECT (semi-succesfully) will trigger last_task_count to be writen from current_task_count");
   CONFIG_ADD_VAR(ANALYZE_OPTION_1, cString, "", "String variable accessible from analysis scripts");
   CONFIG_ADD_VAR(ANALYZE_OPTION_2, cString, "", "String variable accessible from analysis scripts");
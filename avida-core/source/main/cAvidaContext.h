@@ -28,6 +28,9 @@
 
 #include "avida/core/Types.h"
 
+#include "cOutputWorkspace.h"
+#include "cReactionResult.h"
+
 class cWorld;
 
 
@@ -40,11 +43,20 @@ private:
   bool m_analyze;
   bool m_testing;
   bool m_org_faults;
+  int m_background_id;
+  
+  cOutputWorkspace* m_output_ws;
+  cReactionResult* m_reaction_result;
+  
+  cAvidaContext(const cAvidaContext&); // @not_implemented
+  cAvidaContext& operator=(const cAvidaContext&); // @not_implemented
   
 public:
-  cAvidaContext(Avida::WorldDriver* driver, Apto::Random& rng) : m_driver(driver), m_rng(&rng), m_analyze(false), m_testing(false), m_org_faults(false) { ; }
-  cAvidaContext(Avida::WorldDriver* driver, Apto::Random* rng) : m_driver(driver), m_rng(rng), m_analyze(false), m_testing(false), m_org_faults(false) { ; }
-  ~cAvidaContext() { ; }
+  cAvidaContext(Avida::WorldDriver* driver, Apto::Random& rng)
+    : m_driver(driver), m_rng(&rng), m_analyze(false), m_testing(false), m_org_faults(false), m_background_id(-1), m_output_ws(NULL), m_reaction_result(NULL) { ; }
+  cAvidaContext(Avida::WorldDriver* driver, Apto::Random* rng)
+    : m_driver(driver), m_rng(rng), m_analyze(false), m_testing(false), m_org_faults(false), m_background_id(-1), m_output_ws(NULL), m_reaction_result(NULL) { ; }
+  ~cAvidaContext() { delete m_output_ws; delete m_reaction_result; }
   
   Avida::WorldDriver& Driver() { return *m_driver; }
   bool HasDriver() const { return (m_driver != NULL); }
@@ -64,6 +76,34 @@ public:
   void EnableOrgFaultReporting() { m_org_faults = true; }
   void DisableOrgFaultReporting() { m_org_faults = false; }
   bool OrgFaultReporting() { return m_org_faults; }
+  
+  // Test CPUs running on analyze workers while the population updates (see cTestSnapshot) must leave the stats alone.
+  // Their organisms take the given ID, the number of organisms born when the snapshot was captured.
+  void SetBackgroundMode(int org_id) { m_background_id = org_id; }
+  void ClearBackgroundMode() { m_background_id = -1; }
+  bool GetBackgroundMode() { return (m_background_id >= 0); }
+  int GetBackgroundOrgID() { return m_background_id; }
+  
+  // Output testing scratch space, reused across IO instructions.  Returns NULL if the workspace is already in use
+  // further up the call stack (e.g. an output reentered through a triggered instruction).
+  cOutputWorkspace* AcquireOutputWorkspace()
+  {
+    if (!m_output_ws) m_output_ws = new cOutputWorkspace;
+    if (m_output_ws->InUse()) return NULL;
+    m_output_ws->SetInUse(true);
+    return m_output_ws;
+  }
+  void ReleaseOutputWorkspace(cOutputWorkspace* ws) { if (ws && ws == m_output_ws) ws->SetInUse(false); }
+  
+  // Reaction result scratch space for phenotype output tests, resized whenever the environment changes size
+  cReactionResult& GetReactionResult(int num_resources, int num_tasks, int num_reactions)
+  {
+    if (!m_reaction_result || !m_reaction_result->HasSize(num_resources, num_tasks, num_reactions)) {
+      delete m_reaction_result;
+      m_reaction_result = new cReactionResult(num_resources, num_tasks, num_reactions);
+    }
+    return *m_reaction_result;
+  }
 };
 
 #endif
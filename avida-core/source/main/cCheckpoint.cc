@@ -0,0 +1,226 @@
+/*
+ *  cCheckpoint.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cCheckpoint.h"
+
+#include "cCountTracker.h"
+#include "cDoubleSum.h"
+#include "cRunningAverage.h"
+#include "cStringUtil.h"
+
+#include <cstring>
+
+
+static const char CHECKPOINT_MAGIC[8] = { 'A', 'V', 'I', 'D', 'A', 'C', 'K', 'P' };
+
+
+cCheckpoint::cCheckpoint(std::ostream& out) : m_out(&out), m_in(NULL), m_version(FORMAT_VERSION), m_ok(true)
+{
+  m_out->write(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+  writeBytes(FORMAT_VERSION, 4);
+  if (!m_out->good()) Fail("unable to write checkpoint header");
+}
+
+cCheckpoint::cCheckpoint(std::istream& in) : m_out(NULL), m_in(&in), m_version(0), m_ok(true)
+{
+  char magic[sizeof(CHECKPOINT_MAGIC)];
+  m_in->read(magic, sizeof(magic));
+  if (!m_in->good() || memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0) {
+    Fail("not an Avida checkpoint");
+    return;
+  }
+  m_version = static_cast<int>(readBytes(4));
+  if (m_ok && (m_version < 1 || m_version > FORMAT_VERSION)) {
+    Fail(cStringUtil::Stringf("unsupported checkpoint format version %d", m_version));
+  }
+}
+
+
+void cCheckpoint::writeBytes(uint64_t value, int num_bytes)
+{
+  char buf[8];
+  for (int i = 0; i < num_bytes; i++) buf[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+  m_out->write(buf, num_bytes);
+}
+
+uint64_t cCheckpoint::readBytes(int num_bytes)
+{
+  unsigned char buf[8];
+  m_in->read(reinterpret_cast<char*>(buf), num_bytes);
+  if (!m_in->good()) {
+    Fail("unexpected end of checkpoint");
+    return 0;
+  }
+  uint64_t value = 0;
+  for (int i = num_bytes - 1; i >= 0; i--) value = (value << 8) | buf[i];
+  return value;
+}
+
+
+void cCheckpoint::BeginSection(const char* tag)
+{
+  assert(strlen(tag) == 4);
+  if (!m_ok) return;
+
+  if (IsLoading()) {
+    char found[4];
+    m_in->read(found, 4);
+    if (!m_in->good() || memcmp(found, tag, 4) != 0) {
+      Fail(cStringUtil::Stringf("checkpoint section '%s' not found", tag));
+      return;
+    }
+    const std::streamoff length = static_cast<std::streamoff>(readBytes(8));
+    m_section_start.Push(m_in->tellg());
+    m_section_end.Push(m_section_start[m_section_start.GetSize() - 1] + length);
+  } else {
+    m_out->write(tag, 4);
+    writeBytes(0, 8);   // Length is filled in by EndSection()
+    m_section_start.Push(m_out->tellp());
+  }
+}
+
+void cCheckpoint::EndSection()
+{
+  if (!m_ok) return;
+  assert(m_section_start.GetSize());
+  const int depth = m_section_start.GetSize() - 1;
+
+  if (IsLoading()) {
+    const std::streamoff end = m_section_end[depth];
+    const std::streamoff pos = m_in->tellg();
+    if (pos > end) {
+      Fail("checkpoint section overrun");
+      return;
+    }
+    if (pos < end) m_in->seekg(end);   // Skip fields added by a newer writer
+    m_section_end.Resize(depth);
+  } else {
+    const std::streamoff end = m_out->tellp();
+    m_out->seekp(m_section_start[depth] - 8);
+    writeBytes(static_cast<uint64_t>(end - m_section_start[depth]), 8);
+    m_out->seekp(end);
+    if (!m_out->good()) Fail("unable to write checkpoint");
+  }
+  m_section_start.Resize(depth);
+}
+
+
+void cCheckpoint::Transfer(bool& value)
+{
+  unsigned char byte = (value) ? 1 : 0;
+  Transfer(byte);
+  if (IsLoading()) value = (byte != 0);
+}
+
+void cCheckpoint::Transfer(char& value)
+{
+  if (IsLoading()) value = static_cast<char>(readBytes(1));
+  else writeBytes(static_cast<unsigned char>(value), 1);
+}
+
+void cCheckpoint::Transfer(unsigned char& value)
+{
+  if (IsLoading()) value = static_cast<unsigned char>(readBytes(1));
+  else writeBytes(value, 1);
+}
+
+void cCheckpoint::Transfer(int& value)
+{
+  if (IsLoading()) value = static_cast<int>(static_cast<uint32_t>(readBytes(4)));
+  else writeBytes(static_cast<uint32_t>(value), 4);
+}
+
+void cCheckpoint::Transfer(unsigned int& value)
+{
+  if (IsLoading()) value = static_cast<unsigned int>(readBytes(4));
+  else writeBytes(value, 4);
+}
+
+void cCheckpoint::Transfer(long long& value)
+{
+  if (IsLoading()) value = static_cast<long long>(readBytes(8));
+  else writeBytes(static_cast<uint64_t>(value), 8);
+}
+
+void cCheckpoint::Transfer(double& value)
+{
+  // Doubles are stored as their IEEE 754 bit patterns, so that they restore exactly
+  uint64_t bits;
+  if (IsLoading()) {
+    bits = readBytes(8);
+    memcpy(&value, &bits, sizeof(value));
+  } else {
+    memcpy(&bits, &value, sizeof(value));
+    writeBytes(bits, 8);
+  }
+}
+
+void cCheckpoint::Transfer(cString& value)
+{
+  int size = value.GetSize();
+  Transfer(size);
+  if (!m_ok) return;
+  if (IsLoading()) {
+    if (size < 0) {
+      Fail("invalid string size");
+      return;
+    }
+    Apto::Array<char> buf(size);
+    if (size) m_in->read(&buf[0], size);
+    if (!m_in->good()) {
+      Fail("unexpected end of checkpoint");
+      return;
+    }
+    value = cString((size) ? &buf[0] : "", size);
+  } else if (size) {
+    m_out->write(value.GetData(), size);
+  }
+}
+
+void cCheckpoint::Transfer(cCountTracker& value)
+{
+  Transfer(value.cur_count);
+  Transfer(value.last_count);
+  Transfer(value.total_count);
+}
+
+void cCheckpoint::Transfer(cDoubleSum& value)
+{
+  Transfer(value.s1);
+  Transfer(value.s2);
+  Transfer(value.n);
+  Transfer(value.max);
+}
+
+void cCheckpoint::Transfer(cRunningAverage& value)
+{
+  // The window itself is fixed by the owner, only its contents are restored
+  int window_size = value.m_window_size;
+  Transfer(window_size);
+  if (m_ok && window_size != value.m_window_size) Fail("running average window does not match");
+  Transfer(value.m_s1);
+  Transfer(value.m_s2);
+  Transfer(value.m_pointer);
+  Transfer(value.m_n);
+  if (m_ok && (value.m_n < 0 || value.m_n > value.m_window_size || value.m_pointer < 0 || value.m_pointer >= value.m_window_size)) {
+    Fail("invalid running average");
+  }
+  for (int i = 0; i < value.m_n && m_ok; i++) Transfer(value.m_values[i]);
+}
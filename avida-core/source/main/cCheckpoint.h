@@ -0,0 +1,121 @@
+/*
+ *  cCheckpoint.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cCheckpoint_h
+#define cCheckpoint_h
+
+#include "avida/core/Types.h"
+
+#include "cString.h"
+#include "tBuffer.h"
+
+#include <iostream>
+#include <stdint.h>
+#include <utility>
+
+class cCountTracker;
+class cDoubleSum;
+class cRunningAverage;
+
+/**
+ * Reads or writes a binary checkpoint of a running world.  Each participating class has a single Checkpoint() method
+ * that serves both directions: Transfer() writes a value when saving and replaces it when loading.  Values are stored
+ * little-endian at fixed widths.  They are grouped into tagged sections whose lengths are recorded, so that a reader
+ * that does not consume a whole section (one written by a newer format version) skips the rest, while a reader that
+ * overruns one fails instead of misreading everything that follows.
+ **/
+
+class cCheckpoint
+{
+public:
+  static const int FORMAT_VERSION = 1;
+
+private:
+  std::ostream* m_out;
+  std::istream* m_in;
+  int m_version;
+  bool m_ok;
+  cString m_error;
+  Apto::Array<std::streamoff> m_section_start;    // Payload start of each open section
+  Apto::Array<std::streamoff> m_section_end;      // Payload end of each open section (loading only)
+
+  void writeBytes(uint64_t value, int num_bytes);
+  uint64_t readBytes(int num_bytes);
+
+  cCheckpoint(); // @not_implemented
+  cCheckpoint(const cCheckpoint&); // @not_implemented
+  cCheckpoint& operator=(const cCheckpoint&); // @not_implemented
+
+public:
+  explicit cCheckpoint(std::ostream& out);
+  explicit cCheckpoint(std::istream& in);
+
+  bool IsLoading() const { return (m_in != NULL); }
+  bool IsOK() const { return m_ok; }
+  int GetVersion() const { return m_version; }
+  const cString& GetError() const { return m_error; }
+  void Fail(const cString& error) { if (m_ok) m_error = error; m_ok = false; }
+
+  // Sections may be nested; the tag must be four characters
+  void BeginSection(const char* tag);
+  void EndSection();
+
+  void Transfer(bool& value);
+  void Transfer(char& value);
+  void Transfer(unsigned char& value);
+  void Transfer(int& value);
+  void Transfer(unsigned int& value);
+  void Transfer(long long& value);
+  void Transfer(double& value);
+  void Transfer(cString& value);
+  void Transfer(cCountTracker& value);
+  void Transfer(cDoubleSum& value);
+  void Transfer(cRunningAverage& value);
+
+  template <class T1, class T2> void Transfer(std::pair<T1, T2>& value) { Transfer(value.first); Transfer(value.second); }
+  template <class T, template <class> class SP> void Transfer(Apto::Array<T, SP>& arr);
+  template <class T> void Transfer(tBuffer<T>& buf);
+};
+
+
+template <class T, template <class> class SP> void cCheckpoint::Transfer(Apto::Array<T, SP>& arr)
+{
+  int size = arr.GetSize();
+  Transfer(size);
+  if (!m_ok) return;
+  if (IsLoading()) {
+    if (size < 0) {
+      Fail("invalid array size");
+      return;
+    }
+    arr.Resize(size);
+  }
+  for (int i = 0; i < size && m_ok; i++) Transfer(arr[i]);
+}
+
+template <class T> void cCheckpoint::Transfer(tBuffer<T>& buf)
+{
+  Transfer(buf.data);
+  Transfer(buf.offset);
+  Transfer(buf.total);
+  Transfer(buf.last_total);
+}
+
+#endif
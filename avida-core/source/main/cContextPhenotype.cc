@@ -42,3 +42,20 @@ void cContextPhenotype::AddReactionCounts(int number_reactions, Apto::Array<int>
       m_cur_reaction_count[count] += cur_reaction_count[count];
     }
 }
+
+void cContextPhenotype::SetCountSizes(int number_tasks, int number_reactions)
+{
+    // Size the count arrays without adding anything to them.
+    if(m_number_tasks != number_tasks)
+    {
+      m_cur_task_count.ResizeClear(number_tasks);
+      m_cur_task_count.SetAll(0);
+      m_number_tasks = number_tasks;
+    }
+    if(m_number_reactions != number_reactions)
+    {
+      m_cur_reaction_count.ResizeClear(number_reactions);
+      m_cur_reaction_count.SetAll(0);
+      m_number_reactions = number_reactions;
+    }
+}
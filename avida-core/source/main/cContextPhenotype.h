@@ -44,6 +44,7 @@ public:
   Apto::Array<int>& GetTaskCounts() { return m_cur_task_count; }
   void AddReactionCounts(int count, Apto::Array<int>& cur_task_count);
   Apto::Array<int>& GetReactionCounts() { return m_cur_reaction_count; }
+  void SetCountSizes(int number_tasks, int number_reactions);
 
 };
 
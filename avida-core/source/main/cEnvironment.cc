@@ -53,11 +53,12 @@ using namespace Avida;
 
 cEnvironment::cEnvironment(cWorld* world) : m_world(world) , m_tasklib(world),
 m_input_size(INPUT_SIZE_DEFAULT), m_output_size(OUTPUT_SIZE_DEFAULT), m_true_rand(false),
-m_use_specific_inputs(false), m_specific_inputs(), m_mask(0), m_hammers(false), m_paths(false)
+m_use_specific_inputs(false), m_specific_inputs(), m_mask(0), m_hammers(false), m_paths(false), m_version(0)
 {
   mut_rates.Setup(world);
   if (m_world->GetConfig().DEFAULT_GROUP.Get() != -1) possible_group_ids.insert(m_world->GetConfig().DEFAULT_GROUP.Get());
   pp_fts.Resize(0);
+  setupReactionDispatch();
 }
 
 cEnvironment::~cEnvironment()
@@ -1145,6 +1146,14 @@ bool cEnvironment::LoadSetActive(cString desc, Feedback& feedback)
 }
 
 bool cEnvironment::LoadLine(cString line, Feedback& feedback)
+{
+  m_version++;
+  const bool load_ok = loadLine(line, feedback);
+  setupReactionDispatch();
+  return load_ok;
+}
+
+bool cEnvironment::loadLine(cString line, Feedback& feedback)
 
 /* Routine to read in a line from the enviroment file and hand that line
  line to the approprate routine to process it.                         */
@@ -1194,9 +1203,13 @@ bool cEnvironment::Load(const cString& filename, const cString& working_dir, Fee
 
   for (int line_id = 0; line_id < infile.GetNumLines(); line_id++) {
     // Load the next line from the file.
-    bool load_ok = LoadLine(infile.GetLine(line_id), feedback);
-    if (load_ok == false) return false;
+    bool load_ok = loadLine(infile.GetLine(line_id), feedback);
+    if (load_ok == false) {
+      setupReactionDispatch();
+      return false;
+    }
   }
+  setupReactionDispatch();
 
   // Make sure that all pre-declared reactions have been loaded correctly.
   for (int i = 0; i < reaction_lib.GetSize(); i++) {
@@ -1289,9 +1302,10 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
   // Do setup for reaction tests...
   m_tasklib.SetupTests(taskctx);
 
-  // Loop through all reactions to see if any have been triggered...
-  const int num_reactions = reaction_lib.GetSize();
-  for (int i = 0; i < num_reactions; i++) {
+  // Loop through the reactions that this output could trigger to see if any have been triggered...
+  const Apto::Array<int>& candidates = m_reaction_dispatch[taskctx.GetLogicId() + 1];
+  for (int c = 0; c < candidates.GetSize(); c++) {
+    const int i = candidates[c];
     cReaction* cur_reaction = reaction_lib.GetReaction(i);
     assert(cur_reaction != NULL);
 
@@ -1315,18 +1329,7 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
     }
 
     if (context_phenotype != 0) {
-      Apto::Array<int> blank_tasks;
-      Apto::Array<int> blank_reactions;
-      blank_tasks.ResizeClear(task_count.GetSize());
-      for(int count=0;count<task_count.GetSize();count++) {
-        blank_tasks[count] = 0;
-      }
-      blank_reactions.ResizeClear(this->GetReactionLib().GetSize());
-      for(int count=0;count<reaction_count.GetSize();count++) {
-        blank_reactions[count] = 0;
-      }
-      context_phenotype->AddTaskCounts(blank_tasks.GetSize(), blank_tasks);
-      context_phenotype->AddReactionCounts(blank_reactions.GetSize(), blank_reactions);
+      context_phenotype->SetCountSizes(task_count.GetSize(), reaction_count.GetSize());
       int context_task_count = context_phenotype->GetTaskCounts()[task_id];
       if (TestContextRequisites(cur_reaction, context_task_count, context_phenotype->GetReactionCounts(), on_divide) == false) {
         if (!skipProcessing) {  // for those parasites again
@@ -1367,6 +1370,32 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
   return result.GetActive();
 }
 
+void cEnvironment::setupReactionDispatch()
+{
+  // Reactions using phenotypic plasticity bonuses may mark their task even when it is not performed, so they can
+  // never be skipped.  Otherwise, a reaction with a logic only task is a candidate for only those logic ids for which
+  // its task is performed.
+  m_reaction_dispatch.ResizeClear(257);
+  for (int logic_id = -1; logic_id < 256; logic_id++) m_reaction_dispatch[logic_id + 1].Resize(0);
+  
+  const int num_reactions = reaction_lib.GetSize();
+  for (int i = 0; i < num_reactions; i++) {
+    const cReaction* cur_reaction = reaction_lib.GetReaction(i);
+    const cTaskEntry* cur_task = cur_reaction->GetTask();
+    
+    bool indexed = (cur_task != NULL && cur_task->IsLogicOnly());
+    tLWConstListIterator<cReactionProcess> proc_it(cur_reaction->GetProcesses());
+    const cReactionProcess* cur_proc;
+    while (indexed && (cur_proc = proc_it.Next()) != NULL) {
+      if (cur_proc->GetPhenPlastBonusMethod() != DEFAULT) indexed = false;
+    }
+    
+    for (int logic_id = -1; logic_id < 256; logic_id++) {
+      if (!indexed || cur_task->HasLogicId(logic_id)) m_reaction_dispatch[logic_id + 1].Push(i);
+    }
+  }
+}
+
 bool cEnvironment::TestRequisites(cTaskContext& taskctx, const cReaction* cur_reaction,
                                   int task_count, const Apto::Array<int>& reaction_count, const bool on_divide, bool is_parasite) const
 {
@@ -1831,6 +1860,7 @@ double cEnvironment::GetReactionValue(int reaction_id)
 
 bool cEnvironment::SetReactionValue(cAvidaContext& ctx, const cString& name, double value)
 {
+  m_version++;
   const int num_reactions = reaction_lib.GetSize();
 
   // See if this should be applied to all reactions.
@@ -1872,6 +1902,7 @@ bool cEnvironment::SetReactionValue(cAvidaContext& ctx, const cString& name, dou
 
 bool cEnvironment::SetReactionValueMult(const cString& name, double value_mult)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   found_reaction->MultiplyValue(value_mult);
@@ -1880,6 +1911,7 @@ bool cEnvironment::SetReactionValueMult(const cString& name, double value_mult)
 
 bool cEnvironment::SetReactionInst(const cString& name, cString inst_name)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   found_reaction->ModifyInst(inst_name);
@@ -1888,6 +1920,7 @@ bool cEnvironment::SetReactionInst(const cString& name, cString inst_name)
 
 bool cEnvironment::SetReactionMinTaskCount(const cString& name, int min_count)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   return found_reaction->SetMinTaskCount( min_count );
@@ -1895,6 +1928,7 @@ bool cEnvironment::SetReactionMinTaskCount(const cString& name, int min_count)
 
 bool cEnvironment::SetReactionMaxTaskCount(const cString& name, int max_count)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   return found_reaction->SetMaxTaskCount( max_count );
@@ -1902,6 +1936,7 @@ bool cEnvironment::SetReactionMaxTaskCount(const cString& name, int max_count)
 
 bool cEnvironment::SetReactionMinCount(const cString& name, int reaction_min_count)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   return found_reaction->SetMinReactionCount( reaction_min_count );
@@ -1909,6 +1944,7 @@ bool cEnvironment::SetReactionMinCount(const cString& name, int reaction_min_cou
 
 bool cEnvironment::SetReactionMaxCount(const cString& name, int reaction_max_count)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
   return found_reaction->SetMaxReactionCount( reaction_max_count );
@@ -1916,6 +1952,7 @@ bool cEnvironment::SetReactionMaxCount(const cString& name, int reaction_max_cou
 
 bool cEnvironment::SetReactionTask(const cString& name, const cString& task)
 {
+  m_version++;
   cReaction* found_reaction = reaction_lib.GetReaction(name);
   if (found_reaction == NULL) return false;
 
@@ -1924,6 +1961,7 @@ bool cEnvironment::SetReactionTask(const cString& name, const cString& task)
     if (m_tasklib.GetTask(i).GetName() == task)
     {
       found_reaction->SetTask( m_tasklib.GetTaskReference(i) );
+      setupReactionDispatch();
       return true;
     }
   }
@@ -1933,6 +1971,7 @@ bool cEnvironment::SetReactionTask(const cString& name, const cString& task)
 
 bool cEnvironment::SetResourceInflow(const cString& name, double _inflow )
 {
+  m_version++;
   cResource* found_resource = resource_lib.GetResource(name);
   if (found_resource == NULL) return false;
   found_resource->SetInflow( _inflow );
@@ -1941,6 +1980,7 @@ bool cEnvironment::SetResourceInflow(const cString& name, double _inflow )
 
 bool cEnvironment::SetResourceOutflow(const cString& name, double _outflow )
 {
+  m_version++;
   cResource* found_resource = resource_lib.GetResource(name);
   if (found_resource == NULL) return false;
   found_resource->SetOutflow( _outflow );
@@ -1949,6 +1989,7 @@ bool cEnvironment::SetResourceOutflow(const cString& name, double _outflow )
 
 bool cEnvironment::ChangeResource(cReaction* reaction, const cString& res, int process_num)
 {
+  m_version++;
   cReactionProcess* process = reaction->GetProcess(process_num);
   process->SetResource(m_world->GetEnvironment().GetResourceLib().GetResource(res));
   return true;
@@ -83,6 +83,12 @@ private:
   bool m_hammers;
   bool m_paths;
   
+  int m_version;  // bumped by every change made through the methods below
+  
+  // Reactions that may be triggered by an output with each logic id, offset by one so that inconsistent outputs
+  // (logic id -1) map to index 0.  Reactions whose task does not depend only on the logic id appear in every list.
+  Apto::Array< Apto::Array<int> > m_reaction_dispatch;
+  
   cEnvironment(); // @not_implemented
   cEnvironment(const cEnvironment&); // @not_implemented
   cEnvironment& operator=(const cEnvironment&); // @not_implemented
@@ -93,11 +99,14 @@ public:
 
   bool Load(const cString& filename, const cString& working_dir, Feedback& feedback, const Apto::Map<Apto::String, Apto::String>* defs = NULL);
   bool LoadLine(cString line, Feedback& feedback);  // Reads in a single environment configuration line
+  
+  // Changes on every modification, so that results computed against the environment can tell they are stale
+  int GetVersion() const { return m_version; }
 
   // Interaction with the organisms
   void SetupInputs(cAvidaContext& ctx, Apto::Array<int>& input_array, bool random = true) const;
-  void SetSpecificInputs(const Apto::Array<int> in_input_array) { m_use_specific_inputs = true; m_specific_inputs = in_input_array; }
-  void SetSpecificRandomMask(unsigned int mask) { m_mask = mask; }
+  void SetSpecificInputs(const Apto::Array<int> in_input_array) { m_use_specific_inputs = true; m_specific_inputs = in_input_array; m_version++; }
+  void SetSpecificRandomMask(unsigned int mask) { m_mask = mask; m_version++; }
   void SwapInputs(cAvidaContext& ctx, Apto::Array<int>& src_input_array, Apto::Array<int>& dest_input_array) const;
 
 
@@ -149,17 +158,17 @@ public:
   bool SetResourceOutflow(const cString& name, double _outflow );
   bool ChangeResource(cReaction* reaction, const cString& res, int process_num = 0);
 	
-  void AddGroupID(int new_id) { possible_group_ids.insert(new_id); }
+  void AddGroupID(int new_id) { possible_group_ids.insert(new_id); m_version++; }
   bool IsGroupID(int test_id);
   std::set<int> GetGroupIDs() { return possible_group_ids; }
 
-  void AddTargetID(int new_id) { possible_target_ids.insert(new_id); SetAttackPreyFTList(); }
+  void AddTargetID(int new_id) { possible_target_ids.insert(new_id); SetAttackPreyFTList(); m_version++; }
   bool IsTargetID(int test_id);
   std::set<int> GetTargetIDs() { return possible_target_ids; }
   void SetAttackPreyFTList();
   Apto::Array<int> GetAttackPreyFTList() { return pp_fts; }
 
-  void AddHabitat(int new_habitat) { possible_habitats.insert(new_habitat); }
+  void AddHabitat(int new_habitat) { possible_habitats.insert(new_habitat); m_version++; }
   bool IsHabitat(int test_habitat);
   bool HasHammer() { return m_hammers; }
   bool HasPath() { return m_paths; }
@@ -183,6 +192,8 @@ private:
   bool LoadSetActive(cString desc, Feedback& feedback);
   
   bool LoadGradientResource(cString desc, Feedback& feedback);
+  bool loadLine(cString line, Feedback& feedback);
+  void setupReactionDispatch();
   double GetTaskProbability(cAvidaContext& ctx, cTaskContext& taskctx,
 
                             const tList<cReactionProcess>& req_proc, bool& force_mark_task) const;
@@ -25,9 +25,11 @@
 #include "avida/Avida.h"
 
 #include "cActionLibrary.h"
+#include "cCheckpoint.h"
 #include "cInitFile.h"
 #include "cStats.h"
 #include "cString.h"
+#include "cStringUtil.h"
 #include "cWorld.h"
 
 #include <cfloat>           // for DBL_MIN
@@ -162,7 +164,7 @@ void cEventList::Process(cAvidaContext& ctx)
     
     // IMMEDIATE Events always happen and are always deleted
     if (entry->GetTrigger() == IMMEDIATE) {
-      entry->GetAction()->Process(ctx);
+      processAction(entry, ctx);
       Delete(entry);
     } else if (entry->GetTrigger() != BIRTHS_INTERRUPT) {
       //BIRTHS_INTERRUPT occur outside of update boundaries
@@ -176,7 +178,7 @@ void cEventList::Process(cAvidaContext& ctx)
           (t_val <= entry->GetStop() || entry->GetStop() == TRIGGER_END)) {
 
         // Process the Action
-        entry->GetAction()->Process(ctx);
+        processAction(entry, ctx);
         
         // Handle Interval Adjustment
         if (entry->GetInterval() == TRIGGER_ALL) {
@@ -232,7 +234,7 @@ void cEventList::ProcessInterrupt(cAvidaContext& ctx)
 			if (t_val == entry->GetStart() ) {  //This event *must* happen at this value
 				
 				// Process the Action
-				entry->GetAction()->Process(ctx);
+				processAction(entry, ctx);
 				
 				// Handle Interval Adjustment
 				if (entry->GetInterval() == TRIGGER_ALL) {
@@ -262,6 +264,15 @@ void cEventList::ProcessInterrupt(cAvidaContext& ctx)
 }
 
 
+void cEventList::processAction(cEventListEntry* entry, cAvidaContext& ctx)
+{
+  // Test snapshots still running read the environment and configuration, which anything but output may change
+  if (!cActionLibrary::GetInstance().IsOutput((const char*)entry->GetName())) m_world->FinishSnapshots(ctx);
+  
+  entry->GetAction()->Process(ctx);
+}
+
+
 void cEventList::Sync()
 {
   cEventListEntry* entry = m_head;
@@ -306,6 +317,67 @@ void cEventList::SyncEvent(cEventListEntry* entry)
 }
 
 
+void cEventList::Checkpoint(cCheckpoint& ckpt, Feedback& feedback)
+{
+  ckpt.BeginSection("EVNT");
+  
+  int num_events = 0;
+  for (cEventListEntry* entry = m_head; entry != NULL; entry = entry->GetNext()) num_events++;
+  ckpt.Transfer(num_events);
+  
+  if (ckpt.IsLoading()) {
+    while (m_head != NULL) Delete(m_head);
+    while (m_birth_interrupt_queue.GetSize()) delete m_birth_interrupt_queue.Pop();
+    m_num_events = 0;
+    
+    for (int i = 0; i < num_events && ckpt.IsOK(); i++) {
+      cString name;
+      cString args;
+      int trigger = UNDEFINED;
+      double start = 0.0;
+      double interval = 0.0;
+      double stop = 0.0;
+      double original_start = 0.0;
+      ckpt.Transfer(name);
+      ckpt.Transfer(args);
+      ckpt.Transfer(trigger);
+      ckpt.Transfer(start);
+      ckpt.Transfer(interval);
+      ckpt.Transfer(stop);
+      ckpt.Transfer(original_start);
+      if (!ckpt.IsOK()) break;
+      
+      cEventListEntry* prev_tail = m_tail;
+      if (!AddEvent(static_cast<eTriggerType>(trigger), start, interval, stop, name, args, feedback)) {
+        ckpt.Fail(cStringUtil::Stringf("unable to recreate event '%s'", (const char*)name));
+        break;
+      }
+      // AddEvent() retires events that can no longer fire, in which case the tail is unchanged
+      if (m_tail != prev_tail) m_tail->SetOriginalStart(original_start);
+    }
+  } else {
+    for (cEventListEntry* entry = m_head; entry != NULL; entry = entry->GetNext()) {
+      cString name = entry->GetName();
+      cString args = entry->GetArgs();
+      int trigger = entry->GetTrigger();
+      double start = entry->GetStart();
+      double interval = entry->GetInterval();
+      double stop = entry->GetStop();
+      double original_start = entry->GetOriginalStart();
+      ckpt.Transfer(name);
+      ckpt.Transfer(args);
+      ckpt.Transfer(trigger);
+      ckpt.Transfer(start);
+      ckpt.Transfer(interval);
+      ckpt.Transfer(stop);
+      ckpt.Transfer(original_start);
+    }
+  }
+  
+  ckpt.EndSection();
+}
+
+
 void cEventList::PrintEventList(ostream& os)
 {
   cEventListEntry* entry = m_head;
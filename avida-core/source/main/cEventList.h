@@ -35,6 +35,7 @@ namespace Avida {
 };
 
 class cAvidaContext;
+class cCheckpoint;
 class cString;
 class cWorld;
 
@@ -82,6 +83,7 @@ private:
   void DequeueBirthInterruptEvent(double t_val);
   
   void SyncEvent(cEventListEntry* event);
+  void processAction(cEventListEntry* entry, cAvidaContext& ctx);
   double GetTriggerValue(eTriggerType trigger) const;
   void Delete(cEventListEntry* entry);
   
@@ -111,6 +113,12 @@ public:
   void Process(cAvidaContext& ctx);
   void Sync(); // Get all events caught up.
   
+  /**
+   * Saves the pending events, or replaces the current list with the saved one.  Events are recreated from their
+   * names and arguments, so any state held inside an action is not carried over.
+   **/
+  void Checkpoint(cCheckpoint& ckpt, Feedback& feedback);
+  
   void PrintEventList(std::ostream& os = std::cout);
   
   /**
@@ -165,6 +173,7 @@ private:
     
     void NextInterval(){ m_start += m_interval; }
     void Reset() { m_start = m_original_start; }
+    void SetOriginalStart(double start) { m_original_start = start; }
     
     // accessors
     cAction* GetAction() const { assert(m_action != NULL); return m_action; }
@@ -176,6 +185,7 @@ private:
     double GetStart() const { return m_start; }
     double GetInterval() const { return m_interval; }
     double GetStop() const { return m_stop; }
+    double GetOriginalStart() const { return m_original_start; }
     
     cEventListEntry* GetPrev() const { return m_prev; }
     cEventListEntry* GetNext() const { return m_next; }
@@ -27,6 +27,7 @@
 #include "avida/core/WorldDriver.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cPopulation.h"
 #include "cStats.h"
 #include "cWorld.h"
@@ -125,6 +126,84 @@ cGradientCount::cGradientCount(cWorld* world, int peakx, int peaky, int height,
 
 cGradientCount::~cGradientCount() { ; }
 
+void cGradientCount::Checkpoint(cCheckpoint& ckpt)
+{
+  cSpatialResCount::Checkpoint(ckpt);
+
+  // Gradients move and reshape as they run, so both their (event adjustable) settings and internal values are saved
+  ckpt.Transfer(m_peakx);
+  ckpt.Transfer(m_peaky);
+  ckpt.Transfer(m_height);
+  ckpt.Transfer(m_spread);
+  ckpt.Transfer(m_plateau);
+  ckpt.Transfer(m_decay);
+  ckpt.Transfer(m_max_x);
+  ckpt.Transfer(m_max_y);
+  ckpt.Transfer(m_min_x);
+  ckpt.Transfer(m_min_y);
+  ckpt.Transfer(m_move_a_scaler);
+  ckpt.Transfer(m_updatestep);
+  ckpt.Transfer(m_halo);
+  ckpt.Transfer(m_halo_inner_radius);
+  ckpt.Transfer(m_halo_width);
+  ckpt.Transfer(m_halo_anchor_x);
+  ckpt.Transfer(m_halo_anchor_y);
+  ckpt.Transfer(m_move_speed);
+  ckpt.Transfer(m_move_resistance);
+  ckpt.Transfer(m_plateau_inflow);
+  ckpt.Transfer(m_plateau_outflow);
+  ckpt.Transfer(m_cone_inflow);
+  ckpt.Transfer(m_cone_outflow);
+  ckpt.Transfer(m_gradient_inflow);
+  ckpt.Transfer(m_is_plateau_common);
+  ckpt.Transfer(m_floor);
+  ckpt.Transfer(m_habitat);
+  ckpt.Transfer(m_min_size);
+  ckpt.Transfer(m_max_size);
+  ckpt.Transfer(m_config);
+  ckpt.Transfer(m_count);
+  ckpt.Transfer(m_initial_plat);
+  ckpt.Transfer(m_threshold);
+  ckpt.Transfer(m_damage);
+  ckpt.Transfer(m_geometry);
+  ckpt.Transfer(m_initial);
+  ckpt.Transfer(m_move_y_scaler);
+  ckpt.Transfer(m_counter);
+  ckpt.Transfer(m_move_counter);
+  ckpt.Transfer(m_topo_counter);
+  ckpt.Transfer(m_movesignx);
+  ckpt.Transfer(m_movesigny);
+  ckpt.Transfer(m_old_peakx);
+  ckpt.Transfer(m_old_peaky);
+  ckpt.Transfer(m_halo_dir);
+  ckpt.Transfer(m_changling);
+  ckpt.Transfer(m_just_reset);
+  ckpt.Transfer(m_past_height);
+  ckpt.Transfer(m_current_height);
+  ckpt.Transfer(m_ave_plat_cell_loss);
+  ckpt.Transfer(m_common_plat_height);
+  ckpt.Transfer(m_skip_moves);
+  ckpt.Transfer(m_skip_counter);
+  ckpt.Transfer(m_plateau_array);
+  ckpt.Transfer(m_plateau_cell_IDs);
+  ckpt.Transfer(m_wall_cells);
+  ckpt.Transfer(m_mean_plat_inflow);
+  ckpt.Transfer(m_var_plat_inflow);
+  ckpt.Transfer(m_pred_odds);
+  ckpt.Transfer(m_predator);
+  ckpt.Transfer(m_death_odds);
+  ckpt.Transfer(m_deadly);
+  ckpt.Transfer(m_path);
+  ckpt.Transfer(m_hammer);
+  ckpt.Transfer(m_guarded_juvs_per_adult);
+  ckpt.Transfer(m_probabilistic);
+  ckpt.Transfer(m_prob_res_cells);
+  ckpt.Transfer(m_min_usedx);
+  ckpt.Transfer(m_min_usedy);
+  ckpt.Transfer(m_max_usedx);
+  ckpt.Transfer(m_max_usedy);
+}
+
 void cGradientCount::StateAll()
 {
   return;
@@ -155,7 +234,7 @@ void cGradientCount::updatePeakRes(cAvidaContext& ctx)
     int min_pos_y = max(m_peaky - m_spread - 1, 0);
     for (int ii = min_pos_x; ii < max_pos_x + 1; ii++) {
       for (int jj = min_pos_y; jj < max_pos_y + 1; jj++) {
-        if (Element(jj * GetX() + ii).GetAmount() >= 1) {
+        if (GetAmount(jj * GetX() + ii) >= 1) {
           has_edible = true;
           break;
         }
@@ -378,7 +457,7 @@ void cGradientCount::fillinResourceValues()
               thisheight = 0;
             }
             else {
-              double past_height = Element(old_cell_y * GetX() + old_cell_x).GetAmount(); 
+              double past_height = GetAmount(old_cell_y * GetX() + old_cell_x); 
               double newheight = past_height; 
               if (m_cone_inflow > 0 || m_cone_outflow > 0) newheight += m_cone_inflow - (past_height * m_cone_outflow);
               if (m_gradient_inflow > 0) newheight += m_gradient_inflow / (thisdist + 1); 
@@ -389,7 +468,7 @@ void cGradientCount::fillinResourceValues()
           }
         }
       }
-      Element(jj * GetX() + ii).SetAmount(thisheight);
+      SetCellAmount(jj * GetX() + ii, thisheight);
       if (thisheight > 0) updateBounds(ii, jj);
     }
   }         
@@ -415,7 +494,7 @@ void cGradientCount::getCurrentPlatValues()
       double find_plat_dist = temp_height / (thisdist + 1);
       if ((find_plat_dist >= 1 && m_plateau >= 0) || (m_plateau < 0 && thisdist == 0 && m_plateau_array.GetSize() > 0)) {
         double past_cell_height = m_plateau_array[plateau_cell];
-        double pre_move_height = Element(m_plateau_cell_IDs[plateau_cell]).GetAmount();  
+        double pre_move_height = GetAmount(m_plateau_cell_IDs[plateau_cell]);  
         if (pre_move_height < past_cell_height) {
           m_plateau_array[plateau_cell] = pre_move_height; 
           amount_devoured = amount_devoured + past_cell_height - pre_move_height;
@@ -661,13 +740,13 @@ void cGradientCount::generateBarrier(cAvidaContext& ctx)
     // clear any old resource
     if (m_wall_cells.GetSize()) {
       for (int i = 0; i < m_wall_cells.GetSize(); i++) {
-        Element(m_wall_cells[i]).SetAmount(0);
+        SetCellAmount(m_wall_cells[i], 0);
       }
     }
     else {
       for (int ii = 0; ii < GetX(); ii++) {
         for (int jj = 0; jj < GetY(); jj++) {
-          Element(jj * GetX() + ii).SetAmount(0);
+          SetCellAmount(jj * GetX() + ii, 0);
         }
       }
     }
@@ -685,7 +764,7 @@ void cGradientCount::generateBarrier(cAvidaContext& ctx)
         start_randx = ctx.GetRandom().GetUInt(0, GetX());
         start_randy = ctx.GetRandom().GetUInt(0, GetY());  
       }
-      Element(start_randy * GetX() + start_randx).SetAmount(m_plateau);
+      SetCellAmount(start_randy * GetX() + start_randx, m_plateau);
       // if (m_plateau > 0) updateBounds(start_randx, start_randy);
       updateBounds(start_randx, start_randy);
       m_wall_cells.Push(start_randy * GetX() + start_randx);
@@ -779,12 +858,12 @@ void cGradientCount::generateBarrier(cAvidaContext& ctx)
                randy < (m_halo_anchor_y + m_halo_inner_radius) && 
                randx > (m_halo_anchor_x - m_halo_inner_radius) && 
                randy > (m_halo_anchor_y - m_halo_inner_radius)) || 
-              (m_config == 0 && Element(randy * GetX() + randx).GetAmount())) {
+              (m_config == 0 && GetAmount(randy * GetX() + randx))) {
             num_blocks --;
             count_block = false;
           }
           if (count_block) {
-            Element(randy * GetX() + randx).SetAmount(m_plateau);
+            SetCellAmount(randy * GetX() + randx, m_plateau);
             if (m_plateau > 0) updateBounds(randx, randy);
             m_wall_cells.Push(randy * GetX() + randx);
             if (place_corner) {
@@ -793,7 +872,7 @@ void cGradientCount::generateBarrier(cAvidaContext& ctx)
                      cornery < (m_halo_anchor_y + m_halo_inner_radius) && 
                      cornerx > (m_halo_anchor_x - m_halo_inner_radius) && 
                      cornery > (m_halo_anchor_y - m_halo_inner_radius))) ){
-                  Element(cornery * GetX() + cornerx).SetAmount(m_plateau);
+                  SetCellAmount(cornery * GetX() + cornerx, m_plateau);
                   if (m_plateau > 0) updateBounds(cornerx, cornery);
                   m_wall_cells.Push(randy * GetX() + randx);
                 }
@@ -832,14 +911,14 @@ void cGradientCount::generateHills(cAvidaContext& ctx)
     if (m_min_usedx == -1 || m_min_usedy == -1 || m_max_usedx == -1 || m_max_usedy == -1) {
       for (int ii = 0; ii < GetX(); ii++) {
         for (int jj = 0; jj < GetY(); jj++) {
-          Element(jj * GetX() + ii).SetAmount(0);
+          SetCellAmount(jj * GetX() + ii, 0);
         }
       }
     }
     else {
       for (int ii = m_min_usedx; ii < m_max_usedx + 1; ii++) {
         for (int jj = m_min_usedy; jj < m_max_usedy + 1; jj++) {
-          Element(jj * GetX() + ii).SetAmount(0);
+          SetCellAmount(jj * GetX() + ii, 0);
         }
       }
     }
@@ -879,9 +958,9 @@ void cGradientCount::generateHills(cAvidaContext& ctx)
           double thisheight = 0.0;
           double thisdist = sqrt((double) (m_peakx - ii) * (m_peakx - ii) + (m_peaky - jj) * (m_peaky - jj));
           // only plot values when within set config radius & if no larger amount has already been plotted for another overlapping hill
-          if ((thisdist <= rand_hill_radius) && (Element(jj * GetX() + ii).GetAmount() <  m_plateau / (thisdist + 1))) {
+          if ((thisdist <= rand_hill_radius) && (GetAmount(jj * GetX() + ii) <  m_plateau / (thisdist + 1))) {
           thisheight = m_plateau / (thisdist + 1);
-          Element(jj * GetX() + ii).SetAmount(thisheight);
+          SetCellAmount(jj * GetX() + ii, thisheight);
           if (thisheight > 0) updateBounds(ii, jj);
           }
         }
@@ -970,7 +1049,7 @@ void cGradientCount::UpdatePredatoryRes(cAvidaContext& ctx)
   // kill off up to 1 org per update within the predator radius (plateau area), with prob of death for selected prey = m_pred_odds
   if (m_predator) {
     for (int i = 0; i < m_plateau_cell_IDs.GetSize(); i ++) {
-      if (Element(m_plateau_cell_IDs[i]).GetAmount() >= 1) {
+      if (GetAmount(m_plateau_cell_IDs[i]) >= 1) {
         m_world->GetPopulation().ExecutePredatoryResource(ctx, m_plateau_cell_IDs[i], m_pred_odds, m_guarded_juvs_per_adult, m_hammer);
       }
     }
@@ -989,7 +1068,7 @@ void cGradientCount::UpdateDamagingRes(cAvidaContext& ctx)
   // we don't call this for walls and hills because they never move
   if (m_damage) {
     for (int i = 0; i < m_plateau_cell_IDs.GetSize(); i ++) {
-      if (Element(m_plateau_cell_IDs[i]).GetAmount() >= m_threshold) {
+      if (GetAmount(m_plateau_cell_IDs[i]) >= m_threshold) {
         // skip if initiating world and resources (cells don't exist yet)
         if (ctx.HasDriver()) m_world->GetPopulation().ExecuteDamagingResource(ctx, m_plateau_cell_IDs[i], m_damage, m_hammer);
       }
@@ -1002,7 +1081,7 @@ void cGradientCount::UpdateDeadlyRes(cAvidaContext& ctx)
   // we don't call this for walls and hills because they never move
   if (m_deadly) {
     for (int i = 0; i < m_plateau_cell_IDs.GetSize(); i ++) {
-      if (Element(m_plateau_cell_IDs[i]).GetAmount() >= m_threshold) {
+      if (GetAmount(m_plateau_cell_IDs[i]) >= m_threshold) {
         // skip if initiating world and resources (cells don't exist yet)
         if (ctx.HasDriver()) m_world->GetPopulation().ExecuteDeadlyResource(ctx, m_plateau_cell_IDs[i], m_death_odds, m_hammer);
       }
@@ -1044,7 +1123,7 @@ void cGradientCount::BuildProbabilisticRes(cAvidaContext& ctx, double lambda, do
 
   // only if theta == 1 do want want a 'hill' with resource for certain in the center
   if (theta == 0) {
-    Element(m_peaky * worldx + m_peakx).SetAmount(m_initial_plat);
+    SetCellAmount(m_peaky * worldx + m_peakx, m_initial_plat);
     if (m_initial_plat > 0) updateBounds(m_peakx, m_peaky);
     if (m_plateau_outflow > 0 || m_plateau_inflow > 0) { 
       if (num_cells == -1) m_prob_res_cells.Push(m_peaky * worldx + m_peakx);
@@ -1079,7 +1158,7 @@ void cGradientCount::BuildProbabilisticRes(cAvidaContext& ctx, double lambda, do
     double this_prob = (1/lambda) * (sqrt(2 / 3.14159)) * exp(-0.5 * pow(((cell_dist - theta) / lambda), 2));
     
     if (ctx.GetRandom().P(this_prob)) {
-      Element(cell_id).SetAmount(m_initial_plat);
+      SetCellAmount(cell_id, m_initial_plat);
       if (m_initial_plat > 0) updateBounds(this_x, this_y);
       if (m_plateau_outflow > 0 || m_plateau_inflow > 0) {
         if (loop_once) m_prob_res_cells.Push(cell_id);
@@ -1090,7 +1169,7 @@ void cGradientCount::BuildProbabilisticRes(cAvidaContext& ctx, double lambda, do
     }
     // just push this cell out of the way for this loop, but keep it around for next time
     else { 
-      Element(cell_id).SetAmount(0); 
+      SetCellAmount(cell_id, 0); 
       cell_id_array.Swap(cell_idx, max_unused_idx--);
     }
 
@@ -1106,9 +1185,9 @@ void cGradientCount::UpdateProbabilisticRes()
 {
   if (m_plateau_outflow > 0 || m_plateau_inflow > 0) {
     for (int i = 0; i < m_prob_res_cells.GetSize(); i++) {
-      double curr_val = Element(m_prob_res_cells[i]).GetAmount();
+      double curr_val = GetAmount(m_prob_res_cells[i]);
       double amount = curr_val + m_plateau_inflow - (curr_val * m_plateau_outflow);
-      Element(m_prob_res_cells[i]).SetAmount(amount); 
+      SetCellAmount(m_prob_res_cells[i], amount); 
       if (amount > 0) updateBounds(m_prob_res_cells[i] % GetX(), m_prob_res_cells[i] / GetX());
     }
   }
@@ -1118,7 +1197,7 @@ void cGradientCount::clearExistingProbRes()
 {
   for (int x = m_min_usedx; x < m_max_usedx + 1; x ++) {
     for (int y = m_min_usedy; y < m_max_usedy + 1; y ++) {
-      Element(y * GetX() + x).SetAmount(0);
+      SetCellAmount(y * GetX() + x, 0);
     }
   }
 }
@@ -129,6 +129,8 @@ public:
 
   void UpdateCount(cAvidaContext& ctx);
   void StateAll();
+  void Checkpoint(cCheckpoint& ckpt);
+  bool IsConcurrentSafe() const { return false; } // Draws random numbers and may act on the population
   
   void SetGradInitialPlat(double plat_val) { m_initial_plat = plat_val; m_initial = true; }
   void SetGradPeakX(int peakx) { m_peakx = peakx; }
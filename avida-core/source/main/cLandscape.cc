@@ -96,9 +96,10 @@ void cLandscape::Reset(const Genome& in_genome)
 
 double cLandscape::ProcessGenome(cAvidaContext& ctx, cTestCPU* testcpu, Genome& in_genome)
 {
-  testcpu->TestGenome(ctx, m_cpu_test_info, in_genome);
+  cTestCPUCache::sResult result;
+  testcpu->TestGenome(ctx, m_cpu_test_info, in_genome, result);
   
-  double test_fitness = m_cpu_test_info.GetColonyFitness();
+  double test_fitness = result.fitness;
   
   total_fitness += test_fitness;
   total_sqr_fitness += test_fitness * test_fitness;
@@ -200,8 +201,7 @@ void cLandscape::Process_Body(cAvidaContext& ctx, cTestCPU* testcpu, Genome& cur
       
       mod_genome[line_num].SetOp(inst_num);
       if (cur_distance <= 1) {
-        ProcessGenome(ctx, testcpu, mg);
-        if (m_cpu_test_info.GetColonyFitness() >= neut_min) site_count[line_num]++;
+        if (ProcessGenome(ctx, testcpu, mg) >= neut_min) site_count[line_num]++;
       } else {
         Process_Body(ctx, testcpu, mg, cur_distance - 1, line_num + 1);
       }
@@ -286,8 +286,7 @@ void cLandscape::ProcessDelete(cAvidaContext& ctx)
     int cur_inst = base_seq[line_num].GetOp();
     mod_genome.Remove(line_num);
     mod_seq = mod_genome;
-    ProcessGenome(ctx, testcpu, mg);
-    if (m_cpu_test_info.GetColonyFitness() >= neut_min) site_count[line_num]++;
+    if (ProcessGenome(ctx, testcpu, mg) >= neut_min) site_count[line_num]++;
     mod_genome.Insert(line_num, Instruction(cur_inst));
   }
   
@@ -320,8 +319,7 @@ void cLandscape::ProcessInsert(cAvidaContext& ctx)
     for (int inst_num = 0; inst_num < inst_size; inst_num++) {
       mod_genome.Insert(line_num, Instruction(inst_num));
       mod_seq = mod_genome;
-      ProcessGenome(ctx, testcpu, mg);
-      if (m_cpu_test_info.GetColonyFitness() >= neut_min) site_count[line_num]++;
+      if (ProcessGenome(ctx, testcpu, mg) >= neut_min) site_count[line_num]++;
       mod_genome.Remove(line_num);
     }
   }
@@ -734,8 +732,7 @@ void cLandscape::BuildFitnessChart(cAvidaContext& ctx, cTestCPU* testcpu)
       }
       
       mod_seq[line_num].SetOp(inst_num);
-      ProcessGenome(ctx, testcpu, mod_genome);
-      fitness_chart(line_num, inst_num) = m_cpu_test_info.GetColonyFitness();
+      fitness_chart(line_num, inst_num) = ProcessGenome(ctx, testcpu, mod_genome);
     }
     
     mod_seq[line_num].SetOp(cur_inst);
@@ -921,8 +918,9 @@ double cLandscape::TestMutPair(cAvidaContext& ctx, cTestCPU* testcpu, Genome& mo
 
   mod_seq[line1] = mut1;
   mod_seq[line2] = mut2;
-  testcpu->TestGenome(ctx, m_cpu_test_info, mod_genome);
-  double combo_fitness = m_cpu_test_info.GetColonyFitness() / base_fitness;
+  cTestCPUCache::sResult result;
+  testcpu->TestGenome(ctx, m_cpu_test_info, mod_genome, result);
+  double combo_fitness = result.fitness / base_fitness;
   
   mod_seq[line1] = base_seq[line1];
   mod_seq[line2] = base_seq[line2];
@@ -22,8 +22,9 @@
 
 #include "cMutationRates.h"
 
-#include "cWorld.h"
 #include "cAvidaConfig.h"
+#include "cCheckpoint.h"
+#include "cWorld.h"
 
 
 void cMutationRates::Setup(cWorld* world)
@@ -133,3 +134,44 @@ void cMutationRates::Copy(const cMutationRates& in_muts)
   meta = in_muts.meta;
   update = in_muts.update;
 }
+
+void cMutationRates::Checkpoint(cCheckpoint& ckpt)
+{
+  ckpt.Transfer(copy.mut_prob);
+  ckpt.Transfer(copy.ins_prob);
+  ckpt.Transfer(copy.del_prob);
+  ckpt.Transfer(copy.uniform_prob);
+  ckpt.Transfer(copy.slip_prob);
+  ckpt.Transfer(divide.ins_prob);
+  ckpt.Transfer(divide.del_prob);
+  ckpt.Transfer(divide.mut_prob);
+  ckpt.Transfer(divide.uniform_prob);
+  ckpt.Transfer(divide.slip_prob);
+  ckpt.Transfer(divide.trans_prob);
+  ckpt.Transfer(divide.lgt_prob);
+  ckpt.Transfer(divide.divide_mut_prob);
+  ckpt.Transfer(divide.divide_ins_prob);
+  ckpt.Transfer(divide.divide_del_prob);
+  ckpt.Transfer(divide.divide_uniform_prob);
+  ckpt.Transfer(divide.divide_slip_prob);
+  ckpt.Transfer(divide.divide_trans_prob);
+  ckpt.Transfer(divide.divide_lgt_prob);
+  ckpt.Transfer(divide.divide_poisson_mut_mean);
+  ckpt.Transfer(divide.divide_poisson_ins_mean);
+  ckpt.Transfer(divide.divide_poisson_del_mean);
+  ckpt.Transfer(divide.divide_poisson_slip_mean);
+  ckpt.Transfer(divide.divide_poisson_trans_mean);
+  ckpt.Transfer(divide.divide_poisson_lgt_mean);
+  ckpt.Transfer(divide.parent_mut_prob);
+  ckpt.Transfer(divide.parent_ins_prob);
+  ckpt.Transfer(divide.parent_del_prob);
+  ckpt.Transfer(point.ins_prob);
+  ckpt.Transfer(point.del_prob);
+  ckpt.Transfer(point.mut_prob);
+  ckpt.Transfer(inject.ins_prob);
+  ckpt.Transfer(inject.del_prob);
+  ckpt.Transfer(inject.mut_prob);
+  ckpt.Transfer(meta.copy_mut_prob);
+  ckpt.Transfer(meta.standard_dev);
+  ckpt.Transfer(update.death_prob);
+}
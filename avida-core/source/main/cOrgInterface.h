@@ -118,6 +118,7 @@ public:
   virtual double GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id) = 0;
   virtual const Apto::Array<double>& GetFrozenResources(cAvidaContext& ctx, int cell_id) = 0;
   virtual const Apto::Array< Apto::Array<int> >& GetCellIdLists() = 0; 
+  virtual void MaskResourceAccess(int cell_id, Apto::Array<double>& res_count) = 0;
 
   virtual int GetCurrPeakX(cAvidaContext& ctx, int res_id) = 0;
   virtual int GetCurrPeakY(cAvidaContext& ctx, int res_id) = 0;
@@ -26,6 +26,7 @@
 #include "avida/core/WorldDriver.h"
 
 #include "cAvidaContext.h"
+#include "cCheckpoint.h"
 #include "cContextPhenotype.h"
 #include "cDeme.h"
 #include "cEnvironment.h"
@@ -33,6 +34,7 @@
 #include "cHardwareManager.h"
 #include "cInstSet.h"
 #include "cOrgSensor.h"
+#include "cOutputWorkspace.h"
 #include "cPopulationCell.h"
 #include "cStateGrid.h"
 #include "cStringUtil.h"
@@ -207,7 +209,7 @@ cOrganism::cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, in
   , m_prop_map(this)
 {
 	// initializing this here because it may be needed during hardware creation:
-	m_id = m_world->GetStats().GetTotCreatures();
+	m_id = (ctx.GetBackgroundMode()) ? ctx.GetBackgroundOrgID() : m_world->GetStats().GetTotCreatures();
   
   m_hardware = m_world->GetHardwareManager().Create(ctx, this, genome);
   
@@ -260,6 +262,101 @@ cOrganism::~cOrganism()
 }
 
 
+static void checkpointIntSet(cCheckpoint& ckpt, std::set<int>& values)
+{
+  int size = static_cast<int>(values.size());
+  ckpt.Transfer(size);
+  if (ckpt.IsLoading()) {
+    values.clear();
+    for (int i = 0; i < size && ckpt.IsOK(); i++) {
+      int value = 0;
+      ckpt.Transfer(value);
+      values.insert(value);
+    }
+  } else {
+    for (std::set<int>::iterator it = values.begin(); it != values.end(); it++) {
+      int value = *it;
+      ckpt.Transfer(value);
+    }
+  }
+}
+
+// The organism must already be placed in its cell when loading, so that its hardware and interface exist
+bool cOrganism::Checkpoint(cCheckpoint& ckpt)
+{
+  if (!ckpt.IsLoading()) {
+    if (m_parasites.GetSize() || m_msg || m_opinion || m_neighborhood || m_string_map) {
+      ckpt.Fail("checkpointing parasites, messaging, opinions, neighborhoods and strings is not supported");
+      return false;
+    }
+    if (m_forage_target < -1) {
+      ckpt.Fail("checkpointing predators is not supported");
+      return false;
+    }
+  }
+
+  ckpt.BeginSection("ORGN");
+  ckpt.Transfer(m_id);
+  ckpt.Transfer(m_lineage_label);
+  ckpt.Transfer(cclade_id);
+  m_mut_rates.Checkpoint(ckpt);
+
+  ckpt.Transfer(m_input_pointer);
+  ckpt.Transfer(m_input_buf);
+  ckpt.Transfer(m_output_buf);
+  ckpt.Transfer(m_received_messages);
+  ckpt.Transfer(m_cur_sg);
+  ckpt.Transfer(m_sent_value);
+  ckpt.Transfer(m_sent_active);
+  ckpt.Transfer(m_test_receive_pos);
+  ckpt.Transfer(m_gradient_movement);
+  ckpt.Transfer(m_pher_drop);
+  ckpt.Transfer(frac_energy_donating);
+  ckpt.Transfer(m_max_executed);
+  ckpt.Transfer(m_is_sleeping);
+  ckpt.Transfer(killed_event);
+
+  ckpt.Transfer(m_self_raw_materials);
+  ckpt.Transfer(m_other_raw_materials);
+  checkpointIntSet(ckpt, donor_list);
+  checkpointIntSet(ckpt, donating_lineages);
+  ckpt.Transfer(m_num_donate);
+  ckpt.Transfer(m_num_donate_received);
+  ckpt.Transfer(m_amount_donate_received);
+  ckpt.Transfer(m_num_reciprocate);
+  ckpt.Transfer(m_k);
+  ckpt.Transfer(m_failed_reputation_increases);
+  ckpt.Transfer(m_tag);
+  ckpt.Transfer(m_northerly);
+  ckpt.Transfer(m_easterly);
+  ckpt.Transfer(m_forage_target);
+  ckpt.Transfer(m_show_ft);
+  ckpt.Transfer(m_has_set_ft);
+  ckpt.Transfer(m_teach);
+  ckpt.Transfer(m_parent_teacher);
+  ckpt.Transfer(m_parent_ft);
+  ckpt.Transfer(m_parent_group);
+  ckpt.Transfer(m_p_merit);
+  ckpt.Transfer(m_p_mthread);
+  ckpt.Transfer(m_beggar);
+  ckpt.Transfer(m_para_donate);
+  ckpt.Transfer(m_guard);
+  ckpt.Transfer(m_num_guard);
+  ckpt.Transfer(m_num_deposits);
+  ckpt.Transfer(m_amount_deposited);
+  ckpt.Transfer(m_num_point_mut);
+  ckpt.Transfer(m_repair);
+
+  m_phenotype.Checkpoint(ckpt);
+  ckpt.EndSection();
+
+  if (ckpt.IsOK() && !m_hardware->Checkpoint(ckpt)) {
+    ckpt.Fail("hardware type does not support checkpointing");
+  }
+  return ckpt.IsOK();
+}
+
+
 const PropertyMap& cOrganism::Properties() const { return m_prop_map; }
 
 void cOrganism::SetOrgInterface(cAvidaContext& ctx, cOrgInterface* org_interface)
@@ -414,7 +511,6 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   const int deme_id = m_interface->GetDemeID();
   const Apto::Array<double> & global_resource_count = m_interface->GetResources(ctx);
   const Apto::Array<double> & deme_resource_count = m_interface->GetDemeResources(deme_id, ctx);
-  const Apto::Array< Apto::Array<int> > & cell_id_lists = m_interface->GetCellIdLists();
   
   tList<tBuffer<int> > other_input_list;
   tList<tBuffer<int> > other_output_list;
@@ -443,14 +539,10 @@ void cOrganism::doOutput(cAvidaContext& ctx,
     }
   }
   
-  // Do the testing of tasks performed...
-  
-  
-  Apto::Array<double> global_res_change(global_resource_count.GetSize());
-  global_res_change.SetAll(0.0);
-  Apto::Array<double> deme_res_change(deme_resource_count.GetSize());
-  deme_res_change.SetAll(0.0);
-  Apto::Array<cString> insts_triggered;
+  // Do the testing of tasks performed, using the context's scratch arrays (or a local set, if reentered)
+  cOutputWorkspace nested_ws;
+  cOutputWorkspace* ws = ctx.AcquireOutputWorkspace();
+  if (!ws) ws = &nested_ws;
   
   tBuffer<int>* received_messages_point = &m_received_messages;
   if (!m_world->GetConfig().SAVE_RECEIVED.Get()) received_messages_point = NULL;
@@ -459,32 +551,14 @@ void cOrganism::doOutput(cAvidaContext& ctx,
                        m_hardware->GetExtendedMemory(), on_divide, received_messages_point);
   
   //combine global and deme resource counts
-  Apto::Array<double> globalAndDeme_resource_count = global_resource_count + deme_resource_count;
-  Apto::Array<double> globalAndDeme_res_change = global_res_change + deme_res_change;
+  ws->Prepare(global_resource_count, deme_resource_count);
   
   // set any resource amount to 0 if a cell cannot access this resource
-  int cell_id=GetCellID();
-  if (cell_id_lists.GetSize())
-  {
-    for (int i=0; i<cell_id_lists.GetSize(); i++)
-    {
-      // if cell_id_lists have been set then we have to check if this cell is in the list
-      if (cell_id_lists[i].GetSize()) {
-        int j;
-        for (j=0; j<cell_id_lists[i].GetSize(); j++)
-        {
-          if (cell_id==cell_id_lists[i][j])
-            break;
-        }
-        if (j==cell_id_lists[i].GetSize())
-          globalAndDeme_resource_count[i]=0;
-      }
-    }
-  }
+  m_interface->MaskResourceAccess(GetCellID(), ws->GetResCount());
   
-  bool task_completed = m_phenotype.TestOutput(ctx, taskctx, globalAndDeme_resource_count, 
-                                               m_phenotype.GetCurRBinsAvail(), globalAndDeme_res_change, 
-                                               insts_triggered, is_parasite, context_phenotype);
+  bool task_completed = m_phenotype.TestOutput(ctx, taskctx, ws->GetResCount(), 
+                                               m_phenotype.GetCurRBinsAvail(), ws->GetResChange(), 
+                                               ws->GetInstsTriggered(), is_parasite, context_phenotype);
   
   // Handle merit increases that take the organism above it's current population merit
   if (m_world->GetConfig().MERIT_INC_APPLY_IMMEDIATE.Get()) {
@@ -493,8 +567,7 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   }
   
   //disassemble global and deme resource counts 
-  for (int i = 0; i < global_res_change.GetSize(); i++) global_res_change[i] = globalAndDeme_res_change[i];
-  for (int i = 0; i < deme_res_change.GetSize(); i++) deme_res_change[i] = globalAndDeme_res_change[i + global_res_change.GetSize()];
+  ws->SplitResChange();
   
   if(m_world->GetConfig().ENERGY_ENABLED.Get() && m_world->GetConfig().APPLY_ENERGY_METHOD.Get() == 1 && task_completed) {
     m_phenotype.RefreshEnergy();
@@ -507,17 +580,25 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   }
   if (m_phenotype.GetMakeRandomResource()){
     //call the random resource update function
-    m_interface->UpdateRandomResources(ctx, global_res_change);
+    m_interface->UpdateRandomResources(ctx, ws->GetGlobalResChange());
     
   }else{
-    m_interface->UpdateResources(ctx, global_res_change);
+    m_interface->UpdateResources(ctx, ws->GetGlobalResChange());
   }
 
   //update deme resources
-  m_interface->UpdateDemeResources(ctx, deme_res_change);
+  m_interface->UpdateDemeResources(ctx, ws->GetDemeResChange());
 
-  for (int i = 0; i < insts_triggered.GetSize(); i++) 
-    m_hardware->ProcessBonusInst(ctx, m_hardware->GetInstSet().GetInst(insts_triggered[i]));
+  // Triggered instructions may perform output themselves, so release the workspace before running them
+  const Apto::Array<cString>& insts_triggered = ws->GetInstsTriggered();
+  if (insts_triggered.GetSize() == 0) {
+    ctx.ReleaseOutputWorkspace(ws);
+    return;
+  }
+  Apto::Array<cString> bonus_insts(insts_triggered);
+  ctx.ReleaseOutputWorkspace(ws);
+  for (int i = 0; i < bonus_insts.GetSize(); i++) 
+    m_hardware->ProcessBonusInst(ctx, m_hardware->GetInstSet().GetInst(bonus_insts[i]));
 }
 
 void cOrganism::doAVOutput(cAvidaContext& ctx, 
@@ -530,7 +611,6 @@ void cOrganism::doAVOutput(cAvidaContext& ctx,
   //Avatar output has to be seperate from doOutput to ensure avatars, not the true orgs, are triggering reactions
   //  const int deme_id = m_interface->GetDemeID();
   //  const tArray<double> & deme_resource_count = m_interface->GetDemeResources(deme_id, ctx); //todo: DemeAVResources
-  const Apto::Array< Apto::Array<int> > & cell_id_lists = m_interface->GetCellIdLists();
   
   tList<tBuffer<int> > other_input_list;
   tList<tBuffer<int> > other_output_list;
@@ -582,24 +662,7 @@ void cOrganism::doAVOutput(cAvidaContext& ctx,
   Apto::Array<double> avatarAndDeme_res_change = avatar_res_change; // + deme_res_change;
   
   // set any resource amount to 0 if a cell cannot access this resource
-  int cell_id = m_interface->GetAVCellID();
-  if (cell_id_lists.GetSize())
-  {
-	  for (int i = 0; i < cell_id_lists.GetSize(); i++)
-	  {
-		  // if cell_id_lists have been set then we have to check if this cell is in the list
-		  if (cell_id_lists[i].GetSize()) {
-			  int j = 0;
-			  for (j = 0; j < cell_id_lists[i].GetSize(); j++)
-			  {
-				  if (cell_id == cell_id_lists[i][j])
-					  break;
-			  }
-			  if (j == cell_id_lists[i].GetSize())
-				  avatarAndDeme_res_count[i] = 0;
-		  }
-	  }
-  }
+  m_interface->MaskResourceAccess(m_interface->GetAVCellID(), avatarAndDeme_res_count);
   
   bool task_completed = m_phenotype.TestOutput(ctx, taskctx, avatarAndDeme_res_count, 
                                                m_phenotype.GetCurRBinsAvail(), avatarAndDeme_res_change, 
@@ -30,6 +30,7 @@
 
 #include "cCPUMemory.h"
 #include "cMutationRates.h"
+#include "cObjectPool.h"
 #include "cPhenotype.h"
 #include "cOrgInterface.h"
 #include "cOrgMessage.h"
@@ -46,6 +47,7 @@
 
 class cAvidaContext;
 class cBioGroup;
+class cCheckpoint;
 class cContextPhenotype;
 class cEnvironment;
 class cHardwareBase;
@@ -117,6 +119,10 @@ public:
   cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src);
   ~cOrganism();
   
+  // Organisms are allocated from a shared pool, rather than the general heap
+  static void* operator new(size_t size) { return cObjectPool::AllocateSized(size); }
+  static void operator delete(void* ptr, size_t size) { cObjectPool::FreeSized(ptr, size); }
+  
   static void Initialize();
   
   
@@ -135,6 +141,7 @@ public:
 
   void HardwareReset(cAvidaContext& ctx);
   void NotifyDeath(cAvidaContext& ctx);
+  bool Checkpoint(cCheckpoint& ckpt);
 
   void PrintStatus(std::ostream& fp);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp);
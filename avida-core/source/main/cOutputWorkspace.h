@@ -0,0 +1,83 @@
+/*
+ *  cOutputWorkspace.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cOutputWorkspace_h
+#define cOutputWorkspace_h
+
+#include "cString.h"
+
+
+/**
+ * Scratch arrays used while testing an organism's output for tasks and reactions.  Each context owns one, so that the
+ * arrays keep their storage from one IO instruction to the next instead of being allocated anew every time.
+ **/
+
+class cOutputWorkspace
+{
+private:
+  Apto::Array<double> m_res_count;          // Global followed by deme resources available to the organism
+  Apto::Array<double> m_res_change;         // Global followed by deme resource changes
+  Apto::Array<double> m_global_res_change;
+  Apto::Array<double> m_deme_res_change;
+  Apto::Array<cString> m_insts_triggered;
+  bool m_in_use;
+
+  static inline void sizeArray(Apto::Array<double>& arr, int size) { if (arr.GetSize() != size) arr.ResizeClear(size); }
+
+  cOutputWorkspace(const cOutputWorkspace&); // @not_implemented
+  cOutputWorkspace& operator=(const cOutputWorkspace&); // @not_implemented
+
+public:
+  cOutputWorkspace() : m_in_use(false) { ; }
+
+  bool InUse() const { return m_in_use; }
+  void SetInUse(bool in_use) { m_in_use = in_use; }
+
+  // Load the resources seen by the organism and clear the change and triggered instruction arrays
+  void Prepare(const Apto::Array<double>& global_res, const Apto::Array<double>& deme_res)
+  {
+    const int num_global = global_res.GetSize();
+    const int num_deme = deme_res.GetSize();
+    sizeArray(m_res_count, num_global + num_deme);
+    sizeArray(m_res_change, num_global + num_deme);
+    sizeArray(m_global_res_change, num_global);
+    sizeArray(m_deme_res_change, num_deme);
+    for (int i = 0; i < num_global; i++) m_res_count[i] = global_res[i];
+    for (int i = 0; i < num_deme; i++) m_res_count[num_global + i] = deme_res[i];
+    m_res_change.SetAll(0.0);
+    m_insts_triggered.Resize(0);
+  }
+
+  // Split the combined resource changes back into their global and deme parts
+  void SplitResChange()
+  {
+    const int num_global = m_global_res_change.GetSize();
+    for (int i = 0; i < num_global; i++) m_global_res_change[i] = m_res_change[i];
+    for (int i = 0; i < m_deme_res_change.GetSize(); i++) m_deme_res_change[i] = m_res_change[num_global + i];
+  }
+
+  Apto::Array<double>& GetResCount() { return m_res_count; }
+  Apto::Array<double>& GetResChange() { return m_res_change; }
+  const Apto::Array<double>& GetGlobalResChange() const { return m_global_res_change; }
+  const Apto::Array<double>& GetDemeResChange() const { return m_deme_res_change; }
+  Apto::Array<cString>& GetInstsTriggered() { return m_insts_triggered; }
+};
+
+#endif
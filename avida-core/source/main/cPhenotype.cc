@@ -22,6 +22,7 @@
 
 #include "cPhenotype.h"
 #include "avida/systematics/Types.h"
+#include "cCheckpoint.h"
 #include "cContextPhenotype.h"
 #include "cEnvironment.h"
 #include "cDeme.h"
@@ -66,7 +67,6 @@ cPhenotype::cPhenotype(cWorld* world, int parent_generation, int num_nops)
 , mate_preference(MATE_PREFERENCE_RANDOM)
 , cur_mating_display_a(0)
 , cur_mating_display_b(0)
-, m_reaction_result(NULL)
 , last_task_count(m_world->GetEnvironment().GetNumTasks())
 , last_para_tasks(m_world->GetEnvironment().GetNumTasks())
 , last_host_tasks(m_world->GetEnvironment().GetNumTasks())
@@ -109,11 +109,10 @@ cPhenotype::~cPhenotype()
 {
   // Remove Task States
   for (Apto::Map<void*, cTaskState*>::ValueIterator it = m_task_states.Values(); it.Next();) delete (*it.Get());
-  delete m_reaction_result;
 }
 
 
-cPhenotype::cPhenotype(const cPhenotype& in_phen) : m_reaction_result(NULL)
+cPhenotype::cPhenotype(const cPhenotype& in_phen)
 {
   *this = in_phen;
 }
@@ -337,6 +336,217 @@ cPhenotype& cPhenotype::operator=(const cPhenotype& in_phen)
 }
 
 
+void cPhenotype::Checkpoint(cCheckpoint& ckpt)
+{
+  // Task states are keyed by the task they belong to, and the tolerance records are linked lists; neither has a
+  // stable representation yet, so organisms holding them cannot be saved
+  if (!ckpt.IsLoading() && (m_task_states.GetSize() || m_tolerance_immigrants.GetSize() ||
+                            m_tolerance_offspring_own.GetSize() || m_tolerance_offspring_others.GetSize())) {
+    ckpt.Fail("checkpointing task states and tolerance records is not supported");
+    return;
+  }
+
+  double merit_value = merit.GetDouble();
+  ckpt.Transfer(merit_value);
+  if (ckpt.IsLoading()) merit = merit_value;
+
+  ckpt.Transfer(initialized);
+  ckpt.Transfer(executionRatio);
+  ckpt.Transfer(energy_store);
+  ckpt.Transfer(genome_length);
+  ckpt.Transfer(bonus_instruction_count);
+  ckpt.Transfer(copied_size);
+  ckpt.Transfer(executed_size);
+  ckpt.Transfer(gestation_time);
+  ckpt.Transfer(gestation_start);
+  ckpt.Transfer(fitness);
+  ckpt.Transfer(div_type);
+  ckpt.Transfer(cur_bonus);
+  ckpt.Transfer(cur_energy_bonus);
+  ckpt.Transfer(energy_tobe_applied);
+  ckpt.Transfer(energy_testament);
+  ckpt.Transfer(energy_received_buffer);
+  ckpt.Transfer(total_energy_donated);
+  ckpt.Transfer(total_energy_received);
+  ckpt.Transfer(total_energy_applied);
+  ckpt.Transfer(num_energy_requests);
+  ckpt.Transfer(num_energy_donations);
+  ckpt.Transfer(num_energy_receptions);
+  ckpt.Transfer(num_energy_applications);
+  ckpt.Transfer(cur_num_errors);
+  ckpt.Transfer(cur_num_donates);
+  ckpt.Transfer(cur_task_count);
+  ckpt.Transfer(cur_para_tasks);
+  ckpt.Transfer(cur_host_tasks);
+  ckpt.Transfer(cur_internal_task_count);
+  ckpt.Transfer(eff_task_count);
+  ckpt.Transfer(cur_task_quality);
+  ckpt.Transfer(cur_task_value);
+  ckpt.Transfer(cur_internal_task_quality);
+  ckpt.Transfer(cur_rbins_total);
+  ckpt.Transfer(cur_rbins_avail);
+  ckpt.Transfer(cur_collect_spec_counts);
+  ckpt.Transfer(cur_reaction_count);
+  ckpt.Transfer(first_reaction_cycles);
+  ckpt.Transfer(first_reaction_execs);
+  ckpt.Transfer(cur_stolen_reaction_count);
+  ckpt.Transfer(cur_reaction_add_reward);
+  ckpt.Transfer(cur_inst_count);
+  ckpt.Transfer(cur_from_sensor_count);
+  ckpt.Transfer(cur_group_attack_count);
+  ckpt.Transfer(cur_top_pred_group_attack_count);
+  ckpt.Transfer(cur_killed_targets);
+  ckpt.Transfer(cur_attacks);
+  ckpt.Transfer(cur_kills);
+  ckpt.Transfer(cur_sense_count);
+  ckpt.Transfer(sensed_resources);
+  ckpt.Transfer(cur_task_time);
+  ckpt.Transfer(cur_trial_fitnesses);
+  ckpt.Transfer(cur_trial_bonuses);
+  ckpt.Transfer(cur_trial_times_used);
+  ckpt.Transfer(cur_from_message_count);
+  ckpt.Transfer(trial_time_used);
+  ckpt.Transfer(trial_cpu_cycles_used);
+  ckpt.Transfer(m_intolerances);
+  ckpt.Transfer(last_child_germline_propensity);
+  ckpt.Transfer(mating_type);
+  ckpt.Transfer(mate_preference);
+  ckpt.Transfer(cur_mating_display_a);
+  ckpt.Transfer(cur_mating_display_b);
+  ckpt.Transfer(last_merit_base);
+  ckpt.Transfer(last_bonus);
+  ckpt.Transfer(last_energy_bonus);
+  ckpt.Transfer(last_num_errors);
+  ckpt.Transfer(last_num_donates);
+  ckpt.Transfer(last_task_count);
+  ckpt.Transfer(last_para_tasks);
+  ckpt.Transfer(last_host_tasks);
+  ckpt.Transfer(last_internal_task_count);
+  ckpt.Transfer(last_task_quality);
+  ckpt.Transfer(last_task_value);
+  ckpt.Transfer(last_internal_task_quality);
+  ckpt.Transfer(last_rbins_total);
+  ckpt.Transfer(last_rbins_avail);
+  ckpt.Transfer(last_collect_spec_counts);
+  ckpt.Transfer(last_reaction_count);
+  ckpt.Transfer(last_reaction_add_reward);
+  ckpt.Transfer(last_inst_count);
+  ckpt.Transfer(last_from_sensor_count);
+  ckpt.Transfer(last_sense_count);
+  ckpt.Transfer(last_group_attack_count);
+  ckpt.Transfer(last_top_pred_group_attack_count);
+  ckpt.Transfer(last_killed_targets);
+  ckpt.Transfer(last_attacks);
+  ckpt.Transfer(last_kills);
+  ckpt.Transfer(last_from_message_count);
+  ckpt.Transfer(last_fitness);
+  ckpt.Transfer(last_cpu_cycles_used);
+  ckpt.Transfer(cur_child_germline_propensity);
+  ckpt.Transfer(last_mating_display_a);
+  ckpt.Transfer(last_mating_display_b);
+  ckpt.Transfer(num_divides_failed);
+  ckpt.Transfer(num_divides);
+  ckpt.Transfer(generation);
+  ckpt.Transfer(cpu_cycles_used);
+  ckpt.Transfer(time_used);
+  ckpt.Transfer(num_execs);
+  ckpt.Transfer(age);
+  ckpt.Transfer(fault_desc);
+  ckpt.Transfer(neutral_metric);
+  ckpt.Transfer(life_fitness);
+  ckpt.Transfer(exec_time_born);
+  ckpt.Transfer(gmu_exec_time_born);
+  ckpt.Transfer(birth_update);
+  ckpt.Transfer(birth_cell_id);
+  ckpt.Transfer(av_birth_cell_id);
+  ckpt.Transfer(birth_group_id);
+  ckpt.Transfer(birth_forager_type);
+  ckpt.Transfer(testCPU_inst_count);
+  ckpt.Transfer(last_task_id);
+  ckpt.Transfer(num_new_unique_reactions);
+  ckpt.Transfer(res_consumed);
+  ckpt.Transfer(is_germ_cell);
+  ckpt.Transfer(last_task_time);
+  ckpt.Transfer(to_die);
+  ckpt.Transfer(to_delete);
+  ckpt.Transfer(make_random_resource);
+  ckpt.Transfer(is_injected);
+  ckpt.Transfer(is_clone);
+  ckpt.Transfer(is_donor_cur);
+  ckpt.Transfer(is_donor_last);
+  ckpt.Transfer(is_donor_rand);
+  ckpt.Transfer(is_donor_rand_last);
+  ckpt.Transfer(is_donor_null);
+  ckpt.Transfer(is_donor_null_last);
+  ckpt.Transfer(is_donor_kin);
+  ckpt.Transfer(is_donor_kin_last);
+  ckpt.Transfer(is_donor_edit);
+  ckpt.Transfer(is_donor_edit_last);
+  ckpt.Transfer(is_donor_gbg);
+  ckpt.Transfer(is_donor_gbg_last);
+  ckpt.Transfer(is_donor_truegb);
+  ckpt.Transfer(is_donor_truegb_last);
+  ckpt.Transfer(is_donor_threshgb);
+  ckpt.Transfer(is_donor_threshgb_last);
+  ckpt.Transfer(is_donor_quanta_threshgb);
+  ckpt.Transfer(is_donor_quanta_threshgb_last);
+  ckpt.Transfer(is_donor_shadedgb);
+  ckpt.Transfer(is_donor_shadedgb_last);
+  ckpt.Transfer(is_donor_locus);
+  ckpt.Transfer(is_donor_locus_last);
+  ckpt.Transfer(is_energy_requestor);
+  ckpt.Transfer(is_energy_donor);
+  ckpt.Transfer(is_energy_receiver);
+  ckpt.Transfer(has_used_donated_energy);
+  ckpt.Transfer(has_open_energy_request);
+  ckpt.Transfer(num_thresh_gb_donations);
+  ckpt.Transfer(num_thresh_gb_donations_last);
+  ckpt.Transfer(num_quanta_thresh_gb_donations);
+  ckpt.Transfer(num_quanta_thresh_gb_donations_last);
+  ckpt.Transfer(num_shaded_gb_donations);
+  ckpt.Transfer(num_shaded_gb_donations_last);
+  ckpt.Transfer(num_donations_locus);
+  ckpt.Transfer(num_donations_locus_last);
+  ckpt.Transfer(is_receiver);
+  ckpt.Transfer(is_receiver_last);
+  ckpt.Transfer(is_receiver_rand);
+  ckpt.Transfer(is_receiver_kin);
+  ckpt.Transfer(is_receiver_kin_last);
+  ckpt.Transfer(is_receiver_edit);
+  ckpt.Transfer(is_receiver_edit_last);
+  ckpt.Transfer(is_receiver_gbg);
+  ckpt.Transfer(is_receiver_truegb);
+  ckpt.Transfer(is_receiver_truegb_last);
+  ckpt.Transfer(is_receiver_threshgb);
+  ckpt.Transfer(is_receiver_threshgb_last);
+  ckpt.Transfer(is_receiver_quanta_threshgb);
+  ckpt.Transfer(is_receiver_quanta_threshgb_last);
+  ckpt.Transfer(is_receiver_shadedgb);
+  ckpt.Transfer(is_receiver_shadedgb_last);
+  ckpt.Transfer(is_receiver_gb_same_locus);
+  ckpt.Transfer(is_receiver_gb_same_locus_last);
+  ckpt.Transfer(is_modifier);
+  ckpt.Transfer(is_modified);
+  ckpt.Transfer(is_fertile);
+  ckpt.Transfer(is_mutated);
+  ckpt.Transfer(is_multi_thread);
+  ckpt.Transfer(parent_true);
+  ckpt.Transfer(parent_sex);
+  ckpt.Transfer(parent_cross_num);
+  ckpt.Transfer(born_parent_group);
+  ckpt.Transfer(kaboom_executed);
+  ckpt.Transfer(kaboom_executed2);
+  ckpt.Transfer(copy_true);
+  ckpt.Transfer(divide_sex);
+  ckpt.Transfer(mate_select_id);
+  ckpt.Transfer(cross_num);
+  ckpt.Transfer(child_fertile);
+  ckpt.Transfer(last_child_fertile);
+  ckpt.Transfer(child_copied_size);
+  ckpt.Transfer(permanent_germline_propensity);
+}
+
+
 /**
  * This function is run whenever a new organism is being constructed inside
  * of its parent.
@@ -1508,8 +1718,11 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
   const double task_refractory_period = m_world->GetConfig().TASK_REFRACTORY_PERIOD.Get();
   double refract_factor;
   
-  if (!m_reaction_result) m_reaction_result = new cReactionResult(num_resources, num_tasks, num_reactions);
-  cReactionResult& result = *m_reaction_result;
+  // Snapshot test CPUs run on analyze workers alongside the population, and so leave the stats alone
+  const bool record_stats = !ctx.GetBackgroundMode();
+  
+  // The reaction result is scratch space, invalidated before returning, so it is shared by every phenotype in this context
+  cReactionResult& result = ctx.GetReactionResult(num_resources, num_tasks, num_reactions);
   
   // Run everything through the environment.
   bool found = env.TestOutput(ctx, result, taskctx, eff_task_count, cur_reaction_count, res_in, rbins_in, 
@@ -1554,7 +1767,7 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
       if (result.UsedEnvResource() == false) { cur_internal_task_count[i]++; }
       
       // if we want to generate an age-task histogram
-      if (m_world->GetConfig().AGE_POLY_TRACKING.Get()) {
+      if (record_stats && m_world->GetConfig().AGE_POLY_TRACKING.Get()) {
         m_world->GetStats().AgeTaskEvent(taskctx.GetOrganism()->GetID(), i, time_used);
       }
     }
@@ -1571,7 +1784,7 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
   }
 
   for (int i = 0; i < num_tasks; i++) {
-    if (result.TaskDone(i) && !last_task_count[i]) {
+    if (record_stats && result.TaskDone(i) && !last_task_count[i]) {
       m_world->GetStats().AddNewTaskCount(i);
       int prev_num_tasks = 0;
       int cur_num_tasks = 0;
@@ -1585,7 +1798,7 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
   
   for (int i = 0; i < num_reactions; i++) {
     cur_reaction_add_reward[i] += result.GetReactionAddBonus(i);
-    if (result.ReactionTriggered(i) && last_reaction_count[i]==0) {
+    if (record_stats && result.ReactionTriggered(i) && last_reaction_count[i]==0) {
       m_world->GetStats().AddNewReactionCount(i);
     }
     if (result.ReactionTriggered(i) == true) {
@@ -1614,7 +1827,7 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
             // track time used if applicable
             int cur_time_used = time_used - last_task_time; 
             last_task_time = time_used;
-            m_world->GetStats().AddTaskSwitchTime(last_task_id, i, cur_time_used);
+            if (record_stats) m_world->GetStats().AddTaskSwitchTime(last_task_id, i, cur_time_used);
             if (last_task_id != i) {
               num_new_unique_reactions++;
               last_task_id = i;
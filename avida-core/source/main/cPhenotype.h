@@ -60,6 +60,7 @@
  *************************************************************************/
 
 class cAvidaContext;
+class cCheckpoint;
 class cContextPhenotype;
 class cEnvironment;
 template <class T> class tBuffer;
@@ -156,8 +157,6 @@ private:
   int cur_mating_display_a;                   // value of organism's current mating display A trait
   int cur_mating_display_b;                   // value of organism's current mating display B trait
 
-  cReactionResult* m_reaction_result;
-  
 
 
   // 3. These mark the status of "in progress" variables at the last divide.
@@ -315,7 +314,7 @@ private:
   inline void SetGroupAttackInstSetSize(int num_group_attack_inst);
   
 public:
-  cPhenotype() : m_world(NULL), m_reaction_result(NULL) { ; } // Will not construct a valid cPhenotype! Only exists to support incorrect cDeme Apto::Array usage.
+  cPhenotype() : m_world(NULL) { ; } // Will not construct a valid cPhenotype! Only exists to support incorrect cDeme Apto::Array usage.
   cPhenotype(cWorld* world, int parent_generation, int num_nops);
 
 
@@ -327,6 +326,7 @@ public:
 	
   void ResetMerit();
   void Sterilize();
+  void Checkpoint(cCheckpoint& ckpt);
   // Run when being setup *as* and offspring.
   void SetupOffspring(const cPhenotype & parent_phenotype, const InstructionSequence & _genome);
 
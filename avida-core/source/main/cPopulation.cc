@@ -35,6 +35,7 @@
 
 #include "avida/private/systematics/GenomeTestMetrics.h"
 #include "avida/private/systematics/Genotype.h"
+#include "avida/private/systematics/GenotypeArbiter.h"
 
 #include "apto/rng.h"
 #include "apto/scheduler.h"
@@ -44,6 +45,7 @@
 
 #include "cAvidaContext.h"
 #include "cCPUTestInfo.h"
+#include "cCheckpoint.h"
 #include "cCodeLabel.h"
 #include "cDemePlaceholderUnit.h"
 #include "cEnvironment.h"
@@ -56,11 +58,13 @@
 #include "cParasite.h"
 #include "cPhenotype.h"
 #include "cPopulationCell.h"
+#include "cReplayRandom.h"
 #include "cResource.h"
 #include "cResourceCount.h"
 #include "cStats.h"
 #include "cTestCPU.h"
 #include "cTopology.h"
+#include "cTournamentIndex.h"
 #include "cWorld.h"
 
 #include "cHardwareCPU.h"
@@ -265,7 +269,15 @@ public:
 cPopulation::cPopulation(cWorld* world)  
 : m_world(world)
 , m_scheduler(NULL)
+, m_scheduler_rng(NULL)
+, m_scheduled_cell(-1)
 , birth_chamber(world)
+, m_update_pool(NULL)
+, m_resource_pool(NULL)
+, m_reaper_index(NULL)
+, m_reaper_stamp(0)
+, m_time_used_index(NULL)
+, m_changed_cells_valid(false)
 , print_mini_trace_genomes(false)
 , use_micro_traces(false)
 , m_next_prey_q(0)
@@ -297,6 +309,11 @@ cPopulation::cPopulation(cWorld* world)
   
   
   SetupCellGrid();
+  resource_count.AttachClock(&m_resource_clock);
+  if (m_world->GetConfig().RESOURCE_THREADS.Get() > 1) {
+    m_resource_pool = new cWorkerPool(m_world->GetConfig().RESOURCE_THREADS.Get());
+    resource_count.SetWorkerPool(m_resource_pool);
+  }
   
   Data::ArgumentedProviderActivateFunctor activate(m_world, &cWorld::GetPopulationProvider);
   m_world->GetDataManager()->Register("core.population.group_id[]", activate);
@@ -315,7 +332,8 @@ cPopulation::cPopulation(cWorld* world)
 void cPopulation::ClearCellGrid()
 {
   delete sleep_log; sleep_log = NULL;
-  reaper_queue.Clear();
+  delete m_reaper_index; m_reaper_index = NULL;
+  delete m_time_used_index; m_time_used_index = NULL;
   delete m_scheduler; m_scheduler = NULL;
 }
 
@@ -341,9 +359,10 @@ void cPopulation::SetupCellGrid()
   
   // Setup the cells.  Do things that are not dependent upon topology here.
   bool fill_reaper_queue = (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST);
+  if (fill_reaper_queue) m_reaper_index = new cTournamentIndex(num_cells);
   for (int i = 0; i < num_cells; i++) {
     cell_array[i].Setup(m_world, i, environment.GetMutRates(), i % world_x, i / world_x);    
-    if (fill_reaper_queue) reaper_queue.Push(&(cell_array[i]));
+    if (fill_reaper_queue) PushReaperCell(i);
   }
   
   // What are the sizes of the demes that we're creating?
@@ -364,6 +383,7 @@ void cPopulation::SetupCellGrid()
       cell_array[cell_id].SetDemeID(deme_id);
     }
     deme_array[deme_id].Setup(deme_id, deme_cells, deme_size_x, m_world);
+    deme_array[deme_id].AttachResourceClock(&m_deme_resource_clock);
   }
   
   // Setup the topology.
@@ -604,6 +624,10 @@ cPopulation::~cPopulation()
 {
   for (int i = 0; i < cell_array.GetSize(); i++) delete cell_array[i].GetOrganism(); 
   delete m_scheduler;
+  delete m_update_pool;
+  delete m_resource_pool;
+  delete m_reaper_index;
+  delete m_time_used_index;
 }
 
 
@@ -611,7 +635,18 @@ inline void cPopulation::AdjustSchedule(const cPopulationCell& cell, const cMeri
 {
   const int deme_id = cell.GetDemeID();
   const cDeme& deme = deme_array[deme_id];
-  m_scheduler->AdjustPriority(cell.GetID(), deme.HasDemeMerit() ? (merit.GetDouble() * deme.GetDemeMerit().GetDouble()) : merit.GetDouble());
+  const double priority = deme.HasDemeMerit() ? (merit.GetDouble() * deme.GetDemeMerit().GetDouble()) : merit.GetDouble();
+  m_schedule_priority[cell.GetID()] = priority;
+  m_scheduler->AdjustPriority(cell.GetID(), priority);
+}
+
+// Note that a cell has executed, so that its time used is re-indexed before the next full soup energy used birth
+inline void cPopulation::MarkTimeUsed(int cell_id)
+{
+  if (m_time_used_index && !m_time_used_is_dirty[cell_id]) {
+    m_time_used_is_dirty[cell_id] = true;
+    m_time_used_dirty.Push(cell_id);
+  }
 }
 
 
@@ -931,6 +966,7 @@ bool cPopulation::ActivateOffspring(cAvidaContext& ctx, const Genome& offspring_
         }
       }
       AdjustSchedule(parent_cell, parent_phenotype.GetMerit());
+      CellContentsChanged(parent_cell);
       
       if (!is_doomed) {
         // In a local run, face the offspring toward the parent.
@@ -1329,10 +1365,11 @@ bool cPopulation::ActivateOrganism(cAvidaContext& ctx, cOrganism* in_organism, c
   
   // Initialize the time-slice for this new organism.
   AdjustSchedule(target_cell, in_organism->GetPhenotype().GetMerit());
+  CellContentsChanged(target_cell);
   
   // Special handling for certain birth methods.
   if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST) {
-    reaper_queue.Push(&target_cell);
+    PushReaperCell(target_cell.GetID());
   }
   
   // If neural networking, add input and output avatars.. @JJB**
@@ -2262,6 +2299,7 @@ void cPopulation::KillOrganism(cPopulationCell& in_cell, cAvidaContext& ctx)
   
   // Alert the scheduler that this cell has a 0 merit.
   AdjustSchedule(in_cell, cMerit(0));
+  CellContentsChanged(in_cell);
 }
 
 void cPopulation::InjureOrg(cAvidaContext& ctx, cPopulationCell& in_cell, double injury, bool ding_reacs)
@@ -2449,6 +2487,9 @@ void cPopulation::SwapCells(int cell_id1, int cell_id2, cAvidaContext& ctx)
     AdjustSchedule(cell2, cMerit(0));
   }
   
+  CellContentsChanged(cell1);
+  CellContentsChanged(cell2);
+  
   //LHZ: Take organism imputs from the PopulationCell along with the organisms
   environment.SwapInputs(ctx, cell1.m_inputs, cell2.m_inputs);
   
@@ -5285,12 +5326,7 @@ cPopulationCell& cPopulation::PositionOffspring(cPopulationCell& parent_cell, cA
   }
   
   if (birth_method == POSITION_OFFSPRING_FULL_SOUP_ELDEST) {
-    cPopulationCell * out_cell = reaper_queue.PopRear();
-    if (parent_ok == false && out_cell->GetID() == parent_cell.GetID()) {
-      out_cell = reaper_queue.PopRear();
-      reaper_queue.PushRear(&parent_cell);
-    }
-    return *out_cell;
+    return GetCell(PopReaperCell(parent_ok ? -1 : parent_cell.GetID()));
   }
   
   if (birth_method == POSITION_OFFSPRING_DEME_RANDOM) {
@@ -5305,24 +5341,8 @@ cPopulationCell& cPopulation::PositionOffspring(cPopulationCell& parent_cell, cA
     return GetCell(out_cell_id);
   }
   else if (birth_method == POSITION_OFFSPRING_FULL_SOUP_ENERGY_USED) {
-    tList<cPopulationCell> found_list;
-    int max_time_used = 0;
-    for  (int i=0; i < cell_array.GetSize(); i++)
-    {
-      int time_used = cell_array[i].IsOccupied() ? cell_array[i].GetOrganism()->GetPhenotype().GetTimeUsed() : INT_MAX;
-      if (time_used == max_time_used)
-      {
-        found_list.Push(&cell_array[i]);
-      }
-      else if (time_used > max_time_used)
-      {
-        max_time_used = time_used;
-        found_list.Clear();
-        found_list.Push(&cell_array[i]);
-      }
-    }
-    int choice = ctx.GetRandom().GetUInt(found_list.GetSize());
-    return *( found_list.GetPos(choice) );
+    MarkTimeUsed(parent_cell.GetID());
+    return GetCell(FindMaxTimeUsedCell(ctx));
   }
   
   // All remaining methods require us to choose among mulitple local positions.
@@ -5642,6 +5662,109 @@ int cPopulation::FindRandEmptyCell(cAvidaContext& ctx)
   return cell_id;
 }
 
+
+// Re-key a cell in the population-wide replacement indices after an organism has entered, left, or divided in it.
+void cPopulation::UpdateReplacementIndices(const cPopulationCell& cell)
+{
+  const int cell_id = cell.GetID();
+  const cOrganism* org = cell.GetOrganism();
+  if (m_time_used_index) {
+    m_time_used_index->SetKey(cell_id, (org) ? org->GetPhenotype().GetTimeUsed() : INT_MAX);
+  }
+}
+
+
+// Called whenever an organism enters, leaves, or divides in a cell, so that everything keyed on cell contents can follow.
+void cPopulation::CellContentsChanged(const cPopulationCell& cell)
+{
+  UpdateReplacementIndices(cell);
+
+  const int cell_id = cell.GetID();
+  if (m_changed_cells_valid && !m_cell_changed[cell_id]) {
+    m_cell_changed[cell_id] = true;
+    m_changed_cells.Push(cell_id);
+  }
+}
+
+
+// Begin a new changed cell period.  Until the first call, cells are not tracked and the changed set is never valid.
+void cPopulation::ResetChangedCells()
+{
+  if (m_cell_changed.GetSize() != cell_array.GetSize()) {
+    m_cell_changed.ResizeClear(cell_array.GetSize());
+    m_cell_changed.SetAll(false);
+  } else {
+    for (int i = 0; i < m_changed_cells.GetSize(); i++) m_cell_changed[m_changed_cells[i]] = false;
+  }
+  m_changed_cells.Resize(0);
+  m_changed_cells_valid = true;
+}
+
+
+// The reaper queue hands out cells in the order that they were (re)filled, oldest first.
+void cPopulation::PushReaperCell(int cell_id)
+{
+  assert(m_reaper_index);
+  if (m_reaper_stamp == INT_MAX) RenumberReaperCells();
+  m_reaper_index->SetKey(cell_id, -(++m_reaper_stamp));
+}
+
+// Before the stamps run out, number the queued cells afresh from 1 upward, keeping their order
+void cPopulation::RenumberReaperCells()
+{
+  Apto::Array<int> queued;
+  while (m_reaper_index->GetNumMax() > 0) {
+    const int cell_id = m_reaper_index->FindMax();
+    m_reaper_index->SetKey(cell_id, cTournamentIndex::NO_KEY);
+    queued.Push(cell_id);
+  }
+  for (int i = 0; i < queued.GetSize(); i++) m_reaper_index->SetKey(queued[i], -(i + 1));
+  m_reaper_stamp = queued.GetSize();
+}
+
+int cPopulation::PopReaperCell(int skip_cell)
+{
+  assert(m_reaper_index);
+  
+  // A skipped cell keeps its place in the queue
+  int skip_key = cTournamentIndex::NO_KEY;
+  if (skip_cell >= 0) {
+    skip_key = m_reaper_index->GetKey(skip_cell);
+    m_reaper_index->SetKey(skip_cell, cTournamentIndex::NO_KEY);
+  }
+  
+  const int cell_id = m_reaper_index->FindMax();
+  assert(cell_id >= 0);
+  m_reaper_index->SetKey(cell_id, cTournamentIndex::NO_KEY);
+  
+  if (skip_cell >= 0) m_reaper_index->SetKey(skip_cell, skip_key);
+  return cell_id;
+}
+
+
+// Find the cell whose organism has used the most time, choosing randomly among ties.  Empty cells come first.  Ties are
+// numbered from the last cell down, as the list the scan once built counted them.
+int cPopulation::FindMaxTimeUsedCell(cAvidaContext& ctx)
+{
+  if (!m_time_used_index) {
+    m_time_used_index = new cTournamentIndex(cell_array.GetSize());
+    m_time_used_is_dirty.ResizeClear(cell_array.GetSize());
+    m_time_used_is_dirty.SetAll(false);
+    m_time_used_dirty.Resize(0);
+    for (int i = 0; i < cell_array.GetSize(); i++) UpdateReplacementIndices(cell_array[i]);
+  }
+  
+  for (int i = 0; i < m_time_used_dirty.GetSize(); i++) {
+    const int cell_id = m_time_used_dirty[i];
+    m_time_used_is_dirty[cell_id] = false;
+    UpdateReplacementIndices(cell_array[cell_id]);
+  }
+  m_time_used_dirty.Resize(0);
+  
+  const int num_max = m_time_used_index->GetNumMax();
+  return m_time_used_index->FindMax(num_max - 1 - ctx.GetRandom().GetUInt(num_max));
+}
+
 // This function updates the list of empty cell ids in the population
 // and returns the number of empty cells found. Used by global PREFER_EMPTY
 // PositionOffspring() methods with demes (only). 
@@ -5672,7 +5795,8 @@ int cPopulation::UpdateEmptyCellIDArray(int deme_id)
 
 int cPopulation::ScheduleOrganism()
 {
-  return m_scheduler->Next();
+  m_scheduled_cell = m_scheduler->Next();
+  return m_scheduled_cell;
 }
 
 void cPopulation::ProcessStep(cAvidaContext& ctx, double step_size, int cell_id)
@@ -5688,6 +5812,7 @@ void cPopulation::ProcessStep(cAvidaContext& ctx, double step_size, int cell_id)
   cOrganism* cur_org = cell.GetOrganism();
   
   cell.GetHardware()->SingleProcess(ctx);
+  MarkTimeUsed(cell_id);
   
   double merit = cur_org->GetPhenotype().GetMerit().GetDouble();
   if (cur_org->GetPhenotype().GetToDelete() == true) {
@@ -5696,12 +5821,12 @@ void cPopulation::ProcessStep(cAvidaContext& ctx, double step_size, int cell_id)
   }
   
   m_world->GetStats().IncExecuted();
-  resource_count.Update(step_size);
   
-  // These must be done even if there is only one deme.
-  for(int i = 0; i < GetNumDemes(); i++) {
-    GetDeme(i).Update(step_size);
-  }
+  // Resource time is applied lazily by the resource counts themselves (see cResourceClock), so advancing it is O(1)
+  // regardless of the number of demes.  These must be done even if there is only one deme.
+  if (step_size != m_resource_clock.GetStepSize() && m_resource_clock.GetSteps()) CloseResourceClocks();
+  m_resource_clock.Tick(step_size);
+  m_deme_resource_clock.Tick(step_size);
   
   cDeme & deme = GetDeme(GetCell(cell_id).GetDemeID());
   deme.IncTimeUsed(merit);
@@ -5730,8 +5855,9 @@ void cPopulation::ProcessStepSpeculative(cAvidaContext& ctx, double step_size, i
     // We have already executed this instruction, just decrement the counter
     cell.DecSpeculative();
   } else {
-    // Execute the actual instruction
-    if (hw->SingleProcess(ctx)) {
+    // Execute the actual instruction.  When parallel update workers are active, speculation is instead performed in
+    // bulk at each sync point (see ProcessParallelSpeculation).
+    if (hw->SingleProcess(ctx) && !m_update_pool) {
       // Speculatively execute additional instructions
       int spec_count = 0;
       while (spec_count < 32) {
@@ -5742,10 +5868,13 @@ void cPopulation::ProcessStepSpeculative(cAvidaContext& ctx, double step_size, i
       m_world->GetStats().AddSpeculative(spec_count);
     }
   }
+  MarkTimeUsed(cell_id);
+  
+  if (step_size != m_resource_clock.GetStepSize() && m_resource_clock.GetSteps()) CloseResourceClocks();
   
   // Deme specific
   if (GetNumDemes() > 1) {
-    for(int i = 0; i < GetNumDemes(); i++) GetDeme(i).Update(step_size);
+    m_deme_resource_clock.Tick(step_size);
     
     cDeme& deme = GetDeme(GetCell(cell_id).GetDemeID());
     deme.IncTimeUsed(cur_org->GetPhenotype().GetMerit().GetDouble());
@@ -5759,9 +5888,109 @@ void cPopulation::ProcessStepSpeculative(cAvidaContext& ctx, double step_size, i
   }
   
   m_world->GetStats().IncExecuted();
-  resource_count.Update(step_size);
+  m_resource_clock.Tick(step_size);
+}
+
+class cSpeculativeBandTask : public cWorkerPool::cTask
+{
+private:
+  cWorld* m_world;
+  Apto::Array<cPopulationCell>& m_cells;
+  int m_band_size;
+  int m_depth;
+  bool m_fault_reporting;
+  Apto::Array<int> m_seeds;
+  Apto::Array<int> m_spec_total;
+  Apto::Array<int> m_spec_num;
+  
+public:
+  cSpeculativeBandTask(cWorld* world, Apto::Array<cPopulationCell>& cells, int num_bands, int depth, cAvidaContext& ctx)
+    : m_world(world), m_cells(cells), m_depth(depth), m_fault_reporting(ctx.OrgFaultReporting())
+    , m_seeds(num_bands), m_spec_total(num_bands), m_spec_num(num_bands)
+  {
+    m_band_size = (cells.GetSize() + num_bands - 1) / num_bands;
+    
+    // Seeds are drawn in band order from the calling context, so each band receives the same random stream
+    // regardless of which worker happens to claim it.
+    for (int i = 0; i < num_bands; i++) {
+      m_seeds[i] = ctx.GetRandom().GetInt(ctx.GetRandom().MaxSeed());
+      m_spec_total[i] = 0;
+      m_spec_num[i] = 0;
+    }
+  }
+  
+  int GetSpecTotal(int band) const { return m_spec_total[band]; }
+  int GetSpecNum(int band) const { return m_spec_num[band]; }
+  
+  void Run(int worker_id, int task_id)
+  {
+    (void)worker_id;
+    
+    Apto::RNG::AvidaRNG rng(m_seeds[task_id]);
+    cAvidaContext ctx(&m_world->GetDriver(), rng);
+    if (m_fault_reporting) ctx.EnableOrgFaultReporting();
+    
+    const int begin = task_id * m_band_size;
+    const int end = Apto::Min(begin + m_band_size, m_cells.GetSize());
+    for (int i = begin; i < end; i++) {
+      cPopulationCell& cell = m_cells[i];
+      if (!cell.IsOccupied()) continue;
+      
+      cHardwareBase* hw = cell.GetHardware();
+      if (!hw->SupportsSpeculative() || hw->IsTraced()) continue;
+      
+      // Only instructions that cannot affect other organisms are executed here (speculative execution stops at the
+      // first instruction flagged STALL), so cells in different bands never touch shared state.
+      const int start = cell.GetSpeculativeState();
+      int count = start;
+      while (count < m_depth && hw->SingleProcess(ctx, true)) count++;
+      
+      if (count > start) {
+        cell.SetSpeculativeState(count);
+        m_spec_total[task_id] += count - start;
+        m_spec_num[task_id]++;
+      }
+    }
+  }
+};
+
+
+void cPopulation::SetupParallelUpdate(int num_threads)
+{
+  delete m_update_pool;
+  m_update_pool = NULL;
+  if (num_threads > 1) m_update_pool = new cWorkerPool(num_threads);
+}
+
+
+// Pre-execute all organisms in parallel, up to UPDATE_THREAD_DEPTH speculative instructions each.  The serial
+// ProcessStepSpeculative loop then consumes these credits one at a time, executing only the STALL instructions
+// (divides, IO, movement, resource access, ...) itself, in schedule order.
+//
+// Cells are split into a fixed number of contiguous bands, each band having its own random number stream seeded from
+// ctx, so results are reproducible for any given seed and thread count.
+void cPopulation::ProcessParallelSpeculation(cAvidaContext& ctx)
+{
+  assert(m_update_pool);
+  
+  const int num_bands = Apto::Min(m_update_pool->GetNumWorkers() * 4, cell_array.GetSize());
+  if (num_bands <= 0) return;
+  
+  cSpeculativeBandTask task(m_world, cell_array, num_bands, m_world->GetConfig().UPDATE_THREAD_DEPTH.Get(), ctx);
+  m_update_pool->Execute(task, num_bands);
+  
+  cStats& stats = m_world->GetStats();
+  for (int i = 0; i < num_bands; i++) {
+    if (task.GetSpecNum(i)) stats.AddSpeculative(task.GetSpecTotal(i), task.GetSpecNum(i));
+  }
+  
+  // Pre-executed organisms have used time that the time used index has not yet seen
+  if (m_time_used_index) {
+    for (int i = 0; i < cell_array.GetSize(); i++) if (cell_array[i].GetSpeculativeState()) MarkTimeUsed(i);
+  }
 }
 
+
 // Loop through all the demes getting stats and doing calculations
 // which must be done on a deme by deme basis.
 void cPopulation::UpdateDemeStats(cAvidaContext& ctx) { 
@@ -6208,8 +6437,20 @@ void cPopulation::ProcessPreUpdate()
   for (int i = 0; i < deme_array.GetSize(); i++) deme_array[i].ProcessPreUpdate();   
 }
 
+// Bring every resource count up to date with the steps executed so far and start counting anew
+void cPopulation::CloseResourceClocks()
+{
+  resource_count.SyncClock();
+  for (int i = 0; i < deme_array.GetSize(); i++) deme_array[i].SyncResourceClock();
+  
+  m_resource_clock.NextEpoch();
+  m_deme_resource_clock.NextEpoch();
+}
+
 void cPopulation::ProcessPostUpdate(cAvidaContext& ctx)
 {
+  CloseResourceClocks();
+  
   ProcessUpdateCellActions(ctx);
   
   cStats& stats = m_world->GetStats();
@@ -6937,7 +7178,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
       if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST &&
           cell_array[cell_id].IsOccupied() == true) {
         // Have to manually take this cell out of the reaper Queue.
-        reaper_queue.Remove( &(cell_array[cell_id]) );
+        m_reaper_index->SetKey(cell_id, cTournamentIndex::NO_KEY);
       }
       
       // Setup the child's mutation rates.  Since this organism is being injected
@@ -7002,6 +7243,150 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
   return true;
 }
 
+// Keys of a replacement index, which is created on load if it existed when saved and discarded if it did not
+static void checkpointTournamentIndex(cCheckpoint& ckpt, cTournamentIndex*& index, int num_cells)
+{
+  bool present = (index != NULL);
+  ckpt.Transfer(present);
+  if (ckpt.IsLoading()) {
+    delete index;
+    index = (present) ? new cTournamentIndex(num_cells) : NULL;
+  }
+  if (!index) return;
+  
+  for (int i = 0; i < num_cells && ckpt.IsOK(); i++) {
+    int key = index->GetKey(i);
+    ckpt.Transfer(key);
+    if (ckpt.IsLoading()) index->SetKey(i, key);
+  }
+}
+
+void cPopulation::Checkpoint(cCheckpoint& ckpt, cAvidaContext& ctx)
+{
+  if (!ckpt.IsLoading()) {
+    const cAvidaConfig& config = m_world->GetConfig();
+    if (deme_array.GetSize() > 1 || config.USE_AVATARS.Get() || config.USE_FORM_GROUPS.Get() || config.ENABLE_HGT.Get()) {
+      ckpt.Fail("checkpointing demes, avatars, groups and HGT is not supported");
+      return;
+    }
+    // The integrated schedulers keep per cell progress that they do not expose
+    if (config.SLICING_METHOD.Get() == SLICE_INTEGRATED_MERIT || config.SLICING_METHOD.Get() == SLICE_PROB_INTEGRATED_MERIT) {
+      ckpt.Fail("checkpointing integrated merit schedulers is not supported");
+      return;
+    }
+    for (int i = 0; i < live_org_list.GetSize(); i++) {
+      if (live_org_list[i]->GetPhenotype().DivideSex()) {
+        ckpt.Fail("checkpointing sexual populations is not supported");
+        return;
+      }
+    }
+  }
+  
+  Systematics::GenotypeArbiterPtr genotypes;
+  genotypes.DynamicCastFrom(Systematics::Manager::Of(m_world->GetNewWorld())->ArbiterForRole("genotype"));
+  if (!genotypes) {
+    ckpt.Fail("genotype arbiter not found");
+    return;
+  }
+  
+  ckpt.BeginSection("POPL");
+  
+  // Organisms are recreated by injecting their genomes, in their live list order, and then restoring their state.
+  // The genotypes they belong to are recreated first, and their state restored after the organisms are classified.
+  if (ckpt.IsLoading()) {
+    for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx);
+  }
+  genotypes->CheckpointLineage(ckpt);
+  int num_orgs = live_org_list.GetSize();
+  ckpt.Transfer(num_orgs);
+  for (int i = 0; i < num_orgs && ckpt.IsOK(); i++) {
+    cOrganism* org = (ckpt.IsLoading()) ? NULL : live_org_list[i];
+    int cell_id = (org) ? org->GetCellID() : -1;
+    int lineage_label = (org) ? org->GetLineageLabel() : 0;
+    int genotype_id = (org) ? org->SystematicsGroup("genotype")->ID() : -1;
+    cString genome_str((org) ? (const char*)org->GetGenome().AsString() : "");
+    ckpt.Transfer(cell_id);
+    ckpt.Transfer(lineage_label);
+    ckpt.Transfer(genotype_id);
+    ckpt.Transfer(genome_str);
+    if (!ckpt.IsOK()) break;
+    
+    if (ckpt.IsLoading()) {
+      if (cell_id < 0 || cell_id >= cell_array.GetSize() || cell_array[cell_id].IsOccupied()) {
+        ckpt.Fail("invalid organism cell");
+        break;
+      }
+      Systematics::RoleClassificationHints hints;
+      hints["genotype"]["id"] = Apto::FormatStr("%d", genotype_id);
+      InjectGenome(cell_id, Systematics::Source(Systematics::DUPLICATION, ""), Genome(Apto::String((const char*)genome_str)),
+                   ctx, lineage_label, true, &hints);
+      org = cell_array[cell_id].GetOrganism();
+    }
+    if (!org->Checkpoint(ckpt)) break;
+    if (ckpt.IsLoading()) CellContentsChanged(cell_array[cell_id]);
+  }
+  
+  // Cells follow their occupants, since placing an organism resets parts of its cell
+  for (int i = 0; i < cell_array.GetSize() && ckpt.IsOK(); i++) cell_array[i].Checkpoint(ckpt);
+  
+  resource_count.Checkpoint(ckpt);
+  
+  ckpt.Transfer(m_reaper_stamp);
+  checkpointTournamentIndex(ckpt, m_reaper_index, cell_array.GetSize());
+  checkpointTournamentIndex(ckpt, m_time_used_index, cell_array.GetSize());
+  ckpt.Transfer(m_time_used_dirty);
+  ckpt.Transfer(m_time_used_is_dirty);
+  
+  if (ckpt.IsOK()) genotypes->CheckpointState(ckpt);
+  if (ckpt.IsOK()) checkpointScheduler(ckpt);
+  
+  ckpt.EndSection();
+}
+
+// The scheduler is rebuilt from the priority of every cell and the position of its random stream, replacing the
+// priorities set as the organisms were placed
+void cPopulation::checkpointScheduler(cCheckpoint& ckpt)
+{
+  ckpt.BeginSection("SCHD");
+  if (m_scheduler_rng && !ckpt.IsLoading()) m_scheduler_rng->Rebase();
+  int slicing_method = m_world->GetConfig().SLICING_METHOD.Get();
+  int seed = (m_scheduler_rng) ? m_scheduler_rng->Seed() : 0;
+  long long draws = (m_scheduler_rng) ? m_scheduler_rng->GetDraws() : 0;
+  Apto::Array<double> priority(m_schedule_priority);
+  int scheduled_cell = m_scheduled_cell;
+  ckpt.Transfer(slicing_method);
+  ckpt.Transfer(seed);
+  ckpt.Transfer(draws);
+  ckpt.Transfer(priority);
+  ckpt.Transfer(scheduled_cell);
+  ckpt.EndSection();
+  if (!ckpt.IsOK() || !ckpt.IsLoading()) return;
+  
+  if (slicing_method != m_world->GetConfig().SLICING_METHOD.Get() || priority.GetSize() != cell_array.GetSize() ||
+      draws < 0 || scheduled_cell < -1 || scheduled_cell >= cell_array.GetSize()) {
+    ckpt.Fail("scheduler does not match the configuration");
+    return;
+  }
+  
+  delete m_scheduler;
+  BuildTimeSlicer();
+  if (m_scheduler_rng) m_scheduler_rng->Restore(seed, draws);
+  for (int i = 0; i < cell_array.GetSize(); i++) {
+    if (priority[i] == 0.0) continue;
+    m_schedule_priority[i] = priority[i];
+    m_scheduler->AdjustPriority(i, priority[i]);
+  }
+  
+  // A round robin picks up after the cell it last returned, even if that cell has since emptied
+  if (slicing_method == SLICE_CONSTANT && scheduled_cell >= 0) {
+    if (priority[scheduled_cell] == 0.0) m_scheduler->AdjustPriority(scheduled_cell, 1.0);
+    for (int i = 0; i <= cell_array.GetSize() && m_scheduler->Next() != scheduled_cell; i++) ;
+    if (priority[scheduled_cell] == 0.0) m_scheduler->AdjustPriority(scheduled_cell, 0.0);
+  }
+  m_scheduled_cell = scheduled_cell;
+}
+
+
 /**
  * This function loads a genome from a given file, and initializes
  * a cpu with it.
@@ -7019,7 +7404,7 @@ void cPopulation::Inject(const Genome& genome, Systematics::Source src, cAvidaCo
   if (cell_id < 0) {
     switch (m_world->GetConfig().BIRTH_METHOD.Get()) {
       case POSITION_OFFSPRING_FULL_SOUP_ELDEST:
-        cell_id = reaper_queue.PopRear()->GetID();
+        cell_id = PopReaperCell();
       default:
         cell_id = 0;
     }
@@ -7295,6 +7680,11 @@ void cPopulation::ResetInputs(cAvidaContext& ctx)
 
 void cPopulation::BuildTimeSlicer()
 {
+  m_scheduler_rng = NULL;
+  m_schedule_priority.ResizeClear(cell_array.GetSize());
+  m_schedule_priority.SetAll(0.0);
+  m_scheduled_cell = -1;
+  
   switch (m_world->GetConfig().SLICING_METHOD.Get()) {
     case SLICE_CONSTANT:
       m_scheduler = new Apto::Scheduler::RoundRobin(cell_array.GetSize());
@@ -7310,7 +7700,8 @@ void cPopulation::BuildTimeSlicer()
       break;
     case SLICE_PROB_MERIT:
     {
-      Apto::SmartPtr<Apto::Random> rng(new Apto::RNG::AvidaRNG(m_world->GetRandom().GetInt(0x7FFFFFFF)));
+      m_scheduler_rng = new cReplayRandom(m_world->GetRandom().GetInt(0x7FFFFFFF));
+      Apto::SmartPtr<Apto::Random> rng(m_scheduler_rng);
       m_scheduler = new Apto::Scheduler::Probabilistic(cell_array.GetSize(), rng);
     }
       break;
@@ -7364,7 +7755,7 @@ void cPopulation::InjectClone(int cell_id, cOrganism& orig_org, Systematics::Sou
   if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST &&
       cell_array[cell_id].IsOccupied() == true) {
     // Have to manually take this cell out of the reaper Queue.
-    reaper_queue.Remove( &(cell_array[cell_id]) );
+    m_reaper_index->SetKey(cell_id, cTournamentIndex::NO_KEY);
   }
   
   // Setup the mutation rate based on the population cell...
@@ -7430,7 +7821,7 @@ void cPopulation::CompeteOrganisms_ConstructOffspring(int cell_id, cOrganism& pa
   if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST &&
       cell_array[cell_id].IsOccupied() == true) {
     // Have to manually take this cell out of the reaper Queue.
-    reaper_queue.Remove( &(cell_array[cell_id]) );
+    m_reaper_index->SetKey(cell_id, cTournamentIndex::NO_KEY);
   }
   
   // Setup the mutation rate based on the population cell...
@@ -7491,7 +7882,7 @@ void cPopulation::InjectGenome(int cell_id, Systematics::Source src, const Genom
   if (m_world->GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_FULL_SOUP_ELDEST &&
       cell_array[cell_id].IsOccupied() == true) {
     // Have to manually take this cell out of the reaper Queue.
-    reaper_queue.Remove( &(cell_array[cell_id]) );
+    m_reaper_index->SetKey(cell_id, cTournamentIndex::NO_KEY);
   }
   
   // Setup the child's mutation rates.  Since this organism is being injected
@@ -9270,6 +9661,7 @@ void cPopulation::MixPopulation(cAvidaContext& ctx)
       cell_array[i].InsertOrganism(population[i], ctx); 
       AdjustSchedule(cell_array[i], cell_array[i].GetOrganism()->GetPhenotype().GetMerit());
     }
+    CellContentsChanged(cell_array[i]);
   }
 }
 
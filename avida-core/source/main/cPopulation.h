@@ -39,11 +39,15 @@
 
 
 class cAvidaContext;
+class cCheckpoint;
 class cCodeLabel;
 class cEnvironment;
 class cLineage;
 class cOrganism;
 class cPopulationCell;
+class cReplayRandom;
+class cTournamentIndex;
+class cWorkerPool;
 
 using namespace Avida;
 
@@ -66,10 +70,17 @@ private:
   // Components...
   cWorld* m_world;
   Apto::PriorityScheduler* m_scheduler;                // Handles allocation of CPU cycles
+  cReplayRandom* m_scheduler_rng;                      // Random stream of a probabilistic scheduler (owned by it)
+  Apto::Array<double> m_schedule_priority;             // Priority last given to each cell, to rebuild the scheduler
+  int m_scheduled_cell;                                // Cell last returned by the scheduler
   Apto::Array<cPopulationCell> cell_array;  // Local cells composing the population
   Apto::Array<int> empty_cell_id_array;     // Used for PREFER_EMPTY birth methods
   cResourceCount resource_count;       // Global resources available
+  cResourceClock m_resource_clock;     // Steps elapsed this update, applied lazily to resource_count
+  cResourceClock m_deme_resource_clock; // Steps elapsed this update, applied lazily to all deme resource counts
   cBirthChamber birth_chamber;         // Global birth chamber.
+  cWorkerPool* m_update_pool;          // Parallel pre-execution workers (NULL when single threaded)
+  cWorkerPool* m_resource_pool;        // Spatial resource update workers (NULL when single threaded)
   //Keeps track of which organisms are in which group.
   Apto::Map<int, Apto::Array<cOrganism*, Apto::Smart> > m_group_list;
   Apto::Map<int, Apto::Array<pair<int,int> > > m_group_intolerances;
@@ -89,7 +100,14 @@ private:
   Apto::Array<GeneticRepresentationPtr> host_genotype_list;
   
   // Data Tracking...
-  tList<cPopulationCell> reaper_queue; // Death order in some mass-action runs
+  cTournamentIndex* m_reaper_index;       // Death order in some mass-action runs, keyed on negated activation order
+  int m_reaper_stamp;                     // Key of the latest queued cell, negated; renumbered before it can overflow
+  cTournamentIndex* m_time_used_index;    // Cells keyed on time used, empty cells first (full soup energy used births)
+  Apto::Array<int> m_time_used_dirty;     // Cells executed since their time used was last indexed
+  Apto::Array<bool> m_time_used_is_dirty;
+  Apto::Array<int> m_changed_cells;       // Cells whose contents changed since ResetChangedCells()
+  Apto::Array<bool> m_cell_changed;
+  bool m_changed_cells_valid;
   Apto::Array<int, Apto::Smart> minitrace_queue;
   bool print_mini_trace_genomes;
   bool print_mini_trace_reacs;
@@ -260,6 +278,11 @@ public:
   void ProcessStep(cAvidaContext& ctx, double step_size, int cell_id);
   void ProcessStepSpeculative(cAvidaContext& ctx, double step_size, int cell_id);
 
+  // Parallel update support -- pre-executes non-interacting instructions of all organisms across worker threads
+  void SetupParallelUpdate(int num_threads);
+  bool HasParallelUpdate() const { return (m_update_pool != NULL); }
+  void ProcessParallelSpeculation(cAvidaContext& ctx);
+
   // Calculate the statistics from the most recent update.
   void ProcessPostUpdate(cAvidaContext& ctx);
   void ProcessPreUpdate();
@@ -281,6 +304,9 @@ public:
                       bool load_groups = false, bool load_birth_cells = false, bool load_avatars = false, bool load_rebirth = false, bool load_parent_dat = false, int traceq = 0);
   bool SaveFlameData(const cString& filename);
   
+  // Checkpointing of organisms and their genotypes, cells, resources, replacement indices and the scheduler
+  void Checkpoint(cCheckpoint& ckpt, cAvidaContext& ctx);
+  
   void SetMiniTraceQueue(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void AppendMiniTraces(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void LoadMiniTraceQ(const cString& filename, int orgs_per, bool print_genomes, bool print_reacs);
@@ -302,6 +328,13 @@ public:
   cDeme& GetDeme(int i) { return deme_array[i]; }
 
   cPopulationCell& GetCell(int in_num) { assert(in_num >=0); assert(in_num < cell_array.GetSize()); return cell_array[in_num]; }
+  
+  // Cells that have had an organism born, die, move, or divide in them since ResetChangedCells() was last called.  The
+  // set is only meaningful while ChangedCellsValid() is true; otherwise consumers must treat every cell as changed.
+  bool ChangedCellsValid() const { return m_changed_cells_valid; }
+  const Apto::Array<int>& GetChangedCells() const { return m_changed_cells; }
+  void ResetChangedCells();
+  
   const Apto::Array<double>& GetResources(cAvidaContext& ctx) const { return resource_count.GetResources(ctx); }
   const Apto::Array<double>& GetCellResources(int cell_id, cAvidaContext& ctx) const { return resource_count.GetCellResources(cell_id, ctx); } 
   const Apto::Array<double>& GetFrozenResources(cAvidaContext& ctx, int cell_id) const { return resource_count.GetFrozenResources(ctx, cell_id); }
@@ -452,6 +485,8 @@ private:
   void SetupCellGrid();
   void ClearCellGrid();
   void BuildTimeSlicer(); // Build the schedule object
+  void checkpointScheduler(cCheckpoint& ckpt);
+  void CloseResourceClocks();
   
   // Methods to place offspring in the population.
   cPopulationCell& PositionOffspring(cPopulationCell& parent_cell, cAvidaContext& ctx, bool parent_ok = true); 
@@ -465,6 +500,15 @@ private:
   void FindEmptyCell(tList<cPopulationCell>& cell_list, tList<cPopulationCell>& found_list);
   int FindRandEmptyCell(cAvidaContext& ctx);
   
+  // Population-wide replacement indices, updated on birth, death, movement and aging
+  void CellContentsChanged(const cPopulationCell& cell);
+  void UpdateReplacementIndices(const cPopulationCell& cell);
+  void PushReaperCell(int cell_id);
+  int PopReaperCell(int skip_cell = -1);
+  void RenumberReaperCells();
+  int FindMaxTimeUsedCell(cAvidaContext& ctx);
+  inline void MarkTimeUsed(int cell_id);
+  
   // Update statistics collecting...
   void UpdateDemeStats(cAvidaContext& ctx); 
   void UpdateOrganismStats(cAvidaContext& ctx); 
@@ -23,6 +23,7 @@
 #include "cPopulationCell.h"
 
 #include "avida/core/Feedback.h"
+#include "cCheckpoint.h"
 #include "cDoubleSum.h"
 #include "nHardware.h"
 #include "cOrganism.h"
@@ -140,6 +141,45 @@ void cPopulationCell::Rotate(cPopulationCell& new_facing)
   }
 }
 
+// The occupant, if any, is checkpointed separately, and must already be restored when loading (placing an organism
+// can rotate its cell and reset the inputs)
+void cPopulationCell::Checkpoint(cCheckpoint& ckpt)
+{
+  if (!ckpt.IsLoading() && ((m_hgt && m_hgt->fragments.size()) || HasAV())) {
+    ckpt.Fail("checkpointing genome fragments and avatars is not supported");
+    return;
+  }
+  
+  ckpt.Transfer(m_inputs);
+  
+  // Facing is stored as the id of the faced cell, and restored by rotating the connection list back around to it
+  int faced_id = (m_connections.GetSize()) ? m_connections.GetFirst()->GetID() : -1;
+  ckpt.Transfer(faced_id);
+  if (ckpt.IsLoading() && faced_id >= 0) {
+    int scan_count = 0;
+    while (m_connections.GetSize() && m_connections.GetFirst()->GetID() != faced_id && scan_count++ < m_connections.GetSize()) {
+      m_connections.CircNext();
+    }
+    if (!m_connections.GetSize() || m_connections.GetFirst()->GetID() != faced_id) {
+      ckpt.Fail("cell connections do not match the world");
+      return;
+    }
+  }
+  
+  ckpt.Transfer(m_cell_data.contents);
+  ckpt.Transfer(m_cell_data.org_id);
+  ckpt.Transfer(m_cell_data.update);
+  ckpt.Transfer(m_cell_data.territory);
+  ckpt.Transfer(m_cell_data.current);
+  ckpt.Transfer(m_cell_data.forager);
+  ckpt.Transfer(m_spec_state);
+  ckpt.Transfer(m_migrant);
+  ckpt.Transfer(m_visits);
+  ckpt.Transfer(m_can_input);
+  ckpt.Transfer(m_can_output);
+  m_mut_rates->Checkpoint(ckpt);
+}
+
 /*! This method recursively builds a set of cells that neighbor this cell, out to 
  the given depth.  The set must be passed in by-reference, as calls to this method 
  must share a common set of already-visited cells.
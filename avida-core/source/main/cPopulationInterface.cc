@@ -398,6 +398,11 @@ const Apto::Array< Apto::Array<int> >& cPopulationInterface::GetCellIdLists()
 	return m_world->GetPopulation().GetCellIdLists();
 }
 
+void cPopulationInterface::MaskResourceAccess(int cell_id, Apto::Array<double>& res_count)
+{
+  m_world->GetPopulation().GetResourceCount().MaskCellAccess(cell_id, res_count);
+}
+
 int cPopulationInterface::GetCurrPeakX(cAvidaContext& ctx, int res_id) 
 { 
   return m_world->GetPopulation().GetCurrPeakX(ctx, res_id); 
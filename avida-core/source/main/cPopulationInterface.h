@@ -121,6 +121,7 @@ public:
   double GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id);
   const Apto::Array<double>& GetDemeResources(int deme_id, cAvidaContext& ctx); 
   const Apto::Array< Apto::Array<int> >& GetCellIdLists();
+  void MaskResourceAccess(int cell_id, Apto::Array<double>& res_count);
   int GetCurrPeakX(cAvidaContext& ctx, int res_id); 
   int GetCurrPeakY(cAvidaContext& ctx, int res_id);
   int GetFrozenPeakX(cAvidaContext& ctx, int res_id); 
@@ -65,6 +65,12 @@ public:
   cReactionResult(const int num_resources, const int num_tasks, const int num_reactions);
   ~cReactionResult() { ; }
 
+  bool HasSize(int num_resources, int num_tasks, int num_reactions) const
+  {
+    return (resources_consumed.GetSize() == num_resources && tasks_done.GetSize() == num_tasks &&
+            reactions_triggered.GetSize() == num_reactions);
+  }
+
   bool GetActive() const { return active_reaction; }
   bool GetActiveDeme() const { return active_deme_reaction; }
   void Invalidate() { active_reaction = false; }
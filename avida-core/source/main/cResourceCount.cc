@@ -21,10 +21,12 @@
  */
 
 #include "cResourceCount.h"
+#include "cCheckpoint.h"
 #include "cResource.h"
 #include "cGradientCount.h"
 #include "cWorld.h"
 #include "cStats.h"
+#include "cWorkerPool.h"
 
 #include "nGeometry.h"
 
@@ -37,71 +39,15 @@ const double cResourceCount::EPSILON (1.0e-15);
 const int cResourceCount::PRECALC_DISTANCE(100);
 
 
-void FlowMatter(cSpatialCountElem &elem1, cSpatialCountElem &elem2, 
-                double inxdiffuse, 
-                double inydiffuse, double inxgravity, double inygravity,
-                int xdist, int ydist, double dist) {
-
-  /* Routine to calculate the amount of flow from one Element to another.
-     Amount of flow is a function of:
-
-       1) Amount of material in each cell (will try to equalize)
-       2) Distance between each cell
-       3) x and y "gravity"
-
-     This method only effect the delta amount of each element.  The State
-     method will need to be called at the end of each time step to complete
-     the movement of material.
-  */
-
-  double  diff, flowamt, xgravity, xdiffuse, ygravity,  ydiffuse;
-
-  if (((elem1.amount == 0.0) && (elem2.amount == 0.0)) && (dist < 0.0)) return;
-  diff = (elem1.amount - elem2.amount);
-  if (xdist != 0) {
-
-    /* if there is material to be effected by x gravity */
-
-    if (((xdist>0) && (inxgravity>0.0)) || ((xdist<0) && (inxgravity<0.0))) {
-      xgravity = elem1.amount * fabs(inxgravity)/3.0;
-    } else {
-      xgravity = -elem2.amount * fabs(inxgravity)/3.0;
-    }
-    
-    /* Diffusion uses the diffusion constant x half the difference (as the 
-       elements attempt to equalize) / the number of possible neighbors (8) */
-
-    xdiffuse = inxdiffuse * diff / 16.0;
-  } else {
-    xdiffuse = 0.0;
-    xgravity = 0.0;
-  }  
-  if (ydist != 0) {
-
-    /* if there is material to be effected by y gravity */
-
-    if (((ydist>0) && (inygravity>0.0)) || ((ydist<0) && (inygravity<0.0))) {
-      ygravity = elem1.amount * fabs(inygravity)/3.0;
-    } else {
-      ygravity = -elem2.amount * fabs(inygravity)/3.0;
-    }
-    ydiffuse = inydiffuse * diff / 16.0;
-  } else {
-    ydiffuse = 0.0;
-    ygravity = 0.0;
-  }  
-
-  flowamt = ((xdiffuse + ydiffuse + xgravity + ygravity)/
-             (fabs(xdist*1.0) + fabs(ydist*1.0)))/dist;
-  elem1.delta -= flowamt;
-  elem2.delta += flowamt;
-}
-
 cResourceCount::cResourceCount(int num_resources)
   : update_time(0.0)
   , spatial_update_time(0.0)
   , m_last_updated(0)
   , m_spatial_update(0)
+  , m_clock(NULL)
+  , m_clock_epoch(0)
+  , m_clock_steps(0)
+  , m_worker_pool(NULL)
 {
   if(num_resources > 0) {
     SetSize(num_resources);
@@ -110,13 +56,26 @@ cResourceCount::cResourceCount(int num_resources)
   return;
 }
 
-cResourceCount::cResourceCount(const cResourceCount &rc) {
+cResourceCount::cResourceCount(const cResourceCount &rc)
+  : m_clock(NULL)
+  , m_clock_epoch(0)
+  , m_clock_steps(0)
+  , m_worker_pool(NULL)
+{
   *this = rc;
 
   return;
 }
 
 const cResourceCount &cResourceCount::operator=(const cResourceCount &rc) {
+  // Copy the source's fully elapsed time.  This count keeps its own clock attachment and worker pool (if any), counting
+  // from now.
+  rc.SyncClock();
+  if (m_clock) {
+    m_clock_epoch = m_clock->GetEpoch();
+    m_clock_steps = m_clock->GetSteps();
+  }
+  
   SetSize(rc.GetSize());
   resource_name = rc.resource_name;
   resource_initial = rc.resource_initial;  
@@ -136,6 +95,8 @@ const cResourceCount &cResourceCount::operator=(const cResourceCount &rc) {
   update_time = rc.update_time;
   spatial_update_time = rc.spatial_update_time;
   cell_lists = rc.cell_lists;
+  cell_access = rc.cell_access;
+  cell_list_res = rc.cell_list_res;
 
   return *this;
 }
@@ -166,6 +127,8 @@ void cResourceCount::SetSize(int num_resources)
   curr_grid_res_cnt.ResizeClear(num_resources);
   curr_spatial_res_cnt.ResizeClear(num_resources);
   cell_lists.ResizeClear(num_resources);
+  cell_access.ResizeClear(num_resources);
+  cell_list_res.Resize(0);
   resource_name.SetAll("");
   resource_initial.SetAll(0.0);
   resource_count.SetAll(0.0);
@@ -304,6 +267,7 @@ void cResourceCount::Setup(cWorld* world, const int& res_index, const cString& n
     for (int i = 0; i < in_cell_id_list_ptr->GetSize(); i++) {
       cell_lists[res_index][i] = (*in_cell_id_list_ptr)[i]; 
     }
+    setupCellAccess(res_index);
   }
   else {
     resource_count[res_index] = 0; 
@@ -539,6 +503,53 @@ void cResourceCount::Update(double in_time)
   spatial_update_time += in_time;
  }
 
+void cResourceCount::Checkpoint(cCheckpoint& ckpt)
+{
+  SyncClock();
+
+  int num_resources = resource_count.GetSize();
+  ckpt.Transfer(num_resources);
+  if (ckpt.IsLoading() && num_resources != resource_count.GetSize()) {
+    ckpt.Fail("resource count does not match the environment");
+    return;
+  }
+
+  ckpt.Transfer(resource_count);
+  Apto::Array<double> decay(decay_rate);
+  Apto::Array<double> inflow(inflow_rate);
+  ckpt.Transfer(decay);
+  ckpt.Transfer(inflow);
+  if (ckpt.IsLoading() && ckpt.IsOK()) {
+    // Go through the setters, so that the precalculated step tables follow any rates that events had changed
+    for (int i = 0; i < num_resources; i++) {
+      SetDecay(resource_name[i], decay[i]);
+      SetInflow(resource_name[i], inflow[i]);
+    }
+  }
+
+  ckpt.Transfer(update_time);
+  ckpt.Transfer(spatial_update_time);
+  ckpt.Transfer(m_last_updated);
+  ckpt.Transfer(m_spatial_update);
+  for (int i = 0; i < num_resources && ckpt.IsOK(); i++) {
+    if (spatial_resource_count[i]) spatial_resource_count[i]->Checkpoint(ckpt);
+  }
+
+  // Time already elapsed on the clock has been applied above, so pick it up from where it stands now
+  if (ckpt.IsLoading() && m_clock) {
+    m_clock_epoch = m_clock->GetEpoch();
+    m_clock_steps = m_clock->GetSteps();
+  }
+}
+
+void cResourceCount::AttachClock(const cResourceClock* clock)
+{
+  SyncClock();
+  m_clock = clock;
+  m_clock_epoch = (clock) ? clock->GetEpoch() : 0;
+  m_clock_steps = (clock) ? clock->GetSteps() : 0;
+}
+
  
 const Apto::Array<double> & cResourceCount::GetResources(cAvidaContext& ctx) const
 {
@@ -604,6 +615,36 @@ double cResourceCount::GetCellResVal(cAvidaContext& ctx, int cell_id, int res_id
   return res_val;
 }
 
+void cResourceCount::MaskCellAccess(int cell_id, Apto::Array<double>& res_count) const
+// Zero the amount of each resource restricted to a cell list that does not include cell_id.
+{
+  for (int i = 0; i < cell_list_res.GetSize(); i++) {
+    const int res_id = cell_list_res[i];
+    if (!CellHasAccess(res_id, cell_id)) res_count[res_id] = 0;
+  }
+}
+
+void cResourceCount::setupCellAccess(int res_index)
+{
+  int max_cell = -1;
+  for (int i = 0; i < cell_lists[res_index].GetSize(); i++) {
+    if (cell_lists[res_index][i] > max_cell) max_cell = cell_lists[res_index][i];
+  }
+  
+  Apto::Array<unsigned int>& bits = cell_access[res_index];
+  bits.ResizeClear((max_cell >> 5) + 1);
+  bits.SetAll(0);
+  for (int i = 0; i < cell_lists[res_index].GetSize(); i++) {
+    const int cell_id = cell_lists[res_index][i];
+    if (cell_id >= 0) bits[cell_id >> 5] |= (1u << (cell_id & 31));
+  }
+  
+  cell_list_res.Resize(0);
+  for (int i = 0; i < cell_lists.GetSize(); i++) {
+    if (cell_lists[i].GetSize()) cell_list_res.Push(i);
+  }
+}
+
 const Apto::Array<int> & cResourceCount::GetResourcesGeometry() const
 {
   return geometry;
@@ -655,7 +696,7 @@ void cResourceCount::ModifyCell(cAvidaContext& ctx, const Apto::Array<double> &
         resource_count[i] += res_change[i];
       assert(resource_count[i] >= 0.0);
     } else {
-      double temp = spatial_resource_count[i]->Element(cell_id).GetAmount();
+      double temp = spatial_resource_count[i]->GetAmount(cell_id);
       spatial_resource_count[i]->Rate(cell_id, res_change[i]);
       /* Ideally the state of the cell's resource should not be set till
          the end of the update so that all processes (inflow, outflow, 
@@ -664,10 +705,10 @@ void cResourceCount::ModifyCell(cAvidaContext& ctx, const Apto::Array<double> &
          the organism demand to work immediately on the state of the resource */ 
     
       spatial_resource_count[i]->State(cell_id);
-      if(spatial_resource_count[i]->Element(cell_id).GetAmount() != temp){
+      if(spatial_resource_count[i]->GetAmount(cell_id) != temp){
         spatial_resource_count[i]->SetModified(true);
       }
-      assert(spatial_resource_count[i]->Element(cell_id).GetAmount() >= 0.0);
+      assert(spatial_resource_count[i]->GetAmount(cell_id) >= 0.0);
     }
   }
 }
@@ -751,8 +792,38 @@ int cResourceCount::GetMaxUsedY(int res_id)
 }
 
 ///// Private Methods /////////
+void cResourceCount::applyClock() const
+{
+  // All steps of a previous epoch were applied before it was closed, so only those of the current one remain
+  if (m_clock_epoch != m_clock->GetEpoch()) {
+    m_clock_epoch = m_clock->GetEpoch();
+    m_clock_steps = 0;
+  }
+  const int pending = m_clock->GetSteps() - m_clock_steps;
+  m_clock_steps = m_clock->GetSteps();
+  
+  // Elapsed time is only ever consumed by global and partial resources, so counts without them can skip it entirely
+  bool has_global = false;
+  for (int i = 0; i < geometry.GetSize(); i++) {
+    if (geometry[i] == nGeometry::GLOBAL || geometry[i] == nGeometry::PARTIAL) {
+      has_global = true;
+      break;
+    }
+  }
+  if (!has_global) return;
+  
+  // Replay the individual steps, rather than adding pending * step_size, so that update_time is bit-identical to
+  // what calling Update() after every step would have produced
+  const double step_size = m_clock->GetStepSize();
+  for (int i = 0; i < pending; i++) {
+    update_time += step_size;
+    spatial_update_time += step_size;
+  }
+}
+
 void cResourceCount::DoUpdates(cAvidaContext& ctx, bool global_only) const
 { 
+  SyncClock();
   assert(update_time >= -EPSILON);
 
   // Determine how many update steps have progressed
@@ -782,25 +853,123 @@ void cResourceCount::DoUpdates(cAvidaContext& ctx, bool global_only) const
   if (global_only) return;
 
   // If one (or more) complete update has occured update the spatial resources
+  Apto::Array<int> concurrent;
   while (m_spatial_update > m_last_updated) {
     m_last_updated++;
     for (int i = 0; i < resource_count.GetSize(); i++) {
-     if (geometry[i] != nGeometry::GLOBAL && geometry[i] != nGeometry::PARTIAL) {
-        spatial_resource_count[i]->UpdateCount(ctx);
-        spatial_resource_count[i]->Source(inflow_rate[i]);
-        spatial_resource_count[i]->Sink(decay_rate[i]);
-        if (spatial_resource_count[i]->GetCellListSize() > 0) {
-          spatial_resource_count[i]->CellInflow();
-          spatial_resource_count[i]->CellOutflow();
-        }
-        spatial_resource_count[i]->FlowAll();
-        spatial_resource_count[i]->StateAll();
-        // BDB: resource_count[i] = spatial_resource_count[i]->SumAll();
+      if (geometry[i] == nGeometry::GLOBAL || geometry[i] == nGeometry::PARTIAL) continue;
+      
+      // Independent resources are collected and updated together, anything else is updated in its original position
+      // (after the resources preceding it), as it may use the random number generator or interact with the population
+      if (m_worker_pool && spatial_resource_count[i]->IsConcurrentSafe()) {
+        concurrent.Push(i);
+      } else {
+        updateSpatialResources(concurrent);
+        concurrent.Resize(0);
+        updateSpatialResource(ctx, i);
       }
     }
+    updateSpatialResources(concurrent);
+    concurrent.Resize(0);
   }
 }
 
+void cResourceCount::updateSpatialResource(cAvidaContext& ctx, int res_index) const
+{
+  cSpatialResCount* res = spatial_resource_count[res_index];
+  res->UpdateCount(ctx);
+  res->Source(inflow_rate[res_index]);
+  res->Sink(decay_rate[res_index]);
+  if (res->GetCellListSize() > 0) {
+    res->CellInflow();
+    res->CellOutflow();
+  }
+  res->FlowAll();
+  res->StateAll();
+  // BDB: resource_count[i] = spatial_resource_count[i]->SumAll();
+}
+
+
+// Concurrent update of a set of independent spatial resources.  Each resource is split into bands of rows, and updated
+// in two passes: the first applies its inflows and outflows (one task per resource) and calculates the flows out of
+// every band, the second folds the flows into the cells of every band (which reads the flows of the neighboring
+// bands' boundary rows) and the cells' changes into their amounts.  Every cell sees exactly the same operations, in
+// the same order, as in a serial update, so results do not depend on the number of threads.
+class cSpatialUpdateTask : public cWorkerPool::cTask
+{
+private:
+  struct sBand
+  {
+    cSpatialResCount* res;
+    int row_begin;
+    int row_end;
+  };
+  
+  const Apto::Array<cSpatialResCount*>& m_spatial;
+  const Apto::Array<double>& m_inflow;
+  const Apto::Array<double>& m_decay;
+  const Apto::Array<int>& m_res_indexes;
+  Apto::Array<sBand> m_bands;
+  bool m_apply;
+  
+public:
+  // Number of cells above which a resource grid is split into several bands
+  static const int BAND_CELLS = 16384;
+  
+  cSpatialUpdateTask(const Apto::Array<cSpatialResCount*>& spatial, const Apto::Array<double>& inflow,
+                     const Apto::Array<double>& decay, const Apto::Array<int>& res_indexes)
+    : m_spatial(spatial), m_inflow(inflow), m_decay(decay), m_res_indexes(res_indexes), m_apply(false)
+  {
+    for (int i = 0; i < m_res_indexes.GetSize(); i++) {
+      cSpatialResCount* res = m_spatial[m_res_indexes[i]];
+      const int num_rows = res->GetY();
+      const int num_bands = Apto::Max(1, Apto::Min(num_rows, res->GetSize() / BAND_CELLS));
+      for (int b = 0; b < num_bands; b++) {
+        sBand band;
+        band.res = res;
+        band.row_begin = (b * num_rows) / num_bands;
+        band.row_end = ((b + 1) * num_rows) / num_bands;
+        m_bands.Push(band);
+      }
+    }
+  }
+  
+  int GetNumTasks() const { return (m_apply) ? m_bands.GetSize() : (m_res_indexes.GetSize() + m_bands.GetSize()); }
+  void SetApply() { m_apply = true; }
+  
+  void Run(int, int task_id)
+  {
+    if (m_apply) {
+      const sBand& band = m_bands[task_id];
+      if (band.res->HasFlow()) band.res->ApplyFlows(band.row_begin, band.row_end);
+      band.res->StateRows(band.row_begin, band.row_end);
+    } else if (task_id < m_res_indexes.GetSize()) {
+      const int res_index = m_res_indexes[task_id];
+      cSpatialResCount* res = m_spatial[res_index];
+      res->Source(m_inflow[res_index]);
+      res->Sink(m_decay[res_index]);
+      if (res->GetCellListSize() > 0) {
+        res->CellInflow();
+        res->CellOutflow();
+      }
+    } else {
+      const sBand& band = m_bands[task_id - m_res_indexes.GetSize()];
+      if (band.res->HasFlow()) band.res->CalcFlows(band.row_begin, band.row_end);
+    }
+  }
+};
+
+void cResourceCount::updateSpatialResources(const Apto::Array<int>& res_indexes) const
+{
+  if (res_indexes.GetSize() == 0) return;
+  
+  // UpdateCount() is skipped, it does nothing for concurrently safe resources (see cSpatialResCount::IsConcurrentSafe)
+  cSpatialUpdateTask task(spatial_resource_count, inflow_rate, decay_rate, res_indexes);
+  m_worker_pool->Execute(task, task.GetNumTasks());
+  task.SetApply();
+  m_worker_pool->Execute(task, task.GetNumTasks());
+}
+
 void cResourceCount::ReinitializeResources(cAvidaContext& ctx, double additional_resource)
 {
   for(int i = 0; i < resource_name.GetSize(); i++) {
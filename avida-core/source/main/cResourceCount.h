@@ -31,9 +31,38 @@
 #include "tMatrix.h"
 #include "nGeometry.h"
 
+#include <cassert>
+
+class cCheckpoint;
+class cWorkerPool;
 class cWorld;
 
 
+/**
+ * Counts the execution steps of the current update.  Resource counts attached to a clock bring their elapsed time up
+ * to date lazily, the next time they are read, rather than being advanced after every executed instruction.  The
+ * owner of the clock must synchronize every attached count before calling NextEpoch().
+ **/
+
+class cResourceClock
+{
+private:
+  double m_step_size;
+  int m_steps;
+  int m_epoch;
+
+public:
+  cResourceClock() : m_step_size(0.0), m_steps(0), m_epoch(0) { ; }
+
+  void Tick(double step_size) { assert(m_steps == 0 || step_size == m_step_size); m_step_size = step_size; m_steps++; }
+  void NextEpoch() { m_epoch++; m_steps = 0; }
+
+  double GetStepSize() const { return m_step_size; }
+  int GetSteps() const { return m_steps; }
+  int GetEpoch() const { return m_epoch; }
+};
+
+
 class cResourceCount
 {
 private:
@@ -50,14 +79,27 @@ private:
   mutable Apto::Array< Apto::Array<double> > curr_spatial_res_cnt;
   int verbosity;
   Apto::Array< Apto::Array<int> > cell_lists;
+  Apto::Array< Apto::Array<unsigned int> > cell_access;  // Bitmap of the cells in each resource's cell list
+  Apto::Array<int> cell_list_res;                      // Resources restricted to a cell list
 
   // Setup the update process to use lazy evaluation...
   mutable double update_time;     // Portion of an update compleated...
   mutable double spatial_update_time;
   mutable int m_last_updated;
   mutable int m_spatial_update;
+  
+  // Lazily applied elapsed time, when attached to a shared clock
+  const cResourceClock* m_clock;
+  mutable int m_clock_epoch;
+  mutable int m_clock_steps;
+  
+  cWorkerPool* m_worker_pool;     // Workers for concurrent spatial resource updates (NULL when serial), not owned
 
   void DoUpdates(cAvidaContext& ctx, bool global_only = false) const;         // Update resource count based on update time
+  void applyClock() const;
+  void updateSpatialResource(cAvidaContext& ctx, int res_index) const;
+  void updateSpatialResources(const Apto::Array<int>& res_indexes) const;
+  void setupCellAccess(int res_index);
 
   // A few constants to describe update process...
   static const double UPDATE_STEP;   // Fraction of an update per step
@@ -127,6 +169,12 @@ public:
   void SetDecay(const cString& name, const double _decay);
   
   void Update(double in_time);
+  void AttachClock(const cResourceClock* clock);
+  void SetWorkerPool(cWorkerPool* pool) { m_worker_pool = pool; }
+  void SyncClock() const
+  {
+    if (m_clock && (m_clock_epoch != m_clock->GetEpoch() || m_clock_steps != m_clock->GetSteps())) applyClock();
+  }
 
   int GetSize(void) const { return resource_count.GetSize(); }
   const Apto::Array<double>& ReadResources(void) const { return resource_count; }
@@ -139,6 +187,8 @@ public:
   int GetResourceGeometry(int res_id) const { return geometry[res_id]; }
   const Apto::Array<Apto::Array<double> >& GetSpatialRes(cAvidaContext& ctx);
   const Apto::Array<Apto::Array<int> >& GetCellIdLists() const { return cell_lists; }
+  inline bool CellHasAccess(int res_id, int cell_id) const;
+  void MaskCellAccess(int cell_id, Apto::Array<double>& res_count) const;
   void Modify(cAvidaContext& ctx, const Apto::Array<double>& res_change);
   void Modify(cAvidaContext& ctx, int id, double change);
   void ModifyCell(cAvidaContext& ctx, const Apto::Array<double> & res_change, int cell_id);
@@ -167,6 +217,18 @@ public:
   void UpdateGlobalResources(cAvidaContext& ctx) { DoUpdates(ctx, true); }
   void UpdateRandomResources(cAvidaContext& ctx) { DoUpdates(ctx, false); }
   void UpdateResources(cAvidaContext& ctx) { DoUpdates(ctx, false); }
+
+  // The resources must already be set up from the environment when loading
+  void Checkpoint(cCheckpoint& ckpt);
 };
 
+
+inline bool cResourceCount::CellHasAccess(int res_id, int cell_id) const
+{
+  if (cell_lists[res_id].GetSize() == 0) return true;
+  const Apto::Array<unsigned int>& bits = cell_access[res_id];
+  const int word = cell_id >> 5;
+  return (cell_id >= 0 && word < bits.GetSize() && (bits[word] & (1u << (cell_id & 31))));
+}
+
 #endif
@@ -21,11 +21,24 @@
 
 #include "cResourceHistory.h"
 
+#include "apto/core/Mutex.h"
+
 #include "cInitFile.h"
 #include "cResourceCount.h"
 #include "cStringList.h"
 
 
+static Apto::Mutex s_version_mutex;
+static int s_next_version = 0;
+
+
+int cResourceHistory::nextVersion()
+{
+  Apto::MutexAutoLock lock(s_version_mutex);
+  return s_next_version++;
+}
+
+
 int cResourceHistory::getEntryForUpdate(int update, bool exact) const
 {
   int entry = -1;
@@ -83,6 +96,8 @@ void cResourceHistory::AddEntry(int update, const Apto::Array<double>& values)
   // Note that this method does not currently validate that 'update' does not already exist as an entry
   // If this happens, incorrect resource levels may be returned upon retreival
 
+  m_version = nextVersion();
+  
   int new_entry = m_entries.GetSize();
   m_entries.Resize(new_entry + 1);
   m_entries[new_entry].update = update;
@@ -101,6 +116,7 @@ bool cResourceHistory::LoadFile(const cString& filename, const cString& working_
     return false;
   }
   
+  m_version = nextVersion();
   m_entries.Resize(file.GetNumLines());
   for (int line = 0; line < file.GetNumLines(); line++) {
     cStringList cur_line(file.GetLine(line));
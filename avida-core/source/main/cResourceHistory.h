@@ -38,16 +38,21 @@ private:
   };
   
   Apto::Array<sResourceHistoryEntry> m_entries;
+  int m_version;
   
   
   int getEntryForUpdate(int update, bool exact) const;
+  static int nextVersion();
   
   
   cResourceHistory(const cResourceHistory&); // @not_implemented
   cResourceHistory& operator=(const cResourceHistory&); // @not_implemented
   
 public:
-  cResourceHistory() { ; }
+  cResourceHistory() : m_version(nextVersion()) { ; }
+  
+  // Unique across all histories, and changed by every modification, unlike the address of the history
+  int GetVersion() const { return m_version; }
   
   bool GetResourceCountForUpdate(cAvidaContext& ctx, int update, cResourceCount& rc, bool exact = false) const;
   bool GetResourceLevelsForUpdate(int update, Apto::Array<double>& levels, bool exact = false) const;
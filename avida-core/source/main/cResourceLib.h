@@ -23,6 +23,7 @@
 #ifndef cResourceLib_h
 #define cResourceLib_h
 
+#include "apto/core/Mutex.h"
 #include "avida/core/Types.h"
 
 class cResource;
@@ -35,6 +36,7 @@ class cResourceLib
 private:
   Apto::Array<cResource*> m_resource_array;
   mutable cResourceHistory* m_initial_levels;
+  mutable Apto::Mutex m_initial_mutex;  // test CPUs on analyze workers may compute the initial levels concurrently
   int m_num_deme_resources;
   
   cResourceLib(const cResourceLib&); // @not_implemented
@@ -22,59 +22,193 @@
 #include "cSpatialResCount.h"
 
 #include "AvidaTools.h"
+#include "cCheckpoint.h"
 #include "nGeometry.h"
 
 #include <cmath>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 using namespace std;
 using namespace AvidaTools;
 
+
+/* Flow of material from a cell to one of its neighbors.  Amount of flow is a function of:
+
+     1) Amount of material in each cell (will try to equalize)
+     2) Distance between each cell
+     3) x and y "gravity"
+
+   The coefficients for each of the four flow directions are fixed for the whole grid, and the calculation below (both
+   scalar and vectorized) performs exactly the same floating point operations, in the same order, as the original
+   pairwise calculation, so that results do not depend on which path processed a cell. */
+
+namespace {
+  struct cFlowCoefficients
+  {
+    bool has_x;
+    bool has_y;
+    bool x_from_source;  // x gravity moves the source cell's material (otherwise pulls the neighbor's)
+    bool y_from_source;
+    double xdiffuse;
+    double ydiffuse;
+    double xgravity;     // absolute value of the gravity
+    double ygravity;
+    double steps;        // |xdist| + |ydist|
+    double dist;
+  };
+  
+  void SetupFlow(cFlowCoefficients& c, int xdist, int ydist, double dist,
+                 double xdiffuse, double ydiffuse, double xgravity, double ygravity)
+  {
+    c.has_x = (xdist != 0);
+    c.has_y = (ydist != 0);
+    c.x_from_source = ((xdist > 0) && (xgravity > 0.0)) || ((xdist < 0) && (xgravity < 0.0));
+    c.y_from_source = ((ydist > 0) && (ygravity > 0.0)) || ((ydist < 0) && (ygravity < 0.0));
+    c.xdiffuse = xdiffuse;
+    c.ydiffuse = ydiffuse;
+    c.xgravity = fabs(xgravity);
+    c.ygravity = fabs(ygravity);
+    c.steps = fabs(xdist * 1.0) + fabs(ydist * 1.0);
+    c.dist = dist;
+  }
+  
+  inline double FlowAmount(double amount1, double amount2, const cFlowCoefficients& c)
+  {
+    const double diff = amount1 - amount2;
+    double xdiffuse = 0.0, ydiffuse = 0.0, xgravity = 0.0, ygravity = 0.0;
+    
+    /* Diffusion uses the diffusion constant x half the difference (as the 
+       elements attempt to equalize) / the number of possible neighbors (8) */
+    
+    if (c.has_x) {
+      xgravity = (c.x_from_source) ? amount1 * c.xgravity / 3.0 : -amount2 * c.xgravity / 3.0;
+      xdiffuse = c.xdiffuse * diff / 16.0;
+    }
+    if (c.has_y) {
+      ygravity = (c.y_from_source) ? amount1 * c.ygravity / 3.0 : -amount2 * c.ygravity / 3.0;
+      ydiffuse = c.ydiffuse * diff / 16.0;
+    }
+    
+    return ((xdiffuse + ydiffuse + xgravity + ygravity) / c.steps) / c.dist;
+  }
+  
+  // Flow from each of count contiguous cells to the matching (equally contiguous) neighbor
+  void FlowRow(const double* amount, const double* neighbor, double* flow, int count, const cFlowCoefficients& c)
+  {
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d three = _mm256_set1_pd(3.0);
+    const __m256d sixteen = _mm256_set1_pd(16.0);
+    const __m256d xdiffuse_c = _mm256_set1_pd(c.xdiffuse);
+    const __m256d ydiffuse_c = _mm256_set1_pd(c.ydiffuse);
+    const __m256d xgravity_c = _mm256_set1_pd(c.xgravity);
+    const __m256d ygravity_c = _mm256_set1_pd(c.ygravity);
+    const __m256d steps = _mm256_set1_pd(c.steps);
+    const __m256d dist = _mm256_set1_pd(c.dist);
+    
+    for (; i + 4 <= count; i += 4) {
+      const __m256d amount1 = _mm256_loadu_pd(amount + i);
+      const __m256d amount2 = _mm256_loadu_pd(neighbor + i);
+      const __m256d diff = _mm256_sub_pd(amount1, amount2);
+      __m256d xdiffuse = zero, ydiffuse = zero, xgravity = zero, ygravity = zero;
+      if (c.has_x) {
+        const __m256d moved = (c.x_from_source) ? amount1 : _mm256_xor_pd(amount2, sign);
+        xgravity = _mm256_div_pd(_mm256_mul_pd(moved, xgravity_c), three);
+        xdiffuse = _mm256_div_pd(_mm256_mul_pd(xdiffuse_c, diff), sixteen);
+      }
+      if (c.has_y) {
+        const __m256d moved = (c.y_from_source) ? amount1 : _mm256_xor_pd(amount2, sign);
+        ygravity = _mm256_div_pd(_mm256_mul_pd(moved, ygravity_c), three);
+        ydiffuse = _mm256_div_pd(_mm256_mul_pd(ydiffuse_c, diff), sixteen);
+      }
+      const __m256d total = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(xdiffuse, ydiffuse), xgravity), ygravity);
+      _mm256_storeu_pd(flow + i, _mm256_div_pd(_mm256_div_pd(total, steps), dist));
+    }
+#endif
+    for (; i < count; i++) flow[i] = FlowAmount(amount[i], neighbor[i], c);
+  }
+  
+  // Index of the first entry of the (ascending) edge cell list that is not before cell_id
+  int FirstEdgeCell(const Apto::Array<int>& cells, int cell_id)
+  {
+    int lo = 0, hi = cells.GetSize();
+    while (lo < hi) {
+      const int mid = (lo + hi) / 2;
+      if (cells[mid] < cell_id) lo = mid + 1;
+      else hi = mid;
+    }
+    return lo;
+  }
+  
+  // Fold the flows into the deltas of count contiguous interior cells, in the order the pairwise calculation visits them:
+  // inflow from the NW, N, NE and W neighbors, then outflow to the E, SE, S and SW neighbors
+  void AccumulateRow(double* delta, const double* flow_e, const double* flow_se, const double* flow_s,
+                     const double* flow_sw, int count, int world_x)
+  {
+    int i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= count; i += 4) {
+      __m256d d = _mm256_loadu_pd(delta + i);
+      d = _mm256_add_pd(d, _mm256_loadu_pd(flow_se + i - world_x - 1));
+      d = _mm256_add_pd(d, _mm256_loadu_pd(flow_s + i - world_x));
+      d = _mm256_add_pd(d, _mm256_loadu_pd(flow_sw + i - world_x + 1));
+      d = _mm256_add_pd(d, _mm256_loadu_pd(flow_e + i - 1));
+      d = _mm256_sub_pd(d, _mm256_loadu_pd(flow_e + i));
+      d = _mm256_sub_pd(d, _mm256_loadu_pd(flow_se + i));
+      d = _mm256_sub_pd(d, _mm256_loadu_pd(flow_s + i));
+      d = _mm256_sub_pd(d, _mm256_loadu_pd(flow_sw + i));
+      _mm256_storeu_pd(delta + i, d);
+    }
+#endif
+    for (; i < count; i++) {
+      double d = delta[i];
+      d += flow_se[i - world_x - 1];
+      d += flow_s[i - world_x];
+      d += flow_sw[i - world_x + 1];
+      d += flow_e[i - 1];
+      d -= flow_e[i];
+      d -= flow_se[i];
+      d -= flow_s[i];
+      d -= flow_sw[i];
+      delta[i] = d;
+    }
+  }
+}
+
+
 /* Setup a single spatial resource with known flows */
 
 cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry, double inxdiffuse, double inydiffuse,
                                    double inxgravity, double inygravity)
-: grid(inworld_x * inworld_y), m_initial(0.0), m_modified(false)
+: m_initial(0.0), m_modified(false)
 {
-  int i;
- 
   xdiffuse = inxdiffuse;
   ydiffuse = inydiffuse;
   xgravity = inxgravity;
   ygravity = inygravity;
-  world_x = inworld_x;
-  world_y = inworld_y;
-  geometry = ingeometry;
-  num_cells = world_x * world_y;
-  for (i = 0; i < GetSize(); i++) {
-    cSpatialCountElem tmpelem;
-    grid[i] = tmpelem;
-  } 
-  SetPointers();
+  ResizeClear(inworld_x, inworld_y, ingeometry);
 }
 
 /* Setup a single spatial resource using default flow amounts  */
 
 cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry)
-: grid(inworld_x * inworld_y), m_initial(0.0), m_modified(false)
+: m_initial(0.0), m_modified(false)
 {
-  int i;
- 
   xdiffuse = 1.0;
   ydiffuse = 1.0;
   xgravity = 0.0;
   ygravity = 0.0;
-  world_x = inworld_x;
-  world_y = inworld_y;
-  geometry = ingeometry;
-  num_cells = world_x * world_y;
-  for (i = 0; i < GetSize(); i++) {
-    cSpatialCountElem tmpelem;
-    grid[i] = tmpelem;
-   } 
-   SetPointers();
+  ResizeClear(inworld_x, inworld_y, ingeometry);
 }
 
-cSpatialResCount::cSpatialResCount() : m_initial(0.0), xdiffuse(1.0), ydiffuse(1.0), xgravity(0.0), ygravity(0.0), m_modified(false)
+cSpatialResCount::cSpatialResCount()
+  : m_initial(0.0), xdiffuse(1.0), ydiffuse(1.0), xgravity(0.0), ygravity(0.0), world_x(0), world_y(0), num_cells(0)
+  , m_modified(false)
 {
   geometry = nGeometry::GLOBAL;
 }
@@ -84,67 +218,97 @@ cSpatialResCount::~cSpatialResCount() { ; }
 
 void cSpatialResCount::ResizeClear(int inworld_x, int inworld_y, int ingeometry)
 {
-  int i;
- 
-  grid.ResizeClear(inworld_x * inworld_y); 
   world_x = inworld_x;
   world_y = inworld_y;
   geometry = ingeometry;
   num_cells = world_x * world_y;
-  for (i = 0; i < GetSize(); i++) {
-    cSpatialCountElem tmpelem;
-    grid[i] = tmpelem;
-   } 
-   SetPointers();
+  
+  m_amount.ResizeClear(num_cells);
+  m_delta.ResizeClear(num_cells);
+  m_cell_initial.ResizeClear(num_cells);
+  m_flow.ResizeClear(4 * num_cells);
+  m_amount.SetAll(0.0);
+  m_delta.SetAll(0.0);
+  m_cell_initial.SetAll(0.0);
+  m_flow.SetAll(0.0);
+  
+  SetPointers();
 }
 
-void cSpatialResCount::SetPointers()
+/* Neighbor receiving the flow from a cell in one of the four directions handled by each cell (0 = E, 1 = SE, 2 = S,
+   3 = SW), or -1 if the cells are not connected.  All cells are treated like they are in a torus, except that the
+   top, bottom and sides of a bounded grid are not linked. */
+
+int cSpatialResCount::flowNeighbor(int cell_id, int dir) const
 {
-  /* Pointer 0 will point to the cell above and to the left the current cell
-     and will go clockwise around the cell.                               */
-
-  int     i,ii;
-  double  SQRT2 = sqrt(2.0);
-
-  /* First treat all cells like they are in a torus */
-
-  for (i = 0; i < GetSize(); i++) {
-    grid[i].SetPtr(0 ,GridNeighbor(i, world_x, world_y, -1, -1), -1, -1, SQRT2);
-    grid[i].SetPtr(1 ,GridNeighbor(i, world_x, world_y,  0, -1),  0, -1, 1.0);
-    grid[i].SetPtr(2 ,GridNeighbor(i, world_x, world_y, +1, -1), +1, -1, SQRT2);
-    grid[i].SetPtr(3 ,GridNeighbor(i, world_x, world_y, +1,  0), +1,  0, 1.0);
-    grid[i].SetPtr(4 ,GridNeighbor(i, world_x, world_y, +1, +1), +1, +1, SQRT2);
-    grid[i].SetPtr(5 ,GridNeighbor(i, world_x, world_y,  0, +1),  0, +1, 1.0);
-    grid[i].SetPtr(6 ,GridNeighbor(i, world_x, world_y, -1, +1), -1, +1, SQRT2);
-    grid[i].SetPtr(7 ,GridNeighbor(i, world_x, world_y, -1,  0), -1,  0, 1.0);
-  }
- 
-  /* Fix links for top, bottom and sides for non-torus */
+  static const int DIR_X[4] = { +1, +1,  0, -1 };
+  static const int DIR_Y[4] = {  0, +1, +1, +1 };
   
   if (geometry == nGeometry::GRID) {
-    /* Top and bottom */
-
-    for (i = 0; i < world_x; i++) {
-      grid[i].SetPtr(0, -99, -99, -99, -99.0);
-      grid[i].SetPtr(1, -99, -99, -99, -99.0);
-      grid[i].SetPtr(2, -99, -99, -99, -99.0);
-      ii = num_cells-1-i;
-      grid[ii].SetPtr(4, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(5, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(6, -99, -99, -99, -99.0);
-    }
+    const int x = cell_id % world_x;
+    const int y = cell_id / world_x;
+    if (DIR_Y[dir] > 0 && y == world_y - 1) return -1;
+    if (DIR_X[dir] > 0 && x == world_x - 1) return -1;
+    if (DIR_X[dir] < 0 && x == 0) return -1;
+  }
+  
+  return GridNeighbor(cell_id, world_x, world_y, DIR_X[dir], DIR_Y[dir]);
+}
 
-    /* fix links for right and left sides */
-
-    for (i = 0; i < world_y; i++) {
-      ii = i * world_x;    
-      grid[ii].SetPtr(0, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(7, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(6, -99, -99, -99, -99.0);
-      ii = ((i + 1) * world_x) - 1;
-      grid[ii].SetPtr(2, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(3, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(4, -99, -99, -99, -99.0);
+/* Build the topology used by FlowAll().  Interior cells exchange material with neighbors at fixed offsets and are
+   handled as a stencil over the rows of the grid.  Cells in the first and last rows and columns may wrap around (or be
+   unlinked in a bounded grid), so their neighbors, and the exact order in which the pairwise flows reach their
+   deltas, are recorded here. */
+
+void cSpatialResCount::SetPointers()
+{
+  m_edge_src.Resize(0);
+  m_edge_src_nb.Resize(0);
+  m_edge_dst.Resize(0);
+  m_edge_term_start.Resize(0);
+  m_edge_terms.Resize(0);
+  if (num_cells == 0) return;
+  
+  Apto::Array<int> dst_index(num_cells);
+  dst_index.SetAll(-1);
+  for (int i = 0; i < num_cells; i++) {
+    const int x = i % world_x;
+    const int y = i / world_x;
+    if (x == 0 || x == world_x - 1 || y == world_y - 1) {
+      m_edge_src.Push(i);
+      for (int dir = 0; dir < 4; dir++) m_edge_src_nb.Push(flowNeighbor(i, dir));
+    }
+    if (x == 0 || x == world_x - 1 || y == 0 || y == world_y - 1) {
+      dst_index[i] = m_edge_dst.GetSize();
+      m_edge_dst.Push(i);
+    }
+  }
+  
+  /* Replay the pairwise visiting order (each cell, then each of its four directions) twice: first to count the terms
+     of each edge cell, then to place them. */
+  
+  m_edge_term_start.Resize(m_edge_dst.GetSize() + 1);
+  m_edge_term_start.SetAll(0);
+  for (int i = 0; i < num_cells; i++) {
+    for (int dir = 0; dir < 4; dir++) {
+      const int nb = flowNeighbor(i, dir);
+      if (nb < 0) continue;
+      if (dst_index[i] >= 0) m_edge_term_start[dst_index[i] + 1]++;
+      if (dst_index[nb] >= 0) m_edge_term_start[dst_index[nb] + 1]++;
+    }
+  }
+  for (int e = 0; e < m_edge_dst.GetSize(); e++) m_edge_term_start[e + 1] += m_edge_term_start[e];
+  
+  m_edge_terms.Resize(m_edge_term_start[m_edge_dst.GetSize()]);
+  Apto::Array<int> fill(m_edge_dst.GetSize());
+  for (int e = 0; e < m_edge_dst.GetSize(); e++) fill[e] = m_edge_term_start[e];
+  for (int i = 0; i < num_cells; i++) {
+    for (int dir = 0; dir < 4; dir++) {
+      const int nb = flowNeighbor(i, dir);
+      if (nb < 0) continue;
+      const int flow_index = dir * num_cells + i;
+      if (dst_index[i] >= 0) m_edge_terms[fill[dst_index[i]]++] = -(flow_index + 1);
+      if (dst_index[nb] >= 0) m_edge_terms[fill[dst_index[nb]]++] = flow_index + 1;
     }
   }
 }
@@ -222,10 +386,10 @@ void cSpatialResCount::SetCellList(Apto::Array<cCellResource>* in_cell_list_ptr)
     /* Be sure the user entered a valid cell id or if the the program is loading
        the resource for the testCPU that does not have a grid set up */
        
-    if (cell_id >= 0 && cell_id <= grid.GetSize()) {
+    if (cell_id >= 0 && cell_id < num_cells) {
       Rate((*cell_list_ptr)[i].GetId(), (*cell_list_ptr)[i].GetInitial());
       State((*cell_list_ptr)[i].GetId());
-      Element(cell_id).SetInitial((*cell_list_ptr)[i].GetInitial());
+      m_cell_initial[cell_id] = (*cell_list_ptr)[i].GetInitial();
     }
   }
 }
@@ -233,8 +397,8 @@ void cSpatialResCount::SetCellList(Apto::Array<cCellResource>* in_cell_list_ptr)
 /* Set the rate variable for one element using the array index */
 
 void cSpatialResCount::Rate(int x, double ratein) const {
-  if (x >= 0 && x < grid.GetSize()) {
-    grid[x].Rate(ratein);
+  if (x >= 0 && x < num_cells) {
+    m_delta[x] += ratein;
   } else {
     assert(false); // x not valid id
   }
@@ -244,7 +408,7 @@ void cSpatialResCount::Rate(int x, double ratein) const {
 
 void cSpatialResCount::Rate(int x, int y, double ratein) const { 
   if (x >= 0 && x < world_x && y>= 0 && y < world_y) {
-    grid[y * world_x + x].Rate(ratein);
+    m_delta[y * world_x + x] += ratein;
   } else {
     assert(false); // x or y not valid id
   }
@@ -254,8 +418,9 @@ void cSpatialResCount::Rate(int x, int y, double ratein) const {
    the array index */
    
 void cSpatialResCount::State(int x) { 
-  if (x >= 0 && x < grid.GetSize()) {
-    grid[x].State();
+  if (x >= 0 && x < num_cells) {
+    m_amount[x] += m_delta[x];
+    m_delta[x] = 0.0;
   } else {
     assert(false); // x not valid id
   }
@@ -266,7 +431,9 @@ void cSpatialResCount::State(int x) {
    
 void cSpatialResCount::State(int x, int y) { 
   if (x >= 0 && x < world_x && y >= 0 && y < world_y) {
-    grid[y*world_x + x].State();
+    const int cell_id = y * world_x + x;
+    m_amount[cell_id] += m_delta[cell_id];
+    m_delta[cell_id] = 0.0;
   } else {
     assert(false); // x or y not valid id
   }
@@ -275,8 +442,8 @@ void cSpatialResCount::State(int x, int y) {
 /* Get the state of one element using the array index */
 
 double cSpatialResCount::GetAmount(int x) const { 
-  if (x >= 0 && x < grid.GetSize()) {
-    return grid[x].GetAmount(); 
+  if (x >= 0 && x < num_cells) {
+    return m_amount[x]; 
   } else {
     return -99.9;
   }
@@ -286,57 +453,128 @@ double cSpatialResCount::GetAmount(int x) const {
 
 double cSpatialResCount::GetAmount(int x, int y) const { 
   if (x >= 0 && x < world_x && y >= 0 && y < world_y) {
-    return grid[y*world_x + x].GetAmount(); 
+    return m_amount[y * world_x + x]; 
   } else {
     return -99.9;
   }
 }
 
 void cSpatialResCount::RateAll(double ratein) {
-
-  int i;
- 
-  for (i = 0; i < num_cells; i++) {
-    grid[i].Rate(ratein);
-  } 
+  double* delta = (num_cells) ? &m_delta[0] : NULL;
+  for (int i = 0; i < num_cells; i++) delta[i] += ratein;
 }
 
 /* For each cell in the grid add the changes stored in the rate variable
    with the total of the resource */
 
 void cSpatialResCount::StateAll() {
+  StateRows(0, world_y);
+}
 
-  int i;
- 
-  for (i = 0; i < num_cells; i++) {
-    grid[i].State();
-  } 
+void cSpatialResCount::StateRows(int row_begin, int row_end) {
+  const int cell_begin = row_begin * world_x;
+  const int cell_end = row_end * world_x;
+  if (cell_begin >= cell_end) return;
+  
+  double* amount = &m_amount[0];
+  double* delta = &m_delta[0];
+  for (int i = cell_begin; i < cell_end; i++) {
+    amount[i] += delta[i];
+    delta[i] = 0.0;
+  }
 }
 
+/* Move material between every pair of neighboring cells.  Flow is two way, so each cell only handles its E, SE, S and
+   SW neighbors.  The outgoing flows of all cells are calculated first, then folded into the deltas; the interior of
+   the grid is processed as a row stencil and the edge cells through the lists built by SetPointers(). */
+
 void cSpatialResCount::FlowAll() {
+  if (!HasFlow()) return;
+  
+  CalcFlows(0, world_y);
+  ApplyFlows(0, world_y);
+}
 
+bool cSpatialResCount::HasFlow() const
+{
   // @JEB save time if diffusion and gravity off...
-  if ((xdiffuse == 0.0) && (ydiffuse == 0.0) && (xgravity == 0.0) && (ygravity == 0.0)) return;
+  if ((xdiffuse == 0.0) && (ydiffuse == 0.0) && (xgravity == 0.0) && (ygravity == 0.0)) return false;
+  return (num_cells > 0);
+}
 
-  int     i,k,ii,xdist,ydist;
-  double  dist;
- 
-  for (i = 0; i < num_cells; i++) {
-      
-    /* because flow is two way we must check only half the neighbors to 
-       prevent double flow calculations */
-
-    for (k = 3; k <= 6; k++) {
-      ii = grid[i].GetElemPtr(k);
-      xdist = grid[i].GetPtrXdist(k);
-      ydist = grid[i].GetPtrYdist(k);
-      dist = grid[i].GetPtrDist(k);
-      if (ii >= 0) {
-        FlowMatter(grid[i],grid[ii],xdiffuse,ydiffuse,xgravity,ygravity,
-                   xdist, ydist, dist);
+/* Calculate the outgoing flows of the cells in rows [row_begin, row_end).  Only reads the amounts (including those of
+   the row below the band), so any number of bands can be calculated concurrently. */
+
+void cSpatialResCount::CalcFlows(int row_begin, int row_end) {
+  if (row_begin >= row_end) return;
+  
+  const double SQRT2 = sqrt(2.0);
+  cFlowCoefficients coeff[4];
+  SetupFlow(coeff[0], +1,  0, 1.0,   xdiffuse, ydiffuse, xgravity, ygravity);
+  SetupFlow(coeff[1], +1, +1, SQRT2, xdiffuse, ydiffuse, xgravity, ygravity);
+  SetupFlow(coeff[2],  0, +1, 1.0,   xdiffuse, ydiffuse, xgravity, ygravity);
+  SetupFlow(coeff[3], -1, +1, SQRT2, xdiffuse, ydiffuse, xgravity, ygravity);
+  const int offset[4] = { 1, world_x + 1, world_x, world_x - 1 };
+  
+  const double* amount = &m_amount[0];
+  double* flow = &m_flow[0];
+  
+  // Interior cells (all but the first and last column and the last row) ...
+  const int row_cells = world_x - 2;
+  if (row_cells > 0) {
+    for (int y = row_begin; y < Apto::Min(row_end, world_y - 1); y++) {
+      const int row_start = y * world_x + 1;
+      for (int dir = 0; dir < 4; dir++) {
+        FlowRow(amount + row_start, amount + row_start + offset[dir], flow + dir * num_cells + row_start, row_cells,
+                coeff[dir]);
       }
     }
   }
+  
+  // ... and edge cells
+  const int cell_end = row_end * world_x;
+  for (int e = FirstEdgeCell(m_edge_src, row_begin * world_x); e < m_edge_src.GetSize(); e++) {
+    const int cell_id = m_edge_src[e];
+    if (cell_id >= cell_end) break;
+    for (int dir = 0; dir < 4; dir++) {
+      const int nb = m_edge_src_nb[e * 4 + dir];
+      flow[dir * num_cells + cell_id] = (nb >= 0) ? FlowAmount(amount[cell_id], amount[nb], coeff[dir]) : 0.0;
+    }
+  }
+}
+
+/* Fold the flows into the deltas of the cells in rows [row_begin, row_end).  Reads the flows of the row above the band
+   (and, for the edge cells, of wrapped around rows), so the flows of every band must have been calculated first. */
+
+void cSpatialResCount::ApplyFlows(int row_begin, int row_end) {
+  if (row_begin >= row_end) return;
+  
+  double* delta = &m_delta[0];
+  const double* flow = &m_flow[0];
+  
+  // Interior cells (all but the first and last row and column) ...
+  const int row_cells = world_x - 2;
+  if (row_cells > 0) {
+    for (int y = Apto::Max(row_begin, 1); y < Apto::Min(row_end, world_y - 1); y++) {
+      const int row_start = y * world_x + 1;
+      AccumulateRow(delta + row_start, flow + row_start, flow + num_cells + row_start, flow + 2 * num_cells + row_start,
+                    flow + 3 * num_cells + row_start, row_cells, world_x);
+    }
+  }
+  
+  // ... and edge cells
+  const int cell_end = row_end * world_x;
+  for (int e = FirstEdgeCell(m_edge_dst, row_begin * world_x); e < m_edge_dst.GetSize(); e++) {
+    const int cell_id = m_edge_dst[e];
+    if (cell_id >= cell_end) break;
+    double d = delta[cell_id];
+    for (int t = m_edge_term_start[e]; t < m_edge_term_start[e + 1]; t++) {
+      const int term = m_edge_terms[t];
+      if (term > 0) d += flow[term - 1];
+      else d -= flow[-term - 1];
+    }
+    delta[cell_id] = d;
+  }
 }
 
 /* Total up all the resources in each cell */
@@ -379,7 +617,7 @@ void cSpatialResCount::CellInflow() const {
     /* Be sure the user entered a valid cell id or if the the program is loading
        the resource for the testCPU that does not have a grid set up */
        
-    if (cell_id >= 0 && cell_id < grid.GetSize()) {
+    if (cell_id >= 0 && cell_id < num_cells) {
       Rate(cell_id, (*cell_list_ptr)[i].GetInflow());
     }
   }
@@ -415,7 +653,7 @@ void cSpatialResCount::CellOutflow() const {
     /* Be sure the user entered a valid cell id or if the the program is loading
        the resource for the testCPU that does not have a grid set up */
        
-    if (cell_id >= 0 && cell_id < grid.GetSize()) {
+    if (cell_id >= 0 && cell_id < num_cells) {
       deltaamount = Apto::Max((GetAmount(cell_id) * (*cell_list_ptr)[i].GetOutflow()), 0.0);
     }                     
     Rate((*cell_list_ptr)[i].GetId(), -deltaamount); 
@@ -424,14 +662,43 @@ void cSpatialResCount::CellOutflow() const {
 
 void cSpatialResCount::SetCellAmount(int cell_id, double res)
 {
-  if (cell_id >= 0 && cell_id < grid.GetSize())
+  if (cell_id >= 0 && cell_id < num_cells)
   {
-    Element(cell_id).SetAmount(res);
+    m_amount[cell_id] = res;
   }
 }
 
 
 void cSpatialResCount::ResetResourceCounts()
 {
-  for (int i = 0; i < grid.GetSize(); i++) grid[i].ResetResourceCount(m_initial);
+  for (int i = 0; i < num_cells; i++) m_amount[i] = m_initial + m_cell_initial[i];
+}
+
+// The grid layout and flow connections are rebuilt from the environment, so only amounts and the settings that
+// events may have changed are saved
+void cSpatialResCount::Checkpoint(cCheckpoint& ckpt)
+{
+  const int saved_cells = num_cells;
+  ckpt.Transfer(m_amount);
+  ckpt.Transfer(m_cell_initial);
+  if (ckpt.IsLoading() && (m_amount.GetSize() != saved_cells || m_cell_initial.GetSize() != saved_cells)) {
+    ckpt.Fail("spatial resource grid size does not match the world");
+    return;
+  }
+  ckpt.Transfer(m_initial);
+  ckpt.Transfer(xdiffuse);
+  ckpt.Transfer(ydiffuse);
+  ckpt.Transfer(xgravity);
+  ckpt.Transfer(ygravity);
+  ckpt.Transfer(inflowX1);
+  ckpt.Transfer(inflowX2);
+  ckpt.Transfer(inflowY1);
+  ckpt.Transfer(inflowY2);
+  ckpt.Transfer(outflowX1);
+  ckpt.Transfer(outflowX2);
+  ckpt.Transfer(outflowY1);
+  ckpt.Transfer(outflowY2);
+  ckpt.Transfer(curr_peakx);
+  ckpt.Transfer(curr_peaky);
+  ckpt.Transfer(m_modified);
 }
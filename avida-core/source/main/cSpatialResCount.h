@@ -26,14 +26,30 @@
 #define cSpatialResCount_h
 
 #include "cAvidaContext.h"
-#include "cSpatialCountElem.h"
 #include "cResource.h"
 
+class cCheckpoint;
+
 
 class cSpatialResCount
 {
 private:
-  Apto::Array<cSpatialCountElem> grid;
+  // Per cell state is kept in flat arrays, so that the whole-grid updates stream through contiguous memory
+  mutable Apto::Array<double> m_amount;
+  mutable Apto::Array<double> m_delta;
+  Apto::Array<double> m_cell_initial;
+  
+  // Flow from each cell toward its E, SE, S and SW neighbors (one num_cells block per direction), used by FlowAll()
+  Apto::Array<double> m_flow;
+  
+  // Cells on the edge of the grid cannot use the interior stencil, their neighbors and the ordered flow terms of their
+  // deltas are listed explicitly instead (built by SetPointers())
+  Apto::Array<int> m_edge_src;        // Edge cells, whose outgoing flows are calculated individually
+  Apto::Array<int> m_edge_src_nb;     // Four neighbors per edge cell (E, SE, S, SW), -1 if not connected
+  Apto::Array<int> m_edge_dst;        // Edge cells, whose deltas are accumulated from the term list
+  Apto::Array<int> m_edge_term_start; // Offset of each edge cell's terms, plus a final end offset
+  Apto::Array<int> m_edge_terms;      // Flow index + 1 for inflow, -(flow index + 1) for outflow
+  
   double m_initial;
   double xdiffuse, ydiffuse;
   double xgravity, ygravity;
@@ -46,6 +62,8 @@ private:
   Apto::Array<cCellResource> *cell_list_ptr;
   bool m_modified;
   
+  int flowNeighbor(int cell_id, int dir) const;
+  
 public:
   cSpatialResCount();
   cSpatialResCount(int inworld_x, int inworld_y, int ingeometry);
@@ -58,11 +76,10 @@ public:
   void SetPointers();
   void CheckRanges();
   void SetCellList(Apto::Array<cCellResource> *in_cell_list_ptr);
-  int GetSize() const { return grid.GetSize(); }
+  int GetSize() const { return m_amount.GetSize(); }
   int GetX() const { return world_x; }
   int GetY() const { return world_y; }
   int GetCellListSize() const { return cell_list_ptr->GetSize(); }
-  cSpatialCountElem& Element(int x) { return grid[x]; }
   void Rate(int x, double ratein) const;
   void Rate(int x, int y, double ratein) const;
   void State(int x);
@@ -72,6 +89,15 @@ public:
   void RateAll(double ratein); 
   virtual void StateAll();
   void FlowAll(); 
+  
+  // FlowAll() and StateAll() split into row bands, for concurrent updates.  The flows of every band must be calculated
+  // before those of any band are applied, as neighboring bands exchange the flows of their boundary rows.
+  bool HasFlow() const;
+  void CalcFlows(int row_begin, int row_end);
+  void ApplyFlows(int row_begin, int row_end);
+  void StateRows(int row_begin, int row_end);
+  virtual bool IsConcurrentSafe() const { return true; } // UpdateCount() does nothing, other updates only touch own state
+  
   double SumAll() const;
   void Source(double amount) const;
   void CellInflow() const;
@@ -95,6 +121,7 @@ public:
   void SetOutflowY2(int in_outflowY2) { outflowY2 = in_outflowY2; }
   virtual void UpdateCount(cAvidaContext&) { ; }
   void ResetResourceCounts();
+  virtual void Checkpoint(cCheckpoint& ckpt);
   void SetModified(bool in_modified) { m_modified = in_modified; }
   bool GetModified() { return m_modified; }
   
@@ -29,6 +29,7 @@
 #include "avida/data/Util.h"
 #include "avida/output/File.h"
 
+#include "cCheckpoint.h"
 #include "cEnvironment.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
@@ -567,6 +568,19 @@ void cStats::RecordBirth(bool breed_true)
   else num_breed_in++;
 }
 
+void cStats::Checkpoint(cCheckpoint& ckpt)
+{
+  ckpt.BeginSection("STAT");
+  ckpt.Transfer(m_update);
+  ckpt.Transfer(last_update);
+  ckpt.Transfer(avida_time);
+  ckpt.Transfer(rave_true_replication_rate);
+  ckpt.Transfer(cumulative_births);
+  ckpt.Transfer(tot_organisms);
+  ckpt.Transfer(tot_executed);
+  ckpt.EndSection();
+}
+
 void cStats::ProcessUpdate()
 {
   // Increment the "avida_time"
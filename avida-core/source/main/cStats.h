@@ -51,6 +51,7 @@
 #include <set>
 #include <utility>
 
+class cCheckpoint;
 class cWorld;
 class cOrganism;
 class cOrgMessage;
@@ -442,6 +443,10 @@ public:
   inline void SetCurrentUpdate(int new_update) { m_update = new_update; }
   inline void IncCurrentUpdate() { m_update++; }
 
+  // Only the clock and the running totals that carry across updates (organism ids, event triggers, time averages) are
+  // checkpointed, everything else is recollected each update
+  void Checkpoint(cCheckpoint& ckpt);
+
   // Accessors...
   int GetUpdate() const { return m_update; }
   double GetGeneration() const { return SumGeneration().Average(); }
@@ -725,6 +730,7 @@ public:
   void SetCompetitionOrgsReplicated(int _in) { num_orgs_replicated = _in; }
 
   void AddSpeculative(int spec) { m_spec_total += spec; m_spec_num++; }
+  void AddSpeculative(int spec, int num) { m_spec_total += spec; m_spec_num += num; }
   void AddSpeculativeWaste(int waste) { m_spec_waste += waste; }
 
   // Sexual selection recording
@@ -44,11 +44,14 @@ private:
   cArgContainer* m_args;
   Apto::String m_prop_id_ave;
   Apto::String m_prop_id_count;
+  bool m_logic_only;               // Does the result of this task depend only on the logic id of the output?
+  unsigned int m_logic_ids[8];     // Logic ids for which a logic only task is performed
 
 public:
   cTaskEntry(const cString& name, const cString& desc, int in_id, tTaskTest fun, cArgContainer* args)
-    : m_name(name), m_desc(desc), m_id(in_id), m_test_fun(fun), m_args(args)
+    : m_name(name), m_desc(desc), m_id(in_id), m_test_fun(fun), m_args(args), m_logic_only(false)
   {
+    for (int i = 0; i < 8; i++) m_logic_ids[i] = 0;
     m_prop_id_ave = Apto::FormatStr("environment.triggers.%s.average", (const char*)name);
     m_prop_id_count = Apto::FormatStr("environment.triggers.%s.count", (const char*)name);
   }
@@ -68,6 +71,14 @@ public:
   
   bool HasArguments() const { return (m_args != NULL); }
   cArgContainer& GetArguments() const { return *m_args; }
+  
+  bool IsLogicOnly() const { return m_logic_only; }
+  void SetLogicOnly() { m_logic_only = true; }
+  void AddLogicId(int logic_id) { m_logic_ids[logic_id >> 5] |= (1u << (logic_id & 31)); }
+  bool HasLogicId(int logic_id) const
+  {
+    return (logic_id >= 0 && logic_id < 256 && (m_logic_ids[logic_id >> 5] & (1u << (logic_id & 31))));
+  }
 };
 
 #endif
@@ -351,10 +351,43 @@ cTaskEntry* cTaskLib::AddTask(const cString& name, const cString& info, cEnvReqs
     return NULL;
   }
   
+  // Tasks that depend only on the logic id of the output are indexed by it when testing reactions
+  if (isLogicOnly(task_array[start_size])) setupLogicIds(task_array[start_size]);
+  
   // And return the found task.
   return task_array[start_size];
 }
 
+bool cTaskLib::isLogicOnly(const cTaskEntry* entry) const
+{
+  const tTaskTest fun = entry->GetTestFun();
+  if (fun == &cTaskLib::Task_Not || fun == &cTaskLib::Task_Nand || fun == &cTaskLib::Task_And ||
+      fun == &cTaskLib::Task_OrNot || fun == &cTaskLib::Task_Or || fun == &cTaskLib::Task_AndNot ||
+      fun == &cTaskLib::Task_Nor || fun == &cTaskLib::Task_Xor || fun == &cTaskLib::Task_Equ) {
+    return true;
+  }
+  
+  // All 3-input logic functions
+  return entry->GetName().IsSubstring("logic_3", 0);
+}
+
+void cTaskLib::setupLogicIds(cTaskEntry* entry) const
+{
+  // Run the task against every possible logic id, recording those for which it is performed
+  tBuffer<int> inputs(1);
+  tBuffer<int> outputs(1);
+  tList<tBuffer<int> > other_buffers;
+  Apto::Array<int, Apto::Smart> ext_mem;
+  cTaskContext ctx(NULL, inputs, outputs, other_buffers, other_buffers, ext_mem);
+  ctx.SetTaskEntry(entry);
+  
+  entry->SetLogicOnly();
+  for (int logic_id = 0; logic_id < 256; logic_id++) {
+    ctx.SetLogicId(logic_id);
+    if (TestOutput(ctx) > 0.0) entry->AddLogicId(logic_id);
+  }
+}
+
 void cTaskLib::NewTask(const cString& name, const cString& desc, tTaskTest task_fun, int reqs, cArgContainer* args)
 {
   if (reqs & REQ_NEIGHBOR_INPUT) use_neighbor_input = true;
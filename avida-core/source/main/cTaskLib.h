@@ -85,6 +85,8 @@ private:
 private:
   
   void NewTask(const cString& name, const cString& desc, tTaskTest task_fun, int reqs = 0, cArgContainer* args = NULL);
+  bool isLogicOnly(const cTaskEntry* entry) const;
+  void setupLogicIds(cTaskEntry* entry) const;
 
   inline double FractionalReward(unsigned int supplied, unsigned int correct);  
 
@@ -34,6 +34,7 @@
 
 #include "cAnalyze.h"
 #include "cAnalyzeGenotype.h"
+#include "cCheckpoint.h"
 #include "cEnvironment.h"
 #include "cEventList.h"
 #include "cHardwareManager.h"
@@ -45,6 +46,8 @@
 #include "cUserFeedback.h"
 
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 
 using namespace AvidaTools;
 
@@ -70,6 +73,9 @@ cWorld::~cWorld()
 {
   // m_actlib is not owned by cWorld, DO NOT DELETE
   
+  // Outstanding snapshots run on the analyze job queue and write through the output manager
+  FinishSnapshots(*m_ctx);
+  
   // These must be deleted first
   delete m_analyze; m_analyze = NULL;
   
@@ -114,7 +120,9 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
     
     // Output Manager
     Apto::String opath = Apto::FileSystem::GetAbsolutePath(Apto::String(m_conf->DATA_DIR.Get()), Apto::String(m_working_dir));
-    Output::ManagerPtr(new Output::Manager(opath))->AttachTo(new_world);
+    Output::ManagerPtr output_mgr(new Output::Manager(opath));
+    output_mgr->AttachTo(new_world);
+    if (m_conf->OUTPUT_THREAD.Get()) output_mgr->StartWriter();
   }
   
 
@@ -145,7 +153,10 @@ bool cWorld::setup(World* new_world, cUserFeedback* feedback, const Apto::Map<Ap
   // Systematics
   Systematics::ManagerPtr systematics(new Systematics::Manager);
   systematics->AttachTo(new_world);
-  systematics->RegisterArbiter(Systematics::ArbiterPtr(new Systematics::GenotypeArbiter(new_world, "genotype", m_conf->THRESHOLD.Get(), m_conf->DISABLE_GENOTYPE_CLASSIFICATION.Get())));
+  Apto::String historic_spill;
+  if (m_conf->HISTORIC_SPILL_MB.Get() > 0) historic_spill = Output::Manager::Of(new_world)->OutputIDFromPath("genotype_historic.spill");
+  systematics->RegisterArbiter(Systematics::ArbiterPtr(new Systematics::GenotypeArbiter(new_world, "genotype", m_conf->THRESHOLD.Get(), m_conf->DISABLE_GENOTYPE_CLASSIFICATION.Get(),
+                                                                                        historic_spill, m_conf->HISTORIC_SPILL_MB.Get())));
 
   
   // Setup Stats Object
@@ -217,11 +228,167 @@ cAnalyze& cWorld::GetAnalyze()
 
 void cWorld::GetEvents(cAvidaContext& ctx)
 {  
+  // A checkpoint is taken after the events of its update have been processed, so resuming from one picks up there
+  const cString restore_file = m_conf->RESTORE_CHECKPOINT.Get();
+  if (restore_file != "" && restore_file != "-") {
+    m_conf->RESTORE_CHECKPOINT.Set("-");
+    if (!LoadCheckpoint(restore_file, ctx)) ctx.Driver().Abort(Avida::INVALID_CONFIG);
+    return;
+  }
+  
   if (m_pop->GetSyncEvents() == true) {
     m_event_list->Sync();
     m_pop->SetSyncEvents(false);
   }
   m_event_list->Process(ctx);
+  
+  if (m_snapshots.GetSize()) writeSnapshots(ctx, false);
+  
+  if (m_checkpoint_file.GetSize()) {
+    const cString filename = m_checkpoint_file;
+    m_checkpoint_file = "";
+    SaveCheckpoint(filename, ctx);
+  }
+}
+
+
+void cWorld::SubmitSnapshot(cTestSnapshotPtr snapshot, cAvidaContext& ctx)
+{
+  snapshot->submit(!ctx.GetAnalyzeMode());
+  
+  // Analyze mode has no updates to write from, so the results are waited on here
+  if (ctx.GetAnalyzeMode()) {
+    snapshot->Wait();
+    snapshot->Write(ctx);
+    return;
+  }
+  
+  m_snapshots.Push(snapshot);
+}
+
+
+void cWorld::writeSnapshots(cAvidaContext& ctx, bool wait)
+{
+  // Stop at the first incomplete snapshot, so that output files stay in update order
+  int written = 0;
+  for (; written < m_snapshots.GetSize(); written++) {
+    if (wait) m_snapshots[written]->Wait();
+    else if (!m_snapshots[written]->IsComplete()) break;
+    m_snapshots[written]->Write(ctx);
+  }
+  
+  if (!written) return;
+  for (int i = written; i < m_snapshots.GetSize(); i++) m_snapshots[i - written] = m_snapshots[i];
+  m_snapshots.Resize(m_snapshots.GetSize() - written);
+}
+
+
+void cWorld::RequestCheckpoint(const cString& filename)
+{
+  m_checkpoint_file = filename;
+}
+
+
+bool cWorld::SaveCheckpoint(const cString& filename, cAvidaContext& ctx)
+{
+  Output::ManagerPtr output_mgr = Output::Manager::Of(m_new_world);
+  Apto::String path = output_mgr->OutputIDFromPath(Apto::String((const char*)filename));
+  
+  // Output written up to this point must be on disk along with the checkpoint
+  FinishSnapshots(ctx);
+  output_mgr->DrainWriter();
+  
+  // Written beside the target and renamed over it once complete, so that a failed save leaves any earlier checkpoint
+  Apto::String tmp_path = path + ".tmp";
+  std::ofstream fp((const char*)tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fp.good()) {
+    ctx.Driver().Feedback().Error("unable to open checkpoint file '%s'", (const char*)tmp_path);
+    return false;
+  }
+  
+  cCheckpoint ckpt(fp);
+  if (!checkpoint(ckpt, ctx)) {
+    ctx.Driver().Feedback().Error("unable to save checkpoint '%s': %s", (const char*)path, (const char*)ckpt.GetError());
+    fp.close();
+    std::remove((const char*)tmp_path);
+    return false;
+  }
+  fp.close();
+  if (fp.fail()) {
+    ctx.Driver().Feedback().Error("unable to write checkpoint file '%s'", (const char*)tmp_path);
+    std::remove((const char*)tmp_path);
+    return false;
+  }
+  // Some platforms will not rename over an existing file, in which case the old checkpoint is removed first
+  if (std::rename((const char*)tmp_path, (const char*)path) != 0 &&
+      (std::remove((const char*)path) != 0 || std::rename((const char*)tmp_path, (const char*)path) != 0)) {
+    ctx.Driver().Feedback().Error("unable to replace checkpoint file '%s'", (const char*)path);
+    std::remove((const char*)tmp_path);
+    return false;
+  }
+  return true;
+}
+
+
+bool cWorld::LoadCheckpoint(const cString& filename, cAvidaContext& ctx)
+{
+  Apto::String path = Apto::FileSystem::GetAbsolutePath(Apto::String((const char*)filename), Apto::String(m_working_dir));
+  std::ifstream fp((const char*)path, std::ios::in | std::ios::binary);
+  if (!fp.good()) {
+    ctx.Driver().Feedback().Error("unable to open checkpoint file '%s'", (const char*)path);
+    return false;
+  }
+  
+  cCheckpoint ckpt(fp);
+  if (!checkpoint(ckpt, ctx)) {
+    ctx.Driver().Feedback().Error("unable to load checkpoint '%s': %s", (const char*)path, (const char*)ckpt.GetError());
+    return false;
+  }
+  
+  m_pop->SetSyncEvents(false);
+  return true;
+}
+
+
+// Both directions of a checkpoint: world layout, then the population (whose placement of organisms touches the
+// statistics), the statistics, the event list and the analyze job queue.  Rebuilding all of these draws on the random
+// number generator, so its state is written first but only restored once everything else is in place.
+bool cWorld::checkpoint(cCheckpoint& ckpt, cAvidaContext& ctx)
+{
+  ckpt.BeginSection("WRLD");
+  int world_x = m_conf->WORLD_X.Get();
+  int world_y = m_conf->WORLD_Y.Get();
+  int geometry = m_conf->WORLD_GEOMETRY.Get();
+  int num_cells = m_pop->GetSize();
+  ckpt.Transfer(world_x);
+  ckpt.Transfer(world_y);
+  ckpt.Transfer(geometry);
+  ckpt.Transfer(num_cells);
+  if (ckpt.IsOK() && (world_x != m_conf->WORLD_X.Get() || world_y != m_conf->WORLD_Y.Get() ||
+                      geometry != m_conf->WORLD_GEOMETRY.Get() || num_cells != m_pop->GetSize())) {
+    ckpt.Fail("world layout does not match the configuration");
+  }
+  if (!ckpt.IsLoading()) m_rng.Rebase();
+  int seed = m_rng.Seed();
+  long long draws = m_rng.GetDraws();
+  bool analyze = (m_analyze != NULL);
+  ckpt.Transfer(seed);
+  ckpt.Transfer(draws);
+  ckpt.Transfer(analyze);
+  ckpt.EndSection();
+  
+  if (ckpt.IsOK()) m_pop->Checkpoint(ckpt, ctx);
+  if (ckpt.IsOK()) m_stats->Checkpoint(ckpt);
+  if (ckpt.IsOK()) m_event_list->Checkpoint(ckpt, ctx.Driver().Feedback());
+  
+  // The job queue draws its seed stream from the world generator when it is created
+  if (ckpt.IsOK() && analyze) GetAnalyze().GetJobQueue().Checkpoint(ckpt);
+  
+  if (ckpt.IsOK() && ckpt.IsLoading()) {
+    if (draws < 0) ckpt.Fail("invalid random number generator state");
+    else m_rng.Restore(seed, draws);
+  }
+  return ckpt.IsOK();
 }
 
 int cWorld::GetNumResources()
@@ -29,11 +29,14 @@
 
 #include "cAvidaConfig.h"
 #include "cAvidaContext.h"
+#include "cReplayRandom.h"
+#include "cTestSnapshot.h"
 
 #include <cassert>
 
 class cAnalyze;
 class cAnalyzeGenotype;
+class cCheckpoint;
 class cEnvironment;
 class cEventList;
 class cHardwareManager;
@@ -69,12 +72,16 @@ protected:
   
   Data::ManagerPtr m_data_mgr;
 
-  Apto::RNG::AvidaRNG m_rng;
+  cReplayRandom m_rng;
   
   bool m_test_on_div;     // flag derived from a collection of configuration settings
   bool m_test_sterilize;  // flag derived from a collection of configuration settings
   
   bool m_own_driver;      // specifies whether this world object should manage its driver object
+  
+  cString m_checkpoint_file;  // Checkpoint to be written once the events of the current update have been processed
+  
+  Apto::Array<cTestSnapshotPtr> m_snapshots;  // Submitted test CPU snapshots not yet written, in submission order
 
   cWorld(cAvidaConfig* cfg, const cString& wd);
   
@@ -115,6 +122,21 @@ public:
   inline void SetVerbosity(int v) { m_conf->VERBOSITY.Set(v); }
 
   void GetEvents(cAvidaContext& ctx);
+  
+  // Checkpointing (see cCheckpoint).  Requested checkpoints are written after the events of the current update, when
+  // the world is between updates.  Saving leaves the run untouched; the state of the random number generators and of
+  // the scheduler is recorded along with everything else, so that a resumed run continues exactly as the saving run does.
+  void RequestCheckpoint(const cString& filename);
+  bool SaveCheckpoint(const cString& filename, cAvidaContext& ctx);
+  bool LoadCheckpoint(const cString& filename, cAvidaContext& ctx);
+  
+  // Test CPU snapshots (see cTestSnapshot) are tested on the analyze job queue while the run continues.  Completed
+  // snapshots are written after the events of an update, in the order they were submitted.
+  void SubmitSnapshot(cTestSnapshotPtr snapshot, cAvidaContext& ctx);
+  
+  // Waits for and writes every pending snapshot.  Anything that changes the environment or configuration during a run
+  // must call this first, as the snapshot tests read both.
+  void FinishSnapshots(cAvidaContext& ctx) { if (m_snapshots.GetSize()) writeSnapshots(ctx, true); }
 	
 	cEventList* GetEventsList() { return m_event_list; }
 
@@ -139,6 +161,8 @@ public:
 protected:
   // Internal Methods
   bool setup(World* new_world, cUserFeedback* errors,  const Apto::Map<Apto::String, Apto::String>* mappings);
+  bool checkpoint(cCheckpoint& ckpt, cAvidaContext& ctx);
+  void writeSnapshots(cAvidaContext& ctx, bool wait);
 
 };
 
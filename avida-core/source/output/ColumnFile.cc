@@ -0,0 +1,486 @@
+/*
+ *  output/ColumnFile.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/output/ColumnFile.h"
+
+#include "avida/output/Manager.h"
+#include "avida/private/output/Writer.h"
+
+#include <cassert>
+#include <cstring>
+
+
+// File layout: the magic string and format version, followed by chunks, each a one byte tag and an eight byte payload
+// length.  All integers are little-endian, doubles are stored as their IEEE 754 bit patterns.
+//   'T' - verbatim text
+//   'S' - schema: column count, then for each column its type, stream precision and flags, and descriptor
+//   'R' - rows: row count, then for each column the length of its encoded values followed by the values
+static const char COLUMN_FILE_MAGIC[8] = { 'A', 'V', 'D', 'C', 'O', 'L', 'S', '\n' };
+
+
+namespace {
+  inline void putBytes(std::string& buf, uint64_t value, int num_bytes)
+  {
+    for (int i = 0; i < num_bytes; i++) buf += static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+
+  inline void putString(std::string& buf, const char* str, size_t len)
+  {
+    putBytes(buf, len, 4);
+    buf.append(str, len);
+  }
+
+  inline void putValue(std::string& buf, int type, double d, int64_t i, const std::string& s)
+  {
+    switch (type) {
+      case Avida::Output::ColumnFile::COL_DOUBLE:
+      {
+        uint64_t bits;
+        memcpy(&bits, &d, sizeof(bits));
+        putBytes(buf, bits, 8);
+      }
+        break;
+      case Avida::Output::ColumnFile::COL_INT:
+        putBytes(buf, static_cast<uint64_t>(i), 8);
+        break;
+      default:
+        putString(buf, s.data(), s.size());
+        break;
+    }
+  }
+
+
+  // Reads little-endian values from a chunk payload, failing rather than reading past its end
+  class ChunkReader
+  {
+  private:
+    const std::string& m_buf;
+    size_t m_pos;
+    bool m_ok;
+
+  public:
+    ChunkReader(const std::string& buf) : m_buf(buf), m_pos(0), m_ok(true) { ; }
+
+    bool OK() const { return m_ok; }
+    size_t Position() const { return m_pos; }
+
+    uint64_t Get(int num_bytes)
+    {
+      if (!m_ok || m_pos + num_bytes > m_buf.size()) {
+        m_ok = false;
+        return 0;
+      }
+      uint64_t value = 0;
+      for (int i = num_bytes - 1; i >= 0; i--) value = (value << 8) | static_cast<unsigned char>(m_buf[m_pos + i]);
+      m_pos += num_bytes;
+      return value;
+    }
+
+    std::string GetString()
+    {
+      const size_t len = static_cast<size_t>(Get(4));
+      if (!m_ok || m_pos + len > m_buf.size()) {
+        m_ok = false;
+        return std::string();
+      }
+      std::string str(m_buf, m_pos, len);
+      m_pos += len;
+      return str;
+    }
+  };
+
+  inline std::string formatValue(int type, int precision, unsigned int flags, double d, int64_t i, const std::string& s)
+  {
+    if (type == Avida::Output::ColumnFile::COL_TEXT) return s;
+
+    std::ostringstream fmt;
+    fmt.precision(precision);
+    fmt.flags(static_cast<std::ios::fmtflags>(flags));
+    switch (type) {
+      case Avida::Output::ColumnFile::COL_DOUBLE: fmt << d; break;
+      case Avida::Output::ColumnFile::COL_INT:    fmt << static_cast<long long>(i); break;
+      default:                                     fmt << s; break;
+    }
+    fmt << " ";
+    return fmt.str();
+  }
+};
+
+
+Avida::Output::ColumnFile::ColumnFile(World* world, const OutputID& output_id)
+  : File(world, output_id, &m_raw), m_num_rows(0), m_line_is_text(false)
+{
+  const std::ios::openmode mode = std::ios::out | std::ios::binary | std::ios::trunc;
+  m_write_buf = Output::Manager::Of(world)->OpenBuffered(output_id, mode);
+  if (m_write_buf) m_out.std::ios::rdbuf(m_write_buf);
+  else m_out.open(output_id, mode);
+  m_out.write(COLUMN_FILE_MAGIC, sizeof(COLUMN_FILE_MAGIC));
+  std::string version;
+  putBytes(version, FORMAT_VERSION, 4);
+  m_out.write(version.data(), version.size());
+  if (!m_out.good()) m_fp.setstate(std::ios::failbit);
+}
+
+Avida::Output::ColumnFile::~ColumnFile()
+{
+  Flush();
+}
+
+
+bool Avida::Output::ColumnFile::beginValue(const char* descr, const char* format)
+{
+  // Until the header has been written, raw text precedes the whole header (as it does in Output::File), and so is
+  // never part of the current row
+  if (!m_descr_written) {
+    m_col_names.Push(descr);
+    WriteColumnDesc(descr, format);
+    return true;
+  }
+
+  syncRaw();
+  return !m_line_is_text;
+}
+
+Avida::Output::ColumnFile::Value& Avida::Output::ColumnFile::pushValue(int type)
+{
+  m_row.Resize(m_row.GetSize() + 1);
+  Value& value = m_row[m_row.GetSize() - 1];
+  value.type = type;
+  value.precision = static_cast<int>(m_fp.precision());
+  value.flags = static_cast<unsigned int>(m_fp.flags());
+  return value;
+}
+
+
+void Avida::Output::ColumnFile::Write(double x, const char* descr, const char* format)
+{
+  if (beginValue(descr, format)) pushValue(COL_DOUBLE).d = x;
+  else m_fp << x << " ";
+}
+
+void Avida::Output::ColumnFile::Write(int i, const char* descr, const char* format)
+{
+  if (beginValue(descr, format)) pushValue(COL_INT).i = i;
+  else m_fp << i << " ";
+}
+
+void Avida::Output::ColumnFile::Write(long i, const char* descr, const char* format)
+{
+  if (beginValue(descr, format)) pushValue(COL_INT).i = i;
+  else m_fp << i << " ";
+}
+
+void Avida::Output::ColumnFile::Write(unsigned int i, const char* descr, const char*)
+{
+  if (beginValue(descr, "")) pushValue(COL_INT).i = i;
+  else m_fp << i << " ";
+}
+
+void Avida::Output::ColumnFile::Write(const char* data_str, const char* descr, const char* format)
+{
+  if (beginValue(descr, format)) pushValue(COL_STRING).s = data_str;
+  else m_fp << data_str << " ";
+}
+
+void Avida::Output::ColumnFile::Write(Apto::Array<int> list, const char* descr, const char* format)
+{
+  // Lists vary in length, so each is stored as the text it would have been written as
+  std::ostringstream text;
+  text.copyfmt(m_fp);
+  for (int i = 0; i < list.GetSize(); i++) text << list[i] << " ";
+
+  if (beginValue(descr, format)) pushValue(COL_TEXT).s = text.str();
+  else m_fp << text.str();
+}
+
+
+// Move any text written directly to the file stream into the current row, which from then on is stored as text
+void Avida::Output::ColumnFile::syncRaw()
+{
+  const std::string raw = m_raw.str();
+  if (raw.empty()) return;
+  m_raw.str("");
+
+  if (!m_line_is_text) {
+    m_line_text.clear();
+    for (int i = 0; i < m_row.GetSize(); i++) {
+      const Value& v = m_row[i];
+      m_line_text += formatValue(v.type, v.precision, v.flags, v.d, v.i, v.s);
+    }
+    m_row.Resize(0);
+    m_line_is_text = true;
+  }
+  m_line_text += raw;
+}
+
+
+void Avida::Output::ColumnFile::FlushComments()
+{
+  if (!m_descr_written) {
+    writeChunk('T', m_raw.str());
+    m_raw.str("");
+    writeChunk('T', std::string((const char*)m_descr));
+    m_descr = "";
+
+    m_descr_written = true;
+    assert(m_row.GetSize() == 0);
+  }
+}
+
+
+void Avida::Output::ColumnFile::Endl()
+{
+  if (!m_descr_written) {
+    std::string header(m_raw.str());
+    m_raw.str("");
+    if (m_filetype != "") header += std::string("#filetype ") + (const char*)m_filetype + "\n";
+    if (m_format != "") header += std::string("#format ") + (const char*)m_format + "\n";
+    header += (const char*)m_descr;
+    header += "\n";
+    writeChunk('T', header);
+    m_descr = "";
+
+    m_descr_written = true;
+  }
+
+  syncRaw();
+  if (m_line_is_text || m_row.GetSize() == 0) {
+    m_line_text += "\n";
+    flushRows();
+    writeChunk('T', m_line_text);
+    m_line_text.clear();
+    m_line_is_text = false;
+  } else {
+    addRow();
+  }
+}
+
+
+void Avida::Output::ColumnFile::addRow()
+{
+  // Start a new schema whenever the shape or formatting of the rows changes
+  bool matches = (m_row.GetSize() == m_schema.GetSize());
+  for (int i = 0; matches && i < m_row.GetSize(); i++) {
+    matches = (m_row[i].type == m_schema[i].type && m_row[i].precision == m_schema[i].precision &&
+               m_row[i].flags == m_schema[i].flags);
+  }
+
+  if (!matches) {
+    flushRows();
+    m_schema.Resize(m_row.GetSize());
+    m_col_data.Resize(m_row.GetSize());
+
+    std::string payload;
+    putBytes(payload, m_schema.GetSize(), 4);
+    for (int i = 0; i < m_schema.GetSize(); i++) {
+      m_schema[i].type = m_row[i].type;
+      m_schema[i].precision = m_row[i].precision;
+      m_schema[i].flags = m_row[i].flags;
+      m_schema[i].name = (i < m_col_names.GetSize()) ? m_col_names[i] : Apto::String("");
+      m_col_data[i].clear();
+
+      putBytes(payload, m_schema[i].type, 1);
+      putBytes(payload, static_cast<uint32_t>(m_schema[i].precision), 4);
+      putBytes(payload, m_schema[i].flags, 4);
+      putString(payload, m_schema[i].name, m_schema[i].name.GetSize());
+    }
+    writeChunk('S', payload);
+  }
+
+  for (int i = 0; i < m_row.GetSize(); i++) {
+    const Value& v = m_row[i];
+    putValue(m_col_data[i], v.type, v.d, v.i, v.s);
+  }
+  m_row.Resize(0);
+
+  if (++m_num_rows >= CHUNK_ROWS) flushRows();
+}
+
+
+void Avida::Output::ColumnFile::flushRows()
+{
+  if (m_num_rows == 0) return;
+
+  std::string payload;
+  putBytes(payload, m_num_rows, 4);
+  for (int i = 0; i < m_col_data.GetSize(); i++) {
+    putBytes(payload, m_col_data[i].size(), 8);
+    payload += m_col_data[i];
+    m_col_data[i].clear();
+  }
+  writeChunk('R', payload);
+  m_num_rows = 0;
+}
+
+
+void Avida::Output::ColumnFile::writeChunk(char tag, const std::string& payload)
+{
+  if (tag == 'T' && payload.empty()) return;
+
+  std::string chunk_header(1, tag);
+  putBytes(chunk_header, payload.size(), 8);
+  m_out.write(chunk_header.data(), chunk_header.size());
+  m_out.write(payload.data(), payload.size());
+  if (!m_out.good()) m_fp.setstate(std::ios::failbit);
+}
+
+
+void Avida::Output::ColumnFile::Flush()
+{
+  flushRows();
+
+  // Text written outside of any row (e.g. through OFStream()) must not wait for an Endl() that may never come
+  if (!m_descr_written) {
+    writeChunk('T', m_raw.str());
+    m_raw.str("");
+  } else {
+    syncRaw();
+    if (m_line_is_text) {
+      writeChunk('T', m_line_text);
+      m_line_text.clear();
+    }
+  }
+
+  m_out.flush();
+  if (m_write_buf) m_write_buf->Commit();
+}
+
+
+bool Avida::Output::ColumnFile::ConvertToText(std::istream& in, std::ostream& out)
+{
+  char magic[sizeof(COLUMN_FILE_MAGIC)];
+  in.read(magic, sizeof(magic));
+  if (!in.good() || memcmp(magic, COLUMN_FILE_MAGIC, sizeof(magic)) != 0) return false;
+
+  std::string header(4, '\0');
+  in.read(&header[0], 4);
+  if (!in.good()) return false;
+  const int version = static_cast<int>(ChunkReader(header).Get(4));
+  if (version < 1 || version > FORMAT_VERSION) return false;
+
+  // Chunk lengths come from the file, so they are checked against what remains of it before anything is allocated.
+  // Streams that cannot seek are read in bounded pieces instead, so that a bad length fails at the end of the input.
+  uint64_t remaining = 0;
+  bool seekable = false;
+  const std::streampos start = in.tellg();
+  if (start != std::streampos(-1)) {
+    in.seekg(0, std::ios::end);
+    const std::streampos end = in.tellg();
+    in.seekg(start);
+    if (!in.good()) return false;
+    if (end != std::streampos(-1) && end >= start) {
+      remaining = static_cast<uint64_t>(end - start);
+      seekable = true;
+    }
+  }
+
+  Apto::Array<ColumnSpec> schema;
+  std::string chunk_header(9, '\0');
+  std::string payload;
+  while (in.read(&chunk_header[0], 9)) {
+    ChunkReader header_reader(chunk_header);
+    const char tag = static_cast<char>(header_reader.Get(1));
+    const uint64_t length = header_reader.Get(8);
+    if (seekable) {
+      if (remaining < 9 || length > remaining - 9) return false;
+      remaining -= 9 + length;
+      payload.resize(static_cast<size_t>(length));
+      if (length && !in.read(&payload[0], static_cast<std::streamsize>(length))) return false;
+    } else {
+      if (length > static_cast<uint64_t>(payload.max_size())) return false;
+      payload.clear();
+      char block[65536];
+      for (uint64_t left = length; left > 0;) {
+        const std::streamsize count = static_cast<std::streamsize>((left < sizeof(block)) ? left : sizeof(block));
+        if (!in.read(block, count)) return false;
+        payload.append(block, static_cast<size_t>(count));
+        left -= static_cast<uint64_t>(count);
+      }
+    }
+
+    ChunkReader reader(payload);
+    switch (tag) {
+      case 'T':
+        out << payload;
+        break;
+
+      case 'S':
+      {
+        // Every column spec takes at least 13 bytes, which bounds the column count by the payload size
+        const int num_cols = static_cast<int>(reader.Get(4));
+        if (!reader.OK() || num_cols < 0 || static_cast<uint64_t>(num_cols) * 13 > payload.size()) return false;
+        schema.Resize(num_cols);
+        for (int i = 0; i < num_cols; i++) {
+          schema[i].type = static_cast<int>(reader.Get(1));
+          schema[i].precision = static_cast<int>(static_cast<uint32_t>(reader.Get(4)));
+          schema[i].flags = static_cast<unsigned int>(reader.Get(4));
+          schema[i].name = reader.GetString().c_str();
+        }
+        if (!reader.OK()) return false;
+      }
+        break;
+
+      case 'R':
+      {
+        // Decode each column in turn, then emit the rows
+        // Every value takes at least 4 bytes, which bounds the cell count by the payload size.  Rows are never written
+        // without a schema of at least one column.
+        const int num_rows = static_cast<int>(reader.Get(4));
+        if (!reader.OK() || num_rows < 0 || (num_rows > 0 && schema.GetSize() == 0)) return false;
+        if (static_cast<uint64_t>(num_rows) * schema.GetSize() * 4 > payload.size()) return false;
+        Apto::Array<std::string> cells(num_rows * schema.GetSize());
+        for (int col = 0; col < schema.GetSize(); col++) {
+          const uint64_t col_length = reader.Get(8);
+          if (!reader.OK() || col_length > payload.size() - reader.Position()) return false;
+          const size_t col_end = reader.Position() + static_cast<size_t>(col_length);
+          for (int row = 0; row < num_rows; row++) {
+            double d = 0.0;
+            int64_t i = 0;
+            std::string s;
+            if (schema[col].type == COL_DOUBLE) {
+              const uint64_t bits = reader.Get(8);
+              memcpy(&d, &bits, sizeof(d));
+            } else if (schema[col].type == COL_INT) {
+              i = static_cast<int64_t>(reader.Get(8));
+            } else {
+              s = reader.GetString();
+            }
+            cells[row * schema.GetSize() + col] = formatValue(schema[col].type, schema[col].precision, schema[col].flags, d, i, s);
+          }
+          if (!reader.OK() || reader.Position() != col_end) return false;
+        }
+        if (!reader.OK()) return false;
+
+        for (int row = 0; row < num_rows; row++) {
+          for (int col = 0; col < schema.GetSize(); col++) out << cells[row * schema.GetSize() + col];
+          out << "\n";
+        }
+      }
+        break;
+
+      default:
+        // Unknown chunks are skipped, so that later versions may add them
+        break;
+    }
+  }
+
+  return in.eof();
+}
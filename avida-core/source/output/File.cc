@@ -25,7 +25,9 @@
 #include "avida/output/File.h"
 
 #include "avida/core/Feedback.h"
+#include "avida/output/ColumnFile.h"
 #include "avida/output/Manager.h"
+#include "avida/private/output/Writer.h"
 
 #include <ctime>
 
@@ -45,7 +47,8 @@ Avida::Output::FilePtr Avida::Output::File::createWithPath(World* world, Apto::S
     return FilePtr(NULL);
   }
   
-  FilePtr rtn(new File(world, oid, append));
+  // Files selected for columnar output are always written anew, as column files cannot be appended to
+  FilePtr rtn((mgr->IsColumnar(oid)) ? new ColumnFile(world, oid) : new File(world, oid, append));
   
   if (!rtn->Good() || rtn->Fail()) {
     if (feedback) feedback->Error("unable to open file '%s' for writing", (const char*)oid);
@@ -91,11 +94,24 @@ Avida::Output::FilePtr Avida::Output::File::StaticWithPath(World* world, Apto::S
 Avida::Output::File::File(World* world, const OutputID& name, bool append)
   : Socket(world, name), m_descr_written(false), m_num_cols(0)
 {
-  m_fp.open(name, (append) ? (std::ios::out | std::ios::app) : std::ios::out);
+  const std::ios::openmode mode = (append) ? (std::ios::out | std::ios::app) : std::ios::out;
+  m_write_buf = Output::Manager::Of(world)->OpenBuffered(name, mode);
+  if (m_write_buf) m_fp.std::ios::rdbuf(m_write_buf);
+  else m_fp.open(name, mode);
   assert(m_fp.good());
 }
 
-Avida::Output::File::~File() { ; }
+Avida::Output::File::File(World* world, const OutputID& name, std::streambuf* capture_buf)
+  : Socket(world, name), m_descr_written(false), m_num_cols(0), m_write_buf(NULL)
+{
+  m_fp.std::ios::rdbuf(capture_buf);
+}
+
+Avida::Output::File::~File()
+{
+  // Deleting the buffer hands its remaining text to the writer thread
+  delete m_write_buf;
+}
 
 
 
@@ -255,4 +271,5 @@ void Avida::Output::File::Endl()
 void Avida::Output::File::Flush()
 {
   m_fp.flush();
+  if (m_write_buf) m_write_buf->Commit();
 }
@@ -25,6 +25,7 @@
 #include "avida/output/Manager.h"
 
 #include "avida/output/Socket.h"
+#include "avida/private/output/Writer.h"
 
 Avida::Output::Manager::Manager(const Apto::String& output_path) : m_world(NULL)
 {
@@ -40,7 +41,11 @@ Avida::Output::Manager::Manager(const Apto::String& output_path) : m_world(NULL)
   }
 }
 
-Avida::Output::Manager::~Manager() { ; }
+Avida::Output::Manager::~Manager()
+{
+  // Files that outlive the manager write out whatever they still hold on their own
+  StopWriter();
+}
 
 
 Avida::Output::OutputID Avida::Output::Manager::OutputIDFromPath(Apto::String path) const
@@ -115,6 +120,58 @@ void Avida::Output::Manager::FlushAll()
 }
 
 
+void Avida::Output::Manager::SetColumnar(const OutputID& output_id, bool columnar)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (columnar) m_columnar.Set(output_id, true);
+  else m_columnar.Remove(output_id);
+}
+
+bool Avida::Output::Manager::IsColumnar(const OutputID& output_id) const
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_columnar.Has(output_id);
+}
+
+
+void Avida::Output::Manager::StartWriter(int max_blocks)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (m_writer) return;
+  m_writer = WriterPtr(new Writer(max_blocks));
+  m_writer->Start();
+}
+
+void Avida::Output::Manager::StopWriter()
+{
+  m_mutex.Lock();
+  WriterPtr writer = m_writer;
+  m_writer = WriterPtr();
+  m_mutex.Unlock();
+  
+  // Files still open keep a reference to the writer, and write directly once it has stopped
+  if (writer) writer->Stop();
+}
+
+void Avida::Output::Manager::DrainWriter()
+{
+  FlushAll();
+  
+  m_mutex.Lock();
+  WriterPtr writer = m_writer;
+  m_mutex.Unlock();
+  
+  if (writer) writer->Drain();
+}
+
+Avida::Output::WriteBuffer* Avida::Output::Manager::OpenBuffered(const OutputID& output_id, std::ios::openmode mode)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (!m_writer) return NULL;
+  return m_writer->Open(output_id, mode);
+}
+
+
 bool Avida::Output::Manager::AttachTo(World* world)
 {
   if (m_world) return false;
@@ -0,0 +1,224 @@
+/*
+ *  output/Writer.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/private/output/Writer.h"
+
+
+Avida::Output::Writer::Writer(int max_blocks)
+  : m_ring((max_blocks > 0) ? max_blocks : 1), m_head(0), m_count(0), m_busy(false), m_terminate(false), m_stopped(false)
+{
+}
+
+Avida::Output::Writer::~Writer()
+{
+  Stop();
+}
+
+
+Avida::Output::WriteBuffer* Avida::Output::Writer::Open(const OutputID& path, std::ios::openmode mode)
+{
+  SinkPtr sink(new Sink);
+  if (!sink->file.open(path, mode | std::ios::out)) return NULL;
+
+  AddReference();  // explictly add reference, since this is internally creating a smart pointer to itself
+  WriteBuffer* buffer = new WriteBuffer(WriterPtr(this), sink);
+
+  m_mutex.Lock();
+  m_buffers.Push(buffer);
+  m_mutex.Unlock();
+
+  return buffer;
+}
+
+
+void Avida::Output::Writer::Drain()
+{
+  // Committed text that found the ring full is still held by its buffer, and is handed off now, waiting for space
+  m_mutex.Lock();
+  Apto::Array<WriteBuffer*> buffers(m_buffers);
+  m_mutex.Unlock();
+  for (int i = 0; i < buffers.GetSize(); i++) buffers[i]->handoff(true);
+
+  m_mutex.Lock();
+  while (m_count > 0 || m_busy) m_space_cond.Wait(m_mutex);
+  m_mutex.Unlock();
+}
+
+void Avida::Output::Writer::Stop()
+{
+  m_mutex.Lock();
+  if (m_stopped) {
+    m_mutex.Unlock();
+    return;
+  }
+  m_terminate = true;
+  m_mutex.Unlock();
+
+  // The writer thread only exits once the ring is empty
+  m_cond.Signal();
+  Join();
+
+  m_mutex.Lock();
+  m_stopped = true;
+  m_mutex.Unlock();
+}
+
+
+void Avida::Output::Writer::release(WriteBuffer* buffer)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  for (int i = 0; i < m_buffers.GetSize(); i++) {
+    if (m_buffers[i] == buffer) {
+      m_buffers[i] = m_buffers[m_buffers.GetSize() - 1];
+      m_buffers.Resize(m_buffers.GetSize() - 1);
+      break;
+    }
+  }
+}
+
+
+bool Avida::Output::Writer::push(SinkPtr sink, std::string& data, bool flush, bool wait)
+{
+  m_mutex.Lock();
+  if (m_stopped) {
+    m_mutex.Unlock();
+    write(*sink, data, flush);
+    data.clear();
+    return true;
+  }
+
+  while (m_count == m_ring.GetSize()) {
+    if (!wait) {
+      m_mutex.Unlock();
+      return false;
+    }
+    m_space_cond.Wait(m_mutex);
+  }
+
+  // Swapping hands over the buffered text without copying it
+  Block& block = m_ring[(m_head + m_count) % m_ring.GetSize()];
+  block.sink = sink;
+  block.data.swap(data);
+  block.flush = flush;
+  m_count++;
+  m_mutex.Unlock();
+
+  m_cond.Signal();
+  data.clear();
+  return true;
+}
+
+
+void Avida::Output::Writer::write(Sink& sink, const std::string& data, bool flush)
+{
+  if (data.size()) sink.file.sputn(data.data(), data.size());
+  if (flush) sink.file.pubsync();
+}
+
+
+void Avida::Output::Writer::Run()
+{
+  std::string data;
+
+  m_mutex.Lock();
+  while (true) {
+    while (!m_terminate && m_count == 0) m_cond.Wait(m_mutex);
+    if (m_count == 0) break;
+
+    Block& block = m_ring[m_head];
+    SinkPtr sink = block.sink;
+    block.sink = SinkPtr();
+    data.swap(block.data);
+    const bool flush = block.flush;
+    m_head = (m_head + 1) % m_ring.GetSize();
+    m_count--;
+    m_busy = true;
+    m_mutex.Unlock();
+
+    write(*sink, data, flush);
+    data.clear();
+    sink = SinkPtr();  // the last block of a released file closes it here, off the simulation thread
+
+    m_mutex.Lock();
+    m_busy = false;
+    m_space_cond.Broadcast();
+  }
+  m_mutex.Unlock();
+}
+
+
+
+Avida::Output::WriteBuffer::WriteBuffer(WriterPtr writer, Writer::SinkPtr sink)
+  : m_writer(writer), m_sink(sink), m_flush_pending(false)
+{
+  setp(m_put, m_put + sizeof(m_put));
+}
+
+Avida::Output::WriteBuffer::~WriteBuffer()
+{
+  m_writer->release(this);
+
+  // The buffer is going away, so the last of its text must be handed off even if that means waiting on the writer
+  collect();
+  m_flush_pending = true;
+  handoff(true);
+}
+
+
+void Avida::Output::WriteBuffer::Commit()
+{
+  collect();
+  m_flush_pending = true;
+  handoff(false);
+}
+
+
+Avida::Output::WriteBuffer::int_type Avida::Output::WriteBuffer::overflow(int_type c)
+{
+  collect();
+  if (!traits_type::eq_int_type(c, traits_type::eof())) m_data += traits_type::to_char_type(c);
+  if (m_data.size() >= static_cast<size_t>(Writer::BLOCK_SIZE)) handoff(false);
+  return traits_type::not_eof(c);
+}
+
+int Avida::Output::WriteBuffer::sync()
+{
+  // Only collects, so that flushing the stream (e.g. std::endl after every row) does not hand off a block per row
+  collect();
+  return 0;
+}
+
+
+void Avida::Output::WriteBuffer::collect()
+{
+  if (pptr() > pbase()) m_data.append(pbase(), pptr() - pbase());
+  setp(m_put, m_put + sizeof(m_put));
+}
+
+void Avida::Output::WriteBuffer::handoff(bool wait)
+{
+  if (m_data.empty() && !m_flush_pending) return;
+
+  // Text that cannot be handed off yet simply keeps accumulating (along with any requested flush), until it grows
+  // large enough to wait on the writer
+  if (m_data.size() >= static_cast<size_t>(Writer::MAX_PENDING)) wait = true;
+  if (m_writer->push(m_sink, m_data, m_flush_pending, wait)) m_flush_pending = false;
+}
@@ -29,6 +29,7 @@
 
 #include "avida/private/systematics/GenotypeArbiter.h"
 
+#include "cCheckpoint.h"
 #include "cHardwareManager.h"
 #include "cStringList.h"
 #include "cStringUtil.h"
@@ -130,8 +131,10 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
   , m_mgr(mgr)
   , m_handle(NULL)
   , m_src(founder->UnitSource())
-  , m_genome(founder->UnitGenome())
-  , m_name("001-no_name")
+  , m_live(new LiveState(founder->UnitGenome(), mgr->NumEnvironmentActionTriggers()))
+  , m_record(-1)
+  , m_length(0)
+  , m_name_num(-1)
   , m_threshold(false)
   , m_active(true)
   , m_generation_born(founder->Properties().Get("generation").IntValue())
@@ -142,10 +145,10 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
   , m_num_organisms(1)
   , m_last_num_organisms(0)
   , m_total_organisms(1)
+  , m_jump(NULL)
   , m_last_birth_cell(0)
   , m_last_group_id(-1)
   , m_last_forager_type(-1)
-  , m_task_counts(mgr->NumEnvironmentActionTriggers())
   , m_prop_map(NULL)
 {
   AddActiveReference();
@@ -157,8 +160,6 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
       assert(p);
       m_parents[i] = p;
       m_parents[i]->AddPassiveReference();
-      if (i > 0) m_parent_str += ",";
-      m_parent_str += Apto::AsStr(m_parents[i]->ID());
       
 //      m_copied_size.Add(p->Properties().Get(s_prop_name_ave_copy_size));
 //      m_exe_size.Add(p->Properties().Get(s_prop_name_ave_exe_size));
@@ -174,12 +175,13 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
     }
   }
   if (m_parents.GetSize()) m_depth = m_parents[0]->Depth() + 1;
-  if (!m_src.external) m_breed_in.Inc();
+  setupJump();
+  if (!m_src.external) m_live->breed_in.Inc();
   
-  InstructionSequencePtr seq;
-  seq.DynamicCastFrom(m_genome.Representation());
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(m_live->genome.Representation());
   assert(seq);
-  m_name = Apto::FormatStr("%03d-no_name", seq->GetSize());
+  m_length = seq->GetSize();
 }
 
 
@@ -187,7 +189,10 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 : Group(in_id)
 , m_mgr(mgr)
 , m_handle(NULL)
-, m_name("001-no_name")
+, m_live(NULL)
+, m_record(-1)
+, m_length(0)
+, m_name_num(-1)
 , m_threshold(false)
 , m_active(false)
 , m_update_born(-1)
@@ -197,10 +202,10 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 , m_num_organisms(0)
 , m_last_num_organisms(0)
 , m_total_organisms(0)
+, m_jump(NULL)
 , m_last_birth_cell(0)
 , m_last_group_id(-1)
 , m_last_forager_type(-1)
-, m_task_counts(mgr->NumEnvironmentActionTriggers())
 , m_prop_map(NULL)
 {
   Apto::Map<Apto::String, Apto::String>& props = *(*static_cast<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> >*>(prop_p));
@@ -215,7 +220,10 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
   if (inst_set == "") inst_set = "(default)";
   
   cHardwareManager::SetupPropertyMap(prop_map, (const char*)inst_set);
-  m_genome = Avida::Genome(Apto::StrAs(props.Get("hw_type")), prop_map, GeneticRepresentationPtr(new InstructionSequence((const char*)props.Get("sequence"))));
+  InstructionSequence* seq = new InstructionSequence((const char*)props.Get("sequence"));
+  m_length = seq->GetSize();
+  m_live = new LiveState(Avida::Genome(Apto::StrAs(props.Get("hw_type")), prop_map, GeneticRepresentationPtr(seq)),
+                         mgr->NumEnvironmentActionTriggers());
   
   if (props.Has("gen_born")) {
     m_generation_born = Apto::StrAs(props.Get("gen_born"));
@@ -232,13 +240,14 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
   assert(props.Has("depth"));
   m_depth = Apto::StrAs(props.Get("depth"));
   
+  Apto::String parent_str;
   if (props.Has("parents")) {
-    m_parent_str = (const char*)props.Get("parents");
+    parent_str = props.Get("parents");
   } else if (props.Has("parent_id")) { // Backwards compatible load
-    m_parent_str = (const char*)props.Get("parent_id");
+    parent_str = props.Get("parent_id");
   }
-  if (m_parent_str == "(none)") m_parent_str = "";
-  cStringList parents((const char*)m_parent_str,',');
+  if (parent_str == "(none)") parent_str = "";
+  cStringList parents((const char*)parent_str,',');
   
   m_parents.Resize(parents.GetSize());
   for (int i = 0; i < m_parents.GetSize(); i++) {
@@ -248,12 +257,54 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
     assert(m_parents[i]);
     m_parents[i]->AddPassiveReference();
   }
+  setupJump();
+}
+
+
+Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, const Genome& genome, const Source& src,
+                                       const Apto::Array<GenotypePtr>& parents)
+: Group(in_id)
+, m_mgr(mgr)
+, m_handle(NULL)
+, m_src(src)
+, m_live(new LiveState(genome, mgr->NumEnvironmentActionTriggers()))
+, m_record(-1)
+, m_length(0)
+, m_name_num(-1)
+, m_threshold(false)
+, m_active(false)
+, m_generation_born(-1)
+, m_update_born(-1)
+, m_update_deactivated(-1)
+, m_depth(0)
+, m_active_offspring_genotypes(0)
+, m_num_organisms(0)
+, m_last_num_organisms(0)
+, m_total_organisms(0)
+, m_parents(parents)
+, m_jump(NULL)
+, m_last_birth_cell(0)
+, m_last_group_id(-1)
+, m_last_forager_type(-1)
+, m_prop_map(NULL)
+{
+  // Restored from a checkpoint, the remaining state follows in Checkpoint() once the organisms have been reinjected
+  for (int i = 0; i < m_parents.GetSize(); i++) m_parents[i]->AddPassiveReference();
+  if (m_parents.GetSize()) m_depth = m_parents[0]->Depth() + 1;
+  setupJump();
+  
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(m_live->genome.Representation());
+  assert(seq);
+  m_length = seq->GetSize();
 }
 
 
 Avida::Systematics::Genotype::~Genotype()
 {  
   delete m_prop_map;
+  delete m_live;
+  if (m_record >= 0) m_mgr->m_store.Remove(m_record);
 }
 
 Avida::Systematics::RoleID Avida::Systematics::Genotype::Role() const
@@ -269,10 +320,10 @@ Avida::Systematics::ArbiterPtr Avida::Systematics::Genotype::Arbiter() const
 
 Avida::Systematics::GroupPtr Avida::Systematics::Genotype::ClassifyNewUnit(UnitPtr u, ConstGroupMembershipPtr parents)
 {
-  m_births.Inc();
+  m_live->births.Inc();
   
   if (Matches(u)) {
-    m_breed_true.Inc();
+    m_live->breed_true.Inc();
     m_total_organisms++;
     m_num_organisms++;
     
@@ -282,33 +333,33 @@ Avida::Systematics::GroupPtr Avida::Systematics::Genotype::ClassifyNewUnit(UnitP
     return g;
   }  
   
-  m_breed_out.Inc();
+  m_live->breed_out.Inc();
   return m_mgr->ClassifyNewUnit(u, parents);
 }
 
 void Avida::Systematics::Genotype::HandleUnitGestation(UnitPtr u)
 {
-  m_gestation_count.Inc();
+  m_live->gestation_count.Inc();
   
-  m_copied_size.Add(u->Properties().Get(s_unit_prop_name_last_copied_size));
-  m_exe_size.Add(u->Properties().Get(s_unit_prop_name_last_executed_size));
+  m_live->copied_size.Add(u->Properties().Get(s_unit_prop_name_last_copied_size));
+  m_live->exe_size.Add(u->Properties().Get(s_unit_prop_name_last_executed_size));
   
   double last_gestation_time = u->Properties().Get(s_unit_prop_name_last_gestation_time);
-  m_gestation_time.Add(last_gestation_time);
-  m_repro_rate.Add(1.0 / last_gestation_time);
-  m_merit.Add(u->Properties().Get(s_unit_prop_name_last_metabolic_rate));
-  m_fitness.Add(u->Properties().Get(s_unit_prop_name_last_fitness));
+  m_live->gestation_time.Add(last_gestation_time);
+  m_live->repro_rate.Add(1.0 / last_gestation_time);
+  m_live->merit.Add(u->Properties().Get(s_unit_prop_name_last_metabolic_rate));
+  m_live->fitness.Add(u->Properties().Get(s_unit_prop_name_last_fitness));
 
   // Collect all relevant action trigger counts
 //  for (int i = 0; i < m_mgr->EnvironmentActionTriggerCountIDs().GetSize(); i++) {
-//    m_task_counts[i].Add(static_cast<int>(u->Properties().Get(m_mgr->EnvironmentActionTriggerCountIDs()[i])));
+//    m_live->task_counts[i].Add(static_cast<int>(u->Properties().Get(m_mgr->EnvironmentActionTriggerCountIDs()[i])));
 //  }
 }
 
 
 void Avida::Systematics::Genotype::RemoveUnit()
 {
-  m_deaths.Inc();
+  m_live->deaths.Inc();
   
   // Remove active reference
   m_a_refs--;
@@ -350,31 +401,36 @@ bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
   
   df.Write(m_src.arguments.GetSize() ? (const char*)m_src.arguments : "(none)", "Source Args", "src_args");
   
-  cString str("");
-  if (m_parents.GetSize()) {
-    str += cStringUtil::Stringf("%d", m_parents[0]->ID());
-    for (int i = 1; i < m_parents.GetSize(); i++) {
-      str += cStringUtil::Stringf(",%d", m_parents[i]->ID());
-    }
-  }
-  df.Write((str.GetSize()) ? str : "(none)", "Parent ID(s)", "parents");
+  const Apto::String parents = parentString();
+  df.Write((parents.GetSize()) ? (const char*)parents : "(none)", "Parent ID(s)", "parents");
   
   df.Write(m_num_organisms, "Number of currently living organisms", "num_units");
   df.Write(m_total_organisms, "Total number of organisms that ever existed", "total_units");
   
-  ConstInstructionSequencePtr seq;
-  seq.DynamicCastFrom(m_genome.Representation());
-  df.Write(seq->GetSize(), "Genome Length", "length");
+  df.Write(m_length, "Genome Length", "length");
   
-  df.Write(m_merit.Average(), "Average Merit", "merit");
-  df.Write(m_gestation_time.Average(), "Average Gestation Time", "gest_time");
-  df.Write(m_fitness.Average(), "Average Fitness", "fitness");
+  if (m_live) {
+    df.Write(m_live->merit.Average(), "Average Merit", "merit");
+    df.Write(m_live->gestation_time.Average(), "Average Gestation Time", "gest_time");
+    df.Write(m_live->fitness.Average(), "Average Fitness", "fitness");
+  } else {
+    const HistoricStore& store = m_mgr->m_store;
+    df.Write(store.Stat(m_record, HistoricStore::STAT_MERIT), "Average Merit", "merit");
+    df.Write(store.Stat(m_record, HistoricStore::STAT_GESTATION_TIME), "Average Gestation Time", "gest_time");
+    df.Write(store.Stat(m_record, HistoricStore::STAT_FITNESS), "Average Fitness", "fitness");
+  }
   
   df.Write(m_generation_born, "Generation Born", "gen_born");
   df.Write(m_update_born, "Update Born", "update_born");
   df.Write(m_update_deactivated, "Update Deactivated", "update_deactivated");
   df.Write(m_depth, "Phylogenetic Depth", "depth");
-  m_genome.LegacySave(dfp);
+  if (m_live) {
+    m_live->genome.LegacySave(dfp);
+  } else {
+    Genome genome;
+    decodeGenome(genome);
+    genome.LegacySave(dfp);
+  }
   
   return false;
 }
@@ -440,7 +496,8 @@ bool Avida::Systematics::Genotype::Matches(UnitPtr u)
   }
   
   // Compare the genomes
-  return (m_genome == u->UnitGenome());
+  assert(m_live);
+  return (m_live->genome == u->UnitGenome());
 }
 
 void Avida::Systematics::Genotype::NotifyNewUnit(UnitPtr u)
@@ -451,7 +508,7 @@ void Avida::Systematics::Genotype::NotifyNewUnit(UnitPtr u)
       case DIVISION:
       case HORIZONTAL:
       case VERTICAL:
-        m_breed_in.Inc();
+        m_live->breed_in.Inc();
         break;
         
       default:
@@ -469,12 +526,126 @@ void Avida::Systematics::Genotype::NotifyNewUnit(UnitPtr u)
 void Avida::Systematics::Genotype::UpdateReset()
 {
   m_last_num_organisms = m_num_organisms;
-  m_births.Next();
-  m_deaths.Next();
-  m_breed_out.Next();
-  m_breed_true.Next();
-  m_breed_in.Next();
-  m_gestation_count.Next();
+  m_live->births.Next();
+  m_live->deaths.Next();
+  m_live->breed_out.Next();
+  m_live->breed_true.Next();
+  m_live->breed_in.Next();
+  m_live->gestation_count.Next();
+}
+
+
+void Avida::Systematics::Genotype::Freeze()
+{
+  if (!m_live) return;
+  
+  HistoricStore& store = m_mgr->m_store;
+  if (m_record < 0) {
+    // Only encode against a parent that is already frozen, since its own chain of deltas can no longer change
+    GenotypePtr parent = (m_parents.GetSize()) ? m_parents[0] : GenotypePtr(NULL);
+    if (parent && parent->m_record >= 0 && store.Chain(parent->m_record) < HistoricStore::MAX_CHAIN) {
+      Genome base;
+      parent->decodeGenome(base);
+      m_record = store.Add(m_live->genome, &base, parent->m_record);
+    } else {
+      m_record = store.Add(m_live->genome);
+    }
+  }
+  
+  store.SetStat(m_record, HistoricStore::STAT_COPIED_SIZE, m_live->copied_size.Average());
+  store.SetStat(m_record, HistoricStore::STAT_EXE_SIZE, m_live->exe_size.Average());
+  store.SetStat(m_record, HistoricStore::STAT_GESTATION_TIME, m_live->gestation_time.Average());
+  store.SetStat(m_record, HistoricStore::STAT_REPRO_RATE, m_live->repro_rate.Average());
+  store.SetStat(m_record, HistoricStore::STAT_MERIT, m_live->merit.Average());
+  store.SetStat(m_record, HistoricStore::STAT_FITNESS, m_live->fitness.Average());
+  store.SetStat(m_record, HistoricStore::STAT_MAX_FITNESS, m_live->fitness.Max());
+  store.SetTotalGestation(m_record, m_live->gestation_count.GetTotal());
+  
+  // The property map references the live state, so it must go with it
+  delete m_prop_map;
+  m_prop_map = NULL;
+  delete m_live;
+  m_live = NULL;
+}
+
+void Avida::Systematics::Genotype::Thaw()
+{
+  if (m_live) return;
+  
+  // The record is kept, as the genomes of descendants may be encoded against it
+  Genome genome;
+  decodeGenome(genome);
+  m_live = new LiveState(genome, m_mgr->NumEnvironmentActionTriggers());
+  
+  // Carry on from the summary the record holds, so that freezing again does not lose the earlier gestations.  Each
+  // average goes back in as one entry weighted by those gestations; the zero weight entry only restores the maximum.
+  HistoricStore& store = m_mgr->m_store;
+  const int total_gestation = store.TotalGestation(m_record);
+  if (total_gestation > 0) {
+    m_live->gestation_count.AddTotal(total_gestation);
+    m_live->copied_size.Add(store.Stat(m_record, HistoricStore::STAT_COPIED_SIZE), total_gestation);
+    m_live->exe_size.Add(store.Stat(m_record, HistoricStore::STAT_EXE_SIZE), total_gestation);
+    m_live->gestation_time.Add(store.Stat(m_record, HistoricStore::STAT_GESTATION_TIME), total_gestation);
+    m_live->repro_rate.Add(store.Stat(m_record, HistoricStore::STAT_REPRO_RATE), total_gestation);
+    m_live->merit.Add(store.Stat(m_record, HistoricStore::STAT_MERIT), total_gestation);
+    m_live->fitness.Add(store.Stat(m_record, HistoricStore::STAT_FITNESS), total_gestation);
+    m_live->fitness.Add(store.Stat(m_record, HistoricStore::STAT_MAX_FITNESS), 0.0);
+  }
+  
+  delete m_prop_map;
+  m_prop_map = NULL;
+}
+
+
+void Avida::Systematics::Genotype::Checkpoint(cCheckpoint& ckpt)
+{
+  ckpt.Transfer(m_threshold);
+  ckpt.Transfer(m_name_num);
+  ckpt.Transfer(m_generation_born);
+  ckpt.Transfer(m_update_born);
+  ckpt.Transfer(m_update_deactivated);
+  ckpt.Transfer(m_active_offspring_genotypes);
+  ckpt.Transfer(m_last_num_organisms);
+  ckpt.Transfer(m_total_organisms);
+  ckpt.Transfer(m_last_birth_cell);
+  ckpt.Transfer(m_last_group_id);
+  ckpt.Transfer(m_last_forager_type);
+  
+  bool frozen = (m_live == NULL);
+  ckpt.Transfer(frozen);
+  if (!ckpt.IsOK()) return;
+  
+  if (frozen) {
+    // Frozen again on load, with the summary it held replacing the one taken from the empty live state
+    if (ckpt.IsLoading()) Freeze();
+    HistoricStore& store = m_mgr->m_store;
+    for (int i = 0; i < HistoricStore::NUM_STATS; i++) {
+      double value = store.Stat(m_record, (HistoricStore::Statistic)i);
+      ckpt.Transfer(value);
+      if (ckpt.IsLoading()) store.SetStat(m_record, (HistoricStore::Statistic)i, value);
+    }
+    int total_gestation = store.TotalGestation(m_record);
+    ckpt.Transfer(total_gestation);
+    if (ckpt.IsLoading()) store.SetTotalGestation(m_record, total_gestation);
+  } else {
+    ckpt.Transfer(m_live->births);
+    ckpt.Transfer(m_live->deaths);
+    ckpt.Transfer(m_live->breed_in);
+    ckpt.Transfer(m_live->breed_true);
+    ckpt.Transfer(m_live->breed_out);
+    ckpt.Transfer(m_live->gestation_count);
+    ckpt.Transfer(m_live->copied_size);
+    ckpt.Transfer(m_live->exe_size);
+    ckpt.Transfer(m_live->gestation_time);
+    ckpt.Transfer(m_live->repro_rate);
+    ckpt.Transfer(m_live->merit);
+    ckpt.Transfer(m_live->fitness);
+  }
+  
+  if (ckpt.IsLoading()) {
+    delete m_prop_map;
+    m_prop_map = NULL;
+  }
 }
 
 
@@ -488,46 +659,80 @@ void Avida::Systematics::Genotype::setupPropertyMap() const
 #define ADD_REF_PROP(NAME, TYPE, VAL) m_prop_map->Define(PropertyPtr(new ReferenceProperty<TYPE>(s_prop_name_ ## NAME, s_prop_desc_map, const_cast<TYPE&>(VAL))));
 #define ADD_STR_PROP(NAME, VAL) m_prop_map->Define(PropertyPtr(new StringProperty(s_prop_name_ ## NAME, s_prop_desc_map, VAL)));
   
-  ADD_FUN_PROP(genome, Apto::String, GetFunctor(&m_genome, &Genome::AsString));
+  ADD_FUN_PROP(genome, Apto::String, GetFunctor(this, &Genotype::genomeString));
   ADD_STR_PROP(src_transmission_type, (int)m_src.transmission_type);
-  ADD_REF_PROP(name, Apto::String, m_name);
-  ADD_REF_PROP(parents, Apto::String, m_parent_str);
+  ADD_FUN_PROP(name, Apto::String, GetFunctor(this, &Genotype::name));
+  ADD_FUN_PROP(parents, Apto::String, GetFunctor(this, &Genotype::parentString));
   ADD_REF_PROP(threshold, bool, m_threshold);
   ADD_REF_PROP(update_born, int, m_update_born);
   
-  ADD_FUN_PROP(ave_copy_size, double, GetFunctor(&m_copied_size, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_exe_size, double, GetFunctor(&m_exe_size, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_gestation_time, double, GetFunctor(&m_gestation_time, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_repro_rate, double, GetFunctor(&m_repro_rate, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_metabolic_rate, double, GetFunctor(&m_merit, &cDoubleSum::Average));
-  ADD_FUN_PROP(ave_fitness, double, GetFunctor(&m_fitness, &cDoubleSum::Average));
-
-  ADD_FUN_PROP(max_fitness, double, GetFunctor(&m_fitness, &cDoubleSum::Max));
-  
-  ADD_REF_PROP(recent_births, int, m_births.GetCur());
-  ADD_REF_PROP(recent_deaths, int, m_deaths.GetCur());
-  ADD_REF_PROP(recent_breed_true, int, m_breed_true.GetCur());
-  ADD_REF_PROP(recent_breed_in, int, m_breed_in.GetCur());
-  ADD_REF_PROP(recent_breed_out, int, m_breed_out.GetCur());
-  ADD_REF_PROP(recent_gestation_count, int, m_gestation_count.GetCur());
-  
   ADD_REF_PROP(total_organisms, int, m_total_organisms);
-  ADD_REF_PROP(last_births, int, m_births.GetLast());
-  ADD_REF_PROP(last_deaths, int, m_deaths.GetLast());
-  ADD_REF_PROP(last_breed_true, int, m_breed_true.GetLast());
-  ADD_REF_PROP(last_breed_in, int, m_breed_in.GetLast());
-  ADD_REF_PROP(last_breed_out, int, m_breed_out.GetLast());
-  ADD_REF_PROP(last_gestation_count, int, m_gestation_count.GetLast());
   
   ADD_REF_PROP(last_birth_cell, int, m_last_birth_cell);
   ADD_REF_PROP(last_group_id, int, m_last_group_id);
   ADD_REF_PROP(last_forager_type, int, m_last_forager_type);
-
-  ADD_REF_PROP(total_gestation_count, int, m_gestation_count.GetTotal());
-
-  // Collect all relevant action trigger counts
-  for (int i = 0; i < m_mgr->EnvironmentActionTriggerAverageIDs().GetSize(); i++) {
-    m_prop_map->Define(PropertyPtr(new FunctorProperty<double>(m_mgr->EnvironmentActionTriggerAverageIDs()[i], s_prop_desc_map, FunctorProperty<double>::GetFunctor(&m_task_counts[i], &Apto::Stat::Accumulator<int>::Mean))));
+  
+  if (m_live) {
+    ADD_FUN_PROP(ave_copy_size, double, GetFunctor(&m_live->copied_size, &cDoubleSum::Average));
+    ADD_FUN_PROP(ave_exe_size, double, GetFunctor(&m_live->exe_size, &cDoubleSum::Average));
+    ADD_FUN_PROP(ave_gestation_time, double, GetFunctor(&m_live->gestation_time, &cDoubleSum::Average));
+    ADD_FUN_PROP(ave_repro_rate, double, GetFunctor(&m_live->repro_rate, &cDoubleSum::Average));
+    ADD_FUN_PROP(ave_metabolic_rate, double, GetFunctor(&m_live->merit, &cDoubleSum::Average));
+    ADD_FUN_PROP(ave_fitness, double, GetFunctor(&m_live->fitness, &cDoubleSum::Average));
+
+    ADD_FUN_PROP(max_fitness, double, GetFunctor(&m_live->fitness, &cDoubleSum::Max));
+  
+    ADD_REF_PROP(recent_births, int, m_live->births.GetCur());
+    ADD_REF_PROP(recent_deaths, int, m_live->deaths.GetCur());
+    ADD_REF_PROP(recent_breed_true, int, m_live->breed_true.GetCur());
+    ADD_REF_PROP(recent_breed_in, int, m_live->breed_in.GetCur());
+    ADD_REF_PROP(recent_breed_out, int, m_live->breed_out.GetCur());
+    ADD_REF_PROP(recent_gestation_count, int, m_live->gestation_count.GetCur());
+  
+    ADD_REF_PROP(last_births, int, m_live->births.GetLast());
+    ADD_REF_PROP(last_deaths, int, m_live->deaths.GetLast());
+    ADD_REF_PROP(last_breed_true, int, m_live->breed_true.GetLast());
+    ADD_REF_PROP(last_breed_in, int, m_live->breed_in.GetLast());
+    ADD_REF_PROP(last_breed_out, int, m_live->breed_out.GetLast());
+    ADD_REF_PROP(last_gestation_count, int, m_live->gestation_count.GetLast());
+
+    ADD_REF_PROP(total_gestation_count, int, m_live->gestation_count.GetTotal());
+
+    // Collect all relevant action trigger counts
+    for (int i = 0; i < m_mgr->EnvironmentActionTriggerAverageIDs().GetSize(); i++) {
+      m_prop_map->Define(PropertyPtr(new FunctorProperty<double>(m_mgr->EnvironmentActionTriggerAverageIDs()[i], s_prop_desc_map, FunctorProperty<double>::GetFunctor(&m_live->task_counts[i], &Apto::Stat::Accumulator<int>::Mean))));
+    }
+  } else {
+    // Frozen genotypes report the summary held in their record, and no recent activity
+    const HistoricStore& store = m_mgr->m_store;
+    ADD_STR_PROP(ave_copy_size, store.Stat(m_record, HistoricStore::STAT_COPIED_SIZE));
+    ADD_STR_PROP(ave_exe_size, store.Stat(m_record, HistoricStore::STAT_EXE_SIZE));
+    ADD_STR_PROP(ave_gestation_time, store.Stat(m_record, HistoricStore::STAT_GESTATION_TIME));
+    ADD_STR_PROP(ave_repro_rate, store.Stat(m_record, HistoricStore::STAT_REPRO_RATE));
+    ADD_STR_PROP(ave_metabolic_rate, store.Stat(m_record, HistoricStore::STAT_MERIT));
+    ADD_STR_PROP(ave_fitness, store.Stat(m_record, HistoricStore::STAT_FITNESS));
+    
+    ADD_STR_PROP(max_fitness, store.Stat(m_record, HistoricStore::STAT_MAX_FITNESS));
+    
+    ADD_STR_PROP(recent_births, 0);
+    ADD_STR_PROP(recent_deaths, 0);
+    ADD_STR_PROP(recent_breed_true, 0);
+    ADD_STR_PROP(recent_breed_in, 0);
+    ADD_STR_PROP(recent_breed_out, 0);
+    ADD_STR_PROP(recent_gestation_count, 0);
+    
+    ADD_STR_PROP(last_births, 0);
+    ADD_STR_PROP(last_deaths, 0);
+    ADD_STR_PROP(last_breed_true, 0);
+    ADD_STR_PROP(last_breed_in, 0);
+    ADD_STR_PROP(last_breed_out, 0);
+    ADD_STR_PROP(last_gestation_count, 0);
+    
+    ADD_STR_PROP(total_gestation_count, store.TotalGestation(m_record));
+    
+    for (int i = 0; i < m_mgr->EnvironmentActionTriggerAverageIDs().GetSize(); i++) {
+      m_prop_map->Define(PropertyPtr(new StringProperty(m_mgr->EnvironmentActionTriggerAverageIDs()[i], s_prop_desc_map, 0.0)));
+    }
   }
   
 #undef ADD_FUN_PROP
@@ -535,6 +740,91 @@ void Avida::Systematics::Genotype::setupPropertyMap() const
 #undef ADD_STR_PROP
 }
 
+void Avida::Systematics::Genotype::decodeGenome(Genome& genome) const
+{
+  if (m_live) {
+    genome = m_live->genome;
+    return;
+  }
+  
+  const HistoricStore& store = m_mgr->m_store;
+  if (store.IsDelta(m_record)) {
+    Genome base;
+    m_parents[0]->decodeGenome(base);
+    store.Decode(m_record, &base, genome);
+  } else {
+    store.Decode(m_record, NULL, genome);
+  }
+}
+
+
+void Avida::Systematics::Genotype::setupJump()
+{
+  // Skew-binary jump pointers (Myers, 1983): each genotype stores a single jump, either to its parent or to its parent's
+  // jump's jump, such that the jumps along any lineage reach a given depth in O(log depth) steps
+  m_jump = this;
+  if (!m_parents.GetSize()) return;
+  
+  Genotype* parent = &(*m_parents[0]);
+  Genotype* parent_jump = parent->m_jump;
+  if (parent_jump != parent && parent->m_depth - parent_jump->m_depth == parent_jump->m_depth - parent_jump->m_jump->m_depth) {
+    m_jump = parent_jump->m_jump;
+  } else {
+    m_jump = parent;
+  }
+}
+
+Avida::Systematics::Genotype* Avida::Systematics::Genotype::ancestorAtDepth(int depth)
+{
+  Genotype* g = this;
+  while (g->m_depth > depth) {
+    if (g->m_jump->m_depth >= depth && g->m_jump->m_depth < g->m_depth) {
+      g = g->m_jump;
+    } else if (g->m_parents.GetSize()) {
+      g = &(*g->m_parents[0]);
+    } else {
+      return NULL;
+    }
+  }
+  return (g->m_depth == depth) ? g : NULL;
+}
+
+
+Apto::String Avida::Systematics::Genotype::name() const
+{
+  if (m_name_num < 0) return Apto::FormatStr("%03d-no_name", m_length);
+  
+  int num = m_name_num;
+  char alpha[6];
+  for (int i = 4; i >= 0; i--) {
+    alpha[i] = (num % 26) + 'a';
+    num /= 26;
+  }
+  alpha[5] = '\0';
+  
+  return Apto::FormatStr("%03d-%s", m_length, alpha);
+}
+
+Apto::String Avida::Systematics::Genotype::parentString() const
+{
+  Apto::String str;
+  for (int i = 0; i < m_parents.GetSize(); i++) {
+    if (i > 0) str += ",";
+    str += Apto::AsStr(m_parents[i]->ID());
+  }
+  return str;
+}
+
+Apto::String Avida::Systematics::Genotype::genomeString() const
+{
+  if (m_live) return m_live->genome.AsString();
+  
+  Genome genome;
+  decodeGenome(genome);
+  return genome.AsString();
+}
+
+
 inline Avida::Systematics::GenotypePtr Avida::Systematics::Genotype::thisPtr()
 {
   AddReference(); // Explicitly add reference to internally created SmartPtr
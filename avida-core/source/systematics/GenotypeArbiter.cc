@@ -31,21 +31,27 @@
 
 #include "avida/private/systematics/Genotype.h"
 
+#include "cCheckpoint.h"
 #include "cDoubleSum.h"
 
+#include <algorithm>
 #include <cmath>
 
 
-Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class)
+Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID& role, int threshold, bool disable_class,
+                                                     const Apto::String& spill_path, int spill_mb)
   : Arbiter(role)
   , m_threshold(threshold)
   , m_disable_class(disable_class)
   , m_active_sz(1)
+  , m_store(spill_path, spill_mb)
   , m_coalescent(NULL)
+  , m_coalescent_floor(NULL)
   , m_best(0)
   , m_next_id(1)
   , m_dom_prev(-1)
   , m_dom_time(0)
+  , m_restoring(false)
   , m_cur_update(-1)
   , m_tot_genotypes(0)
   , m_coalescent_depth(-1)
@@ -86,16 +92,16 @@ void Avida::Systematics::GenotypeArbiter::PerformUpdate(Context&, Update current
 {
   m_cur_update = current_update + 1; // +1 since PerformUpdate happens at end of updates, but m_cur_update is used during
   
-  if (m_active_sz.GetSize() < HASH_SIZE) {
+  if (m_active_sz.GetSize() < m_active_hash.GetCapacity()) {
     for (int i = 0; i < m_active_sz.GetSize(); i++) {
       Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
       while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) (*list_it.Get())->UpdateReset();
     }
   } else {
-    for (int i = 0; i < HASH_SIZE; i++) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[i].Begin());
-      while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) (*list_it.Get())->UpdateReset();
-    }    
+    for (int i = 0; i < m_active_hash.GetCapacity(); i++) {
+      GenotypePtr genotype = m_active_hash.EntryAt(i);
+      if (genotype && genotype->IsThreshold()) genotype->UpdateReset();
+    }
   }
 
   Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
@@ -134,6 +140,8 @@ Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(voi
 {
   GenotypePtr g(new Genotype(thisPtr(), m_next_id++, props));
   m_historic.Push(g, &g->m_handle);
+  m_id_index.Insert(hashID(g->ID()), g);
+  g->Freeze();
   return g;
 }
 
@@ -141,15 +149,7 @@ Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(voi
 
 Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::Group(GroupID g_id)
 {
-  for (int i = m_best; i >= 0; i--) {
-    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
-    while (list_it.Next() != NULL) if ((*list_it.Get())->ID() == g_id) return *list_it.Get();
-  }
-  
-  Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-  while (list_it.Next() != NULL) if ((*list_it.Get())->ID() == g_id) return *list_it.Get();
-  
-  return GroupPtr(NULL);
+  return findGenotype(g_id);
 }
 
 
@@ -160,6 +160,204 @@ Avida::Systematics::Arbiter::IteratorPtr Avida::Systematics::GenotypeArbiter::Be
 }
 
 
+Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::AncestorAtDepth(GroupID g_id, int depth)
+{
+  GenotypePtr genotype = findGenotype(g_id);
+  if (!genotype) return GroupPtr(NULL);
+  
+  Genotype* ancestor = genotype->ancestorAtDepth(depth);
+  if (!ancestor) return GroupPtr(NULL);
+  
+  ancestor->AddReference(); // Explicitly add reference to internally created SmartPtr
+  return GroupPtr(ancestor);
+}
+
+bool Avida::Systematics::GenotypeArbiter::IsAncestor(GroupID ancestor_id, GroupID g_id)
+{
+  GenotypePtr ancestor = findGenotype(ancestor_id);
+  GenotypePtr genotype = findGenotype(g_id);
+  if (!ancestor || !genotype) return false;
+  
+  return (genotype->ancestorAtDepth(ancestor->Depth()) == &(*ancestor));
+}
+
+
+
+
+void Avida::Systematics::GenotypeArbiter::CheckpointLineage(cCheckpoint& ckpt)
+{
+  if (ckpt.IsLoading() && m_id_index.GetSize()) {
+    ckpt.Fail("genotypes remain after clearing the population");
+    return;
+  }
+  
+  ckpt.BeginSection("GLIN");
+  Apto::Array<int> ids;
+  if (!ckpt.IsLoading()) genotypeIDs(ids);
+  int num_genotypes = ids.GetSize();
+  ckpt.Transfer(num_genotypes);
+  ckpt.Transfer(m_next_id);
+  
+  // Every tracked genotype, active or historic, is recreated under its own ID, parents ahead of their offspring
+  for (int i = 0; i < num_genotypes && ckpt.IsOK(); i++) {
+    GenotypePtr g = (ckpt.IsLoading()) ? GenotypePtr(NULL) : findGenotype(ids[i]);
+    int g_id = (g) ? g->ID() : -1;
+    cString genome_str((g) ? (const char*)g->genomeString() : "");
+    int transmission_type = (g) ? (int)g->m_src.transmission_type : 0;
+    bool external = (g) ? g->m_src.external : false;
+    cString src_args((g) ? (const char*)g->m_src.arguments : "");
+    bool active = (g) ? g->IsActive() : false;
+    Apto::Array<int> parent_ids((g) ? g->m_parents.GetSize() : 0);
+    for (int p = 0; p < parent_ids.GetSize(); p++) parent_ids[p] = g->m_parents[p]->ID();
+    ckpt.Transfer(g_id);
+    ckpt.Transfer(genome_str);
+    ckpt.Transfer(transmission_type);
+    ckpt.Transfer(external);
+    ckpt.Transfer(src_args);
+    ckpt.Transfer(active);
+    ckpt.Transfer(parent_ids);
+    if (!ckpt.IsOK() || !ckpt.IsLoading()) continue;
+    
+    if (g_id <= 0 || g_id >= m_next_id || findGenotype(g_id)) {
+      ckpt.Fail("invalid genotype id");
+      break;
+    }
+    Apto::Array<GenotypePtr> parents(parent_ids.GetSize());
+    for (int p = 0; p < parents.GetSize(); p++) {
+      if (parent_ids[p] < g_id) parents[p] = findGenotype(parent_ids[p]);
+      if (!parents[p]) ckpt.Fail("invalid genotype parent");
+    }
+    Genome genome(Apto::String((const char*)genome_str));
+    ConstInstructionSequencePtr seq;
+    seq.DynamicCastFrom(genome.Representation());
+    if (!seq) ckpt.Fail("invalid genotype genome");
+    if (!ckpt.IsOK()) break;
+    
+    g = GenotypePtr(new Genotype(thisPtr(), g_id, genome, Source((TransmissionType)transmission_type,
+                                                                    Apto::String((const char*)src_args), external), parents));
+    m_id_index.Insert(hashID(g_id), g);
+    if (active) {
+      // Empty until its organisms are reinjected
+      g->Reactivate();
+      m_active_hash.Insert(hashGenome(*seq), g);
+      m_active_sz[0].PushRear(g, &g->m_handle);
+    } else {
+      m_historic.PushRear(g, &g->m_handle);
+    }
+  }
+  ckpt.EndSection();
+  
+  // Threshold status and names are restored with the rest of the state, rather than earned again during reinjection
+  if (ckpt.IsLoading() && ckpt.IsOK()) m_restoring = true;
+}
+
+
+void Avida::Systematics::GenotypeArbiter::CheckpointState(cCheckpoint& ckpt)
+{
+  ckpt.BeginSection("GSTA");
+  Apto::Array<int> ids;
+  if (!ckpt.IsLoading()) genotypeIDs(ids);
+  ckpt.Transfer(ids);
+  if (ckpt.IsOK() && ckpt.IsLoading() && ids.GetSize() != m_id_index.GetSize()) {
+    ckpt.Fail("organisms were classified outside of the checkpointed genotypes");
+  }
+  for (int i = 0; i < ids.GetSize() && ckpt.IsOK(); i++) {
+    GenotypePtr g = findGenotype(ids[i]);
+    if (!g) {
+      ckpt.Fail("unknown genotype");
+      break;
+    }
+    int num_units = g->NumUnits();
+    ckpt.Transfer(num_units);
+    if (ckpt.IsOK() && num_units != g->NumUnits()) {
+      ckpt.Fail("genotype abundance does not match its organisms");
+      break;
+    }
+    g->Checkpoint(ckpt);
+  }
+  
+  // List order decides the dominant genotype among equals and the order in which genotypes are saved
+  int num_sizes = m_active_sz.GetSize();
+  ckpt.Transfer(num_sizes);
+  if (ckpt.IsOK() && ckpt.IsLoading()) {
+    if (num_sizes < 1) ckpt.Fail("invalid genotype abundance lists");
+    else resizeActiveList(num_sizes - 1);
+  }
+  for (int i = 0; i < num_sizes && ckpt.IsOK(); i++) checkpointList(ckpt, m_active_sz[i], i);
+  checkpointList(ckpt, m_historic, -1);
+  
+  ckpt.Transfer(m_best);
+  ckpt.Transfer(m_dom_prev);
+  ckpt.Transfer(m_dom_time);
+  ckpt.Transfer(m_sz_count);
+  ckpt.Transfer(m_cur_update);
+  ckpt.Transfer(m_tot_genotypes);
+  ckpt.Transfer(m_num_genotypes);
+  ckpt.Transfer(m_num_historic_genotypes);
+  ckpt.Transfer(m_num_threshold);
+  ckpt.Transfer(m_tot_threshold);
+  ckpt.Transfer(m_coalescent_depth);
+  ckpt.Transfer(m_ave_age);
+  ckpt.Transfer(m_ave_abundance);
+  ckpt.Transfer(m_ave_depth);
+  ckpt.Transfer(m_ave_size);
+  ckpt.Transfer(m_ave_threshold_age);
+  ckpt.Transfer(m_stderr_age);
+  ckpt.Transfer(m_stderr_abundance);
+  ckpt.Transfer(m_stderr_depth);
+  ckpt.Transfer(m_stderr_size);
+  ckpt.Transfer(m_stderr_threshold_age);
+  ckpt.Transfer(m_var_age);
+  ckpt.Transfer(m_var_abundance);
+  ckpt.Transfer(m_var_depth);
+  ckpt.Transfer(m_var_size);
+  ckpt.Transfer(m_var_threshold_age);
+  ckpt.Transfer(m_entropy);
+  ckpt.Transfer(m_dom_id);
+  if (ckpt.IsOK() && ckpt.IsLoading() && (m_best < 0 || m_best >= m_active_sz.GetSize() ||
+                                          (m_best && !m_active_sz[m_best].GetSize()))) {
+    ckpt.Fail("invalid dominant genotype abundance");
+  }
+  
+  int coalescent_id = (m_coalescent) ? m_coalescent->ID() : -1;
+  int floor_id = (m_coalescent_floor) ? m_coalescent_floor->ID() : -1;
+  ckpt.Transfer(coalescent_id);
+  ckpt.Transfer(floor_id);
+  if (ckpt.IsOK() && ckpt.IsLoading()) {
+    m_coalescent = (coalescent_id >= 0) ? findGenotype(coalescent_id) : GenotypePtr(NULL);
+    m_coalescent_floor = (floor_id >= 0) ? findGenotype(floor_id) : GenotypePtr(NULL);
+    if ((coalescent_id >= 0 && !m_coalescent) || (floor_id >= 0 && !m_coalescent_floor)) {
+      ckpt.Fail("unknown coalescent genotype");
+    }
+  }
+  ckpt.EndSection();
+  
+  if (ckpt.IsLoading()) m_restoring = false;
+}
+
+void Avida::Systematics::GenotypeArbiter::checkpointList(cCheckpoint& ckpt,
+                                                         Apto::List<GenotypePtr, Apto::SparseVector>& list, int num_units)
+{
+  Apto::Array<int> ids;
+  if (!ckpt.IsLoading()) {
+    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(list.Begin());
+    while (list_it.Next() != NULL) ids.Push((*list_it.Get())->ID());
+  }
+  ckpt.Transfer(ids);
+  if (!ckpt.IsOK() || !ckpt.IsLoading()) return;
+  
+  // Move each listed genotype to the back in turn, leaving the list in saved order (historic lists pass num_units -1)
+  for (int i = 0; i < ids.GetSize(); i++) {
+    GenotypePtr g = findGenotype(ids[i]);
+    if (!g || g->IsActive() != (num_units >= 0) || (num_units >= 0 && g->NumUnits() != num_units)) {
+      ckpt.Fail("genotype lists do not match");
+      return;
+    }
+    g->m_handle->Remove();
+    list.PushRear(g, &g->m_handle);
+  }
+  if (list.GetSize() != ids.GetSize()) ckpt.Fail("genotype lists do not match");
+}
 
 
 Avida::Data::ConstDataSetPtr Avida::Systematics::GenotypeArbiter::Provides() const
@@ -205,10 +403,7 @@ void Avida::Systematics::GenotypeArbiter::UpdateProvidedValues(Update current_up
       sum_abundance.Add(abundance);
       sum_depth.Add(bg->Depth(), abundance);
       
-      ConstInstructionSequencePtr seq;
-      seq.DynamicCastFrom(bg->GroupGenome().Representation());
-      assert(seq);
-      sum_size.Add(seq->GetSize(), abundance);
+      sum_size.Add(bg->GenomeLength(), abundance);
       
       // Calculate this genotype's contribution to entropy
       // - when p = 1.0, partial_ent calculation would return -0.0. This may propagate
@@ -283,7 +478,7 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   ConstInstructionSequencePtr seq;
   seq.DynamicCastFrom(u->UnitGenome().Representation());
   assert(seq);
-  int list_num = hashGenome(*seq);
+  const unsigned long long seq_hash = hashGenome(*seq);
   
   GenotypePtr found;
 
@@ -291,52 +486,42 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   if (hints && hints->Get("id", gid_str)) {
     int gid = Apto::StrAs(gid_str);
     
-    // Search all lists attempting to locate the referenced genotype by ID
-    for (int i = 0; i < m_active_sz.GetSize() && !found; i++) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
-      while (list_it.Next() != NULL) {
-        if ((*list_it.Get())->ID() == gid) {
-          found = *list_it.Get();
-          found->NotifyNewUnit(u);
-          break;
-        }
-      }
-    }
+    // Locate the referenced genotype by ID
+    found = findGenotype(gid);
     
-    if (!found) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-      while (list_it.Next() != NULL) {
-        if ((*list_it.Get())->ID() == gid) {
-          found = *list_it.Get();
-          seq.DynamicCastFrom(found->GroupGenome().Representation());
-          assert(seq);
-          
-          m_active_hash[hashGenome(*seq)].Push(found);
-          found->m_handle->Remove(); // Remove from historic list
-          resizeActiveList(found->NumUnits());
-          m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
-          found->Reactivate();
-          found->NotifyNewUnit(u);
-          m_tot_genotypes++;
-          if (found->NumUnits() > m_best) {
-            m_best = found->NumUnits();
-            found->SetThreshold();
-            found->SetName(nameGenotype(seq->GetSize()));
-            m_num_threshold++;
-            m_tot_threshold++;
-            notifyListeners(found, EVENT_ADD_THRESHOLD);
-          }          
-        }
+    if (found && found->IsActive()) {
+      found->NotifyNewUnit(u);
+    } else if (found) {
+      // Historic genotype, return it to the active set
+      found->Thaw();
+      m_coalescent_floor = GenotypePtr(NULL); // its lineage may once again hold the coalescent
+      seq.DynamicCastFrom(found->GroupGenome().Representation());
+      assert(seq);
+      
+      m_active_hash.Insert(hashGenome(*seq), found);
+      found->m_handle->Remove(); // Remove from historic list
+      resizeActiveList(found->NumUnits());
+      m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
+      found->Reactivate();
+      found->NotifyNewUnit(u);
+      m_tot_genotypes++;
+      if (found->NumUnits() > m_best) {
+        m_best = found->NumUnits();
+        found->SetThreshold();
+        found->SetName(nameGenotype(found->GenomeLength()));
+        m_num_threshold++;
+        m_tot_threshold++;
+        notifyListeners(found, EVENT_ADD_THRESHOLD);
       }
     }
   } 
   
   // No hints or unable to locate hinted genome, search for a matching genotype
   if (!found) {
-    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[list_num].Begin());
-    while (list_it.Next() != NULL) {
-      if ((*list_it.Get())->Matches(u)) {
-        found = *list_it.Get();
+    int slot = -1;
+    for (GenotypePtr genotype = m_active_hash.Find(seq_hash, slot); genotype; genotype = m_active_hash.Find(seq_hash, slot)) {
+      if (genotype->Matches(u)) {
+        found = genotype;
         found->NotifyNewUnit(u);
         break;
       }
@@ -350,16 +535,15 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
     } else {
       found = GenotypePtr(new Genotype(thisPtr(), m_next_id++, u, m_cur_update, ConstGroupMembershipPtr(NULL)));
     }
-    m_active_hash[list_num].Push(found);
+    m_active_hash.Insert(seq_hash, found);
+    m_id_index.Insert(hashID(found->ID()), found);
     resizeActiveList(found->NumUnits());
     m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
     m_tot_genotypes++;
     if (found->NumUnits() > m_best) {
       m_best = found->NumUnits();
       found->SetThreshold();
-      seq.DynamicCastFrom(found->GroupGenome().Representation());
-      assert(seq);
-      found->SetName(nameGenotype(seq->GetSize()));
+      found->SetName(nameGenotype(found->GenomeLength()));
       m_num_threshold++;
       m_tot_threshold++;
       notifyListeners(found, EVENT_ADD_THRESHOLD);
@@ -397,12 +581,9 @@ void Avida::Systematics::GenotypeArbiter::AdjustGenotype(GenotypePtr genotype, i
     if (new_size > m_best) m_best = new_size;
   }
   
-  if (!genotype->IsThreshold() && (new_size >= m_threshold || genotype == getBest())) {
+  if (!m_restoring && !genotype->IsThreshold() && (new_size >= m_threshold || genotype == getBest())) {
     genotype->SetThreshold();
-    ConstInstructionSequencePtr seq;
-    seq.DynamicCastFrom(genotype->GroupGenome().Representation());
-    assert(seq);
-    genotype->SetName(nameGenotype(seq->GetSize()));
+    genotype->SetName(nameGenotype(genotype->GenomeLength()));
     m_num_threshold++;
     m_tot_threshold++;
     notifyListeners(genotype, EVENT_ADD_THRESHOLD);
@@ -468,31 +649,48 @@ void Avida::Systematics::GenotypeArbiter::setupProvidedData(World* world)
 
 
 
-unsigned int Avida::Systematics::GenotypeArbiter::hashGenome(const InstructionSequence& genome) const
+unsigned long long Avida::Systematics::GenotypeArbiter::hashGenome(const InstructionSequence& genome) const
 {
-  unsigned int total = 0;
-  
+  // 64-bit FNV-1a over the instruction ops
+  unsigned long long hash = 14695981039346656037ULL;
   for (int i = 0; i < genome.GetSize(); i++) {
-    total += (genome[i].GetOp() + 3) * i;
+    hash ^= (unsigned long long)genome[i].GetOp();
+    hash *= 1099511628211ULL;
   }
   
-  return total % HASH_SIZE;
+  // Final avalanche so that the low bits used to index the table depend on the entire sequence
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return hash;
 }
 
-Apto::String Avida::Systematics::GenotypeArbiter::nameGenotype(int size)
+
+int Avida::Systematics::GenotypeArbiter::nameGenotype(int size)
 {
+  // Names are formatted on demand by the genotype, from its length and this sequence number
   if (m_sz_count.GetSize() <= size) m_sz_count.Resize(size + 1, 0);
-  int num = m_sz_count[size]++;
-  
-  char alpha[6];
-  
-  for (int i = 4; i >= 0; i--) {
-    alpha[i] = (num % 26) + 'a';
-    num /= 26;
+  return m_sz_count[size]++;
+}
+
+Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::findGenotype(int g_id) const
+{
+  const unsigned long long key = hashID(g_id);
+  int slot = -1;
+  for (GenotypePtr genotype = m_id_index.Find(key, slot); genotype; genotype = m_id_index.Find(key, slot)) {
+    if (genotype->ID() == g_id) return genotype;
   }
-  alpha[5] = '\0';
-  
-  return Apto::FormatStr("%03d-%s", size, alpha);
+  return GenotypePtr(NULL);
+}
+
+void Avida::Systematics::GenotypeArbiter::genotypeIDs(Apto::Array<int>& ids) const
+{
+  // IDs are handed out in order of creation, so that sorting them places parents ahead of their offspring
+  ids.Resize(0);
+  for (int i = 0; i < m_id_index.GetCapacity(); i++) {
+    if (m_id_index.EntryAt(i)) ids.Push(m_id_index.EntryAt(i)->ID());
+  }
+  if (ids.GetSize()) std::sort(&ids[0], &ids[0] + ids.GetSize());
 }
 
 void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
@@ -502,8 +700,7 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
   if (genotype->IsActive()) {
     ConstInstructionSequencePtr seq;
     seq.DynamicCastFrom(genotype->GroupGenome().Representation());
-    int list_num = hashGenome(*seq);
-    m_active_hash[list_num].Remove(genotype);
+    m_active_hash.Remove(hashGenome(*seq), genotype);
     genotype->Deactivate(m_cur_update);
     m_historic.Push(genotype, &genotype->m_handle);
   }
@@ -514,7 +711,11 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
     genotype->ClearThreshold();
   }
   
-  if (genotype->PassiveReferenceCount()) return;
+  // Genotypes kept only as ancestors are frozen, releasing everything that is not needed to describe them
+  if (genotype->PassiveReferenceCount()) {
+    genotype->Freeze();
+    return;
+  }
     
   const Apto::Array<GenotypePtr>& parents = genotype->Parents();
   for (int i = 0; i < parents.GetSize(); i++) {
@@ -527,6 +728,7 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
   
   assert(genotype->m_handle);
   genotype->m_handle->Remove(); // Remove from historic list
+  m_id_index.Remove(hashID(genotype->ID()), genotype);
   
   delete genotype->m_handle;
   genotype->m_handle = NULL;
@@ -538,23 +740,47 @@ void Avida::Systematics::GenotypeArbiter::updateCoalescent()
   
   if (m_best == 0) {
     m_coalescent = GenotypePtr(NULL);
+    m_coalescent_floor = GenotypePtr(NULL);
     m_coalescent_depth = -1;
     return;
   }
   
   // @note - update coalescent assumes asexual population
-  GenotypePtr test_gen = getBest();
-  GenotypePtr found_gen = test_gen;
-  GenotypePtr parent_gen = (found_gen->Parents().GetSize()) ? (found_gen->Parents()[0]) : GenotypePtr(NULL);
-
-  while (parent_gen) {
-    if (test_gen->ActiveReferenceCount() > 0 || test_gen->PassiveReferenceCount() > 1) found_gen = test_gen;
+  GenotypePtr best = getBest();
+  Genotype* found_gen = NULL;
+  
+  // Genotypes above the last coalescent have neither units nor other branches, and never regain them short of being
+  // reactivated.  So the new coalescent is the first genotype below the last one, along the lineage of the best
+  // genotype, that is active or a branch point.  Each genotype passed over is left above the coalescent for good.
+  const int floor_depth = (m_coalescent_floor) ? m_coalescent_floor->Depth() : -1;
+  if (floor_depth >= 0 && floor_depth <= best->Depth() && best->ancestorAtDepth(floor_depth) == &(*m_coalescent_floor)) {
+    for (int depth = floor_depth; depth < best->Depth(); depth++) {
+      Genotype* test_gen = best->ancestorAtDepth(depth);
+      if (!test_gen) break;
+      if (test_gen->m_parents.GetSize() &&
+          (test_gen->ActiveReferenceCount() > 0 || test_gen->PassiveReferenceCount() > 1)) {
+        found_gen = test_gen;
+        break;
+      }
+    }
+    if (!found_gen) found_gen = &(*best);
+  } else {
+    // No usable floor (first search, reactivation or a separately rooted lineage), walk the whole lineage
+    Genotype* test_gen = &(*best);
+    found_gen = test_gen;
+    Genotype* parent_gen = (found_gen->m_parents.GetSize()) ? &(*found_gen->m_parents[0]) : NULL;
     
-    test_gen = parent_gen;
-    parent_gen = (test_gen->Parents().GetSize()) ? (test_gen->Parents()[0]) : GenotypePtr(NULL);
+    while (parent_gen) {
+      if (test_gen->ActiveReferenceCount() > 0 || test_gen->PassiveReferenceCount() > 1) found_gen = test_gen;
+      
+      test_gen = parent_gen;
+      parent_gen = (test_gen->m_parents.GetSize()) ? &(*test_gen->m_parents[0]) : NULL;
+    }
   }
   
-  m_coalescent = found_gen;
+  found_gen->AddReference(); // Explicitly add reference to internally created SmartPtr
+  m_coalescent = GenotypePtr(found_gen);
+  m_coalescent_floor = m_coalescent;
   m_coalescent_depth = m_coalescent->Depth();
 }
 
@@ -0,0 +1,314 @@
+/*
+ *  systematics/HistoricStore.cc
+ *  avida-core
+ *
+ *  Copyright 2013 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/private/systematics/HistoricStore.h"
+
+#include "avida/core/InstructionSequence.h"
+
+#include "cHardwareManager.h"
+
+#if !APTO_PLATFORM(WINDOWS)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+
+static const Apto::BasicString<Apto::ThreadSafe> s_prop_id_instset("instset");
+
+enum { ENC_KEYFRAME = 0, ENC_DELTA = 1 };
+
+
+static inline void putVarint(Apto::Array<unsigned char>& buf, unsigned int value)
+{
+  while (value >= 0x80) {
+    buf.Push((unsigned char)(value | 0x80));
+    value >>= 7;
+  }
+  buf.Push((unsigned char)value);
+}
+
+static inline unsigned int getVarint(const unsigned char*& p)
+{
+  unsigned int value = 0;
+  for (int shift = 0; ; shift += 7) {
+    const unsigned char b = *p++;
+    value |= (unsigned int)(b & 0x7f) << shift;
+    if (!(b & 0x80)) break;
+  }
+  return value;
+}
+
+
+Avida::Systematics::HistoricStore::HistoricStore(const Apto::String& spill_path, int resident_mb)
+  : m_cur_chunk(-1)
+  , m_spill_path(spill_path)
+  , m_spill_fd(-1)
+  , m_resident_limit((long long)resident_mb * 1024 * 1024)
+  , m_resident_bytes(0)
+  , m_file_size(0)
+  , m_spill_next(0)
+{
+#if APTO_PLATFORM(WINDOWS)
+  m_resident_limit = 0;  // spilling relies on mmap
+#endif
+  if (m_spill_path.GetSize() == 0) m_resident_limit = 0;
+}
+
+Avida::Systematics::HistoricStore::~HistoricStore()
+{
+  for (int i = 0; i < m_chunks.GetSize(); i++) if (m_chunks[i].data) releaseChunk(i);
+#if !APTO_PLATFORM(WINDOWS)
+  if (m_spill_fd >= 0) {
+    close(m_spill_fd);
+    unlink(m_spill_path);
+  }
+#endif
+}
+
+
+int Avida::Systematics::HistoricStore::Add(const Genome& genome, const Genome* base, int base_record)
+{
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(genome.Representation());
+  assert(seq);
+
+  Apto::Array<unsigned char> buf;
+  int chain = 0;
+
+  if (base && base_record >= 0 && m_chain[base_record] < MAX_CHAIN && base->HardwareType() == genome.HardwareType() &&
+      base->Properties().Get(s_prop_id_instset).StringValue() == genome.Properties().Get(s_prop_id_instset).StringValue()) {
+    ConstInstructionSequencePtr base_seq;
+    base_seq.DynamicCastFrom(base->Representation());
+    assert(base_seq);
+
+    // Mutations are local, so the edit is the span between the common prefix and the common suffix
+    const int size = seq->GetSize();
+    const int base_size = base_seq->GetSize();
+    int prefix = 0;
+    while (prefix < size && prefix < base_size && (*seq)[prefix] == (*base_seq)[prefix]) prefix++;
+    int suffix = 0;
+    while (suffix < size - prefix && suffix < base_size - prefix &&
+           (*seq)[size - 1 - suffix] == (*base_seq)[base_size - 1 - suffix]) suffix++;
+
+    const int mid = size - prefix - suffix;
+    if (mid < size) {
+      buf.Push(ENC_DELTA);
+      putVarint(buf, prefix);
+      putVarint(buf, suffix);
+      putVarint(buf, mid);
+      for (int i = prefix; i < prefix + mid; i++) buf.Push((unsigned char)(*seq)[i].GetOp());
+      chain = m_chain[base_record] + 1;
+    }
+  }
+
+  if (!chain) {
+    const Apto::String inst_set = genome.Properties().Get(s_prop_id_instset).StringValue();
+    buf.Push(ENC_KEYFRAME);
+    putVarint(buf, genome.HardwareType() + 1);
+    for (int i = 0; i < inst_set.GetSize(); i++) buf.Push((unsigned char)inst_set[i]);
+    buf.Push(0);
+    putVarint(buf, seq->GetSize());
+    for (int i = 0; i < seq->GetSize(); i++) buf.Push((unsigned char)(*seq)[i].GetOp());
+  }
+
+  const int record = allocRecord();
+  m_chain[record] = (unsigned char)chain;
+  unsigned char* data = allocBytes(record, buf.GetSize());
+  for (int i = 0; i < buf.GetSize(); i++) data[i] = buf[i];
+
+  if (m_resident_limit > 0 && m_resident_bytes > m_resident_limit) spill();
+
+  return record;
+}
+
+
+void Avida::Systematics::HistoricStore::Remove(int record)
+{
+  const int idx = m_chunk[record];
+  m_chunks[idx].live -= m_length[record];
+  if (m_chunks[idx].live == 0 && idx != m_cur_chunk) releaseChunk(idx);
+  m_free.Push(record);
+}
+
+
+void Avida::Systematics::HistoricStore::Decode(int record, const Genome* base, Genome& genome) const
+{
+  const unsigned char* p = recordBytes(record);
+
+  if (*p++ == ENC_DELTA) {
+    assert(base);
+    ConstInstructionSequencePtr base_seq;
+    base_seq.DynamicCastFrom(base->Representation());
+    assert(base_seq);
+
+    const int prefix = getVarint(p);
+    const int suffix = getVarint(p);
+    const int mid = getVarint(p);
+
+    InstructionSequence* seq = new InstructionSequence(prefix + mid + suffix);
+    for (int i = 0; i < prefix; i++) (*seq)[i] = (*base_seq)[i];
+    for (int i = 0; i < mid; i++) (*seq)[prefix + i].SetOp(*p++);
+    for (int i = 0; i < suffix; i++) (*seq)[prefix + mid + i] = (*base_seq)[base_seq->GetSize() - suffix + i];
+
+    genome = Genome(base->HardwareType(), base->Properties(), GeneticRepresentationPtr(seq));
+    return;
+  }
+
+  const int hw_type = (int)getVarint(p) - 1;
+  const Apto::String inst_set((const char*)p);
+  p += inst_set.GetSize() + 1;
+
+  const int size = getVarint(p);
+  InstructionSequence* seq = new InstructionSequence(size);
+  for (int i = 0; i < size; i++) (*seq)[i].SetOp(*p++);
+
+  HashPropertyMap props;
+  cHardwareManager::SetupPropertyMap(props, inst_set);
+  genome = Genome(hw_type, props, GeneticRepresentationPtr(seq));
+}
+
+
+int Avida::Systematics::HistoricStore::allocRecord()
+{
+  if (m_free.GetSize()) {
+    const int record = m_free[m_free.GetSize() - 1];
+    m_free.Resize(m_free.GetSize() - 1);
+    return record;
+  }
+
+  for (int i = 0; i < NUM_STATS; i++) m_stats[i].Push(0.0);
+  m_total_gestation.Push(0);
+  m_chunk.Push(-1);
+  m_offset.Push(0);
+  m_length.Push(0);
+  m_chain.Push(0);
+  return m_chain.GetSize() - 1;
+}
+
+
+unsigned char* Avida::Systematics::HistoricStore::allocBytes(int record, int length)
+{
+  if (m_cur_chunk < 0 || m_chunks[m_cur_chunk].used + length > m_chunks[m_cur_chunk].size) {
+    // Retire the current chunk, releasing it right away if everything in it has been removed in the meantime
+    if (m_cur_chunk >= 0 && m_chunks[m_cur_chunk].live == 0) releaseChunk(m_cur_chunk);
+
+    Chunk chunk;
+    chunk.size = (length > CHUNK_SIZE) ? length : CHUNK_SIZE;
+    chunk.data = new unsigned char[chunk.size];
+    chunk.used = 0;
+    chunk.live = 0;
+    chunk.file_offset = -1;
+    m_resident_bytes += chunk.size;
+
+    if (m_free_chunks.GetSize()) {
+      m_cur_chunk = m_free_chunks[m_free_chunks.GetSize() - 1];
+      m_free_chunks.Resize(m_free_chunks.GetSize() - 1);
+      m_chunks[m_cur_chunk] = chunk;
+    } else {
+      m_chunks.Push(chunk);
+      m_cur_chunk = m_chunks.GetSize() - 1;
+    }
+  }
+
+  Chunk& chunk = m_chunks[m_cur_chunk];
+  m_chunk[record] = m_cur_chunk;
+  m_offset[record] = chunk.used;
+  m_length[record] = length;
+  chunk.used += length;
+  chunk.live += length;
+  return chunk.data + m_offset[record];
+}
+
+
+const unsigned char* Avida::Systematics::HistoricStore::recordBytes(int record) const
+{
+  return m_chunks[m_chunk[record]].data + m_offset[record];
+}
+
+
+void Avida::Systematics::HistoricStore::releaseChunk(int idx)
+{
+  Chunk& chunk = m_chunks[idx];
+  if (chunk.file_offset < 0) {
+    delete [] chunk.data;
+    m_resident_bytes -= chunk.size;
+  } else {
+#if !APTO_PLATFORM(WINDOWS)
+    munmap(chunk.data, chunk.size);
+#endif
+    m_free_file.Push(chunk.file_offset);
+  }
+  chunk.data = NULL;
+  if (idx == m_cur_chunk) m_cur_chunk = -1;
+  m_free_chunks.Push(idx);
+}
+
+
+void Avida::Systematics::HistoricStore::spill()
+{
+#if !APTO_PLATFORM(WINDOWS)
+  if (m_spill_fd < 0) {
+    m_spill_fd = open(m_spill_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_spill_fd < 0) {
+      m_resident_limit = 0;  // keep everything in memory when the spill file cannot be created
+      return;
+    }
+  }
+
+  // Walk the chunks round robin, so that the ones spilled are the ones filled longest ago
+  int checked = 0;
+  while (m_resident_bytes > m_resident_limit && checked < m_chunks.GetSize()) {
+    if (m_spill_next >= m_chunks.GetSize()) m_spill_next = 0;
+    const int idx = m_spill_next++;
+    checked++;
+
+    Chunk& chunk = m_chunks[idx];
+    if (!chunk.data || chunk.file_offset >= 0 || idx == m_cur_chunk || chunk.size != CHUNK_SIZE) continue;
+
+    long long offset = m_file_size;
+    if (m_free_file.GetSize()) {
+      offset = m_free_file[m_free_file.GetSize() - 1];
+      m_free_file.Resize(m_free_file.GetSize() - 1);
+    }
+
+    bool written = true;
+    for (int done = 0; done < chunk.used && written;) {
+      const ssize_t n = pwrite(m_spill_fd, chunk.data + done, chunk.used - done, offset + done);
+      if (n <= 0) written = false;
+      else done += n;
+    }
+    void* mapped = written ? mmap(NULL, chunk.size, PROT_READ, MAP_SHARED, m_spill_fd, offset) : MAP_FAILED;
+    if (mapped == MAP_FAILED) {
+      if (offset != m_file_size) m_free_file.Push(offset);
+      m_resident_limit = 0;
+      return;
+    }
+    if (offset == m_file_size) m_file_size += CHUNK_SIZE;
+
+    delete [] chunk.data;
+    chunk.data = static_cast<unsigned char*>(mapped);
+    chunk.file_offset = offset;
+    m_resident_bytes -= chunk.size;
+    checked = 0;
+  }
+#endif
+}
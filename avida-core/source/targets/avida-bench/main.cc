@@ -0,0 +1,610 @@
+/*
+ *  main.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "AvidaTools.h"
+
+#include "apto/core/FileSystem.h"
+#include "avida/Avida.h"
+#include "avida/core/InstructionSequence.h"
+#include "avida/core/Version.h"
+#include "avida/core/World.h"
+#include "avida/systematics/Arbiter.h"
+#include "avida/systematics/Group.h"
+#include "avida/systematics/Manager.h"
+#include "avida/util/CmdLine.h"
+
+#include "avida/private/util/GenomeLoader.h"
+
+#include "cAvidaConfig.h"
+#include "cCPUTestInfo.h"
+#include "cDemePlaceholderUnit.h"
+#include "cEnvironment.h"
+#include "cHardwareBase.h"
+#include "cHardwareManager.h"
+#include "cInstSet.h"
+#include "cOrganism.h"
+#include "cPopulation.h"
+#include "cPopulationCell.h"
+#include "cReactionResult.h"
+#include "cSpatialResCount.h"
+#include "cStats.h"
+#include "cStringUtil.h"
+#include "cTaskContext.h"
+#include "cTestCPU.h"
+#include "cTestCPUInterface.h"
+#include "cUserFeedback.h"
+#include "cWorld.h"
+#include "nGeometry.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined(_WIN32)
+# define NOMINMAX
+# include <windows.h>
+#elif defined(__APPLE__)
+# include <mach/mach_time.h>
+#else
+# include <time.h>
+#endif
+
+using namespace Avida;
+using namespace std;
+
+
+// Micro-benchmarks of the core simulation routines, each run in isolation on a world built from the standard
+// configuration.  Every benchmark times a fixed number of operations, repeated -reps times, and the results are
+// written as JSON (to stdout, or the file given with -o) so that runs from different releases can be compared.
+//
+// Unless a seed is given, the random number generator is seeded with 1, so that runs are repeatable.  Benchmarks can
+// be selected by name prefix with -bench (which may be repeated), and -scale multiplies every operation count.
+//
+// Usage: avida-bench [-org <file>] [-reps <n>] [-scale <x>] [-bench <name>] [-list] [-o <file>] [standard avida arguments]
+
+static const PropertyID s_prop_id_instset("instset");
+
+static const char* s_inst_class_names[NUM_INST_CLASSES] = {
+  "nop", "flow-control", "conditional", "arithmetic-logic", "data", "environment", "lifecycle", "other"
+};
+
+
+static void printFeedback(cUserFeedback& feedback)
+{
+  for (int i = 0; i < feedback.GetNumMessages(); i++) {
+    switch (feedback.GetMessageType(i)) {
+      case cUserFeedback::UF_ERROR:    cerr << "error: "; break;
+      case cUserFeedback::UF_WARNING:  cerr << "warning: "; break;
+      default: break;
+    };
+    cerr << feedback.GetMessage(i) << endl;
+  }
+}
+
+
+// Accumulates elapsed time, read from the monotonic wall clock, over any number of Start()/Stop() intervals.  Intervals
+// should cover many operations, since reading the clock costs about as much as some of the operations timed.
+class cBenchTimer
+{
+private:
+  double m_start;
+  double m_seconds;
+
+public:
+  cBenchTimer() : m_start(0.0), m_seconds(0.0) { ; }
+
+  void Start() { m_start = now(); }
+  void Stop() { m_seconds += now() - m_start; }
+  double Seconds() const { return m_seconds; }
+
+private:
+  static double now()
+  {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return double(count.QuadPart) / double(freq.QuadPart);
+#elif defined(__APPLE__)
+    static mach_timebase_info_data_t timebase = { 0, 0 };
+    if (timebase.denom == 0) mach_timebase_info(&timebase);
+    return double(mach_absolute_time()) * timebase.numer / timebase.denom * 1e-9;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) + double(ts.tv_nsec) * 1e-9;
+#endif
+  }
+};
+
+
+struct sBenchResult
+{
+  cString name;
+  cString unit;                     // What a single timed operation is
+  long long ops;                    // Operations per repetition
+  Apto::Array<double> seconds;      // Time taken by each repetition
+};
+
+
+class cBenchSuite
+{
+public:
+  cWorld* world;
+  cAvidaContext& ctx;
+  GenomePtr genome;
+  int reps;
+  double scale;
+  Apto::Array<sBenchResult> results;
+
+  cBenchSuite(cWorld* in_world, GenomePtr in_genome, int in_reps, double in_scale)
+    : world(in_world), ctx(in_world->GetDefaultContext()), genome(in_genome), reps(in_reps), scale(in_scale) { ; }
+
+  // Scaled operation count for a benchmark, never less than one
+  long long Ops(long long base) const { return std::max(1LL, (long long)(base * scale)); }
+
+  sBenchResult& AddResult(const cString& name, const cString& unit, long long ops)
+  {
+    results.Resize(results.GetSize() + 1);
+    sBenchResult& result = results[results.GetSize() - 1];
+    result.name = name;
+    result.unit = unit;
+    result.ops = ops;
+    return result;
+  }
+};
+
+
+// Benchmarks
+// --------------------------------------------------------------------------------------------------------------
+
+// cTestCPU::TestGenome on the benchmark organism
+static void benchTestCPU(cBenchSuite& suite)
+{
+  cTestCPU* test_cpu = suite.world->GetHardwareManager().CreateTestCPU(suite.ctx);
+  cCPUTestInfo test_info;
+
+  sBenchResult& result = suite.AddResult("test-cpu/test-genome", "genome", suite.Ops(200));
+  for (int rep = 0; rep < suite.reps; rep++) {
+    cBenchTimer timer;
+    timer.Start();
+    for (long long i = 0; i < result.ops; i++) test_cpu->TestGenome(suite.ctx, test_info, *suite.genome);
+    timer.Stop();
+    result.seconds.Push(timer.Seconds());
+  }
+
+  delete test_cpu;
+}
+
+
+// cHardwareBase::SingleProcess, for each instruction class.  The organism run is a copy of the benchmark organism with
+// every instruction replaced by those of one class in turn, executed on a test CPU.  Organisms are replaced (untimed)
+// whenever they die, divide or reach the test CPU time limit.
+static void benchSingleProcess(cBenchSuite& suite)
+{
+  cHardwareManager& hw_mgr = suite.world->GetHardwareManager();
+  const cInstSet& inst_set = hw_mgr.GetInstSet(suite.genome->Properties().Get(s_prop_id_instset).StringValue());
+  cTestCPU* test_cpu = hw_mgr.CreateTestCPU(suite.ctx);
+  cCPUTestInfo test_info;
+
+  // Run a full test first, which sets up the test CPU inputs used by the environment instructions
+  test_cpu->TestGenome(suite.ctx, test_info, *suite.genome);
+
+  for (int inst_class = 0; inst_class < NUM_INST_CLASSES; inst_class++) {
+    Apto::Array<int> ops;
+    for (int op = 0; op < inst_set.GetSize(); op++) {
+      const Instruction inst(op);
+      if (inst_set.GetInstLib()->Get(inst_set.GetLibFunctionIndex(inst)).GetClass() == inst_class) ops.Push(op);
+    }
+    if (ops.GetSize() == 0) continue;
+
+    Genome class_genome(*suite.genome);
+    InstructionSequencePtr seq;
+    seq.DynamicCastFrom(class_genome.Representation());
+    for (int i = 0; i < seq->GetSize(); i++) (*seq)[i] = Instruction(ops[i % ops.GetSize()]);
+    const int time_allocated = suite.world->GetConfig().TEST_CPU_TIME_MOD.Get() * seq->GetSize();
+
+    sBenchResult& result = suite.AddResult(cString("single-process/") + s_inst_class_names[inst_class], "instruction",
+                                           suite.Ops(1000000));
+    suite.ctx.SetTestMode();
+    for (int rep = 0; rep < suite.reps; rep++) {
+      cBenchTimer timer;
+      long long remaining = result.ops;
+      while (remaining > 0) {
+        cOrganism* organism = new cOrganism(suite.world, suite.ctx, class_genome, -1,
+                                            Systematics::Source(Systematics::DIVISION, "", true));
+        organism->SetOrgInterface(suite.ctx, new cTestCPUInterface(test_cpu, test_info, 0));
+        organism->GetPhenotype().SetupInject(*seq);
+
+        const long long steps = std::min(remaining, (long long)time_allocated);
+        long long step = 0;
+        timer.Start();
+        while (step < steps && !organism->IsDead() && organism->GetPhenotype().GetNumDivides() == 0) {
+          organism->GetHardware().SingleProcess(suite.ctx);
+          step++;
+        }
+        timer.Stop();
+
+        organism->NotifyDeath(suite.ctx);
+        delete organism;
+        if (step == 0) break;
+        remaining -= step;
+      }
+      result.seconds.Push(timer.Seconds());
+    }
+    suite.ctx.ClearTestMode();
+  }
+
+  delete test_cpu;
+}
+
+
+// cSpatialResCount::FlowAll on toroidal grids of increasing size, holding random amounts of resource
+static void benchFlowAll(cBenchSuite& suite)
+{
+  const int sizes[] = { 30, 60, 120, 240 };
+  for (int s = 0; s < int(sizeof(sizes) / sizeof(sizes[0])); s++) {
+    const int size = sizes[s];
+    cSpatialResCount res(size, size, nGeometry::TORUS, 0.1, 0.1, 0.0, 0.0);
+    for (int cell_id = 0; cell_id < size * size; cell_id++) res.SetCellAmount(cell_id, suite.ctx.GetRandom().GetDouble());
+
+    sBenchResult& result = suite.AddResult(cStringUtil::Stringf("flow-all/%dx%d", size, size), "update",
+                                           suite.Ops(std::max(1, 20000000 / (size * size))));
+    for (int rep = 0; rep < suite.reps; rep++) {
+      cBenchTimer timer;
+      timer.Start();
+      for (long long i = 0; i < result.ops; i++) res.FlowAll();
+      timer.Stop();
+      result.seconds.Push(timer.Seconds());
+    }
+  }
+}
+
+
+// cEnvironment::TestOutput, with outputs cycling through the logic functions of the current inputs (and a random value)
+static void benchTestOutput(cBenchSuite& suite)
+{
+  const cEnvironment& env = suite.world->GetEnvironment();
+  const int num_resources = env.GetResourceLib().GetSize();
+  const int num_tasks = env.GetNumTasks();
+  const int num_reactions = env.GetReactionLib().GetSize();
+
+  cReactionResult result_scratch(num_resources, num_tasks, num_reactions);
+  Apto::Array<int> task_count(num_tasks);
+  Apto::Array<int> reaction_count(num_reactions);
+  Apto::Array<double> res_count(num_resources);
+  Apto::Array<double> rbins_count(num_resources);
+  task_count.SetAll(0);
+  reaction_count.SetAll(0);
+  res_count.SetAll(0.0);
+  rbins_count.SetAll(0.0);
+
+  Apto::Array<int> input_array;
+  env.SetupInputs(suite.ctx, input_array);
+  tBuffer<int> inputs(env.GetInputSize());
+  for (int i = 0; i < input_array.GetSize(); i++) inputs.Add(input_array[i]);
+  tBuffer<int> outputs(env.GetOutputSize());
+  tList<tBuffer<int> > other_inputs;
+  tList<tBuffer<int> > other_outputs;
+  Apto::Array<int, Apto::Smart> ext_mem;
+  Apto::Map<void*, cTaskState*> task_states;
+
+  const int a = (input_array.GetSize() > 0) ? input_array[0] : 0;
+  const int b = (input_array.GetSize() > 1) ? input_array[1] : 0;
+  const int values[] = { ~a, ~(a & b), a & b, a | ~b, a | b, a & ~b, ~(a | b), a ^ b, ~(a ^ b),
+                         int(suite.ctx.GetRandom().GetUInt(0xFFFFFFFF)) };
+  const int num_values = sizeof(values) / sizeof(values[0]);
+
+  sBenchResult& result = suite.AddResult("environment/test-output", "output", suite.Ops(1000000));
+  for (int rep = 0; rep < suite.reps; rep++) {
+    cBenchTimer timer;
+    timer.Start();
+    for (long long i = 0; i < result.ops; i++) {
+      outputs.Add(values[i % num_values]);
+      cTaskContext taskctx(NULL, inputs, outputs, other_inputs, other_outputs, ext_mem);
+      taskctx.SetTaskStates(&task_states);
+      env.TestOutput(suite.ctx, result_scratch, taskctx, task_count, reaction_count, res_count, rbins_count);
+      result_scratch.Invalidate();
+    }
+    timer.Stop();
+    result.seconds.Push(timer.Seconds());
+  }
+}
+
+
+// GenotypeArbiter::ClassifyNewUnit (through the arbiter of the "genotype" role) of units whose genotypes already exist,
+// as is the case for most births.  The units are mutants of the benchmark organism, each held by an anchoring unit.
+static void benchClassifyNewUnit(cBenchSuite& suite)
+{
+  Systematics::ArbiterPtr arbiter = Systematics::Manager::Of(suite.world->GetNewWorld())->ArbiterForRole("genotype");
+  if (!arbiter) return;
+
+  const cInstSet& inst_set = suite.world->GetHardwareManager().GetInstSet(suite.genome->Properties().Get(s_prop_id_instset).StringValue());
+  const Systematics::Source src(Systematics::DIVISION, "", true);
+
+  const int num_units = 64;
+  Apto::Array<Systematics::UnitPtr> units(num_units);
+  Apto::Array<Systematics::GroupPtr> anchors(num_units);
+  for (int i = 0; i < num_units; i++) {
+    Genome mutant(*suite.genome);
+    InstructionSequencePtr seq;
+    seq.DynamicCastFrom(mutant.Representation());
+    (*seq)[i % seq->GetSize()] = inst_set.GetRandomInst(suite.ctx);
+
+    units[i] = Systematics::UnitPtr(new cDemePlaceholderUnit(src, mutant));
+    anchors[i] = arbiter->ClassifyNewUnit(Systematics::UnitPtr(new cDemePlaceholderUnit(src, mutant)));
+  }
+
+  sBenchResult& result = suite.AddResult("systematics/classify-new-unit", "unit", suite.Ops(200000));
+  for (int rep = 0; rep < suite.reps; rep++) {
+    cBenchTimer timer;
+    timer.Start();
+    for (long long i = 0; i < result.ops; i++) {
+      Systematics::GroupPtr group = arbiter->ClassifyNewUnit(units[i % num_units]);
+      group->RemoveUnit();
+    }
+    timer.Stop();
+    result.seconds.Push(timer.Seconds());
+  }
+
+  for (int i = 0; i < num_units; i++) if (anchors[i]) anchors[i]->RemoveUnit();
+}
+
+
+// cStats::ProcessUpdate
+static void benchProcessUpdate(cBenchSuite& suite)
+{
+  cStats& stats = suite.world->GetStats();
+
+  sBenchResult& result = suite.AddResult("stats/process-update", "update", suite.Ops(100000));
+  for (int rep = 0; rep < suite.reps; rep++) {
+    cBenchTimer timer;
+    timer.Start();
+    for (long long i = 0; i < result.ops; i++) stats.ProcessUpdate();
+    timer.Stop();
+    result.seconds.Push(timer.Seconds());
+  }
+}
+
+
+// cPopulation::InjectGenome into successive cells of the population, replacing the previous occupant once it is full
+static void benchInject(cBenchSuite& suite)
+{
+  cPopulation& pop = suite.world->GetPopulation();
+  const int num_cells = pop.GetSize();
+
+  sBenchResult& result = suite.AddResult("population/inject-genome", "birth", suite.Ops(10000));
+  for (int rep = 0; rep < suite.reps; rep++) {
+    cBenchTimer timer;
+    timer.Start();
+    for (long long i = 0; i < result.ops; i++) {
+      pop.InjectGenome(int(i % num_cells), Systematics::Source(Systematics::DIVISION, "", true), *suite.genome, suite.ctx);
+    }
+    timer.Stop();
+    result.seconds.Push(timer.Seconds());
+  }
+}
+
+
+// cPopulation::ActivateOffspring of the benchmark organism, from a parent that is replaced if it dies.  The whole loop is
+// timed as one interval, and the time spent replacing parents is then subtracted.
+static void benchActivateOffspring(cBenchSuite& suite)
+{
+  cPopulation& pop = suite.world->GetPopulation();
+  const Systematics::Source src(Systematics::DIVISION, "", true);
+
+  pop.InjectGenome(0, src, *suite.genome, suite.ctx);
+  cOrganism* parent = pop.GetCell(0).GetOrganism();
+  if (!parent) return;
+
+  sBenchResult& result = suite.AddResult("population/activate-offspring", "birth", suite.Ops(10000));
+  for (int rep = 0; rep < suite.reps; rep++) {
+    cBenchTimer timer;
+    cBenchTimer replace_timer;
+    timer.Start();
+    for (long long i = 0; i < result.ops; i++) {
+      // Mark the parent as running, as it would be when dividing, so that it is not deleted out from under the call
+      parent->SetRunning(true);
+      pop.ActivateOffspring(suite.ctx, *suite.genome, parent);
+      parent->SetRunning(false);
+
+      if (parent->GetPhenotype().GetToDelete()) {
+        replace_timer.Start();
+        delete parent;
+        pop.InjectGenome(0, src, *suite.genome, suite.ctx);
+        parent = pop.GetCell(0).GetOrganism();
+        replace_timer.Stop();
+        if (!parent) return;
+      }
+    }
+    timer.Stop();
+    result.seconds.Push(timer.Seconds() - replace_timer.Seconds());
+  }
+}
+
+
+struct sBenchmark
+{
+  const char* name;
+  void (*run)(cBenchSuite& suite);
+  const char* description;
+};
+
+static const sBenchmark s_benchmarks[] = {
+  { "test-cpu", benchTestCPU, "cTestCPU::TestGenome of the benchmark organism" },
+  { "single-process", benchSingleProcess, "cHardwareBase::SingleProcess, by instruction class" },
+  { "flow-all", benchFlowAll, "cSpatialResCount::FlowAll at several grid sizes" },
+  { "environment", benchTestOutput, "cEnvironment::TestOutput" },
+  { "systematics", benchClassifyNewUnit, "GenotypeArbiter::ClassifyNewUnit of existing genotypes" },
+  { "stats", benchProcessUpdate, "cStats::ProcessUpdate" },
+  { "population/inject", benchInject, "cPopulation::InjectGenome" },
+  { "population/activate", benchActivateOffspring, "cPopulation::ActivateOffspring" },
+};
+static const int s_num_benchmarks = sizeof(s_benchmarks) / sizeof(s_benchmarks[0]);
+
+
+// Output
+// --------------------------------------------------------------------------------------------------------------
+
+static cString jsonString(const char* str)
+{
+  cString out("\"");
+  for (const char* c = str; *c; c++) {
+    switch (*c) {
+      case '"':  out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if ((unsigned char)*c < 0x20) out += cStringUtil::Stringf("\\u%04x", (unsigned char)*c);
+        else out += *c;
+        break;
+    }
+  }
+  out += "\"";
+  return out;
+}
+
+static void writeJSON(ostream& out, const cBenchSuite& suite, const cString& org_file)
+{
+  out.precision(9);
+  out << "{" << endl;
+  out << "  \"suite\": \"avida-bench\"," << endl;
+  out << "  \"format_version\": 1," << endl;
+  out << "  \"avida_version\": " << jsonString((const char*)Avida::Version::Banner()) << "," << endl;
+  out << "  \"organism\": " << jsonString(org_file) << "," << endl;
+  out << "  \"random_seed\": " << suite.world->GetConfig().RANDOM_SEED.Get() << "," << endl;
+  out << "  \"repetitions\": " << suite.reps << "," << endl;
+  out << "  \"scale\": " << suite.scale << "," << endl;
+  out << "  \"results\": [";
+  int num_written = 0;
+  for (int i = 0; i < suite.results.GetSize(); i++) {
+    const sBenchResult& result = suite.results[i];
+
+    // A benchmark that gave up before finishing a repetition has no times to report
+    if (result.seconds.GetSize() == 0) continue;
+
+    Apto::Array<double> sorted(result.seconds);
+    std::sort(&sorted[0], &sorted[0] + sorted.GetSize());
+    const int n = sorted.GetSize();
+    const double median = (n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+
+    out << ((num_written++) ? "," : "") << endl << "    {" << endl;
+    out << "      \"name\": " << jsonString(result.name) << "," << endl;
+    out << "      \"unit\": " << jsonString(result.unit) << "," << endl;
+    out << "      \"ops\": " << result.ops << "," << endl;
+    out << "      \"seconds\": [";
+    for (int r = 0; r < n; r++) out << ((r) ? ", " : "") << result.seconds[r];
+    out << "]," << endl;
+    out << "      \"min_seconds\": " << sorted[0] << "," << endl;
+    out << "      \"median_seconds\": " << median << "," << endl;
+    out << "      \"ns_per_op\": " << (median * 1.0e9 / result.ops) << "," << endl;
+    out << "      \"ops_per_sec\": " << ((median > 0.0) ? (result.ops / median) : 0.0) << endl;
+    out << "    }";
+  }
+  out << endl << "  ]" << endl;
+  out << "}" << endl;
+}
+
+
+int main(int argc, char * argv[])
+{
+  Avida::Initialize();
+
+  // Pull out the benchmark arguments, passing everything else along to the standard avida argument processing
+  cString org_file("default-classic.org");
+  cString out_file;
+  int num_reps = 5;
+  double scale = 1.0;
+  bool list_only = false;
+  Apto::Array<cString> selected;
+
+  Apto::Array<char*> avida_argv;
+  avida_argv.Push(argv[0]);
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-org") == 0 && i + 1 < argc) org_file = argv[++i];
+    else if (strcmp(argv[i], "-reps") == 0 && i + 1 < argc) num_reps = std::max(1, atoi(argv[++i]));
+    else if (strcmp(argv[i], "-scale") == 0 && i + 1 < argc) scale = atof(argv[++i]);
+    else if (strcmp(argv[i], "-bench") == 0 && i + 1 < argc) selected.Push(argv[++i]);
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_file = argv[++i];
+    else if (strcmp(argv[i], "-list") == 0) list_only = true;
+    else avida_argv.Push(argv[i]);
+  }
+
+  if (list_only) {
+    for (int b = 0; b < s_num_benchmarks; b++) cout << s_benchmarks[b].name << "\t" << s_benchmarks[b].description << endl;
+    return 0;
+  }
+
+  // Initialize the configuration data...
+  Apto::Map<Apto::String, Apto::String> defs;
+  cAvidaConfig* cfg = new cAvidaConfig();
+  Avida::Util::ProcessCmdLineArgs(avida_argv.GetSize(), &avida_argv[0], cfg, defs);
+  if (cfg->RANDOM_SEED.Get() < 0) cfg->RANDOM_SEED.Set(1);
+
+  cUserFeedback feedback;
+  Avida::World* new_world = new Avida::World();
+  cWorld* world = cWorld::Initialize(cfg, cString(Apto::FileSystem::GetCWD()), new_world, &feedback, &defs);
+  printFeedback(feedback);
+  if (!world) return -1;
+
+  cUserFeedback load_feedback;
+  GenomePtr genome = Util::LoadGenomeDetailFile(org_file, world->GetWorkingDir(), world->GetHardwareManager(), load_feedback);
+  printFeedback(load_feedback);
+  if (!genome) return -1;
+
+  cCPUTestInfo test_info;
+  cTestCPU* test_cpu = world->GetHardwareManager().CreateTestCPU(world->GetDefaultContext());
+  const bool viable = test_cpu->TestGenome(world->GetDefaultContext(), test_info, *genome);
+  delete test_cpu;
+  if (!viable) {
+    cerr << "error: organism '" << org_file << "' is not viable" << endl;
+    return -1;
+  }
+
+  cBenchSuite suite(world, genome, num_reps, scale);
+  for (int b = 0; b < s_num_benchmarks; b++) {
+    bool run = (selected.GetSize() == 0);
+    const cString name(s_benchmarks[b].name);
+    for (int s = 0; !run && s < selected.GetSize(); s++) {
+      run = (strncmp(name, selected[s], selected[s].GetSize()) == 0);
+    }
+    if (!run) continue;
+
+    cerr << "running " << name << "..." << endl;
+    s_benchmarks[b].run(suite);
+  }
+
+  if (out_file.GetSize()) {
+    ofstream fp(out_file);
+    if (!fp.good()) {
+      cerr << "error: unable to open '" << out_file << "' for writing" << endl;
+      return -1;
+    }
+    writeJSON(fp, suite, org_file);
+  } else {
+    writeJSON(cout, suite, org_file);
+  }
+
+  return 0;
+}
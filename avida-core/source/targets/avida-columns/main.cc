@@ -0,0 +1,64 @@
+/*
+ *  main.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "avida/output/ColumnFile.h"
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+
+// Converts binary column files, written by print actions given the 'binary' format, back to the text data files that
+// the same actions write by default.
+//
+// Usage: avida-columns <column file> [<text file>]
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2 || argc > 3) {
+    cerr << "Usage: " << argv[0] << " <column file> [<text file>]" << endl;
+    return 1;
+  }
+  
+  ifstream in(argv[1], ios::in | ios::binary);
+  if (!in.good()) {
+    cerr << "error: unable to open '" << argv[1] << "'" << endl;
+    return 1;
+  }
+  
+  ofstream out_file;
+  if (argc == 3) {
+    out_file.open(argv[2], ios::out | ios::trunc);
+    if (!out_file.good()) {
+      cerr << "error: unable to open '" << argv[2] << "' for writing" << endl;
+      return 1;
+    }
+  }
+  ostream& out = (argc == 3) ? static_cast<ostream&>(out_file) : cout;
+  
+  if (!Avida::Output::ColumnFile::ConvertToText(in, out)) {
+    cerr << "error: '" << argv[1] << "' is not a valid column file" << endl;
+    return 1;
+  }
+  
+  out.flush();
+  return (out.good()) ? 0 : 1;
+}
@@ -83,6 +83,9 @@ void Avida2Driver::Run()
   if (m_world->GetConfig().SPECULATIVE.Get() &&
       m_world->GetConfig().THREAD_SLICING_METHOD.Get() != 1 && !m_world->GetConfig().IMPLICIT_REPRO_END.Get() && point_mut_prob == 0.0) {
     ActiveProcessStep = &cPopulation::ProcessStepSpeculative;
+    
+    // Parallel pre-execution builds on speculative execution
+    if (m_world->GetConfig().UPDATE_THREADS.Get() > 1) population.SetupParallelUpdate(m_world->GetConfig().UPDATE_THREADS.Get());
   }
   
   cAvidaContext& ctx = m_world->GetDefaultContext();
@@ -108,10 +111,15 @@ void Avida2Driver::Run()
     const int UD_size = m_world->CalculateUpdateSize();
     const double step_size = 1.0 / (double) UD_size;
     
+    // When running in parallel, workers refill each organism's pre-executed instructions once the average organism
+    // should have consumed about half of its UPDATE_THREAD_DEPTH credits
+    const int sync_steps = Apto::Max(1, population.GetNumOrganisms() * Apto::Max(1, m_world->GetConfig().UPDATE_THREAD_DEPTH.Get() / 2));
+    
     for (int i = 0; i < UD_size; i++) {
       if(population.GetNumOrganisms() == 0) {
         break;
       }
+      if (population.HasParallelUpdate() && (i % sync_steps) == 0) population.ProcessParallelSpeculation(ctx);
       (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
     }
     
@@ -312,6 +312,1000 @@ protected:
 };
 
 
+#include "avida/private/systematics/ProbeTable.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+class ProbeTableTests : public cUnitTest
+{
+public:
+  const char* GetUnitName() { return "ProbeTable"; }
+private:
+  typedef Avida::Systematics::ProbeTable<int*> tTable;
+  typedef std::multimap<unsigned long long, int*> tReference;
+  
+  unsigned long long m_state;
+  
+  unsigned long long next()
+  {
+    // xorshift64, deterministic so that failures are reproducible
+    m_state ^= m_state << 13;
+    m_state ^= m_state >> 7;
+    m_state ^= m_state << 17;
+    return m_state;
+  }
+  
+  static bool matches(const tTable& table, const tReference& ref, unsigned long long key)
+  {
+    std::vector<int*> found;
+    int slot = -1;
+    for (int* value = table.Find(key, slot); value; value = table.Find(key, slot)) found.push_back(value);
+    
+    std::vector<int*> expected;
+    std::pair<tReference::const_iterator, tReference::const_iterator> range = ref.equal_range(key);
+    for (tReference::const_iterator it = range.first; it != range.second; it++) expected.push_back(it->second);
+    
+    std::sort(found.begin(), found.end());
+    std::sort(expected.begin(), expected.end());
+    return found == expected;
+  }
+  
+  static bool matchesAll(const tTable& table, const tReference& ref)
+  {
+    if (table.GetSize() != (int)ref.size()) return false;
+    int occupied = 0;
+    for (int i = 0; i < table.GetCapacity(); i++) if (table.EntryAt(i)) occupied++;
+    if (occupied != table.GetSize()) return false;
+    for (tReference::const_iterator it = ref.begin(); it != ref.end(); it = ref.upper_bound(it->first)) {
+      if (!matches(table, ref, it->first)) return false;
+    }
+    return true;
+  }
+  
+  static void removeOne(tReference& ref, unsigned long long key, int* value)
+  {
+    std::pair<tReference::iterator, tReference::iterator> range = ref.equal_range(key);
+    for (tReference::iterator it = range.first; it != range.second; it++) {
+      if (it->second == value) { ref.erase(it); return; }
+    }
+  }
+  
+protected:
+  void RunTests()
+  {
+    const int POOL = 4096;
+    std::vector<int> pool(POOL);
+    m_state = 88172645463325252ULL;
+    
+    // Random insert/remove against a reference multimap, with keys drawn from a small set so that duplicate keys,
+    // shared home slots and long probe runs are all common
+    {
+      tTable table;
+      tReference ref;
+      std::vector<std::pair<unsigned long long, int*> > live;
+      bool ok = true;
+      bool removed_ok = true;
+      for (int op = 0; op < 200000 && ok; op++) {
+        if (live.empty() || (next() % 100) < 55 || live.size() < 16) {
+          if ((int)live.size() == POOL) continue;
+          const unsigned long long key = (next() % 512) << (next() % 2 ? 0 : 12); // many keys share low bits
+          int* value = &pool[next() % POOL];
+          table.Insert(key, value);
+          ref.insert(std::make_pair(key, value));
+          live.push_back(std::make_pair(key, value));
+        } else {
+          const size_t idx = (size_t)(next() % live.size());
+          std::pair<unsigned long long, int*> entry = live[idx];
+          live[idx] = live.back();
+          live.pop_back();
+          removed_ok = removed_ok && table.Remove(entry.first, entry.second);
+          removeOne(ref, entry.first, entry.second);
+        }
+        if ((op % 97) == 0) ok = matchesAll(table, ref);
+      }
+      ReportTestResult("Random Insert/Remove", ok && removed_ok && matchesAll(table, ref));
+      
+      // Drain everything, the table should end up empty without leaving stale entries behind
+      while (!live.empty()) {
+        removed_ok = removed_ok && table.Remove(live.back().first, live.back().second);
+        removeOne(ref, live.back().first, live.back().second);
+        live.pop_back();
+      }
+      ReportTestResult("Drain", removed_ok && table.GetSize() == 0 && matchesAll(table, ref));
+    }
+    
+    // Colliding keys: everything homes to the last slot, so runs wrap around the end of the table
+    {
+      tTable table;
+      tReference ref;
+      for (int i = 0; i < 24; i++) {
+        const unsigned long long key = ((unsigned long long)(i % 6) << 32) | 63;
+        table.Insert(key, &pool[i]);
+        ref.insert(std::make_pair(key, &pool[i]));
+      }
+      bool ok = matchesAll(table, ref);
+      ReportTestResult("Collisions (wrapped run)", ok && table.GetCapacity() == 64);
+      
+      // Remove from the front, middle and back of the run, each removal shifts the rest of the run back
+      const int order[] = { 0, 11, 23, 5, 17, 1 };
+      for (int i = 0; i < 6; i++) {
+        const unsigned long long key = ((unsigned long long)(order[i] % 6) << 32) | 63;
+        ok = ok && table.Remove(key, &pool[order[i]]);
+        removeOne(ref, key, &pool[order[i]]);
+        ok = ok && matchesAll(table, ref);
+      }
+      ReportTestResult("Collisions (remove within run)", ok);
+      
+      ReportTestResult("Remove missing entry", !table.Remove(63, &pool[0]) && !table.Remove(62, &pool[2]) &&
+                       table.GetSize() == 18);
+    }
+    
+    // Slot reuse: deletion leaves no tombstones, so repeated churn never grows the table
+    {
+      tTable table;
+      tReference ref;
+      bool ok = true;
+      for (int round = 0; round < 1000 && ok; round++) {
+        for (int i = 0; i < 30; i++) table.Insert((unsigned long long)(round * 30 + i) << 3, &pool[i]);
+        for (int i = 0; i < 30; i++) ok = ok && table.Remove((unsigned long long)(round * 30 + i) << 3, &pool[i]);
+      }
+      ReportTestResult("Slot Reuse", ok && table.GetSize() == 0 && table.GetCapacity() == 64 && matchesAll(table, ref));
+    }
+    
+    // Growth: the table doubles once it would pass half full, and keeps every entry across the rehash
+    {
+      tTable table;
+      tReference ref;
+      for (int i = 0; i < 32; i++) {
+        const unsigned long long key = next();
+        table.Insert(key, &pool[i]);
+        ref.insert(std::make_pair(key, &pool[i]));
+      }
+      const bool at_limit = (table.GetCapacity() == 64);
+      table.Insert(7, &pool[32]);
+      ref.insert(std::make_pair(7ULL, &pool[32]));
+      const bool grown = (table.GetCapacity() == 128);
+      for (int i = 33; i < 1000; i++) {
+        const unsigned long long key = next() & 0xFFFF;
+        table.Insert(key, &pool[i]);
+        ref.insert(std::make_pair(key, &pool[i]));
+      }
+      ReportTestResult("grow()", at_limit && grown && table.GetCapacity() == 2048 && matchesAll(table, ref));
+    }
+  }
+};
+
+
+#include "cTournamentIndex.h"
+#include "apto/rng.h"
+
+#include <climits>
+#include <list>
+#include <vector>
+
+class cTournamentIndexTests : public cUnitTest
+{
+public:
+  const char* GetUnitName() { return "cTournamentIndex"; }
+private:
+  static const int NUM_CELLS = 300;
+  
+  // Every item holding the largest key, in the order FindMax() numbers them
+  static std::vector<int> maxList(const cTournamentIndex& index)
+  {
+    std::vector<int> found;
+    for (int i = 0; i < index.GetNumMax(); i++) found.push_back(index.FindMax(i));
+    return found;
+  }
+  
+  // cPopulation::PopReaperCell
+  static int popReaper(cTournamentIndex& index, int skip_cell)
+  {
+    int skip_key = cTournamentIndex::NO_KEY;
+    if (skip_cell >= 0) {
+      skip_key = index.GetKey(skip_cell);
+      index.SetKey(skip_cell, cTournamentIndex::NO_KEY);
+    }
+    const int cell_id = index.FindMax();
+    if (cell_id >= 0) index.SetKey(cell_id, cTournamentIndex::NO_KEY);
+    if (skip_cell >= 0) index.SetKey(skip_cell, skip_key);
+    return cell_id;
+  }
+  
+protected:
+  void RunTests()
+  {
+    Apto::RNG::AvidaRNG rng(1138);
+    
+    // Reaper queue, against the list based queue it replaced (push to the front, pop the oldest from the rear, and
+    // when the parent is at the rear take the next cell instead, leaving the parent in place)
+    {
+      cTournamentIndex index(NUM_CELLS);
+      std::list<int> queue;
+      int stamp = 0;
+      bool ok = true;
+      for (int op = 0; op < 100000 && ok; op++) {
+        const int action = rng.GetUInt(10);
+        const int cell_id = rng.GetUInt(NUM_CELLS);
+        if (action < 5) {
+          queue.remove(cell_id);
+          queue.push_front(cell_id);
+          index.SetKey(cell_id, -(++stamp));
+        } else if (action < 7) {
+          queue.remove(cell_id);
+          index.SetKey(cell_id, cTournamentIndex::NO_KEY);
+        } else {
+          const int skip_cell = (action == 9 && queue.size()) ? queue.back() : -1;
+          int expected = -1;
+          for (std::list<int>::reverse_iterator it = queue.rbegin(); it != queue.rend(); it++) {
+            if (*it != skip_cell) { expected = *it; queue.erase(--(it.base())); break; }
+          }
+          ok = (popReaper(index, skip_cell) == expected);
+        }
+        ok = ok && (index.GetNumMax() == (queue.size() ? 1 : 0));
+      }
+      ReportTestResult("Reaper Queue (PopReaperCell)", ok);
+    }
+    
+    // Most time used, empty cells first
+    {
+      cTournamentIndex index(NUM_CELLS);
+      Apto::Array<int> time_used(NUM_CELLS);
+      time_used.SetAll(INT_MAX);
+      for (int i = 0; i < NUM_CELLS; i++) index.SetKey(i, INT_MAX);
+      bool ok = true;
+      for (int op = 0; op < 50000 && ok; op++) {
+        const int action = rng.GetUInt(10);
+        const int cell_id = rng.GetUInt(NUM_CELLS);
+        if (action < 3) {
+          time_used[cell_id] = 0;
+        } else if (action < 4) {
+          time_used[cell_id] = INT_MAX;
+        } else if (action < 8) {
+          if (time_used[cell_id] != INT_MAX) time_used[cell_id] += rng.GetUInt(20);
+        }
+        index.SetKey(cell_id, time_used[cell_id]);
+        
+        if (action >= 8) {
+          // The scan used by POSITION_OFFSPRING_FULL_SOUP_ENERGY_USED, with ties numbered in cell order
+          std::vector<int> expected;
+          int max_time_used = 0;
+          for (int i = 0; i < NUM_CELLS; i++) {
+            if (time_used[i] > max_time_used) { max_time_used = time_used[i]; expected.clear(); }
+            if (time_used[i] == max_time_used) expected.push_back(i);
+          }
+          ok = (maxList(index) == expected) && (index.GetMaxKey() == max_time_used);
+        }
+      }
+      ReportTestResult("Max Time Used Cell (FindMaxTimeUsedCell)", ok);
+    }
+    
+    // Boundaries: an empty index, and a single item
+    {
+      cTournamentIndex empty(0);
+      cTournamentIndex one(1);
+      bool ok = (empty.GetNumMax() == 0 && empty.FindMax() == -1 && one.GetNumMax() == 0 && one.FindMax() == -1);
+      one.SetKey(0, 5);
+      ok = ok && (one.GetNumMax() == 1 && one.FindMax() == 0 && one.GetMaxKey() == 5);
+      one.SetKey(0, cTournamentIndex::NO_KEY);
+      ReportTestResult("Empty and Single Item", ok && one.GetNumMax() == 0);
+    }
+  }
+};
+
+
+#include "avida/core/InstructionSequence.h"
+
+class InstructionSequenceDistanceTests : public cUnitTest
+{
+public:
+  const char* GetUnitName() { return "InstructionSequence Distances"; }
+private:
+  typedef Avida::Instruction Instruction;
+  typedef Avida::InstructionSequence InstructionSequence;
+  
+  Apto::RNG::AvidaRNG m_rng;
+  
+  // The full dynamic programming chart, as computed before the bit-parallel version
+  static int referenceEditDistance(const InstructionSequence& seq1, const InstructionSequence& seq2)
+  {
+    const int size1 = seq1.GetSize();
+    const int size2 = seq2.GetSize();
+    std::vector<int> prev_row(size1 + 1);
+    std::vector<int> cur_row(size1 + 1);
+    for (int j = 0; j <= size1; j++) prev_row[j] = j;
+    for (int i = 1; i <= size2; i++) {
+      cur_row[0] = i;
+      for (int j = 1; j <= size1; j++) {
+        if (seq1[j - 1] == seq2[i - 1]) {
+          cur_row[j] = prev_row[j - 1];
+        } else {
+          cur_row[j] = (prev_row[j] < prev_row[j - 1]) ? prev_row[j] : prev_row[j - 1];
+          if (cur_row[j - 1] < cur_row[j]) cur_row[j] = cur_row[j - 1];
+          cur_row[j]++;
+        }
+      }
+      prev_row.swap(cur_row);
+    }
+    return prev_row[size1];
+  }
+  
+  // The site by site comparison, as computed before the eight sites at a time version
+  static int referenceHammingDistance(const InstructionSequence& seq1, const InstructionSequence& seq2, int offset)
+  {
+    const int start1 = (offset < 0) ? 0 : offset;
+    const int start2 = (offset > 0) ? 0 : -offset;
+    const int overlap = InstructionSequence::FindOverlap(seq1, seq2, offset);
+    int hamming_distance = seq1.GetSize() + seq2.GetSize() - 2 * overlap;
+    for (int i = 0; i < overlap; i++) if (seq1[start1 + i] != seq2[start2 + i]) hamming_distance++;
+    return hamming_distance;
+  }
+  
+  InstructionSequence randomSequence(int size, int alphabet)
+  {
+    InstructionSequence seq(size);
+    for (int i = 0; i < size; i++) seq[i] = Instruction(m_rng.GetUInt(alphabet));
+    return seq;
+  }
+  
+  // A copy of seq with num_edits random substitutions, insertions and deletions
+  InstructionSequence mutant(const InstructionSequence& seq, int num_edits, int alphabet)
+  {
+    InstructionSequence out(seq);
+    for (int i = 0; i < num_edits; i++) {
+      const int kind = m_rng.GetUInt(3);
+      if (kind == 0 && out.GetSize()) out[m_rng.GetUInt(out.GetSize())] = Instruction(m_rng.GetUInt(alphabet));
+      else if (kind == 1 && out.GetSize()) out.Remove(m_rng.GetUInt(out.GetSize()));
+      else out.Insert(m_rng.GetUInt(out.GetSize() + 1), Instruction(m_rng.GetUInt(alphabet)));
+    }
+    return out;
+  }
+  
+public:
+  InstructionSequenceDistanceTests() : m_rng(42) { ; }
+  
+protected:
+  void RunTests()
+  {
+    // Word and block boundaries of the bit-parallel and eight site implementations
+    const int lengths[] = { 0, 1, 7, 8, 9, 63, 64, 65, 127, 128, 129, 64 * 3 + 1, 64 * 5 + 17 };
+    const int num_lengths = sizeof(lengths) / sizeof(int);
+    const int alphabets[] = { 2, 26, 256 };
+    
+    bool edit_ok = true;
+    bool edit_batch_ok = true;
+    bool edit_related_ok = true;
+    bool hamming_ok = true;
+    bool hamming_batch_ok = true;
+    for (int a = 0; a < 3; a++) {
+      const int alphabet = alphabets[a];
+      for (int i = 0; i < num_lengths; i++) {
+        const InstructionSequence seq1 = randomSequence(lengths[i], alphabet);
+        
+        Apto::Array<const InstructionSequence*> seqs;
+        Apto::Array<InstructionSequence> others(num_lengths);
+        for (int j = 0; j < num_lengths; j++) {
+          others[j] = randomSequence(lengths[j], alphabet);
+          seqs.Push(&others[j]);
+          
+          // Unrelated sequences of every pair of lengths
+          edit_ok = edit_ok && (InstructionSequence::FindEditDistance(seq1, others[j]) == referenceEditDistance(seq1, others[j]));
+          
+          // Related sequences, so that the shared prefix and suffix trimming comes into play
+          const InstructionSequence related = mutant(seq1, 1 + m_rng.GetUInt(lengths[j] / 8 + 1), alphabet);
+          edit_related_ok = edit_related_ok &&
+            (InstructionSequence::FindEditDistance(seq1, related) == referenceEditDistance(seq1, related)) &&
+            (InstructionSequence::FindEditDistance(related, seq1) == referenceEditDistance(related, seq1));
+          
+          // Every offset at which the two sequences overlap
+          if (lengths[i] && lengths[j]) {
+            for (int offset = 1 - lengths[j]; offset < lengths[i]; offset++) {
+              hamming_ok = hamming_ok && (InstructionSequence::FindHammingDistance(seq1, others[j], offset) ==
+                                          referenceHammingDistance(seq1, others[j], offset));
+            }
+          }
+        }
+        
+        // The batch versions, which build the pattern for seq1 once and skip the trimming
+        Apto::Array<int> distances;
+        InstructionSequence::FindEditDistances(seq1, seqs, distances);
+        for (int j = 0; j < num_lengths; j++) {
+          edit_batch_ok = edit_batch_ok && (distances[j] == referenceEditDistance(seq1, others[j]));
+        }
+        if (lengths[i]) {
+          Apto::Array<const InstructionSequence*> nonempty;
+          for (int j = 0; j < num_lengths; j++) if (lengths[j]) nonempty.Push(&others[j]);
+          InstructionSequence::FindHammingDistances(seq1, nonempty, distances);
+          for (int j = 0; j < nonempty.GetSize(); j++) {
+            hamming_batch_ok = hamming_batch_ok && (distances[j] == referenceHammingDistance(seq1, *nonempty[j], 0));
+          }
+        }
+      }
+    }
+    ReportTestResult("FindEditDistance (random, boundary lengths)", edit_ok);
+    ReportTestResult("FindEditDistance (related sequences)", edit_related_ok);
+    ReportTestResult("FindEditDistances", edit_batch_ok);
+    ReportTestResult("FindHammingDistance (all offsets)", hamming_ok);
+    ReportTestResult("FindHammingDistances", hamming_batch_ok);
+    
+    // Longer random sequences, several blocks past the boundaries above
+    bool long_ok = true;
+    for (int t = 0; t < 20; t++) {
+      const InstructionSequence seq1 = randomSequence(300 + m_rng.GetUInt(700), 26);
+      const InstructionSequence seq2 = (t % 2) ? mutant(seq1, m_rng.GetUInt(100), 26) : randomSequence(m_rng.GetUInt(1000), 26);
+      long_ok = long_ok && (InstructionSequence::FindEditDistance(seq1, seq2) == referenceEditDistance(seq1, seq2));
+      if (seq2.GetSize()) {
+        long_ok = long_ok && (InstructionSequence::FindHammingDistance(seq1, seq2) == referenceHammingDistance(seq1, seq2, 0));
+      }
+    }
+    ReportTestResult("Long Sequences", long_ok);
+  }
+};
+
+
+
+
+#include "avida/core/Genome.h"
+#include "avida/private/systematics/HistoricStore.h"
+#include "cHardwareManager.h"
+
+#include <fstream>
+#include <string>
+
+class HistoricStoreTests : public cUnitTest
+{
+public:
+  const char* GetUnitName() { return "HistoricStore"; }
+private:
+  typedef Avida::Genome Genome;
+  typedef Avida::Instruction Instruction;
+  typedef Avida::InstructionSequence InstructionSequence;
+  typedef Avida::Systematics::HistoricStore HistoricStore;
+  
+  // A frozen genome as the arbiter tracks it: its record, and the entry of the parent it was encoded against (if any)
+  struct sFrozen
+  {
+    int record;
+    int parent;
+    Genome genome;
+  };
+  
+  Apto::RNG::AvidaRNG m_rng;
+  
+  static Genome makeGenome(const InstructionSequence& seq, const char* inst_set = "heads_default", int hw_type = 0)
+  {
+    Avida::HashPropertyMap props;
+    cHardwareManager::SetupPropertyMap(props, inst_set);
+    return Genome(hw_type, props, Avida::GeneticRepresentationPtr(new InstructionSequence(seq)));
+  }
+  
+  static const InstructionSequence& sequenceOf(const Genome& genome)
+  {
+    Avida::ConstInstructionSequencePtr seq;
+    seq.DynamicCastFrom(genome.Representation());
+    return *seq;
+  }
+  
+  InstructionSequence randomSequence(int size)
+  {
+    InstructionSequence seq(size);
+    for (int i = 0; i < size; i++) seq[i] = Instruction(m_rng.GetUInt(26));
+    return seq;
+  }
+  
+  // A single substitution, insertion or deletion, as a birth would make
+  InstructionSequence mutant(const InstructionSequence& seq)
+  {
+    InstructionSequence out(seq);
+    const int kind = m_rng.GetUInt(3);
+    if (kind == 0) {
+      const int site = m_rng.GetUInt(out.GetSize());
+      out[site] = Instruction((out[site].GetOp() + 1 + m_rng.GetUInt(25)) % 26);
+    } else if (kind == 1 && out.GetSize() > 1) {
+      out.Remove(m_rng.GetUInt(out.GetSize()));
+    } else {
+      out.Insert(m_rng.GetUInt(out.GetSize() + 1), Instruction(m_rng.GetUInt(26)));
+    }
+    return out;
+  }
+  
+  // Freezes genome the way Genotype::Freeze() does, against its parent when the parent's chain has room
+  static sFrozen freeze(HistoricStore& store, const Genome& genome, const Apto::Array<sFrozen>& frozen, int parent)
+  {
+    sFrozen entry;
+    entry.parent = parent;
+    entry.genome = genome;
+    if (parent >= 0 && store.Chain(frozen[parent].record) < HistoricStore::MAX_CHAIN) {
+      entry.record = store.Add(genome, &frozen[parent].genome, frozen[parent].record);
+    } else {
+      entry.record = store.Add(genome);
+      entry.parent = -1;
+    }
+    for (int i = 0; i < HistoricStore::NUM_STATS; i++) {
+      store.SetStat(entry.record, (HistoricStore::Statistic)i, entry.record * 10.0 + i + 0.5);
+    }
+    store.SetTotalGestation(entry.record, entry.record * 3);
+    return entry;
+  }
+  
+  // Thaws an entry the way Genotype::Thaw() does, decoding its chain of parents from the keyframe down
+  static Genome thaw(const HistoricStore& store, const Apto::Array<sFrozen>& frozen, int idx)
+  {
+    Genome genome;
+    if (frozen[idx].parent < 0) {
+      store.Decode(frozen[idx].record, NULL, genome);
+    } else {
+      const Genome base = thaw(store, frozen, frozen[idx].parent);
+      store.Decode(frozen[idx].record, &base, genome);
+    }
+    return genome;
+  }
+  
+  static bool thawsAll(const HistoricStore& store, const Apto::Array<sFrozen>& frozen, const Apto::Array<bool>& live)
+  {
+    for (int i = 0; i < frozen.GetSize(); i++) {
+      if (!live[i]) continue;
+      if (thaw(store, frozen, i).AsString() != frozen[i].genome.AsString()) return false;
+      for (int s = 0; s < HistoricStore::NUM_STATS; s++) {
+        if (store.Stat(frozen[i].record, (HistoricStore::Statistic)s) != frozen[i].record * 10.0 + s + 0.5) return false;
+      }
+      if (store.TotalGestation(frozen[i].record) != frozen[i].record * 3) return false;
+    }
+    return true;
+  }
+  
+  static bool fileExists(const char* path)
+  {
+    std::ifstream file(path);
+    return file.good();
+  }
+  
+  // Runs every test against stores built with the given spill settings, as HISTORIC_SPILL_MB would configure them
+  void testStore(const char* label, const Apto::String& spill_path, int resident_mb)
+  {
+    const std::string prefix = std::string(label) + ": ";
+    
+    // Delta chains: a straight lineage of mutants, each encoded against its parent until the chain is full
+    {
+      HistoricStore store(spill_path, resident_mb);
+      Apto::Array<sFrozen> frozen;
+      Apto::Array<bool> live;
+      bool chain_ok = true;
+      Genome genome = makeGenome(randomSequence(100));
+      for (int i = 0; i < 5 * (HistoricStore::MAX_CHAIN + 1); i++) {
+        frozen.Push(freeze(store, genome, frozen, i - 1));
+        live.Push(true);
+        const int expected = i % (HistoricStore::MAX_CHAIN + 1);
+        chain_ok = chain_ok && store.Chain(frozen[i].record) == expected &&
+                   store.IsDelta(frozen[i].record) == (expected > 0);
+        genome = makeGenome(mutant(sequenceOf(genome)));
+      }
+      const std::string name = prefix + "Delta Chains up to MAX_CHAIN";
+      ReportTestResult(name.c_str(), chain_ok && store.GetSize() == frozen.GetSize() && thawsAll(store, frozen, live));
+    }
+    
+    // Keyframe fallback: past a full chain, across instruction sets or hardware types, and with nothing in common
+    {
+      HistoricStore store(spill_path, resident_mb);
+      const InstructionSequence seq = randomSequence(50);
+      const Genome base = makeGenome(seq);
+      const InstructionSequence child_seq = mutant(seq);
+      int record = store.Add(base);
+      for (int i = 0; i < HistoricStore::MAX_CHAIN; i++) record = store.Add(base, &base, record);
+      const bool full = (store.Chain(record) == HistoricStore::MAX_CHAIN);
+      
+      InstructionSequence disjoint(seq);
+      for (int i = 0; i < disjoint.GetSize(); i++) disjoint[i] = Instruction((seq[i].GetOp() + 1) % 26);
+      const Genome keyframes[] = {
+        makeGenome(child_seq), makeGenome(child_seq, "heads_sex"), makeGenome(child_seq, "heads_default", 1),
+        makeGenome(disjoint), makeGenome(child_seq)
+      };
+      const int records[] = {
+        store.Add(keyframes[0], &base, record), store.Add(keyframes[1], &base, 0), store.Add(keyframes[2], &base, 0),
+        store.Add(keyframes[3], &base, 0), store.Add(keyframes[4], NULL, 0)
+      };
+      
+      bool ok = full;
+      for (int i = 0; i < 5; i++) {
+        Genome decoded;
+        store.Decode(records[i], NULL, decoded);
+        ok = ok && !store.IsDelta(records[i]) && store.Chain(records[i]) == 0 &&
+             decoded.AsString() == keyframes[i].AsString();
+      }
+      const std::string name = prefix + "Keyframe Fallback";
+      ReportTestResult(name.c_str(), ok);
+    }
+    
+    // Freeze and thaw across a branching lineage, with removals whose records are then reused
+    {
+      HistoricStore store(spill_path, resident_mb);
+      Apto::Array<sFrozen> frozen;
+      Apto::Array<bool> live;
+      frozen.Push(freeze(store, makeGenome(randomSequence(80)), frozen, -1));
+      live.Push(true);
+      for (int i = 1; i < 2000; i++) {
+        const int parent = m_rng.GetUInt(frozen.GetSize());
+        frozen.Push(freeze(store, makeGenome(mutant(sequenceOf(frozen[parent].genome))), frozen, parent));
+        live.Push(true);
+      }
+      const bool thawed = thawsAll(store, frozen, live);
+      
+      // Only records that nothing was encoded against are removed, as only those are ever pruned by the arbiter
+      Apto::Array<bool> is_base(frozen.GetSize());
+      for (int i = 0; i < frozen.GetSize(); i++) is_base[i] = false;
+      for (int i = 0; i < frozen.GetSize(); i++) if (frozen[i].parent >= 0) is_base[frozen[i].parent] = true;
+      Apto::Array<int> freed;
+      for (int i = 0; i < frozen.GetSize(); i++) {
+        if (is_base[i] || m_rng.GetUInt(2)) continue;
+        store.Remove(frozen[i].record);
+        freed.Push(frozen[i].record);
+        live[i] = false;
+      }
+      const bool sized = (store.GetSize() == frozen.GetSize() - freed.GetSize());
+      
+      bool reused = true;
+      for (int i = 0; i < freed.GetSize(); i++) {
+        int parent = m_rng.GetUInt(frozen.GetSize());
+        while (!live[parent]) parent = m_rng.GetUInt(frozen.GetSize());
+        frozen.Push(freeze(store, makeGenome(mutant(sequenceOf(frozen[parent].genome))), frozen, parent));
+        live.Push(true);
+        bool found = false;
+        for (int f = 0; f < freed.GetSize(); f++) found = found || (freed[f] == frozen[frozen.GetSize() - 1].record);
+        reused = reused && found;
+      }
+      const std::string name = prefix + "Freeze/Thaw";
+      ReportTestResult(name.c_str(), thawed && sized && reused && thawsAll(store, frozen, live));
+    }
+    
+    // Enough keyframes to fill several chunks, which are spilled and mapped back in when a spill path is set
+    {
+      bool spilled = false;
+      bool ok = true;
+      {
+        HistoricStore store(spill_path, resident_mb);
+        Apto::Array<sFrozen> frozen;
+        Apto::Array<bool> live;
+        for (int i = 0; i < 6 * HistoricStore::CHUNK_SIZE / 1000; i++) {
+          frozen.Push(freeze(store, makeGenome(randomSequence(1000)), frozen, -1));
+          live.Push(true);
+        }
+        spilled = (spill_path.GetSize() > 0 && fileExists(spill_path));
+        ok = thawsAll(store, frozen, live);
+        
+        // Emptying whole chunks releases them, spilled or resident, and later records reuse the space
+        const int num_removed = frozen.GetSize() / 2;
+        for (int i = 0; i < num_removed; i++) {
+          store.Remove(frozen[i].record);
+          live[i] = false;
+        }
+        for (int i = 0; i < 2 * HistoricStore::CHUNK_SIZE / 1000; i++) {
+          frozen.Push(freeze(store, makeGenome(randomSequence(1000)), frozen, -1));
+          live.Push(true);
+        }
+        ok = ok && store.GetSize() == frozen.GetSize() - num_removed && thawsAll(store, frozen, live);
+        for (int i = 0; i < frozen.GetSize(); i++) if (live[i]) store.Remove(frozen[i].record);
+        ok = ok && store.GetSize() == 0;
+      }
+      const bool cleaned_up = (spill_path.GetSize() == 0 || !fileExists(spill_path));
+      
+      const std::string name = prefix + "Spill/Decode Round Trip";
+#if APTO_PLATFORM(WINDOWS)
+      ReportTestResult(name.c_str(), ok && cleaned_up);  // spilling relies on mmap
+#else
+      ReportTestResult(name.c_str(), ok && cleaned_up && spilled == (resident_mb > 0));
+#endif
+    }
+  }
+  
+public:
+  HistoricStoreTests() : m_rng(7) { ; }
+  
+protected:
+  void RunTests()
+  {
+    testStore("Resident", "", 0);
+    testStore("Spilled", "historic-spill.unit-test", 1);
+  }
+};
+
+
+
+
+#include "avida/core/World.h"
+#include "avida/data/Manager.h"
+#include "avida/environment/Manager.h"
+#include "avida/private/systematics/GenotypeArbiter.h"
+#include "avida/systematics/Unit.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+class GenotypeArbiterLineageTests : public cUnitTest
+{
+public:
+  const char* GetUnitName() { return "GenotypeArbiter Lineage"; }
+private:
+  typedef Avida::Systematics::GroupPtr GroupPtr;
+  typedef Avida::Systematics::UnitPtr UnitPtr;
+
+  class cLineageUnit : public Avida::Systematics::Unit
+  {
+  private:
+    Avida::Systematics::Source m_src;
+    Avida::Genome m_genome;
+    Avida::HashPropertyMap m_props;
+
+  public:
+    cLineageUnit(const Avida::Genome& genome, bool external, const Avida::PropertyDescriptionMap& desc)
+      : m_src(Avida::Systematics::DIVISION, "", external), m_genome(genome)
+    {
+      m_props.Define(Avida::PropertyPtr(new Avida::IntProperty("generation", desc, 0)));
+    }
+    ~cLineageUnit() { ; }
+
+    Avida::Systematics::Source UnitSource() const { return m_src; }
+    const Avida::Genome& UnitGenome() const { return m_genome; }
+    const Avida::PropertyMap& Properties() const { return m_props; }
+  };
+
+  Avida::PropertyDescriptionMap m_desc;
+  Apto::RNG::AvidaRNG m_rng;
+  Avida::World* m_world;
+  Avida::Systematics::GenotypeArbiterPtr m_arbiter;
+
+  std::vector<UnitPtr> m_living;
+  std::map<int, int> m_parent;      // First parent of every genotype ever created (-1 for the root)
+  std::map<int, int> m_depth;
+  std::set<int> m_tracked;          // Genotypes still held by the arbiter
+  int m_next_genome;
+
+  // The coalescent as the full walk from the best genotype finds it, updated whenever the arbiter updates its own
+  int m_coalescent;
+  int m_coalescent_checks;
+  bool m_coalescent_ok;
+
+  Avida::Genome makeGenome(int serial, const Avida::Genome* parent)
+  {
+    Avida::InstructionSequence* seq = new Avida::InstructionSequence(20);
+    for (int i = 0; i < 20; i++) {
+      (*seq)[i] = (parent) ? sequenceOf(*parent)[i] : Avida::Instruction(m_rng.GetUInt(26));
+    }
+    // The serial number, written into the leading sites, makes every genome unique
+    for (int i = 0; i < 6; i++, serial /= 26) (*seq)[i] = Avida::Instruction(serial % 26);
+
+    Avida::HashPropertyMap props;
+    cHardwareManager::SetupPropertyMap(props, "heads_default");
+    return Avida::Genome(0, props, Avida::GeneticRepresentationPtr(seq));
+  }
+
+  static const Avida::InstructionSequence& sequenceOf(const Avida::Genome& genome)
+  {
+    Avida::ConstInstructionSequencePtr seq;
+    seq.DynamicCastFrom(genome.Representation());
+    return *seq;
+  }
+
+  int genotypeOf(const UnitPtr& unit) { return unit->SystematicsGroup("genotype")->ID(); }
+
+  void track(const GroupPtr& group, int parent_id)
+  {
+    if (m_parent.count(group->ID())) return;
+    m_parent[group->ID()] = parent_id;
+    m_depth[group->ID()] = (parent_id < 0) ? 0 : m_depth[parent_id] + 1;
+    m_tracked.insert(group->ID());
+  }
+
+  void setup()
+  {
+    m_world = new Avida::World;
+    Avida::Data::ManagerPtr(new Avida::Data::Manager)->AttachTo(m_world);
+    Avida::Environment::ManagerPtr(new Avida::Environment::Manager)->AttachTo(m_world);
+    m_arbiter = Avida::Systematics::GenotypeArbiterPtr(new Avida::Systematics::GenotypeArbiter(m_world, "genotype", 3));
+
+    m_parent.clear();
+    m_depth.clear();
+    m_tracked.clear();
+    m_next_genome = 0;
+    m_coalescent = -1;
+    m_coalescent_checks = 0;
+    m_coalescent_ok = true;
+
+    UnitPtr root(new cLineageUnit(makeGenome(m_next_genome++, NULL), true, m_desc));
+    GroupPtr group = m_arbiter->ClassifyNewUnit(root, static_cast<const Avida::Systematics::ClassificationHints*>(NULL));
+    root->AddClassification(group);
+    track(group, -1);
+    m_living.push_back(root);
+  }
+
+  void teardown()
+  {
+    while (!m_living.empty()) kill(m_living.size() - 1);
+    m_arbiter = Avida::Systematics::GenotypeArbiterPtr(NULL);
+    delete m_world;
+  }
+
+  // A birth from the unit at idx, either a copy of the parent or a new genotype
+  int birth(int idx, bool copy)
+  {
+    const UnitPtr parent = m_living[idx];
+    GroupPtr parent_group = parent->SystematicsGroup("genotype");
+    if (copy && parent_group->ID() == m_coalescent) m_coalescent = -1;  // adjusting the coalescent resets it
+
+    const Avida::Genome genome = (copy) ? parent->UnitGenome() : makeGenome(m_next_genome++, &parent->UnitGenome());
+    UnitPtr child(new cLineageUnit(genome, false, m_desc));
+    Avida::Systematics::GroupMembershipPtr parents(new Avida::Systematics::GroupMembership(1));
+    (*parents)[0] = parent_group;
+    GroupPtr group = parent_group->ClassifyNewUnit(child, parents);
+    child->AddClassification(group);
+    track(group, parent_group->ID());
+
+    m_living.push_back(child);
+    return m_living.size() - 1;
+  }
+
+  void kill(int idx)
+  {
+    if (genotypeOf(m_living[idx]) == m_coalescent) m_coalescent = -1;
+    m_living[idx] = m_living.back();
+    m_living.pop_back();
+
+    // The arbiter updates the coalescent whenever it removes a genotype that has parents
+    bool updated = false;
+    for (std::set<int>::iterator it = m_tracked.begin(); it != m_tracked.end();) {
+      if (m_arbiter->Group(*it)) {
+        it++;
+      } else {
+        if (m_parent[*it] >= 0) updated = true;
+        m_tracked.erase(it++);
+      }
+    }
+    if (!updated) return;
+
+    m_coalescent = walkCoalescent();
+    const int depth = (m_coalescent >= 0) ? m_depth[m_coalescent] : -1;
+    const int found = m_arbiter->GetProvidedValue("systematics.genotype.coalescent_depth")->IntValue();
+    m_coalescent_ok = m_coalescent_ok && (found == depth);
+    m_coalescent_checks++;
+  }
+
+  bool isCoalescent(int g_id)
+  {
+    GroupPtr group = m_arbiter->Group(g_id);
+    return group && (group->ActiveReferenceCount() > 0 || group->PassiveReferenceCount() > 1);
+  }
+
+  // The coalescent search as it was before the incremental version: keep the last coalescent while it still qualifies,
+  // otherwise walk the whole lineage of the best genotype for the oldest genotype (below the root) with units or branches
+  int walkCoalescent()
+  {
+    if (m_coalescent >= 0 && isCoalescent(m_coalescent)) return m_coalescent;
+    if (m_living.empty()) return -1;
+
+    Avida::Systematics::Arbiter::IteratorPtr it = m_arbiter->Begin();
+    int test_id = it->Next()->ID();
+    int found_id = test_id;
+    while (m_parent[test_id] >= 0) {
+      if (isCoalescent(test_id)) found_id = test_id;
+      test_id = m_parent[test_id];
+    }
+    return found_id;
+  }
+
+  // Every ancestor of g_id, found by following the parents one at a time, against AncestorAtDepth and IsAncestor
+  bool ancestryMatches(int g_id)
+  {
+    const int depth = m_depth[g_id];
+    if (m_arbiter->Group(g_id)->Depth() != depth) return false;
+
+    int ancestor = g_id;
+    for (int d = depth; d >= 0; d--) {
+      GroupPtr found = m_arbiter->AncestorAtDepth(g_id, d);
+      if (!found || found->ID() != ancestor || !m_arbiter->IsAncestor(ancestor, g_id)) return false;
+      if (d < depth && m_arbiter->IsAncestor(g_id, ancestor)) return false;
+      ancestor = m_parent[ancestor];
+    }
+    return !m_arbiter->AncestorAtDepth(g_id, depth + 1) && !m_arbiter->AncestorAtDepth(g_id, -1);
+  }
+
+  // IsAncestor for random pairs of tracked genotypes, most of them unrelated
+  bool randomPairsMatch(int num_pairs)
+  {
+    std::vector<int> ids(m_tracked.begin(), m_tracked.end());
+    for (int i = 0; i < num_pairs; i++) {
+      const int ancestor = ids[m_rng.GetUInt(ids.size())];
+      const int g_id = ids[m_rng.GetUInt(ids.size())];
+      bool expected = false;
+      for (int walk = g_id; walk >= 0 && !expected; walk = m_parent[walk]) expected = (walk == ancestor);
+      if (m_arbiter->IsAncestor(ancestor, g_id) != expected) return false;
+    }
+    return true;
+  }
+
+  // Genotypes the arbiter has removed are neither found at any depth nor anyone's ancestor
+  bool removedMissing()
+  {
+    const int root_id = *m_tracked.begin();
+    for (std::map<int, int>::iterator it = m_parent.begin(); it != m_parent.end(); it++) {
+      if (m_tracked.count(it->first)) continue;
+      if (m_arbiter->AncestorAtDepth(it->first, 0) || m_arbiter->IsAncestor(root_id, it->first) ||
+          m_arbiter->IsAncestor(it->first, *m_tracked.rbegin())) return false;
+    }
+    return true;
+  }
+
+  bool sampleMatches(int stride)
+  {
+    int i = 0;
+    for (std::set<int>::iterator it = m_tracked.begin(); it != m_tracked.end(); it++, i++) {
+      if ((i % stride) == 0 && !ancestryMatches(*it)) return false;
+    }
+    return ancestryMatches(*m_tracked.rbegin());
+  }
+
+public:
+  GenotypeArbiterLineageTests() : m_rng(11), m_world(NULL) { ; }
+
+protected:
+  void RunTests()
+  {
+    // Deep lineage: every generation buds off a side branch that dies at once, so that the coalescent is found again
+    // one step further down each time.  Every hundredth branch lives on for a while, holding the coalescent far back.
+    {
+      setup();
+      std::vector<int> held;
+      for (int step = 0; step < 3000; step++) {
+        const int parent = m_living.size() - 1;
+        const int side = birth(parent, false);
+        if (step % 100 == 0) {
+          held.push_back(genotypeOf(m_living[side]));
+        } else {
+          kill(side);
+        }
+        const int next = birth(parent, false);
+        std::swap(m_living[next], m_living[m_living.size() - 1]);
+        kill(parent);
+        std::swap(m_living[parent], m_living[m_living.size() - 1]);
+        if (step % 250 == 249) {
+          // Drop the held branches, leaving only the main line
+          while (m_living.size() > 1) kill(m_living.size() - 2);
+          held.clear();
+        }
+      }
+      const int deepest = genotypeOf(m_living.back());
+      const bool deep = (m_depth[deepest] == 3000);
+
+      ReportTestResult("Deep Lineage: AncestorAtDepth/IsAncestor", deep && removedMissing() && sampleMatches(37) &&
+                       ancestryMatches(deepest) && randomPairsMatch(2000));
+      ReportTestResult("Deep Lineage: Incremental Coalescent", m_coalescent_checks > 2000 && m_coalescent_ok);
+      teardown();
+    }
+
+    // Branching lineage: random births (a third of them copies of the parent) and deaths in a population of about 100
+    {
+      setup();
+      bool lineage_ok = true;
+      for (int event = 1; event <= 20000; event++) {
+        if (m_living.size() < 100 || m_rng.GetUInt(2)) {
+          birth(m_rng.GetUInt(m_living.size()), m_rng.GetUInt(3) == 0);
+        } else {
+          kill(m_rng.GetUInt(m_living.size()));
+        }
+        if (event % 2000 == 0) lineage_ok = lineage_ok && sampleMatches(7) && randomPairsMatch(500);
+      }
+      ReportTestResult("Branching Lineage: AncestorAtDepth/IsAncestor", lineage_ok);
+
+      // Dying out entirely, the coalescent ends up cleared
+      teardown();
+      ReportTestResult("Branching Lineage: Incremental Coalescent",
+                       m_coalescent_checks > 1000 && m_coalescent_ok && m_coalescent == -1);
+    }
+  }
+};
+
+
 
 
 #define TEST(CLASS) \
@@ -333,6 +1327,11 @@ int main(int argc, const char* argv[])
   
   TEST(cRawBitArray);
   TEST(cBitArray);
+  TEST(ProbeTable);
+  TEST(cTournamentIndex);
+  TEST(InstructionSequenceDistance);
+  TEST(HistoricStore);
+  TEST(GenotypeArbiterLineage);
   
   if (failed == 0)
     cout << "All unit tests passed." << endl;
@@ -24,6 +24,7 @@
 
 class cCountTracker
 {
+  friend class cCheckpoint;
 private:
   int cur_count;
   int last_count;
@@ -39,6 +40,7 @@ public:
 
   inline void Inc() { cur_count++; total_count++; }
   inline void Dec() { cur_count--; }
+  inline void AddTotal(int count) { total_count += count; }
   inline void Next() { last_count = cur_count; cur_count = 0; }
   inline void Clear() { cur_count = last_count = total_count = 0; }
 };
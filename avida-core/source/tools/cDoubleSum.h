@@ -28,6 +28,7 @@
 #include <limits>
 
 class cDoubleSum {
+  friend class cCheckpoint;
 private:
   double s1;  // Sum (x)
   double s2;  // Sum of squared x (x^2)
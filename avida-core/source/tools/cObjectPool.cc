@@ -0,0 +1,130 @@
+/*
+ *  cObjectPool.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cObjectPool.h"
+
+#include <new>
+
+
+cObjectPool::cObjectPool(size_t block_size, int slab_blocks)
+: m_block_size(block_size), m_slab_blocks(slab_blocks), m_free_list(NULL), m_in_use(0)
+{
+  // Every block must be able to hold a free list link, and stay suitably aligned for any object
+  const size_t align = sizeof(double) > sizeof(void*) ? sizeof(double) : sizeof(void*);
+  if (m_block_size < sizeof(sFreeBlock)) m_block_size = sizeof(sFreeBlock);
+  m_block_size = (m_block_size + align - 1) / align * align;
+  if (m_slab_blocks < 1) m_slab_blocks = 1;
+}
+
+cObjectPool::~cObjectPool()
+{
+  for (int i = 0; i < m_slabs.GetSize(); i++) ::operator delete(m_slabs[i]);
+}
+
+
+void cObjectPool::addSlab()
+{
+  char* slab = static_cast<char*>(::operator new(m_block_size * m_slab_blocks));
+  m_slabs.Push(slab);
+
+  // Thread the new blocks onto the free list in address order
+  for (int i = m_slab_blocks - 1; i >= 0; i--) {
+    sFreeBlock* block = reinterpret_cast<sFreeBlock*>(slab + i * m_block_size);
+    block->next = m_free_list;
+    m_free_list = block;
+  }
+}
+
+
+void* cObjectPool::Allocate()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  if (!m_free_list) addSlab();
+
+  sFreeBlock* block = m_free_list;
+  m_free_list = block->next;
+  m_in_use++;
+  return block;
+}
+
+void cObjectPool::Free(void* ptr)
+{
+  if (!ptr) return;
+
+  Apto::MutexAutoLock lock(m_mutex);
+  sFreeBlock* block = static_cast<sFreeBlock*>(ptr);
+  block->next = m_free_list;
+  m_free_list = block;
+  m_in_use--;
+}
+
+
+int cObjectPool::GetNumInUse()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_in_use;
+}
+
+int cObjectPool::GetNumSlabs()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+  return m_slabs.GetSize();
+}
+
+
+// The size class pools are all created before main() runs, while the process is still single threaded, and are
+// intentionally never destroyed.  Lookups then only read the table, without taking a lock.  A lookup made during
+// static initialization, before s_size_class_init has run, creates the table itself.
+static cObjectPool** s_size_classes = NULL;
+
+static cObjectPool** sizeClasses()
+{
+  if (!s_size_classes) {
+    cObjectPool** pools = new cObjectPool*[cObjectPool::NUM_SIZE_CLASSES];
+    pools[0] = NULL;
+    for (int i = 1; i < cObjectPool::NUM_SIZE_CLASSES; i++) pools[i] = new cObjectPool(i * cObjectPool::SIZE_CLASS_STEP);
+    s_size_classes = pools;
+  }
+  return s_size_classes;
+}
+
+static struct sSizeClassInit { sSizeClassInit() { sizeClasses(); } } s_size_class_init;
+
+cObjectPool* cObjectPool::ForSize(size_t size)
+{
+  const size_t size_class = (size + SIZE_CLASS_STEP - 1) / SIZE_CLASS_STEP;
+  if (size_class == 0 || size_class >= (size_t)NUM_SIZE_CLASSES) return NULL;
+  return sizeClasses()[size_class];
+}
+
+void* cObjectPool::AllocateSized(size_t size)
+{
+  cObjectPool* pool = ForSize(size);
+  if (pool) return pool->Allocate();
+  return ::operator new(size);
+}
+
+void cObjectPool::FreeSized(void* ptr, size_t size)
+{
+  if (!ptr) return;
+  cObjectPool* pool = ForSize(size);
+  if (pool) pool->Free(ptr);
+  else ::operator delete(ptr);
+}
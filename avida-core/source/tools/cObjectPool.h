@@ -0,0 +1,85 @@
+/*
+ *  cObjectPool.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cObjectPool_h
+#define cObjectPool_h
+
+#include "apto/core.h"
+#include "apto/core/Mutex.h"
+
+#include <cstddef>
+
+
+/**
+ * Thread-safe pool of fixed size memory blocks, carved out of large slabs.  Freed blocks are kept on a free list and
+ * handed out again, so objects that are created and destroyed at a high rate (organisms and their hardware) do not
+ * go through the general purpose allocator each time.  Slab memory is only returned when the pool is destroyed.
+ *
+ * ForSize() returns a shared pool for a size class (multiples of SIZE_CLASS_STEP bytes), or NULL for sizes too large
+ * to be pooled.  Every size class pool is created at startup, so that looking one up takes no lock, and lives for the
+ * lifetime of the process, so objects may safely be released during exit.
+ **/
+
+class cObjectPool
+{
+public:
+  static const size_t SIZE_CLASS_STEP = 64;
+  static const int NUM_SIZE_CLASSES = 256;
+
+private:
+  struct sFreeBlock
+  {
+    sFreeBlock* next;
+  };
+
+  size_t m_block_size;
+  int m_slab_blocks;
+
+  Apto::Mutex m_mutex;
+  sFreeBlock* m_free_list;
+  Apto::Array<char*> m_slabs;
+  int m_in_use;
+
+
+  void addSlab();
+
+  cObjectPool(); // @not_implemented
+  cObjectPool(const cObjectPool&); // @not_implemented
+  cObjectPool& operator=(const cObjectPool&); // @not_implemented
+
+public:
+  cObjectPool(size_t block_size, int slab_blocks = 256);
+  ~cObjectPool();
+
+  void* Allocate();
+  void Free(void* ptr);
+
+  size_t GetBlockSize() const { return m_block_size; }
+  int GetNumInUse();
+  int GetNumSlabs();
+
+  static cObjectPool* ForSize(size_t size);
+
+  // Allocate from the pool for the size class of size, falling back on the global operator new
+  static void* AllocateSized(size_t size);
+  static void FreeSized(void* ptr, size_t size);
+};
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ *  cReplayRandom.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cReplayRandom_h
+#define cReplayRandom_h
+
+#include "apto/rng.h"
+
+
+/**
+ * The standard Avida random number generator, counting the values drawn from it since it was last seeded.  Its state
+ * is then fully described by its seed and that count, so that a checkpoint can restore it without reaching into the
+ * generator by reseeding and replaying the draws.  Restoring costs time in proportion to the number of draws, so a
+ * checkpoint first calls Rebase(), which reseeds the generator from its own stream and leaves nothing to replay.
+ **/
+
+class cReplayRandom : public Apto::RNG::AvidaRNG
+{
+private:
+  long long m_draws;
+
+public:
+  cReplayRandom(int seed = -1) : Apto::RNG::AvidaRNG(seed), m_draws(0) { ; }
+
+  void ResetSeed(int seed) { Apto::RNG::AvidaRNG::ResetSeed(seed); m_draws = 0; }
+
+  long long GetDraws() const { return m_draws; }
+  void Restore(int seed, long long draws) { ResetSeed(seed); while (m_draws < draws) getNext(); }
+  void Rebase() { ResetSeed(1 + GetInt(MaxSeed() - 1)); }
+
+protected:
+  double getNext() { m_draws++; return Apto::RNG::AvidaRNG::getNext(); }
+};
+
+#endif
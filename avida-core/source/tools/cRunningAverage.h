@@ -27,6 +27,7 @@
 
 class cRunningAverage
 {
+  friend class cCheckpoint;
 private:
   double* m_values;  // Array of actual values
   double m_s1;       // average
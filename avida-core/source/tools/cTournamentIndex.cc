@@ -0,0 +1,107 @@
+/*
+ *  cTournamentIndex.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cTournamentIndex.h"
+
+#include <cassert>
+
+
+const int cTournamentIndex::NO_KEY;
+
+
+cTournamentIndex::cTournamentIndex(int in_size)
+  : size(in_size)
+  , num_leaves(1)
+  , item_key(size)
+{
+  while (num_leaves < size) num_leaves *= 2;
+
+  // Node 0 is unused, the root is node 1, and item i sits at leaf node num_leaves + i
+  subtree_max.Resize(2 * num_leaves);
+  subtree_count.Resize(2 * num_leaves);
+  item_key.SetAll(NO_KEY);
+  subtree_max.SetAll(NO_KEY);
+  for (int node = 2 * num_leaves - 1; node > 0; node--) {
+    if (node >= num_leaves) subtree_count[node] = (node - num_leaves < size) ? 1 : 0;
+    else subtree_count[node] = subtree_count[GetLeftChild(node)] + subtree_count[GetRightChild(node)];
+  }
+  subtree_count[0] = 0;
+}
+
+cTournamentIndex::~cTournamentIndex()
+{
+}
+
+
+void cTournamentIndex::SetKey(int id, int in_key)
+{
+  assert(id >= 0 && id < size);
+  if (item_key[id] == in_key) return;
+  item_key[id] = in_key;
+
+  int node = num_leaves + id;
+  subtree_max[node] = in_key;
+
+  while (node > 1) {
+    node = GetParent(node);
+    const int left_node = GetLeftChild(node);
+    const int right_node = GetRightChild(node);
+
+    int best = subtree_max[left_node];
+    int count = subtree_count[left_node];
+    if (subtree_max[right_node] > best) {
+      best = subtree_max[right_node];
+      count = subtree_count[right_node];
+    } else if (subtree_max[right_node] == best) {
+      count += subtree_count[right_node];
+    }
+
+    // Once a subtree is unchanged, none of its ancestors can change either
+    if (subtree_max[node] == best && subtree_count[node] == count) break;
+    subtree_max[node] = best;
+    subtree_count[node] = count;
+  }
+}
+
+
+int cTournamentIndex::FindMax(int choice) const
+{
+  if (GetNumMax() == 0) return -1;
+  assert(choice >= 0 && choice < subtree_count[1]);
+
+  const int target = subtree_max[1];
+  int node = 1;
+  while (node < num_leaves) {
+    // Search the left subtree if the choice falls within it, otherwise the right subtree
+    const int left_node = GetLeftChild(node);
+    if (subtree_max[left_node] == target) {
+      if (choice < subtree_count[left_node]) {
+        node = left_node;
+        continue;
+      }
+      choice -= subtree_count[left_node];
+    }
+
+    node = GetRightChild(node);
+    assert(subtree_max[node] == target && choice < subtree_count[node]);
+  }
+
+  return node - num_leaves;
+}
@@ -0,0 +1,71 @@
+/*
+ *  cTournamentIndex.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cTournamentIndex_h
+#define cTournamentIndex_h
+
+#include "avida/core/Types.h"
+
+#include <climits>
+
+
+/**
+ * This class allows indecies to be assigned an integer key and then finds the index with the largest key.  Items are
+ * held, in order, at the leaves of a complete binary tree; each node keeps the largest key found in its subtree along
+ * with the number of items that share it, so that ties can be broken uniformly and are numbered in index order.
+ * Changing a key is O(log N).
+ **/
+
+class cTournamentIndex
+{
+public:
+  static const int NO_KEY = INT_MIN;  // Items with this key are never returned
+
+protected:
+  int size;
+  int num_leaves;                   // size rounded up to a power of two; leaf nodes follow the num_leaves - 1 inner nodes
+  Apto::Array<int> item_key;
+  Apto::Array<int> subtree_max;
+  Apto::Array<int> subtree_count;
+
+
+  cTournamentIndex(); // @not_implemented
+
+public:
+  cTournamentIndex(int in_size);
+  ~cTournamentIndex();
+
+  void SetKey(int id, int key);
+  int GetKey(int id) const { return item_key[id]; }
+  int GetSize() const { return size; }
+
+  // The largest key in the index, and the number of items holding it
+  int GetMaxKey() const { return subtree_max[1]; }
+  int GetNumMax() const { return (subtree_max[1] != NO_KEY) ? subtree_count[1] : 0; }
+
+  // Returns the choice'th (0 <= choice < GetNumMax()) item holding the largest key, counting up from index 0
+  int FindMax(int choice = 0) const;
+
+  int GetParent(int node) const     { return node / 2; }
+  int GetLeftChild(int node) const  { return 2*node; }
+  int GetRightChild(int node) const { return 2*node + 1; }
+};
+
+#endif
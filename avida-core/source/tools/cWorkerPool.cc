@@ -0,0 +1,110 @@
+/*
+ *  cWorkerPool.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cWorkerPool.h"
+
+
+cWorkerPool::cWorkerPool(int num_workers)
+: m_task(NULL), m_num_tasks(0), m_next_task(0), m_pending(0), m_terminate(false)
+{
+  // The calling thread always acts as worker 0, so only spawn the remainder
+  if (num_workers > 1) {
+    m_workers.Resize(num_workers - 1);
+    for (int i = 0; i < m_workers.GetSize(); i++) {
+      m_workers[i] = new cWorker(this, i + 1);
+      m_workers[i]->Start();
+    }
+  }
+}
+
+cWorkerPool::~cWorkerPool()
+{
+  m_mutex.Lock();
+  m_terminate = true;
+  m_mutex.Unlock();
+
+  m_cond.Broadcast();
+
+  for (int i = 0; i < m_workers.GetSize(); i++) {
+    m_workers[i]->Join();
+    delete m_workers[i];
+  }
+}
+
+
+void cWorkerPool::Execute(cTask& task, int num_tasks)
+{
+  if (num_tasks <= 0) return;
+
+  // Single threaded pools simply run the tasks in order
+  if (m_workers.GetSize() == 0) {
+    for (int i = 0; i < num_tasks; i++) task.Run(0, i);
+    return;
+  }
+
+  m_mutex.Lock();
+  m_task = &task;
+  m_num_tasks = num_tasks;
+  m_next_task = 0;
+  m_pending = num_tasks;
+  m_mutex.Unlock();
+
+  m_cond.Broadcast();
+
+  // Participate in the work until nothing is left to claim
+  m_mutex.Lock();
+  while (m_next_task < m_num_tasks) {
+    const int task_id = m_next_task++;
+    m_mutex.Unlock();
+    task.Run(0, task_id);
+    m_mutex.Lock();
+    m_pending--;
+  }
+
+  // Wait for tasks still running on the other workers
+  while (m_pending > 0) m_done_cond.Wait(m_mutex);
+
+  m_task = NULL;
+  m_num_tasks = 0;
+  m_next_task = 0;
+  m_mutex.Unlock();
+}
+
+
+void cWorkerPool::cWorker::Run()
+{
+  m_pool->m_mutex.Lock();
+  while (true) {
+    while (!m_pool->m_terminate && m_pool->m_next_task >= m_pool->m_num_tasks) {
+      m_pool->m_cond.Wait(m_pool->m_mutex);
+    }
+    if (m_pool->m_terminate) break;
+
+    const int task_id = m_pool->m_next_task++;
+    cTask* task = m_pool->m_task;
+    m_pool->m_mutex.Unlock();
+
+    task->Run(m_id, task_id);
+
+    m_pool->m_mutex.Lock();
+    if (--m_pool->m_pending == 0) m_pool->m_done_cond.Signal();
+  }
+  m_pool->m_mutex.Unlock();
+}
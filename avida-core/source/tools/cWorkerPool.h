@@ -0,0 +1,86 @@
+/*
+ *  cWorkerPool.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cWorkerPool_h
+#define cWorkerPool_h
+
+#include "apto/core.h"
+#include "apto/core/Mutex.h"
+#include "apto/core/Thread.h"
+
+
+/**
+ * Fork-join pool of persistent worker threads.  Execute() hands out the task
+ * indices [0, num_tasks) to the workers (the calling thread participates as
+ * worker 0) and returns once every index has been run.  Tasks are claimed in
+ * whatever order the workers get to them, so anything that must be
+ * reproducible (such as random number streams) has to be keyed on the task
+ * index rather than on the worker id.
+ **/
+
+class cWorkerPool
+{
+public:
+  class cTask
+  {
+  public:
+    virtual ~cTask() { ; }
+    virtual void Run(int worker_id, int task_id) = 0;
+  };
+
+private:
+  class cWorker : public Apto::Thread
+  {
+  private:
+    cWorkerPool* m_pool;
+    int m_id;
+
+    void Run();
+
+  public:
+    cWorker(cWorkerPool* pool, int worker_id) : m_pool(pool), m_id(worker_id) { ; }
+  };
+
+  Apto::Array<cWorker*> m_workers;
+  Apto::Mutex m_mutex;
+  Apto::ConditionVariable m_cond;
+  Apto::ConditionVariable m_done_cond;
+
+  cTask* m_task;
+  int m_num_tasks;
+  int m_next_task;
+  int m_pending;
+  bool m_terminate;
+
+
+  cWorkerPool(); // @not_implemented
+  cWorkerPool(const cWorkerPool&); // @not_implemented
+  cWorkerPool& operator=(const cWorkerPool&); // @not_implemented
+
+public:
+  cWorkerPool(int num_workers);
+  ~cWorkerPool();
+
+  int GetNumWorkers() const { return m_workers.GetSize() + 1; }
+
+  void Execute(cTask& task, int num_tasks);
+};
+
+#endif
@@ -29,8 +29,12 @@
 #include <iostream>
 
 
+class cCheckpoint;
+
+
 template <class T> class tBuffer
 {
+  friend class cCheckpoint;
 private:
   Apto::Array<T> data;      // Contents of buffer...
   int offset;          // Position in buffer to next write.
@@ -54,6 +54,8 @@ public:
   bool HasArg(const cString& test_arg) const { return m_args.HasString(test_arg); }
   
   const cString& GetName() const { return m_data_entry->GetName(); }
+  const cFlexVar& GetIndex() const { return m_idx; }
+  const cStringList& GetArgs() const { return m_args; }
   cString GetDesc(const T* target) const { return m_data_entry->GetDesc(target, m_idx); }
   int GetCompareType() const { return m_data_entry->GetCompareType(); }
   const cString& GetNull() const { return m_data_entry->GetNull(); }
@@ -50,6 +50,7 @@ Avida::Viewer::ClassificationInfo::ClassificationInfo(World* in_world, const Sys
   , m_color_chart_ptr(total_colors)
   , m_threshold_colors(threshold_colors)
   , m_next_color(0)
+  , m_num_color_changes(0)
 {
   m_color_chart_id.SetAll(-1);
   m_color_chart_ptr.SetAll(Systematics::GroupPtr(NULL));
@@ -78,7 +79,10 @@ void Avida::Viewer::ClassificationInfo::Update()
 
   // Clear out colors for genotypes below threshold.
   while (it->Next()) {
-    if (MapColorOf(it->Get())->color >= 0) MapColorOf(it->Get())->color = -1;
+    if (MapColorOf(it->Get())->color >= 0) {
+      MapColorOf(it->Get())->color = -1;
+      m_num_color_changes++;
+    }
   }
 
   // Setup genotypes above threshold.
@@ -95,6 +99,7 @@ void Avida::Viewer::ClassificationInfo::Update()
       m_color_chart_ptr[new_color] = it->Get();
       free_color[new_color] = false;
       MapColorOf(it->Get())->color = new_color;
+      m_num_color_changes++;
     }
     count++;
   }
@@ -188,6 +188,8 @@ double Avida::Viewer::Driver::MutationRate()
 
 void Avida::Viewer::Driver::SetMutationRate(double rate)
 {
+  cAvidaContext ctx(this, m_world->GetRandom());
+  m_world->FinishSnapshots(ctx);
   m_world->GetConfig().COPY_MUT_PROB.Set(rate);
   cPopulation& pop = m_world->GetPopulation();
   for (int i = 0; i < pop.GetSize(); i++) pop.GetCell(i).MutationRates().SetCopyMutProb(rate);
@@ -201,6 +203,8 @@ int Avida::Viewer::Driver::PlacementMode()
 
 void Avida::Viewer::Driver::SetPlacementMode(int mode)
 {
+  cAvidaContext ctx(this, m_world->GetRandom());
+  m_world->FinishSnapshots(ctx);
   m_world->GetConfig().BIRTH_METHOD.Set(mode);
 }
 
@@ -229,6 +233,7 @@ double Avida::Viewer::Driver::ReactionValue(const Apto::String& name)
 void Avida::Viewer::Driver::SetReactionValue(const Apto::String& name, double value)
 {
   cAvidaContext ctx(this, m_world->GetRandom());
+  m_world->FinishSnapshots(ctx);
   m_world->GetEnvironment().SetReactionValue(ctx, (const char*)name, value);
 }
 
@@ -58,6 +58,10 @@ private:
   Apto::Array<int> m_color_count;
   Apto::Array<DiscreteScale::Entry> m_scale_labels;
   
+  Apto::Array<double> m_cell_value;   // Property value of each cell as of the last update, 0.0 when unoccupied
+  double m_max_value;
+  double m_min_value;
+  
   double m_cur_min;
   double m_cur_max;
   double m_target_max;
@@ -67,6 +71,7 @@ private:
 public:
   DoublePropMapMode(cWorld* world, const Apto::String& prop_id, const Apto::String& prop_desc)
   : m_prop_id(prop_id), m_prop_desc(prop_desc), m_color_count(SCALE_MAX + Avida::Viewer::MAP_RESERVED_COLORS), m_scale_labels(SCALE_LABELS)
+  , m_max_value(0.0), m_min_value(0.0)
   , m_cur_min(0.0), m_cur_max(0.0), m_target_max(0.0), m_rescale_rate_min(0.0), m_rescale_rate_max(0.0)
   {
     m_color_grid.Resize(world->GetPopulation().GetSize());
@@ -93,36 +98,97 @@ public:
   Apto::String GetProperty(const Apto::String&) const { return ""; }
   
   void Update(cPopulation& pop);
+  void UpdateCells(cPopulation& pop, const Apto::Array<int>& cells);
   
   
   // DiscreteScale Interface
   int GetScaleRange() const { return m_color_count.GetSize() - Avida::Viewer::MAP_RESERVED_COLORS; }
   int GetNumLabeledEntries() const { return m_scale_labels.GetSize(); }
   DiscreteScale::Entry GetEntry(int index) const { return m_scale_labels[index]; }
+  
+  
+private:
+  inline double cellValue(cPopulation& pop, int cell_id) const;
+  int cellColor(cPopulation& pop, int cell_id) const;
+  void findValueRange();
+  bool updateScale();
+  void updateScaleLabels();
+  void recolorAll(cPopulation& pop);
 };
 
 const double DoublePropMapMode::RESCALE_TOLERANCE = 0.1;
 const double DoublePropMapMode::MAX_RESCALE_FACTOR = 0.03;
 
+inline double DoublePropMapMode::cellValue(cPopulation& pop, int cell_id) const
+{
+  cOrganism* org = pop.GetCell(cell_id).GetOrganism();
+  return (org) ? static_cast<double>(org->Properties().Get(m_prop_id)) : 0.0;
+}
+
 void DoublePropMapMode::Update(cPopulation& pop)
 {
   m_color_grid.Resize(pop.GetSize());
+  m_cell_value.Resize(pop.GetSize());
+  for (int i = 0; i < pop.GetSize(); i++) m_cell_value[i] = cellValue(pop, i);
   
-  // Keep track of how many times each color was assigned.
-  m_color_count.SetAll(0);
+  findValueRange();
+  updateScale();
+  recolorAll(pop);
+}
+
+void DoublePropMapMode::UpdateCells(cPopulation& pop, const Apto::Array<int>& cells)
+{
+  if (m_cell_value.GetSize() != pop.GetSize()) {
+    Update(pop);
+    return;
+  }
   
-  // Determine the max and min in the population.
-  double max_fit = 0.0;
-  double min_fit = 0.0;
+  // Only the changed cells need to be looked up.  The range is only rescanned (from the cached values) when the cell
+  // that held the max or min has dropped away from it.
+  bool rescan = false;
+  for (int i = 0; i < cells.GetSize(); i++) {
+    const int cell_id = cells[i];
+    const double old_value = m_cell_value[cell_id];
+    const double value = cellValue(pop, cell_id);
+    m_cell_value[cell_id] = value;
+    
+    if (value > m_max_value) m_max_value = value;
+    else if (old_value == m_max_value && value < old_value) rescan = true;
+    if (value < m_min_value) m_min_value = value;
+    else if (old_value == m_min_value && value > old_value) rescan = true;
+  }
+  if (rescan) findValueRange();
   
-  for (int i = 0; i < pop.GetSize(); i++) {
-    cOrganism* org = pop.GetCell(i).GetOrganism();
-    if (org == NULL) continue;
-    double fit = org->Properties().Get(m_prop_id);
-    if (fit == 0.0) continue;
-    if (fit > max_fit) max_fit = fit;
-    if (fit < min_fit) min_fit = fit;
+  // When the scale moves every color shifts, otherwise only the changed cells can have a new color.
+  if (updateScale()) {
+    recolorAll(pop);
+    return;
+  }
+  for (int i = 0; i < cells.GetSize(); i++) {
+    const int cell_id = cells[i];
+    const int color = cellColor(pop, cell_id);
+    m_color_count[m_color_grid[cell_id] + Avida::Viewer::MAP_RESERVED_COLORS]--;
+    m_color_grid[cell_id] = color;
+    m_color_count[color + Avida::Viewer::MAP_RESERVED_COLORS]++;
+  }
+}
+
+void DoublePropMapMode::findValueRange()
+{
+  m_max_value = 0.0;
+  m_min_value = 0.0;
+  for (int i = 0; i < m_cell_value.GetSize(); i++) {
+    const double value = m_cell_value[i];
+    if (value > m_max_value) m_max_value = value;
+    if (value < m_min_value) m_min_value = value;
   }
+}
+
+// Move the displayed range toward the population's range, returns true if the displayed range changed.
+bool DoublePropMapMode::updateScale()
+{
+  const double max_fit = m_max_value;
+  const double min_fit = m_min_value;
   
   if (m_cur_max == 0.0) {
     // Reset range
@@ -131,67 +197,64 @@ void DoublePropMapMode::Update(cPopulation& pop)
     m_rescale_rate_min = 0.0;
     m_rescale_rate_max = 0.0;
     
-    // Update scale labels
-    for (int i = 0; i < m_scale_labels.GetSize(); i++) {
-      m_scale_labels[i].index = (SCALE_MAX / (m_scale_labels.GetSize() - 1)) * i;
-      m_scale_labels[i].label =
-      static_cast<const char*>(cStringUtil::Stringf("%2.2f", ((m_cur_max - m_cur_min) / (m_scale_labels.GetSize() - 1)) * i));
-    }
+    updateScaleLabels();
+    return true;
+  }
+  
+  if (max_fit < (1.0 - RESCALE_TOLERANCE) * m_target_max || m_target_max < max_fit) {
+    m_target_max = max_fit * (1.0 + RESCALE_TOLERANCE);
+    m_rescale_rate_max = (m_target_max - m_cur_max) / RESCALE_TIME_CONSTANT;
+  }
+  
+  if (m_rescale_rate_max == 0.0) return false;
+  
+  if (min_fit <= m_cur_max) {
+    m_cur_max += m_rescale_rate_max;
   } else {
-    if (max_fit < (1.0 - RESCALE_TOLERANCE) * m_target_max || m_target_max < max_fit) {
-      m_target_max = max_fit * (1.0 + RESCALE_TOLERANCE);
-      m_rescale_rate_max = (m_target_max - m_cur_max) / RESCALE_TIME_CONSTANT;
-    }
-    
-    if (m_rescale_rate_max != 0.0) {
-      if (min_fit <= m_cur_max) {
-        m_cur_max += m_rescale_rate_max;
-      } else {
-        double max_rate = m_cur_max * MAX_RESCALE_FACTOR;
-        m_cur_max += (m_rescale_rate_max < max_rate) ? m_rescale_rate_max : max_rate;
-      }
-      
-      if (fabs(m_target_max - m_cur_max) <= fabs(m_rescale_rate_max)) {
-        m_cur_max = m_target_max;
-        m_rescale_rate_max = 0.0;
-      }
-      
-      // Update scale labels
-      for (int i = 0; i < m_scale_labels.GetSize(); i++) {
-        m_scale_labels[i].index = (SCALE_MAX / (m_scale_labels.GetSize() - 1)) * i;
-        m_scale_labels[i].label =
-        static_cast<const char*>(cStringUtil::Stringf("%2.2f", ((m_cur_max - m_cur_min) / (m_scale_labels.GetSize() - 1)) * i));
-      }
-    }
+    double max_rate = m_cur_max * MAX_RESCALE_FACTOR;
+    m_cur_max += (m_rescale_rate_max < max_rate) ? m_rescale_rate_max : max_rate;
   }
   
-  // Now fill out the color grid.
-  for (int i = 0; i < pop.GetSize(); i++) {
-    cOrganism* org = pop.GetCell(i).GetOrganism();
-    if (org == NULL) {
-      m_color_grid[i] = Avida::Viewer::MAP_RESERVED_COLOR_BLACK;
-      m_color_count[Avida::Viewer::MAP_RESERVED_COLORS - Avida::Viewer::MAP_RESERVED_COLOR_BLACK]++;
-      continue;
-    }
-    
-    double fit = org->Properties().Get(m_prop_id);
-    if (fit == 0.0) {
-      m_color_grid[i] = Avida::Viewer::MAP_RESERVED_COLOR_DARK_GRAY;
-      m_color_count[Avida::Viewer::MAP_RESERVED_COLORS - Avida::Viewer::MAP_RESERVED_COLOR_DARK_GRAY]++;
-      continue;
-    }
-    
-    //    fit = log2(fit);
-    
-    fit = (fit - m_cur_min) / (m_cur_max - m_cur_min);
-    if (fit > 1.0) {
-      m_color_grid[i] = Avida::Viewer::MAP_RESERVED_COLOR_WHITE;
-      m_color_count[Avida::Viewer::MAP_RESERVED_COLORS - Avida::Viewer::MAP_RESERVED_COLOR_WHITE]++;
-    } else {
-      int color = fit * static_cast<double>(SCALE_MAX - 1);
-      m_color_grid[i] = color;
-      m_color_count[color + Avida::Viewer::MAP_RESERVED_COLORS]++;
-    }
+  if (fabs(m_target_max - m_cur_max) <= fabs(m_rescale_rate_max)) {
+    m_cur_max = m_target_max;
+    m_rescale_rate_max = 0.0;
+  }
+  
+  updateScaleLabels();
+  return true;
+}
+
+void DoublePropMapMode::updateScaleLabels()
+{
+  for (int i = 0; i < m_scale_labels.GetSize(); i++) {
+    m_scale_labels[i].index = (SCALE_MAX / (m_scale_labels.GetSize() - 1)) * i;
+    m_scale_labels[i].label =
+    static_cast<const char*>(cStringUtil::Stringf("%2.2f", ((m_cur_max - m_cur_min) / (m_scale_labels.GetSize() - 1)) * i));
+  }
+}
+
+int DoublePropMapMode::cellColor(cPopulation& pop, int cell_id) const
+{
+  if (!pop.GetCell(cell_id).IsOccupied()) return Avida::Viewer::MAP_RESERVED_COLOR_BLACK;
+  
+  double fit = m_cell_value[cell_id];
+  if (fit == 0.0) return Avida::Viewer::MAP_RESERVED_COLOR_DARK_GRAY;
+  
+  //    fit = log2(fit);
+  
+  fit = (fit - m_cur_min) / (m_cur_max - m_cur_min);
+  if (fit > 1.0) return Avida::Viewer::MAP_RESERVED_COLOR_WHITE;
+  return fit * static_cast<double>(SCALE_MAX - 1);
+}
+
+void DoublePropMapMode::recolorAll(cPopulation& pop)
+{
+  // Keep track of how many times each color was assigned.
+  m_color_count.SetAll(0);
+  for (int i = 0; i < m_color_grid.GetSize(); i++) {
+    const int color = cellColor(pop, i);
+    m_color_grid[i] = color;
+    m_color_count[color + Avida::Viewer::MAP_RESERVED_COLORS]++;
   }
 }
 
@@ -216,6 +279,7 @@ private:
   const Apto::String m_role_desc;
   
   Avida::Viewer::ClassificationInfo* m_info;
+  int m_num_color_changes;    // Color changes made by m_info as of the last update
   Apto::Array<int> m_color_grid;
   Apto::Array<int> m_color_count;
   Apto::Array<DiscreteScale::Entry> m_scale_labels;
@@ -240,6 +304,7 @@ public:
   Apto::String GetProperty(const Apto::String&) const { return ""; }
   
   void Update(cPopulation& pop);
+  void UpdateCells(cPopulation& pop, const Apto::Array<int>& cells);
   
   
   // DiscreteScale Interface
@@ -247,11 +312,18 @@ public:
   int GetNumLabeledEntries() const { return m_scale_labels.GetSize(); }
   DiscreteScale::Entry GetEntry(int index) const { return m_scale_labels[index]; }
   bool IsCategorical() const { return true; }
+  
+  
+private:
+  int cellColor(cPopulation& pop, int cell_id);
+  void recolorAll(cPopulation& pop);
+  void clearUnusedLabels();
 };
 
 ClassificationMapMode::ClassificationMapMode(cWorld* world, const Apto::String& role_id, const Apto::String& role_desc)
 : m_role_id(role_id), m_role_desc(role_desc)
 , m_info(new Avida::Viewer::ClassificationInfo(world->GetNewWorld(), role_id, NUM_COLORS, NUM_COLORS))
+, m_num_color_changes(-1)
 , m_color_count(NUM_COLORS + Avida::Viewer::MAP_RESERVED_COLORS)
 , m_scale_labels(NUM_COLORS + Avida::Viewer::MAP_RESERVED_COLORS)
 {
@@ -271,28 +343,59 @@ ClassificationMapMode::ClassificationMapMode(cWorld* world, const Apto::String&
 void ClassificationMapMode::Update(cPopulation& pop)
 {
   m_info->Update();
+  m_num_color_changes = m_info->GetNumColorChanges();
+  recolorAll(pop);
+}
+
+void ClassificationMapMode::UpdateCells(cPopulation& pop, const Apto::Array<int>& cells)
+{
+  m_info->Update();
+  
+  // Any group gaining or losing its color can recolor cells that have not changed themselves
+  if (m_color_grid.GetSize() != pop.GetSize() || m_num_color_changes != m_info->GetNumColorChanges()) {
+    m_num_color_changes = m_info->GetNumColorChanges();
+    recolorAll(pop);
+    return;
+  }
+  
+  for (int i = 0; i < cells.GetSize(); i++) {
+    const int cell_id = cells[i];
+    m_color_count[m_color_grid[cell_id] + 4]--;
+    m_color_grid[cell_id] = cellColor(pop, cell_id);
+    m_color_count[m_color_grid[cell_id] + 4]++;
+  }
+  clearUnusedLabels();
+}
+
+int ClassificationMapMode::cellColor(cPopulation& pop, int cell_id)
+{
+  cOrganism* org = pop.GetCell(cell_id).GetOrganism();
+  if (org == NULL) return -4;
+  
+  Systematics::GroupPtr bg = org->SystematicsGroup(m_role_id);
+  if (bg) {
+    Avida::Viewer::ClassificationInfo::MapColorPtr mapcolor = bg->GetData<Avida::Viewer::ClassificationInfo::MapColor>();
+    if (mapcolor) {
+      m_scale_labels[mapcolor->color + 4].label = bg->Properties().Get("name").StringValue();
+      return mapcolor->color;
+    }
+  }
+  return -1;
+}
+
+void ClassificationMapMode::recolorAll(cPopulation& pop)
+{
   m_color_grid.Resize(pop.GetSize());
   m_color_count.SetAll(0);            // reset all color counts
   for (int i = 0; i < pop.GetSize(); i++) {
-    cOrganism* org = pop.GetCell(i).GetOrganism();
-    if (org == NULL) {
-      m_color_grid[i] = -4;
-      m_color_count[0]++;
-    } else {
-      Systematics::GroupPtr bg = org->SystematicsGroup(m_role_id);
-      if (bg) {
-        Avida::Viewer::ClassificationInfo::MapColorPtr mapcolor = bg->GetData<Avida::Viewer::ClassificationInfo::MapColor>();
-        if (mapcolor) {
-          m_color_grid[i] = mapcolor->color;
-          m_color_count[mapcolor->color + 4]++;
-          m_scale_labels[mapcolor->color + 4].label = bg->Properties().Get("name").StringValue();
-          continue;
-        }
-      }
-      m_color_grid[i] = -1;
-      m_color_count[3]++;
-    }
+    m_color_grid[i] = cellColor(pop, i);
+    m_color_count[m_color_grid[i] + 4]++;
   }
+  clearUnusedLabels();
+}
+
+void ClassificationMapMode::clearUnusedLabels()
+{
   for (int i = 0; i < m_color_count.GetSize(); i++) if (m_color_count[i] == 0) m_scale_labels[i].label = "-";
 }
 
@@ -332,6 +435,7 @@ public:
   Apto::String GetProperty(const Apto::String& property) const;
   
   void Update(cPopulation& pop);
+  void UpdateCells(cPopulation& pop, const Apto::Array<int>& cells);
   
   
   // DiscreteScale Interface
@@ -341,6 +445,8 @@ public:
   
   
 private:
+  void updateRawCounts(cAvidaContext& ctx, cPopulation& pop, int cell_id);
+  int cellTagState(int cell_id) const;
   void updateTagStates();
 };
 
@@ -409,49 +515,76 @@ void EnvActionMapMode::Update(cPopulation& pop)
   m_action_grid.Resize(pop.GetSize());
   m_raw_action_counts.Resize(pop.GetSize());
   for (int i = 0; i < m_raw_action_counts.GetSize(); i++) m_raw_action_counts[i].Resize(m_action_ids.GetSize());
-  m_action_counts.SetAll(0);            // reset all color counts
   
-  for (int i = 0; i < pop.GetSize(); i++) {
-    cOrganism* org = pop.GetCell(i).GetOrganism();
-    if (org == NULL) {
-      m_raw_action_counts[i].SetAll(0);
-    } else {
-      for (int task_id = 0; task_id < m_action_ids.GetSize(); task_id++) {
-//        if (org->GetPhenotype().GetLastTaskCount()[task_id] > 0) m_raw_action_counts[i][task_id] = 1;
-//        else if (org->GetPhenotype().GetCurTaskCount()[task_id] > 0) m_raw_action_counts[i][task_id] = 2;
-        Systematics::GroupPtr genotype = org->SystematicsGroup("genotype");
-        Systematics::GenomeTestMetricsPtr metrics(Systematics::GenomeTestMetrics::GetMetrics(m_world, ctx, genotype));
-        const Apto::Array<int>& task_counts = metrics->GetTaskCounts();
-        if (task_counts[task_id] > 0) m_raw_action_counts[i][task_id] = 1;
-        else m_raw_action_counts[i][task_id] = 0;
-      }
-    }
-  }
+  for (int i = 0; i < pop.GetSize(); i++) updateRawCounts(ctx, pop, i);
   
   updateTagStates();
 }
 
 
+void EnvActionMapMode::UpdateCells(cPopulation& pop, const Apto::Array<int>& cells)
+{
+  if (m_raw_action_counts.GetSize() != pop.GetSize()) {
+    Update(pop);
+    return;
+  }
+  
+  cAvidaContext ctx(&m_world->GetDriver(), m_world->GetRandom());
+  for (int i = 0; i < cells.GetSize(); i++) {
+    const int cell_id = cells[i];
+    updateRawCounts(ctx, pop, cell_id);
+    if (m_num_enabled == 0) continue;   // Grid stays cleared while no actions are enabled
+    
+    m_action_counts[4 + m_action_grid[cell_id]]--;
+    m_action_grid[cell_id] = cellTagState(cell_id);
+    m_action_counts[4 + m_action_grid[cell_id]]++;
+  }
+}
+
+
+void EnvActionMapMode::updateRawCounts(cAvidaContext& ctx, cPopulation& pop, int cell_id)
+{
+  cOrganism* org = pop.GetCell(cell_id).GetOrganism();
+  if (org == NULL) {
+    m_raw_action_counts[cell_id].SetAll(0);
+    return;
+  }
+  
+//  if (org->GetPhenotype().GetLastTaskCount()[task_id] > 0) m_raw_action_counts[i][task_id] = 1;
+//  else if (org->GetPhenotype().GetCurTaskCount()[task_id] > 0) m_raw_action_counts[i][task_id] = 2;
+  Systematics::GroupPtr genotype = org->SystematicsGroup("genotype");
+  Systematics::GenomeTestMetricsPtr metrics(Systematics::GenomeTestMetrics::GetMetrics(m_world, ctx, genotype));
+  const Apto::Array<int>& task_counts = metrics->GetTaskCounts();
+  for (int task_id = 0; task_id < m_action_ids.GetSize(); task_id++) {
+    m_raw_action_counts[cell_id][task_id] = (task_counts[task_id] > 0) ? 1 : 0;
+  }
+}
+
+
+int EnvActionMapMode::cellTagState(int cell_id) const
+{
+  int color = -1;
+  for (int task_id = 0; task_id < m_action_ids.GetSize(); task_id++) {
+    if (!m_enabled_actions[task_id]) continue;  // Task disabled, so ignore value
+    
+    if (m_raw_action_counts[cell_id][task_id] == 0) return -4;  // One of the enabled tasks is not being performed, so clear tag
+    
+    if (m_raw_action_counts[cell_id][task_id] == 2) color = -3;  // One of the enabled tasks is a current task, so dim the tag
+  }
+  return color;
+}
+
+
 void EnvActionMapMode::updateTagStates()
 {
+  m_action_counts.SetAll(0);            // reset all color counts
   if (m_num_enabled == 0) {
     m_action_grid.SetAll(-4);
     return;
   }
   for (int i = 0; i < m_action_grid.GetSize(); i++) {
-    int color = -1;
-    for (int task_id = 0; task_id < m_action_ids.GetSize(); task_id++) {
-      if (!m_enabled_actions[task_id]) continue;  // Task disabled, so ignore value
-      
-      if (m_raw_action_counts[i][task_id] == 0) {  // One of the enabled tasks is not being performed, so clear tag and exit
-        color = -4;
-        break;
-      }
-      
-      if (m_raw_action_counts[i][task_id] == 2) color = -3;  // One of the enabled tasks is a current task, so dim the tag
-    }
-    m_action_grid[i] = color;
-    m_action_counts[4 + color]++;
+    m_action_grid[i] = cellTagState(i);
+    m_action_counts[4 + m_action_grid[i]]++;
   }
 }
 
@@ -512,7 +645,14 @@ void Avida::Viewer::Map::UpdateMaps(cPopulation& pop)
   m_width = pop.GetWorldX();
   m_height = pop.GetWorldY();
   
-  for (int i = 0; i < m_view_modes.GetSize(); i++) m_view_modes[i]->Update(pop);
+  // Modes only revisit the cells that changed since the last update, unless the population was not tracking changes or
+  // so many cells changed that a full pass is just as cheap.
+  const bool full_refresh = !pop.ChangedCellsValid() || pop.GetChangedCells().GetSize() > pop.GetSize() / 4;
+  for (int i = 0; i < m_view_modes.GetSize(); i++) {
+    if (full_refresh) m_view_modes[i]->Update(pop);
+    else m_view_modes[i]->UpdateCells(pop, pop.GetChangedCells());
+  }
+  pop.ResetChangedCells();
   
   m_rw_lock.WriteUnlock();
 }